@@ -0,0 +1,137 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <vector>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/variables.h"
+#include "containers/data_value_container.h"
+#include "includes/kratos_components.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+/// The containers hold the typical values of a node: two scalars and two vectors
+void FillDataValueContainers(std::vector<DataValueContainer>& rContainers)
+{
+    for (std::size_t i = 0; i < rContainers.size(); ++i)
+    {
+        const double value = static_cast<double>(i);
+        rContainers[i].SetValue(TEMPERATURE, value);
+        rContainers[i].SetValue(PRESSURE, 2.0 * value);
+        rContainers[i].SetValue(DISPLACEMENT, array_1d<double, 3>(3, value));
+        rContainers[i].SetValue(VELOCITY, array_1d<double, 3>(3, 2.0 * value));
+    }
+}
+
+void DataValueContainerSetValueBenchmark(BenchmarkState& rState)
+{
+    std::vector<DataValueContainer> containers(rState.Scaled(100000));
+
+    rState.Run([&](){ FillDataValueContainers(containers); });
+
+    rState.SetItemsPerRun(4 * containers.size());
+}
+
+void DataValueContainerGetValueBenchmark(BenchmarkState& rState)
+{
+    std::vector<DataValueContainer> containers(rState.Scaled(100000));
+    FillDataValueContainers(containers);
+
+    double sum = 0.0;
+    rState.Run([&]()
+    {
+        sum = 0.0;
+        for (std::size_t i = 0; i < containers.size(); ++i)
+        {
+            const DataValueContainer& r_container = containers[i];
+            sum += r_container.GetValue(TEMPERATURE) + r_container.GetValue(PRESSURE)
+                 + r_container.GetValue(DISPLACEMENT)[0] + r_container.GetValue(VELOCITY)[0];
+        }
+    });
+
+    KRATOS_ERROR_IF(sum <= 0.0) << "The values are not found";
+    rState.SetItemsPerRun(4 * containers.size());
+}
+
+/// The names of the registered double variables, each repeated so that a run makes about 100000 lookups
+std::vector<std::string> GetVariableNames(const std::size_t NumberOfLookups)
+{
+    std::vector<std::string> names;
+    for (KratosComponents<Variable<double> >::ComponentsContainerType::const_iterator it = KratosComponents<Variable<double> >::GetComponents().begin();
+            it != KratosComponents<Variable<double> >::GetComponents().end(); ++it)
+        names.push_back(it->first);
+
+    std::vector<std::string> lookups(NumberOfLookups);
+    for (std::size_t i = 0; i < lookups.size(); ++i)
+        lookups[i] = names[(i * 7919) % names.size()];
+    return lookups;
+}
+
+void KratosComponentsGetBenchmark(BenchmarkState& rState)
+{
+    const std::vector<std::string> names = GetVariableNames(rState.Scaled(100000));
+
+    std::size_t sum = 0;
+    rState.Run([&]()
+    {
+        sum = 0;
+        for (std::size_t i = 0; i < names.size(); ++i)
+            sum += KratosComponents<Variable<double> >::Get(names[i]).Key();
+    });
+
+    KRATOS_ERROR_IF(sum == 0) << "The variables are not found";
+    rState.SetItemsPerRun(names.size());
+    rState.SetCounter("registered", KratosComponents<Variable<double> >::GetComponents().size());
+}
+
+void ComponentHandleGetBenchmark(BenchmarkState& rState)
+{
+    const std::vector<std::string> names = GetVariableNames(rState.Scaled(100000));
+    std::vector<ComponentHandle<Variable<double> > > handles;
+    handles.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i)
+        handles.push_back(ComponentHandle<Variable<double> >(names[i]));
+
+    std::size_t sum = 0;
+    rState.Run([&]()
+    {
+        sum = 0;
+        for (std::size_t i = 0; i < handles.size(); ++i)
+            sum += handles[i].Get().Key();
+    });
+
+    KRATOS_ERROR_IF(sum == 0) << "The variables are not found";
+    rState.SetItemsPerRun(handles.size());
+}
+
+void AddContainersBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("containers/DataValueContainer::SetValue", DataValueContainerSetValueBenchmark);
+    rSuite.Add("containers/DataValueContainer::GetValue", DataValueContainerGetValueBenchmark);
+    rSuite.Add("containers/KratosComponents::Get", KratosComponentsGetBenchmark);
+    rSuite.Add("containers/ComponentHandle::Get", ComponentHandleGetBenchmark);
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
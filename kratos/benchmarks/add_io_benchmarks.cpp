@@ -0,0 +1,304 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/model_part_io.h"
+#include "includes/json_io.h"
+#include "includes/serializer.h"
+#include "processes/divide_input_to_partitions_process.h"
+#include "benchmarks/benchmark_utilities.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+void ModelPartIOReadBenchmark(BenchmarkState& rState)
+{
+    const std::size_t divisions = rState.Scaled(24);
+    const std::string filename = (std::filesystem::temp_directory_path() / "kratos_core_benchmarks_io").string();
+    BenchmarkUtilities::WriteMdpa(filename + ".mdpa", divisions, 3);
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    try
+    {
+        rState.Run([&]()
+        {
+            p_model_part.reset(new ModelPart("Benchmark"));
+            p_model_part->AddNodalSolutionStepVariable(TEMPERATURE);
+        },
+        [&]()
+        {
+            ModelPartIO<ModelPart> io(filename);
+            io.ReadModelPart(*p_model_part);
+        });
+    }
+    catch (...)
+    {
+        std::filesystem::remove(filename + ".mdpa");
+        throw;
+    }
+
+    std::filesystem::remove(filename + ".mdpa");
+
+    rState.SetItemsPerRun(p_model_part->NumberOfNodes() + p_model_part->NumberOfElements());
+    rState.SetCounter("nodes", p_model_part->NumberOfNodes());
+    rState.SetCounter("elements", p_model_part->NumberOfElements());
+}
+
+/// A .mdpa file with the nodes of the unit cube and many small NodalData blocks of scalar and component variables
+void WriteNodalDataBlocksMdpa(const std::string& rFilename, const std::size_t Divisions, const std::size_t NumberOfBlocks)
+{
+    std::ofstream output(rFilename.c_str());
+    KRATOS_ERROR_IF(!output) << "Error opening output file " << rFilename;
+
+    const std::size_t number_of_nodes = BenchmarkUtilities::NumberOfNodes(Divisions, 3);
+    double coordinates[3];
+    output << "Begin Nodes\n";
+    for (std::size_t id = 1; id <= number_of_nodes; ++id)
+    {
+        BenchmarkUtilities::GetNodeCoordinates(id, Divisions, 3, coordinates);
+        output << id << " " << coordinates[0] << " " << coordinates[1] << " " << coordinates[2] << "\n";
+    }
+    output << "End Nodes\n\n";
+
+    const char* variables[] = {"TEMPERATURE", "PRESSURE", "DISPLACEMENT_X", "DISPLACEMENT_Y", "DISPLACEMENT_Z"};
+    const std::size_t nodes_per_block = 4;
+    for (std::size_t b = 0; b < NumberOfBlocks; ++b)
+    {
+        output << "Begin NodalData " << variables[b % 5] << "\n";
+        for (std::size_t i = 0; i < nodes_per_block; ++i)
+            output << 1 + (b * nodes_per_block + i) % number_of_nodes << " 0 1.0\n";
+        output << "End NodalData\n";
+    }
+}
+
+void ModelPartIOReadNodalDataBlocksBenchmark(BenchmarkState& rState)
+{
+    const std::size_t number_of_blocks = rState.Scaled(20000);
+    const std::string filename = (std::filesystem::temp_directory_path() / "kratos_core_benchmarks_nodal_data").string();
+    WriteNodalDataBlocksMdpa(filename + ".mdpa", 8, number_of_blocks);
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    try
+    {
+        rState.Run([&]()
+        {
+            p_model_part.reset(new ModelPart("Benchmark"));
+            p_model_part->AddNodalSolutionStepVariable(TEMPERATURE);
+            p_model_part->AddNodalSolutionStepVariable(PRESSURE);
+            p_model_part->AddNodalSolutionStepVariable(DISPLACEMENT);
+        },
+        [&]()
+        {
+            ModelPartIO<ModelPart> io(filename);
+            io.ReadModelPart(*p_model_part);
+        });
+    }
+    catch (...)
+    {
+        std::filesystem::remove(filename + ".mdpa");
+        throw;
+    }
+
+    std::filesystem::remove(filename + ".mdpa");
+
+    rState.SetItemsPerRun(number_of_blocks);
+    rState.SetCounter("nodes", p_model_part->NumberOfNodes());
+}
+
+void KratosJsonIOWriteBenchmark(BenchmarkState& rState)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(24), 3);
+    const std::string filename = (std::filesystem::temp_directory_path() / "kratos_core_benchmarks_io.json").string();
+
+    try
+    {
+        rState.Run([&]()
+        {
+            KratosJsonIO io(filename, BaseIO::WRITE);
+            io.WriteModelPart(model_part);
+        });
+    }
+    catch (...)
+    {
+        std::filesystem::remove(filename);
+        throw;
+    }
+
+    rState.SetItemsPerRun(model_part.NumberOfNodes() + model_part.NumberOfElements());
+    rState.SetCounter("bytes", std::filesystem::file_size(filename));
+    std::filesystem::remove(filename);
+}
+
+void KratosJsonIOReadBenchmark(BenchmarkState& rState)
+{
+    const std::string filename = (std::filesystem::temp_directory_path() / "kratos_core_benchmarks_io.json").string();
+    {
+        ModelPart model_part("Benchmark");
+        BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(24), 3);
+        KratosJsonIO io(filename, BaseIO::WRITE);
+        io.WriteModelPart(model_part);
+    }
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    try
+    {
+        rState.Run([&]()
+        {
+            p_model_part.reset(new ModelPart("Benchmark"));
+            p_model_part->AddNodalSolutionStepVariable(TEMPERATURE);
+        },
+        [&]()
+        {
+            KratosJsonIO io(filename);
+            io.ReadModelPart(*p_model_part);
+        });
+    }
+    catch (...)
+    {
+        std::filesystem::remove(filename);
+        throw;
+    }
+
+    std::filesystem::remove(filename);
+
+    rState.SetItemsPerRun(p_model_part->NumberOfNodes() + p_model_part->NumberOfElements());
+    rState.SetCounter("nodes", p_model_part->NumberOfNodes());
+    rState.SetCounter("elements", p_model_part->NumberOfElements());
+}
+
+void SerializerSaveBenchmark(BenchmarkState& rState)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(16), 3);
+
+    std::unique_ptr<Serializer> p_serializer;
+
+    rState.Run([&](){ p_serializer.reset(new Serializer()); },
+               [&](){ p_serializer->save("ModelPart", model_part); });
+
+    rState.SetItemsPerRun(model_part.NumberOfNodes() + model_part.NumberOfElements());
+    rState.SetCounter("bytes", static_cast<std::stringstream*>(p_serializer->pGetBuffer())->str().size());
+}
+
+void SerializerLoadBenchmark(BenchmarkState& rState)
+{
+    std::string buffer;
+    std::size_t number_of_items;
+    {
+        ModelPart model_part("Benchmark");
+        BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(16), 3);
+
+        Serializer serializer;
+        serializer.save("ModelPart", model_part);
+        buffer = static_cast<std::stringstream*>(serializer.pGetBuffer())->str();
+        number_of_items = model_part.NumberOfNodes() + model_part.NumberOfElements();
+    }
+
+    std::unique_ptr<Serializer> p_serializer;
+    std::unique_ptr<ModelPart> p_model_part;
+
+    rState.Run([&]()
+    {
+        p_serializer.reset(new Serializer());
+        p_serializer->pGetBuffer()->write(buffer.data(), buffer.size());
+        p_serializer->pGetBuffer()->seekg(0);
+        p_model_part.reset(new ModelPart("Benchmark"));
+    },
+    [&](){ p_serializer->load("ModelPart", *p_model_part); });
+
+    KRATOS_ERROR_IF(p_model_part->NumberOfNodes() + p_model_part->NumberOfElements() != number_of_items)
+        << "The loaded model part has " << p_model_part->NumberOfNodes() << " nodes and "
+        << p_model_part->NumberOfElements() << " elements, " << number_of_items << " items are saved";
+
+    rState.SetItemsPerRun(number_of_items);
+    rState.SetCounter("bytes", buffer.size());
+}
+
+/// The division of the mdpa of the unit cube into partition files, end to end: reading the nodes and connectivities,
+/// partitioning them and writing the partition files
+void DivideInputToPartitionsBenchmark(BenchmarkState& rState, const std::size_t NumberOfPartitions)
+{
+    const std::size_t divisions = rState.Scaled(24);
+    const std::string filename = (std::filesystem::temp_directory_path() / "kratos_core_benchmarks_partitions").string();
+    BenchmarkUtilities::WriteMdpa(filename + ".mdpa", divisions, 3);
+
+    auto remove_files = [&]()
+    {
+        std::filesystem::remove(filename + ".mdpa");
+        for (std::size_t i = 0; i < NumberOfPartitions; ++i)
+            std::filesystem::remove(filename + "_" + std::to_string(i) + ".mdpa");
+    };
+
+    std::uintmax_t bytes = 0;
+    try
+    {
+        rState.Run([&]()
+        {
+            ModelPartIO<ModelPart> io(filename);
+            DivideInputToPartitionsProcess<ModelPart>(io, NumberOfPartitions).Execute();
+        });
+
+        for (std::size_t i = 0; i < NumberOfPartitions; ++i)
+            bytes += std::filesystem::file_size(filename + "_" + std::to_string(i) + ".mdpa");
+    }
+    catch (...)
+    {
+        remove_files();
+        throw;
+    }
+
+    remove_files();
+
+    const std::size_t number_of_elements = 6 * divisions * divisions * divisions;
+    rState.SetItemsPerRun(number_of_elements);
+    rState.SetCounter("elements", number_of_elements);
+    rState.SetCounter("partitions", NumberOfPartitions);
+    rState.SetCounter("bytes", bytes);
+}
+
+void AddIOBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("io/ModelPartIO::ReadModelPart", ModelPartIOReadBenchmark);
+    rSuite.Add("io/ModelPartIO::ReadModelPart(NodalData blocks)", ModelPartIOReadNodalDataBlocksBenchmark);
+    for (const std::size_t partitions : {4, 64})
+        rSuite.Add("io/DivideInputToPartitionsProcess::Execute(" + std::to_string(partitions) + " partitions)",
+            [partitions](BenchmarkState& rState){ DivideInputToPartitionsBenchmark(rState, partitions); });
+    rSuite.Add("io/KratosJsonIO::ReadModelPart", KratosJsonIOReadBenchmark);
+    rSuite.Add("io/KratosJsonIO::WriteModelPart", KratosJsonIOWriteBenchmark);
+    rSuite.Add("io/Serializer::save", SerializerSaveBenchmark);
+    rSuite.Add("io/Serializer::load", SerializerLoadBenchmark);
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
@@ -0,0 +1,261 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <vector>
+#include <memory>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "utilities/atomic_utilities.h"
+#include "utilities/memory_usage_utility.h"
+#include "utilities/model_part_reordering_utility.h"
+#include "utilities/mesh_partitioning_utility.h"
+#include "benchmarks/benchmark_utilities.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+/// The ids and the flat coordinates of the nodes of the unit cube, in ascending or shuffled order. The
+/// shuffled ids make each CreateNewNode an insertion in the middle of the nodes, hence the smaller mesh
+void GetNodesData(const std::size_t Divisions, const bool Shuffle, std::vector<ModelPart::IndexType>& rIds, std::vector<double>& rCoordinates)
+{
+    rIds.resize(BenchmarkUtilities::NumberOfNodes(Divisions, 3));
+    for (std::size_t i = 0; i < rIds.size(); ++i)
+        rIds[i] = i + 1;
+    if (Shuffle)
+        std::shuffle(rIds.begin(), rIds.end(), std::mt19937(1));
+
+    rCoordinates.resize(3 * rIds.size());
+    for (std::size_t i = 0; i < rIds.size(); ++i)
+        BenchmarkUtilities::GetNodeCoordinates(rIds[i], Divisions, 3, &rCoordinates[3 * i]);
+}
+
+void ModelPartCreateNewNodeBenchmark(BenchmarkState& rState, const bool Shuffle)
+{
+    std::vector<ModelPart::IndexType> ids;
+    std::vector<double> coordinates;
+    GetNodesData(rState.Scaled(Shuffle ? 16 : 32), Shuffle, ids, coordinates);
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    rState.Run([&](){ p_model_part.reset(new ModelPart("Benchmark")); },
+    [&]()
+    {
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            p_model_part->CreateNewNode(ids[i], coordinates[3 * i], coordinates[3 * i + 1], coordinates[3 * i + 2]);
+    });
+
+    rState.SetItemsPerRun(ids.size());
+}
+
+void ModelPartCreateNewNodesBenchmark(BenchmarkState& rState, const bool Shuffle)
+{
+    std::vector<ModelPart::IndexType> ids;
+    std::vector<double> coordinates;
+    GetNodesData(rState.Scaled(Shuffle ? 16 : 32), Shuffle, ids, coordinates);
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    rState.Run([&](){ p_model_part.reset(new ModelPart("Benchmark")); },
+               [&](){ p_model_part->CreateNewNodes(ids, coordinates); });
+
+    rState.SetItemsPerRun(ids.size());
+}
+
+/// The elements of the Laplacian mesh, created one by one from their node ids or at once
+void ModelPartCreateNewElementsBenchmark(BenchmarkState& rState, const bool Bulk)
+{
+    const std::size_t divisions = rState.Scaled(24);
+    const BenchmarkUtilities::ConnectivitiesType connectivities = BenchmarkUtilities::CreateSimplicesConnectivities(divisions, 3);
+    const std::string element_name = BenchmarkUtilities::ElementName(3);
+
+    std::vector<ModelPart::IndexType> ids(connectivities.size());
+    std::vector<ModelPart::IndexType> flat_connectivities;
+    flat_connectivities.reserve(4 * connectivities.size());
+    for (std::size_t e = 0; e < connectivities.size(); ++e)
+    {
+        ids[e] = e + 1;
+        flat_connectivities.insert(flat_connectivities.end(), connectivities[e].begin(), connectivities[e].end());
+    }
+
+    std::unique_ptr<ModelPart> p_model_part;
+
+    rState.Run([&]()
+    {
+        p_model_part.reset(new ModelPart("Benchmark"));
+        p_model_part->AddNodalSolutionStepVariable(TEMPERATURE);
+        BenchmarkUtilities::CreateNodes(*p_model_part, divisions, 3);
+    },
+    [&]()
+    {
+        if (Bulk)
+            p_model_part->CreateNewElements(element_name, ids, flat_connectivities, p_model_part->pGetProperties(1));
+        else
+            for (std::size_t e = 0; e < connectivities.size(); ++e)
+                p_model_part->CreateNewElement(element_name, ids[e], connectivities[e], p_model_part->pGetProperties(1));
+    });
+
+    rState.SetItemsPerRun(ids.size());
+}
+
+/// The accumulation of the element volumes to their nodes in parallel, under the node locks or by atomic additions
+void NodalAccumulationBenchmark(BenchmarkState& rState, const bool UseLocks)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(32), 3);
+
+    const int number_of_elements = static_cast<int>(model_part.NumberOfElements());
+    const auto it_element_begin = model_part.ElementsBegin();
+
+    rState.Run([&]()
+    {
+        for (auto it = model_part.NodesBegin(); it != model_part.NodesEnd(); ++it)
+            it->FastGetSolutionStepValue(TEMPERATURE) = 0.0;
+    },
+    [&]()
+    {
+        #pragma omp parallel for
+        for (int e = 0; e < number_of_elements; ++e)
+        {
+            Element::GeometryType& r_geometry = (it_element_begin + e)->GetGeometry();
+            const double nodal_volume = r_geometry.Volume() / r_geometry.size();
+            for (std::size_t i = 0; i < r_geometry.size(); ++i)
+            {
+                double& r_value = r_geometry[i].FastGetSolutionStepValue(TEMPERATURE);
+                if (UseLocks)
+                {
+                    r_geometry[i].SetLock();
+                    r_value += nodal_volume;
+                    r_geometry[i].UnSetLock();
+                }
+                else
+                    AtomicAdd(r_value, nodal_volume);
+            }
+        }
+    });
+
+    double total_volume = 0.0;
+    for (auto it = model_part.NodesBegin(); it != model_part.NodesEnd(); ++it)
+        total_volume += it->FastGetSolutionStepValue(TEMPERATURE);
+    KRATOS_ERROR_IF(std::abs(total_volume - 1.0) > 1.0e-10) << "The accumulated volume is " << total_volume << ", not 1";
+
+    rState.SetItemsPerRun(4 * model_part.NumberOfElements());
+    rState.SetCounter("elements", model_part.NumberOfElements());
+}
+
+/// The memory report of the Laplacian model part, with the bytes per node and per element
+void MemoryUsageUtilityBenchmark(BenchmarkState& rState)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(24), 3);
+
+    std::string report;
+    rState.Run([&](){ report = MemoryUsageUtility<ModelPart>::Report(model_part); });
+
+    const MemoryUsageUtility<ModelPart>::MemoryUsage nodes = MemoryUsageUtility<ModelPart>::NodesMemoryUsage(model_part);
+    const MemoryUsageUtility<ModelPart>::MemoryUsage elements = MemoryUsageUtility<ModelPart>::ElementsMemoryUsage(model_part);
+
+    rState.SetItemsPerRun(model_part.NumberOfNodes() + model_part.NumberOfElements());
+    rState.SetCounter("bytes_per_node", static_cast<double>(nodes.Total()) / nodes.NumberOfObjects);
+    rState.SetCounter("bytes_per_element", static_cast<double>(elements.Total()) / elements.NumberOfObjects);
+    for (const auto& r_component : nodes.Components)
+        rState.SetCounter("node " + r_component.first, static_cast<double>(r_component.second) / nodes.NumberOfObjects);
+}
+
+/// The reordering of the shuffled Laplacian model part, whose ids are restored before each run
+void ModelPartReorderingBenchmark(BenchmarkState& rState, const ModelPartReorderingType Type)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateShuffledLaplacianModelPart(model_part, rState.Scaled(32), 3);
+
+    ModelPartReorderingUtility<ModelPart> reordering(Type);
+    rState.Run([&](){ if (reordering.IsReordered()) reordering.RestoreIds(model_part); },
+               [&](){ reordering.Reorder(model_part); });
+
+    rState.SetItemsPerRun(model_part.NumberOfElements());
+    rState.SetCounter("nodes", model_part.NumberOfNodes());
+    rState.SetCounter("elements", model_part.NumberOfElements());
+}
+
+/// The relocation of the nodes and elements of the reordered shuffled Laplacian model part
+void ModelPartRelocationBenchmark(BenchmarkState& rState)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateShuffledLaplacianModelPart(model_part, rState.Scaled(32), 3);
+    ModelPartReorderingUtility<ModelPart>(ModelPartReorderingType::HilbertCurve).Reorder(model_part);
+
+    rState.Run([&](){ ModelPartReorderingUtility<ModelPart>::Relocate(model_part); });
+
+    rState.SetItemsPerRun(model_part.NumberOfElements());
+    rState.SetCounter("nodes", model_part.NumberOfNodes());
+    rState.SetCounter("elements", model_part.NumberOfElements());
+}
+
+/// The partition of the mesh of the unit cube along the Hilbert curve, from the coordinates and connectivities as read by DivideInputToPartitionsProcess
+void MeshPartitioningBenchmark(BenchmarkState& rState, const std::size_t NumberOfPartitions)
+{
+    const std::size_t divisions = rState.Scaled(32);
+    std::vector<MeshPartitioningUtility::PointType> coordinates(BenchmarkUtilities::NumberOfNodes(divisions, 3));
+    for (std::size_t i = 0; i < coordinates.size(); ++i)
+        BenchmarkUtilities::GetNodeCoordinates(i + 1, divisions, 3, &coordinates[i][0]);
+    const MeshPartitioningUtility::ConnectivitiesContainerType elements_connectivities = BenchmarkUtilities::CreateSimplicesConnectivities(divisions, 3);
+    const MeshPartitioningUtility::ConnectivitiesContainerType conditions_connectivities;
+
+    MeshPartitioningUtility partitioner(NumberOfPartitions);
+    rState.Run([&](){ partitioner.Partition(coordinates, elements_connectivities, conditions_connectivities); });
+
+    rState.SetItemsPerRun(elements_connectivities.size());
+    rState.SetCounter("elements", elements_connectivities.size());
+    rState.SetCounter("edge_cut", partitioner.GetEdgeCut());
+    rState.SetCounter("interface_nodes", partitioner.GetNumberOfInterfaceNodes());
+    rState.SetCounter("elements_imbalance", partitioner.GetElementsImbalance());
+    rState.SetCounter("nodes_imbalance", partitioner.GetNodesImbalance());
+}
+
+void AddModelPartBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("model_part/ModelPart::CreateNewNode", [](BenchmarkState& rState){ ModelPartCreateNewNodeBenchmark(rState, false); });
+    rSuite.Add("model_part/ModelPart::CreateNewNodes", [](BenchmarkState& rState){ ModelPartCreateNewNodesBenchmark(rState, false); });
+    rSuite.Add("model_part/ModelPart::CreateNewNode(shuffled ids)", [](BenchmarkState& rState){ ModelPartCreateNewNodeBenchmark(rState, true); });
+    rSuite.Add("model_part/ModelPart::CreateNewNodes(shuffled ids)", [](BenchmarkState& rState){ ModelPartCreateNewNodesBenchmark(rState, true); });
+    rSuite.Add("model_part/ModelPart::CreateNewElement", [](BenchmarkState& rState){ ModelPartCreateNewElementsBenchmark(rState, false); });
+    rSuite.Add("model_part/ModelPart::CreateNewElements", [](BenchmarkState& rState){ ModelPartCreateNewElementsBenchmark(rState, true); });
+    rSuite.Add("model_part/Node::SetLock(nodal accumulation)", [](BenchmarkState& rState){ NodalAccumulationBenchmark(rState, true); });
+    rSuite.Add("model_part/AtomicAdd(nodal accumulation)", [](BenchmarkState& rState){ NodalAccumulationBenchmark(rState, false); });
+    rSuite.Add("model_part/MemoryUsageUtility::Report", MemoryUsageUtilityBenchmark);
+    rSuite.Add("model_part/ModelPartReorderingUtility::Reorder(HilbertCurve)",
+        [](BenchmarkState& rState){ ModelPartReorderingBenchmark(rState, ModelPartReorderingType::HilbertCurve); });
+    rSuite.Add("model_part/ModelPartReorderingUtility::Reorder(ReverseCuthillMcKee)",
+        [](BenchmarkState& rState){ ModelPartReorderingBenchmark(rState, ModelPartReorderingType::ReverseCuthillMcKee); });
+    rSuite.Add("model_part/ModelPartReorderingUtility::Relocate", ModelPartRelocationBenchmark);
+    for (const std::size_t partitions : {4, 64})
+        rSuite.Add("model_part/MeshPartitioningUtility::Partition(" + std::to_string(partitions) + " partitions)",
+            [partitions](BenchmarkState& rState){ MeshPartitioningBenchmark(rState, partitions); });
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
@@ -0,0 +1,238 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "geometries/point.h"
+#include "spatial_containers/bins_static.h"
+#include "spatial_containers/bins_dynamic.h"
+#include "spatial_containers/bins_batch_search.h"
+#include "utilities/auto_collapse_spatial_binning.h"
+#include "processes/find_nodal_neighbours_process.h"
+#include "processes/find_elements_neighbours_process.h"
+#include "benchmarks/benchmark_utilities.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+typedef Point<3> SearchPointType;
+typedef SearchPointType::Pointer SearchPointPointerType;
+typedef std::vector<SearchPointPointerType> SearchPointsContainerType;
+
+typedef Bins<3, SearchPointType, SearchPointsContainerType> StaticBinsType;
+typedef BinsDynamic<3, SearchPointType, SearchPointsContainerType> DynamicBinsType;
+
+/// Uniformly distributed points in the unit cube, always the same for a given seed
+SearchPointsContainerType CreateRandomPoints(const std::size_t NumberOfPoints, const unsigned int Seed)
+{
+    std::mt19937 generator(Seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    SearchPointsContainerType points(NumberOfPoints);
+    for (std::size_t i = 0; i < NumberOfPoints; ++i)
+    {
+        const double x = distribution(generator);
+        const double y = distribution(generator);
+        const double z = distribution(generator);
+        points[i] = SearchPointPointerType(new SearchPointType(x, y, z));
+    }
+    return points;
+}
+
+/// The radius holding about 16 of NumberOfPoints points of the unit cube
+double SearchRadius(const std::size_t NumberOfPoints)
+{
+    const double pi = 3.14159265358979323846;
+    return std::cbrt(16.0 * 3.0 / (4.0 * pi * NumberOfPoints));
+}
+
+template<class TBinsType>
+void BinsConstructionBenchmark(BenchmarkState& rState)
+{
+    SearchPointsContainerType points = CreateRandomPoints(rState.Scaled(200000), 1);
+
+    rState.Run([&](){ TBinsType bins(points.begin(), points.end()); });
+
+    rState.SetItemsPerRun(points.size());
+}
+
+template<class TBinsType>
+void BinsSearchInRadiusBenchmark(BenchmarkState& rState)
+{
+    SearchPointsContainerType points = CreateRandomPoints(rState.Scaled(200000), 1);
+    const SearchPointsContainerType queries = CreateRandomPoints(rState.Scaled(20000), 2);
+    const double radius = SearchRadius(points.size());
+    TBinsType bins(points.begin(), points.end());
+
+    const std::size_t max_number_of_results = 1000;
+    SearchPointsContainerType results(max_number_of_results);
+    std::vector<double> distances(max_number_of_results);
+
+    std::size_t number_of_results = 0;
+    rState.Run([&]()
+    {
+        number_of_results = 0;
+        for (std::size_t i = 0; i < queries.size(); ++i)
+            number_of_results += bins.SearchInRadius(*queries[i], radius, results.begin(), distances.begin(), max_number_of_results);
+    });
+
+    rState.SetItemsPerRun(queries.size());
+    rState.SetCounter("results_per_query", static_cast<double>(number_of_results) / queries.size());
+}
+
+template<class TBinsType>
+void BinsSearchNearestPointBenchmark(BenchmarkState& rState)
+{
+    SearchPointsContainerType points = CreateRandomPoints(rState.Scaled(200000), 1);
+    const SearchPointsContainerType queries = CreateRandomPoints(rState.Scaled(20000), 2);
+    TBinsType bins(points.begin(), points.end());
+
+    std::size_t number_of_found = 0;
+    rState.Run([&]()
+    {
+        number_of_found = 0;
+        for (std::size_t i = 0; i < queries.size(); ++i)
+            if (bins.SearchNearestPoint(*queries[i]))
+                ++number_of_found;
+    });
+
+    KRATOS_ERROR_IF(number_of_found != queries.size()) << "The nearest point is not found for " << queries.size() - number_of_found << " queries";
+    rState.SetItemsPerRun(queries.size());
+}
+
+/// The batched queries of BinsBatchSearch, on the same points and queries as the single queries
+template<class TBinsType>
+void BinsBatchSearchBenchmark(BenchmarkState& rState, const std::string& rQuery)
+{
+    SearchPointsContainerType points = CreateRandomPoints(rState.Scaled(200000), 1);
+    const SearchPointsContainerType query_pointers = CreateRandomPoints(rState.Scaled(20000), 2);
+    std::vector<SearchPointType> queries(query_pointers.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        queries[i] = *query_pointers[i];
+    const double radius = SearchRadius(points.size());
+    TBinsType bins(points.begin(), points.end());
+
+    BinsBatchSearch<TBinsType> search(bins);
+    typename BinsBatchSearch<TBinsType>::ResultsType results;
+
+    rState.Run([&]()
+    {
+        if (rQuery == "radius")
+            search.SearchInRadius(queries.begin(), queries.end(), radius, 1000, results);
+        else if (rQuery == "nearest")
+            search.SearchNearestPoint(queries.begin(), queries.end(), results);
+        else
+            search.SearchNearestPoints(queries.begin(), queries.end(), 8, results);
+    });
+
+    rState.SetItemsPerRun(queries.size());
+    rState.SetCounter("results_per_query", static_cast<double>(results.NumberOfResults()) / queries.size());
+}
+
+/// The merging of coincident points by AutoCollapseSpatialBinning: random points of the unit cube, each given twice
+/// with a perturbation below the tolerance, in random order. The pairs split by the boundary of a cell are not merged.
+void AutoCollapseSpatialBinningBenchmark(BenchmarkState& rState, const bool Bulk)
+{
+    const SearchPointsContainerType points = CreateRandomPoints(rState.Scaled(100000), 1);
+    const double tolerance = 1.0e-6;
+
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<double> perturbation(-0.1 * tolerance, 0.1 * tolerance);
+    std::vector<std::size_t> order(2 * points.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i / 2;
+    std::shuffle(order.begin(), order.end(), generator);
+
+    std::vector<double> coordinates(3 * order.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        for (std::size_t k = 0; k < 3; ++k)
+            coordinates[3 * i + k] = (*points[order[i]])[k] + perturbation(generator);
+
+    std::unique_ptr<AutoCollapseSpatialBinning> p_binning;
+    rState.Run([&](){ p_binning.reset(new AutoCollapseSpatialBinning(0.0, 0.0, 0.0, 0.01, 0.01, 0.01, tolerance)); },
+               [&]()
+    {
+        if (Bulk)
+            p_binning->AddNodes(coordinates);
+        else
+            for (std::size_t i = 0; i < order.size(); ++i)
+                p_binning->AddNode(coordinates[3 * i], coordinates[3 * i + 1], coordinates[3 * i + 2]);
+    });
+
+    rState.SetItemsPerRun(order.size());
+    rState.SetCounter("points", order.size());
+    rState.SetCounter("nodes", p_binning->NumberOfNodes());
+}
+
+/// The neighbour search processes on the Laplacian model part, which rebuild the adjacency of the model part and
+/// fill the legacy neighbour values from it
+void NeighboursSearchBenchmark(BenchmarkState& rState, const bool Elemental)
+{
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, rState.Scaled(32), 3);
+    for (ModelPart::ElementIterator it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it)
+        it->Set(ACTIVE, true);
+
+    if (Elemental)
+    {
+        FindElementalNeighboursProcess process(model_part, 3, 20);
+        rState.Run([&](){ process.Execute(); });
+    }
+    else
+    {
+        FindNodalNeighboursProcess process(model_part, 30, 30);
+        rState.Run([&](){ process.Execute(); });
+    }
+
+    rState.SetItemsPerRun(model_part.NumberOfElements());
+    rState.SetCounter("nodes", model_part.NumberOfNodes());
+    rState.SetCounter("elements", model_part.NumberOfElements());
+}
+
+void AddSearchBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("search/Bins::Bins", BinsConstructionBenchmark<StaticBinsType>);
+    rSuite.Add("search/Bins::SearchInRadius", BinsSearchInRadiusBenchmark<StaticBinsType>);
+    rSuite.Add("search/Bins::SearchNearestPoint", BinsSearchNearestPointBenchmark<StaticBinsType>);
+    rSuite.Add("search/BinsDynamic::BinsDynamic", BinsConstructionBenchmark<DynamicBinsType>);
+    rSuite.Add("search/BinsDynamic::SearchInRadius", BinsSearchInRadiusBenchmark<DynamicBinsType>);
+    rSuite.Add("search/BinsDynamic::SearchNearestPoint", BinsSearchNearestPointBenchmark<DynamicBinsType>);
+    rSuite.Add("search/BinsBatchSearch<Bins>::SearchInRadius", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<StaticBinsType>(rState, "radius"); });
+    rSuite.Add("search/BinsBatchSearch<Bins>::SearchNearestPoint", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<StaticBinsType>(rState, "nearest"); });
+    rSuite.Add("search/BinsBatchSearch<Bins>::SearchNearestPoints(8)", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<StaticBinsType>(rState, "k-nearest"); });
+    rSuite.Add("search/BinsBatchSearch<BinsDynamic>::SearchInRadius", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<DynamicBinsType>(rState, "radius"); });
+    rSuite.Add("search/BinsBatchSearch<BinsDynamic>::SearchNearestPoint", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<DynamicBinsType>(rState, "nearest"); });
+    rSuite.Add("search/BinsBatchSearch<BinsDynamic>::SearchNearestPoints(8)", [](BenchmarkState& rState){ BinsBatchSearchBenchmark<DynamicBinsType>(rState, "k-nearest"); });
+    rSuite.Add("search/AutoCollapseSpatialBinning::AddNode", [](BenchmarkState& rState){ AutoCollapseSpatialBinningBenchmark(rState, false); });
+    rSuite.Add("search/AutoCollapseSpatialBinning::AddNodes", [](BenchmarkState& rState){ AutoCollapseSpatialBinningBenchmark(rState, true); });
+    rSuite.Add("search/FindNodalNeighboursProcess::Execute", [](BenchmarkState& rState){ NeighboursSearchBenchmark(rState, false); });
+    rSuite.Add("search/FindElementalNeighboursProcess::Execute", [](BenchmarkState& rState){ NeighboursSearchBenchmark(rState, true); });
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
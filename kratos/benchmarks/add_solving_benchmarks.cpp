@@ -0,0 +1,1190 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <filesystem>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/matrix_market_interface.h"
+#include "spaces/ublas_space.h"
+#include "spaces/parallel_ublas_space.h"
+#include "linear_solvers/cg_solver.h"
+#include "linear_solvers/bicgstab_solver.h"
+#include "linear_solvers/block_cg_solver.h"
+#include "linear_solvers/block_bicgstab_solver.h"
+#include "linear_solvers/deflated_cg_solver.h"
+#include "linear_solvers/ilu0_preconditioner.h"
+#include "linear_solvers/field_split_preconditioner.h"
+#include "linear_solvers/skyline_lu_factorization_solver.h"
+#include "utilities/sparse_matrix_multiplication_utility.h"
+#include "utilities/model_part_reordering_utility.h"
+#include "utilities/deflation_utils.h"
+#include "solving_strategies/schemes/residualbased_incrementalupdate_static_scheme.h"
+#include "solving_strategies/builder_and_solvers/residualbased_block_builder_and_solver.h"
+#include "solving_strategies/builder_and_solvers/residualbased_block_builder_and_solver_with_constraints_deactivation.h"
+#include "solving_strategies/builder_and_solvers/residualbased_elimination_builder_and_solver_deactivation.h"
+#include "solving_strategies/convergencecriterias/displacement_criteria.h"
+#include "solving_strategies/convergencecriterias/residual_criteria.h"
+#include "solving_strategies/convergencecriterias/and_criteria.h"
+#include "solving_strategies/convergencecriterias/variable_norms_criteria.h"
+#include "solving_strategies/strategies/residualbased_newton_raphson_strategy.h"
+#include "solving_strategies/strategies/residualbased_quasi_newton_strategy.h"
+#include "benchmarks/benchmark_utilities.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+typedef UblasSpace<KRATOS_DOUBLE_TYPE, CompressedMatrix, Vector> SparseSpaceType;
+typedef UblasSpace<KRATOS_DOUBLE_TYPE, Matrix, Vector> LocalSpaceType;
+typedef ParallelUblasSpace<KRATOS_DOUBLE_TYPE, CompressedMatrix, Vector> ParallelSparseSpaceType;
+
+typedef LinearSolver<SparseSpaceType, LocalSpaceType, ModelPart> LinearSolverType;
+typedef Preconditioner<SparseSpaceType, LocalSpaceType, ModelPart> PreconditionerType;
+typedef ILU0Preconditioner<SparseSpaceType, LocalSpaceType, ModelPart> ILU0PreconditionerType;
+typedef FieldSplitPreconditioner<SparseSpaceType, LocalSpaceType, ModelPart> FieldSplitPreconditionerType;
+typedef IterativeSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> IterativeSolverType;
+typedef CGSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> CGSolverType;
+typedef BICGSTABSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> BICGSTABSolverType;
+typedef BlockCGSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> BlockCGSolverType;
+typedef BlockBICGSTABSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> BlockBICGSTABSolverType;
+typedef DeflatedCGSolver<SparseSpaceType, LocalSpaceType, ModelPart, PreconditionerType> DeflatedCGSolverType;
+typedef DeflationUtils<CompressedMatrix, Vector> DeflationUtilsType;
+typedef Scheme<SparseSpaceType, LocalSpaceType, ModelPart> SchemeType;
+typedef ResidualBasedIncrementalUpdateStaticScheme<SparseSpaceType, LocalSpaceType, ModelPart> StaticSchemeType;
+typedef ResidualBasedBlockBuilderAndSolver<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPart> BlockBuilderAndSolverType;
+typedef ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPart> BlockDeactivationBuilderAndSolverType;
+typedef ResidualBasedEliminationBuilderAndSolverDeactivation<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPart> EliminationDeactivationBuilderAndSolverType;
+typedef SkylineLUFactorizationSolver<SparseSpaceType, LocalSpaceType, ModelPart> SkylineLUSolverType;
+typedef ConvergenceCriteria<SparseSpaceType, LocalSpaceType, ModelPart> ConvergenceCriteriaType;
+typedef DisplacementCriteria<SparseSpaceType, LocalSpaceType, ModelPart> DisplacementCriteriaType;
+typedef ResidualCriteria<SparseSpaceType, LocalSpaceType, ModelPart> ResidualCriteriaType;
+typedef And_Criteria<SparseSpaceType, LocalSpaceType, ModelPart> AndCriteriaType;
+typedef VariableNormsCriteria<SparseSpaceType, LocalSpaceType, ModelPart> VariableNormsCriteriaType;
+typedef ResidualBasedNewtonRaphsonStrategy<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPart> NewtonRaphsonStrategyType;
+typedef ResidualBasedQuasiNewtonStrategy<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPart> QuasiNewtonStrategyType;
+
+/// The block builder and solver, with its matrix structure construction accessible to the benchmarks
+class BenchmarkBuilderAndSolver : public BlockBuilderAndSolverType
+{
+public:
+
+    BenchmarkBuilderAndSolver(LinearSolverType::Pointer pLinearSystemSolver)
+    : BlockBuilderAndSolverType(pLinearSystemSolver)
+    {}
+
+    using BlockBuilderAndSolverType::ConstructMatrixStructure;
+
+};
+
+/// The numbering of the mesh of the LaplacianSystem
+enum class MeshOrdering
+{
+    Structured,             // the nodes and the elements are numbered along the structured mesh
+    Shuffled,               // the ids are shuffled, as given by an unstructured mesher
+    HilbertCurve,           // the shuffled mesh, reordered by the ModelPartReorderingUtility
+    ReverseCuthillMcKee,
+    HilbertCurveRelocated,  // the shuffled mesh, reordered and relocated by the ModelPartReorderingUtility
+    ReverseCuthillMcKeeRelocated
+};
+
+/// The system of the Laplacian problem on the structured mesh of the unit cube
+class LaplacianSystem
+{
+public:
+
+    LaplacianSystem(const std::size_t Divisions, const MeshOrdering Ordering = MeshOrdering::Structured)
+    : mModelPart("Benchmark")
+    , mpScheme(new StaticSchemeType())
+    , mBuilderAndSolver(LinearSolverType::Pointer(new CGSolverType(1.0e-8, 5000, PreconditionerType::Pointer(new ILU0PreconditionerType()))))
+    , mpA(new CompressedMatrix(0, 0))
+    , mpDx(new Vector(0))
+    , mpb(new Vector(0))
+    {
+        if (Ordering == MeshOrdering::Structured)
+            BenchmarkUtilities::CreateLaplacianModelPart(mModelPart, Divisions, 3);
+        else
+            BenchmarkUtilities::CreateShuffledLaplacianModelPart(mModelPart, Divisions, 3);
+
+        if (Ordering == MeshOrdering::HilbertCurve || Ordering == MeshOrdering::HilbertCurveRelocated)
+            ModelPartReorderingUtility<ModelPart>(ModelPartReorderingType::HilbertCurve).Reorder(mModelPart);
+        else if (Ordering == MeshOrdering::ReverseCuthillMcKee || Ordering == MeshOrdering::ReverseCuthillMcKeeRelocated)
+            ModelPartReorderingUtility<ModelPart>(ModelPartReorderingType::ReverseCuthillMcKee).Reorder(mModelPart);
+
+        if (Ordering == MeshOrdering::HilbertCurveRelocated || Ordering == MeshOrdering::ReverseCuthillMcKeeRelocated)
+            ModelPartReorderingUtility<ModelPart>::Relocate(mModelPart);
+
+        mBuilderAndSolver.SetUpDofSet(mpScheme, mModelPart);
+        mBuilderAndSolver.SetUpSystem(mModelPart);
+        mBuilderAndSolver.ResizeAndInitializeVectors(mpA, mpDx, mpb, mModelPart.Elements(), mModelPart.Conditions(), mModelPart.GetProcessInfo());
+    }
+
+    void Build()
+    {
+        SparseSpaceType::SetToZero(*mpA);
+        SparseSpaceType::SetToZero(*mpb);
+        mBuilderAndSolver.Build(mpScheme, mModelPart, *mpA, *mpb);
+    }
+
+    void ApplyDirichletConditions()
+    {
+        mBuilderAndSolver.ApplyDirichletConditions(mpScheme, mModelPart, *mpA, *mpDx, *mpb);
+    }
+
+    ModelPart mModelPart;
+
+    SchemeType::Pointer mpScheme;
+
+    BenchmarkBuilderAndSolver mBuilderAndSolver;
+
+    BlockBuilderAndSolverType::TSystemMatrixPointerType mpA;
+
+    BlockBuilderAndSolverType::TSystemVectorPointerType mpDx;
+
+    BlockBuilderAndSolverType::TSystemVectorPointerType mpb;
+
+};
+
+void ConstructMatrixStructureBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(24));
+    CompressedMatrix A;
+
+    rState.Run([&](){ A = CompressedMatrix(system.mpA->size1(), system.mpA->size2()); },
+               [&](){ system.mBuilderAndSolver.ConstructMatrixStructure(A, system.mModelPart.Elements(), system.mModelPart.Conditions(), system.mModelPart.GetProcessInfo()); });
+
+    rState.SetItemsPerRun(A.nnz());
+    rState.SetCounter("equations", A.size1());
+    rState.SetCounter("nonzeros", A.nnz());
+}
+
+void BuildBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(24));
+
+    rState.Run([&](){ system.Build(); });
+
+    rState.SetItemsPerRun(system.mModelPart.NumberOfElements());
+    rState.SetCounter("elements", system.mModelPart.NumberOfElements());
+    rState.SetCounter("nonzeros", system.mpA->nnz());
+}
+
+/// The largest distance of a nonzero to the diagonal
+std::size_t Bandwidth(const CompressedMatrix& rA)
+{
+    std::size_t bandwidth = 0;
+    for (std::size_t i = 0; i < rA.size1(); ++i)
+        for (std::size_t j = rA.index1_data()[i]; j < rA.index1_data()[i + 1]; ++j)
+        {
+            const std::size_t column = rA.index2_data()[j];
+            bandwidth = std::max(bandwidth, (column > i) ? column - i : i - column);
+        }
+    return bandwidth;
+}
+
+/// The assembly on the large mesh, whose numbering gives the locality of the gathers and of the scatter into A
+void BuildOrderingBenchmark(BenchmarkState& rState, const MeshOrdering Ordering)
+{
+    LaplacianSystem system(rState.Scaled(48), Ordering);
+
+    rState.Run([&](){ system.Build(); });
+
+    rState.SetItemsPerRun(system.mModelPart.NumberOfElements());
+    rState.SetCounter("elements", system.mModelPart.NumberOfElements());
+    rState.SetCounter("nonzeros", system.mpA->nnz());
+    rState.SetCounter("bandwidth", Bandwidth(*system.mpA));
+}
+
+/// The staged excavation of the cube: at each stage the next layer of elements from the top is deactivated, and
+/// the system is set up and built again, as done by the strategy reforming the dof set at each step
+template<class TBuilderAndSolverType>
+void StagedExcavationBenchmark(BenchmarkState& rState, const bool IncrementalActivation)
+{
+    const std::size_t divisions = rState.Scaled(24);
+    const std::size_t number_of_stages = 8;
+
+    ModelPart model_part("Benchmark");
+    BenchmarkUtilities::CreateLaplacianModelPart(model_part, divisions, 3);
+    SchemeType::Pointer p_scheme(new StaticSchemeType());
+
+    std::vector<double> heights;
+    for (auto it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it)
+    {
+        double height = 0.0;
+        for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+            height += it->GetGeometry()[i].Z();
+        heights.push_back(height / it->GetGeometry().size());
+    }
+
+    std::unique_ptr<TBuilderAndSolverType> p_builder_and_solver;
+    typename TBuilderAndSolverType::TSystemMatrixPointerType p_A;
+    typename TBuilderAndSolverType::TSystemVectorPointerType p_Dx, p_b;
+
+    rState.Run([&]()
+    {
+        for (auto it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it)
+        {
+            it->Set(ACTIVE, true);
+            it->SetValue(IS_INACTIVE, false);
+        }
+
+        p_builder_and_solver.reset(new TBuilderAndSolverType(LinearSolverType::Pointer(new CGSolverType(1.0e-8, 5000))));
+        p_builder_and_solver->SetReshapeMatrixFlag(true);
+        p_builder_and_solver->SetIncrementalActivationFlag(IncrementalActivation);
+        p_A = typename TBuilderAndSolverType::TSystemMatrixPointerType(new CompressedMatrix(0, 0));
+        p_Dx = typename TBuilderAndSolverType::TSystemVectorPointerType(new Vector(0));
+        p_b = typename TBuilderAndSolverType::TSystemVectorPointerType(new Vector(0));
+    },
+    [&]()
+    {
+        for (std::size_t stage = 0; stage < number_of_stages; ++stage)
+        {
+            // excavate the layer above the current level
+            const double level = 1.0 - 0.5 * stage / number_of_stages;
+            std::size_t e = 0;
+            for (auto it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it, ++e)
+            {
+                if (heights[e] > level)
+                {
+                    it->Set(ACTIVE, false);
+                    it->SetValue(IS_INACTIVE, true);
+                }
+            }
+
+            p_builder_and_solver->SetUpDofSet(p_scheme, model_part);
+            p_builder_and_solver->SetUpSystem(model_part);
+            p_builder_and_solver->ResizeAndInitializeVectors(p_A, p_Dx, p_b, model_part);
+            SparseSpaceType::SetToZero(*p_A);
+            SparseSpaceType::SetToZero(*p_b);
+            p_builder_and_solver->Build(p_scheme, model_part, *p_A, *p_b);
+        }
+    });
+
+    rState.SetItemsPerRun(number_of_stages);
+    rState.SetCounter("elements", model_part.NumberOfElements());
+    rState.SetCounter("stages", number_of_stages);
+    rState.SetCounter("equations", p_A->size1());
+    rState.SetCounter("nonzeros", p_A->nnz());
+}
+
+template<class TSpaceType>
+void SpMVBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(24));
+    system.Build();
+
+    CompressedMatrix& A = *system.mpA;
+    Vector x(A.size2()), y(A.size1());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        x[i] = 1.0 + 1.0e-3 * (i % 1000);
+
+    const std::size_t number_of_products = 10;
+    rState.Run([&]()
+    {
+        for (std::size_t k = 0; k < number_of_products; ++k)
+            TSpaceType::Mult(A, x, y);
+    });
+
+    rState.SetItemsPerRun(number_of_products * A.nnz());
+    rState.SetCounter("nonzeros", A.nnz());
+}
+
+void CGSolverILU0Benchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(24));
+    system.Build();
+    system.ApplyDirichletConditions();
+
+    CGSolverType solver(1.0e-8, 5000, PreconditionerType::Pointer(new ILU0PreconditionerType()));
+    Vector& x = *system.mpDx;
+
+    rState.Run([&](){ SparseSpaceType::SetToZero(x); },
+               [&](){ solver.Solve(*system.mpA, x, *system.mpb); });
+
+    rState.SetItemsPerRun(system.mpA->size1());
+    rState.SetCounter("equations", system.mpA->size1());
+    rState.SetCounter("iterations", solver.GetIterationsNumber());
+}
+
+/// The setup of the DeflatedCGSolver on the Laplacian system of the given size: the aggregation with the structure
+/// of the deflated matrix, or the fill of the deflated matrix with its maps
+void DeflationSetupBenchmark(BenchmarkState& rState, const std::size_t Divisions, const bool Fill)
+{
+    LaplacianSystem system(rState.Scaled(Divisions));
+    system.Build();
+    system.ApplyDirichletConditions();
+
+    CompressedMatrix& A = *system.mpA;
+    const std::size_t max_reduced_size = 1000;
+    std::vector<int> w;
+    CompressedMatrix Ah;
+    std::vector<std::size_t> wt_index1, fill_map;
+    std::vector<int> wt_index2;
+
+    if (Fill)
+    {
+        DeflationUtilsType::ConstructW(max_reduced_size, A, w, Ah);
+        rState.Run([&]()
+        {
+            DeflationUtilsType::ConstructWtranspose(w, Ah.size1(), wt_index1, wt_index2);
+            DeflationUtilsType::ConstructFillMap(A, w, wt_index1, wt_index2, Ah, fill_map);
+            DeflationUtilsType::FillDeflatedMatrix(A, wt_index1, wt_index2, fill_map, Ah);
+        });
+    }
+    else
+    {
+        rState.Run([&](){ DeflationUtilsType::ConstructW(max_reduced_size, A, w, Ah); });
+    }
+
+    rState.SetItemsPerRun(A.nnz());
+    rState.SetCounter("equations", A.size1());
+    rState.SetCounter("nonzeros", A.nnz());
+    rState.SetCounter("reduced_size", Ah.size1());
+}
+
+/// The DeflatedCGSolver on the Laplacian system of the given size, with a constant structure: the aggregation and the
+/// factorization of the deflated matrix are done at the first solve, the measured solves only fill it again
+void DeflatedCGSolverBenchmark(BenchmarkState& rState, const std::size_t Divisions)
+{
+    LaplacianSystem system(rState.Scaled(Divisions));
+    system.Build();
+    system.ApplyDirichletConditions();
+
+    DeflatedCGSolverType solver(1.0e-8, 5000, true, 1000);
+    Vector& x = *system.mpDx;
+
+    rState.Run([&](){ SparseSpaceType::SetToZero(x); },
+               [&](){ solver.Solve(*system.mpA, x, *system.mpb); });
+
+    rState.SetItemsPerRun(system.mpA->size1());
+    rState.SetCounter("equations", system.mpA->size1());
+    rState.SetCounter("iterations", solver.GetIterationsNumber());
+}
+
+/// The Matrix Market or binary dump, or reload, of the matrix of the Laplacian system
+void MatrixIOBenchmark(BenchmarkState& rState, const bool Binary, const bool Read)
+{
+    LaplacianSystem system(rState.Scaled(32));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    const std::string filename = (std::filesystem::temp_directory_path() / (Binary ? "kratos_core_benchmarks_matrix.bin" : "kratos_core_benchmarks_matrix.mm")).string();
+    auto write = [&](){ return Binary ? WriteBinaryMatrix(filename.c_str(), A) : WriteMatrixMarketMatrix(filename.c_str(), A, false); };
+
+    CompressedMatrix B;
+    bool success = true;
+    std::uintmax_t bytes = 0;
+    try
+    {
+        if (Read)
+        {
+            KRATOS_ERROR_IF_NOT(write()) << "The matrix could not be written to " << filename;
+            rState.Run([&](){ B = CompressedMatrix(); },
+                       [&](){ success = Binary ? ReadBinaryMatrix(filename.c_str(), B) : ReadMatrixMarketMatrix(filename.c_str(), B); });
+            KRATOS_ERROR_IF(success && B.nnz() != A.nnz()) << "The matrix read has " << B.nnz() << " nonzeros instead of " << A.nnz();
+        }
+        else
+        {
+            rState.Run([&](){ success = write(); });
+        }
+        bytes = std::filesystem::file_size(filename);
+    }
+    catch (...)
+    {
+        std::filesystem::remove(filename);
+        throw;
+    }
+
+    std::filesystem::remove(filename);
+
+    KRATOS_ERROR_IF_NOT(success) << "The matrix could not be " << (Read ? "read from " : "written to ") << filename;
+    rState.SetItemsPerRun(A.nnz());
+    rState.SetCounter("equations", A.size1());
+    rState.SetCounter("nonzeros", A.nnz());
+    rState.SetCounter("bytes", bytes);
+}
+
+/// The product of A with a multi-vector of NumberOfVectors columns
+void SpMMBenchmark(BenchmarkState& rState, const std::size_t NumberOfVectors)
+{
+    LaplacianSystem system(rState.Scaled(24));
+    system.Build();
+
+    CompressedMatrix& A = *system.mpA;
+    Matrix X(A.size2(), NumberOfVectors), Y(A.size1(), NumberOfVectors);
+    for (std::size_t i = 0; i < X.size1(); ++i)
+        for (std::size_t k = 0; k < NumberOfVectors; ++k)
+            X(i, k) = 1.0 + 1.0e-3 * ((i + 7 * k) % 1000);
+
+    const std::size_t number_of_products = 10;
+    rState.Run([&]()
+    {
+        for (std::size_t k = 0; k < number_of_products; ++k)
+            SparseSpaceType::Mult(A, X, Y);
+    });
+
+    rState.SetItemsPerRun(number_of_products * NumberOfVectors * A.nnz());
+    rState.SetCounter("nonzeros", A.nnz());
+    rState.SetCounter("vectors", NumberOfVectors);
+}
+
+/// The solution of NumberOfRightHandSides right hand sides of the Laplacian system by the multi-vector Solve of the
+/// solver, without preconditioner. The throughput is the number of right hand sides solved per second.
+template<class TSolverType>
+void MultipleRightHandSidesBenchmark(BenchmarkState& rState, const std::size_t NumberOfRightHandSides)
+{
+    LaplacianSystem system(rState.Scaled(24));
+    system.Build();
+    system.ApplyDirichletConditions();
+
+    const Vector& b = *system.mpb;
+    Matrix B(b.size(), NumberOfRightHandSides), X(b.size(), NumberOfRightHandSides);
+    for (std::size_t i = 0; i < B.size1(); ++i)
+        for (std::size_t k = 0; k < NumberOfRightHandSides; ++k)
+            B(i, k) = b[i] * (1.0 + 0.5 * std::sin(0.01 * (k + 1) * i));
+
+    TSolverType solver(1.0e-8, 5000);
+
+    rState.Run([&](){ noalias(X) = ZeroMatrix(X.size1(), X.size2()); },
+               [&](){ solver.Solve(*system.mpA, X, B); });
+
+    // the largest relative residual of the right hand sides
+    Matrix residual(B.size1(), B.size2());
+    SparseSpaceType::Mult(*system.mpA, X, residual);
+    double relative_residual = 0.0;
+    for (std::size_t k = 0; k < NumberOfRightHandSides; ++k)
+        relative_residual = std::max(relative_residual, norm_2(column(B, k) - column(residual, k)) / norm_2(column(B, k)));
+
+    rState.SetItemsPerRun(NumberOfRightHandSides);
+    rState.SetCounter("equations", system.mpA->size1());
+    rState.SetCounter("right_hand_sides", NumberOfRightHandSides);
+    rState.SetCounter("iterations", solver.GetIterationsNumber());
+    rState.SetCounter("relative_residual", relative_residual);
+}
+
+/// The prolongation of the aggregates of 8 consecutive equations of the Laplacian system, smoothed by a product with A
+void CreateProlongation(const CompressedMatrix& rA, CompressedMatrix& rP)
+{
+    const std::size_t aggregate_size = 8;
+    CompressedMatrix tentative(rA.size1(), (rA.size1() + aggregate_size - 1) / aggregate_size);
+    tentative.reserve(rA.size1(), false);
+    for (std::size_t i = 0; i < rA.size1(); ++i)
+        tentative.push_back(i, i / aggregate_size, 1.0);
+    SparseMatrixMultiplicationUtility::MatrixMultiplication(rA, tentative, rP);
+}
+
+void TransposeMatrixBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    CompressedMatrix transpose;
+    rState.Run([&](){ SparseMatrixMultiplicationUtility::TransposeMatrix(transpose, A, 1.0); });
+
+    rState.SetItemsPerRun(A.nnz());
+    rState.SetCounter("nonzeros", A.nnz());
+}
+
+void MatrixMultiplicationBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    CompressedMatrix P, AP;
+    CreateProlongation(A, P);
+    rState.Run([&](){ SparseMatrixMultiplicationUtility::MatrixMultiplication(A, P, AP); });
+
+    rState.SetItemsPerRun(AP.nnz());
+    rState.SetCounter("nonzeros", AP.nnz());
+}
+
+void ProductPlanBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    CompressedMatrix P, AP;
+    CreateProlongation(A, P);
+    SparseMatrixProductPlan<CompressedMatrix> plan;
+    plan.Initialize(A, P, AP);
+    rState.Run([&](){ plan.Multiply(A, P, AP); });
+
+    rState.SetItemsPerRun(AP.nnz());
+    rState.SetCounter("nonzeros", AP.nnz());
+}
+
+/// The Galerkin product P'·A·P as the builder with constraints computes it, with the transpose of P
+void GalerkinProductBenchmark(BenchmarkState& rState)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    CompressedMatrix P, P_transpose, AP, C;
+    CreateProlongation(A, P);
+    rState.Run([&]()
+    {
+        SparseMatrixMultiplicationUtility::TransposeMatrix(P_transpose, P, 1.0);
+        SparseMatrixMultiplicationUtility::MatrixMultiplication(A, P, AP);
+        SparseMatrixMultiplicationUtility::MatrixMultiplication(P_transpose, AP, C);
+    });
+
+    rState.SetItemsPerRun(C.nnz());
+    rState.SetCounter("coarse_equations", C.size1());
+    rState.SetCounter("nonzeros", C.nnz());
+}
+
+/// The Galerkin product P'·A·P by the triple product plan, with (Initialize) or without (Multiply) the symbolic products
+void TripleProductPlanBenchmark(BenchmarkState& rState, const bool Symbolic)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+
+    const CompressedMatrix& A = *system.mpA;
+    CompressedMatrix P, C;
+    CreateProlongation(A, P);
+    SparseMatrixTripleProductPlan<CompressedMatrix> plan;
+    plan.Initialize(P, A, C);
+    if (Symbolic)
+        rState.Run([&](){ plan.Initialize(P, A, C); });
+    else
+        rState.Run([&](){ plan.Multiply(P, A, C); });
+
+    rState.SetItemsPerRun(C.nnz());
+    rState.SetCounter("coarse_equations", C.size1());
+    rState.SetCounter("nonzeros", C.nnz());
+}
+
+/**
+ * Anti-plane shear of the unit cube with the deformation theory of plasticity and a bilinear hardening, on the
+ * out of plane displacement TEMPERATURE, fixed on the boundary, under the uniform load TIME. The shear stress is
+ * G * gamma up to the yield stress and hardens with the modulus H beyond it, which gives a symmetric tangent that
+ * drops from G to H when the element yields.
+ */
+class BenchmarkPlasticityElement : public BenchmarkLaplacianElement
+{
+public:
+
+    KRATOS_CLASS_POINTER_DEFINITION(BenchmarkPlasticityElement);
+
+    static constexpr double ShearModulus = 1.0;
+    static constexpr double YieldStress = 0.3;
+    static constexpr double HardeningModulus = 0.02;
+
+    BenchmarkPlasticityElement(IndexType NewId, GeometryType::Pointer pGeometry, PropertiesType::Pointer pProperties)
+    : BenchmarkLaplacianElement(NewId, pGeometry, pProperties)
+    {}
+
+    Element::Pointer Create(IndexType NewId, NodesArrayType const& ThisNodes, PropertiesType::Pointer pProperties) const override
+    {
+        return Element::Pointer(new BenchmarkPlasticityElement(NewId, GetGeometry().Create(ThisNodes), pProperties));
+    }
+
+    void CalculateLocalSystem(MatrixType& rLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override
+    {
+        CalculateAll(&rLeftHandSideMatrix, rRightHandSideVector, rCurrentProcessInfo);
+    }
+
+    void CalculateRightHandSide(VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override
+    {
+        CalculateAll(nullptr, rRightHandSideVector, rCurrentProcessInfo);
+    }
+
+private:
+
+    void CalculateAll(MatrixType* pLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo)
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        const SizeType number_of_nodes = r_geometry.size();
+        const SizeType dimension = r_geometry.WorkingSpaceDimension();
+        const GeometryData::IntegrationMethod integration_method = r_geometry.GetDefaultIntegrationMethod();
+        const GeometryType::IntegrationPointsArrayType& r_integration_points = r_geometry.IntegrationPoints(integration_method);
+        const Matrix& r_N = r_geometry.ShapeFunctionsValues(integration_method);
+        const double load = rCurrentProcessInfo[TIME];
+
+        GeometryType::ShapeFunctionsIntegrationPointsGradientsType DN_DX;
+        Vector det_J;
+        r_geometry.ShapeFunctionsIntegrationPointsGradients(DN_DX, det_J, integration_method);
+
+        if (pLeftHandSideMatrix != nullptr)
+        {
+            if (pLeftHandSideMatrix->size1() != number_of_nodes || pLeftHandSideMatrix->size2() != number_of_nodes)
+                pLeftHandSideMatrix->resize(number_of_nodes, number_of_nodes, false);
+            noalias(*pLeftHandSideMatrix) = ZeroMatrix(number_of_nodes, number_of_nodes);
+        }
+        if (rRightHandSideVector.size() != number_of_nodes)
+            rRightHandSideVector.resize(number_of_nodes, false);
+        noalias(rRightHandSideVector) = ZeroVector(number_of_nodes);
+
+        Vector displacements(number_of_nodes);
+        for (IndexType i = 0; i < number_of_nodes; ++i)
+            displacements[i] = r_geometry[i].FastGetSolutionStepValue(TEMPERATURE);
+
+        Vector strain(dimension), stress(dimension);
+        Matrix tangent(dimension, dimension);
+        for (IndexType g = 0; g < r_integration_points.size(); ++g)
+        {
+            const double weight = r_integration_points[g].Weight() * std::abs(det_J[g]);
+
+            noalias(strain) = prod(trans(DN_DX[g]), displacements);
+            const double gamma = norm_2(strain);
+            const double yield_gamma = YieldStress / ShearModulus;
+            if (gamma <= yield_gamma)
+            {
+                noalias(stress) = ShearModulus * strain;
+                noalias(tangent) = ShearModulus * IdentityMatrix(dimension);
+            }
+            else
+            {
+                // the secant modulus normal to the strain and the hardening modulus along it
+                const double secant_modulus = (YieldStress + HardeningModulus * (gamma - yield_gamma)) / gamma;
+                noalias(stress) = secant_modulus * strain;
+                noalias(tangent) = secant_modulus * IdentityMatrix(dimension)
+                                 + (HardeningModulus - secant_modulus) / (gamma * gamma) * outer_prod(strain, strain);
+            }
+
+            for (IndexType i = 0; i < number_of_nodes; ++i)
+                rRightHandSideVector[i] += weight * load * r_N(g, i);
+            noalias(rRightHandSideVector) -= weight * prod(DN_DX[g], stress);
+
+            if (pLeftHandSideMatrix != nullptr)
+                noalias(*pLeftHandSideMatrix) += weight * prod(DN_DX[g], Matrix(prod(tangent, trans(DN_DX[g]))));
+        }
+    }
+
+};
+
+/// The skyline LU solver, counting the factorizations
+class CountingSkylineLUSolver : public SkylineLUSolverType
+{
+public:
+
+    KRATOS_CLASS_POINTER_DEFINITION(CountingSkylineLUSolver);
+
+    using SkylineLUSolverType::Solve;
+
+    void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        ++mNumberOfFactorizations;
+        SkylineLUSolverType::InitializeSolutionStep(rA, rX, rB);
+    }
+
+    bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        ++mNumberOfFactorizations;
+        return SkylineLUSolverType::Solve(rA, rX, rB);
+    }
+
+    std::size_t mNumberOfFactorizations = 0;
+
+};
+
+enum class ConvergenceCheck {DisplacementAndResidual, VariableNorms};
+
+/// The checks of the increment and of the residual norms after a solution of the Laplacian problem
+void ConvergenceCriteriaBenchmark(BenchmarkState& rState, const ConvergenceCheck Check)
+{
+    LaplacianSystem system(rState.Scaled(48));
+    system.Build();
+    system.ApplyDirichletConditions();
+
+    ModelPart& r_model_part = system.mModelPart;
+    ModelPart::DofsArrayType& r_dof_set = system.mBuilderAndSolver.GetDofSet();
+    for (auto it = r_model_part.NodesBegin(); it != r_model_part.NodesEnd(); ++it)
+        it->FastGetSolutionStepValue(TEMPERATURE) = 1.0 + 1.0e-3 * (it->Id() % 1000);
+
+    Vector& Dx = *system.mpDx;
+    for (std::size_t i = 0; i < Dx.size(); ++i)
+        Dx[i] = 1.0e-12 * (1.0 + (i % 7));
+
+    ConvergenceCriteriaType::Pointer p_criteria;
+    if (Check == ConvergenceCheck::DisplacementAndResidual)
+        p_criteria = ConvergenceCriteriaType::Pointer(new AndCriteriaType(
+            ConvergenceCriteriaType::Pointer(new DisplacementCriteriaType(1.0e-8, 1.0e-14)),
+            ConvergenceCriteriaType::Pointer(new ResidualCriteriaType(1.0e-8, 1.0e-14))));
+    else
+        p_criteria = ConvergenceCriteriaType::Pointer(new VariableNormsCriteriaType(1.0e-8, 1.0e-14, VariableNormsCombination::IncrementAndResidual));
+    p_criteria->SetEchoLevel(0);
+    p_criteria->Initialize(r_model_part);
+    p_criteria->InitializeSolutionStep(r_model_part, r_dof_set, *system.mpA, Dx, *system.mpb);
+
+    const std::size_t number_of_checks = 10;
+    std::size_t number_of_converged_checks = 0;
+    rState.Run([&]()
+    {
+        for (std::size_t k = 0; k < number_of_checks; ++k)
+            if (p_criteria->PostCriteria(r_model_part, r_dof_set, *system.mpA, Dx, *system.mpb))
+                ++number_of_converged_checks;
+    });
+
+    rState.SetItemsPerRun(number_of_checks * r_dof_set.size());
+    rState.SetCounter("dofs", r_dof_set.size());
+    rState.SetCounter("converged_checks", number_of_converged_checks);
+}
+
+enum class NonlinearStrategy {NewtonRaphson, ModifiedNewtonRaphson, BFGS, Broyden};
+
+/// The load steps of the plasticity problem, with the factorizations and the iterations of the strategy
+void NonlinearStrategyBenchmark(BenchmarkState& rState, const NonlinearStrategy Strategy)
+{
+    const std::size_t divisions = rState.Scaled(14);
+    const std::size_t number_of_steps = 6;
+    const unsigned int max_iterations = 100;
+
+    std::unique_ptr<ModelPart> p_model_part;
+    CountingSkylineLUSolver::Pointer p_solver;
+    NewtonRaphsonStrategyType::Pointer p_strategy;
+    std::size_t number_of_iterations = 0, number_of_unconverged_steps = 0;
+
+    rState.Run([&]()
+    {
+        p_model_part.reset(new ModelPart("Benchmark"));
+        p_model_part->AddNodalSolutionStepVariable(TEMPERATURE);
+        BenchmarkUtilities::CreateNodes(*p_model_part, divisions, 3);
+
+        const BenchmarkUtilities::ConnectivitiesType connectivities = BenchmarkUtilities::CreateSimplicesConnectivities(divisions, 3);
+        Properties::Pointer p_properties = p_model_part->pGetProperties(1);
+        const BenchmarkPlasticityElement prototype(0, Element::GeometryType::Pointer(
+            new Tetrahedra3D4<ModelPart::NodeType>(Element::GeometryType::PointsArrayType(4, ModelPart::NodeType()))), p_properties);
+        for (std::size_t e = 0; e < connectivities.size(); ++e)
+        {
+            Element::NodesArrayType nodes;
+            for (std::size_t i = 0; i < connectivities[e].size(); ++i)
+                nodes.push_back(p_model_part->pGetNode(connectivities[e][i]));
+            p_model_part->AddElement(prototype.Create(e + 1, nodes, p_properties));
+        }
+
+        p_solver = CountingSkylineLUSolver::Pointer(new CountingSkylineLUSolver());
+        SchemeType::Pointer p_scheme(new StaticSchemeType());
+        ConvergenceCriteriaType::Pointer p_criteria(new DisplacementCriteriaType(1.0e-8, 1.0e-14));
+        if (Strategy == NonlinearStrategy::NewtonRaphson || Strategy == NonlinearStrategy::ModifiedNewtonRaphson)
+        {
+            p_strategy = NewtonRaphsonStrategyType::Pointer(new NewtonRaphsonStrategyType(*p_model_part, p_scheme, p_solver, p_criteria, max_iterations));
+            p_strategy->SetKeepSystemConstantDuringIterations(Strategy == NonlinearStrategy::ModifiedNewtonRaphson);
+        }
+        else
+        {
+            QuasiNewtonStrategyType::Pointer p_quasi_newton(new QuasiNewtonStrategyType(*p_model_part, p_scheme, p_solver, p_criteria, max_iterations));
+            p_quasi_newton->SetUpdateType(Strategy == NonlinearStrategy::BFGS ? QuasiNewtonUpdateType::BFGS : QuasiNewtonUpdateType::Broyden);
+            p_strategy = p_quasi_newton;
+        }
+        p_strategy->SetEchoLevel(0);
+        p_criteria->SetEchoLevel(0);
+
+        number_of_iterations = 0;
+        number_of_unconverged_steps = 0;
+    },
+    [&]()
+    {
+        for (std::size_t step = 1; step <= number_of_steps; ++step)
+        {
+            p_model_part->GetProcessInfo()[TIME] = 0.25 * step;
+            p_strategy->Initialize();
+            p_strategy->InitializeSolutionStep();
+            p_strategy->Predict();
+            if (!p_strategy->SolveSolutionStep())
+                ++number_of_unconverged_steps;
+            p_strategy->FinalizeSolutionStep();
+            number_of_iterations += p_model_part->GetProcessInfo()[NL_ITERATION_NUMBER];
+        }
+    });
+
+    double max_displacement = 0.0;
+    for (auto it = p_model_part->NodesBegin(); it != p_model_part->NodesEnd(); ++it)
+        max_displacement = std::max(max_displacement, std::abs(it->FastGetSolutionStepValue(TEMPERATURE)));
+
+    std::size_t number_of_yielded_elements = 0;
+    for (auto it = p_model_part->ElementsBegin(); it != p_model_part->ElementsEnd(); ++it)
+    {
+        const Element::GeometryType& r_geometry = it->GetGeometry();
+        Element::GeometryType::ShapeFunctionsIntegrationPointsGradientsType DN_DX;
+        Vector det_J, displacements(r_geometry.size());
+        r_geometry.ShapeFunctionsIntegrationPointsGradients(DN_DX, det_J, r_geometry.GetDefaultIntegrationMethod());
+        for (std::size_t i = 0; i < r_geometry.size(); ++i)
+            displacements[i] = r_geometry[i].FastGetSolutionStepValue(TEMPERATURE);
+        if (BenchmarkPlasticityElement::ShearModulus * norm_2(prod(trans(DN_DX[0]), displacements)) > BenchmarkPlasticityElement::YieldStress)
+            ++number_of_yielded_elements;
+    }
+
+    rState.SetItemsPerRun(number_of_steps);
+    rState.SetCounter("equations", p_strategy->GetBuilderAndSolver()->GetEquationSystemSize());
+    rState.SetCounter("factorizations", p_solver->mNumberOfFactorizations);
+    rState.SetCounter("iterations", number_of_iterations);
+    rState.SetCounter("unconverged_steps", number_of_unconverged_steps);
+    rState.SetCounter("yielded_elements", number_of_yielded_elements);
+    rState.SetCounter("max_displacement", max_displacement);
+}
+
+enum class CoupledProblem {Consolidation, ThermoElasticity};
+
+/**
+ * Linear coupled problems of the unit cube: the DISPLACEMENT of an elastic solid (E = 1, nu = 0.3) under its weight,
+ * fixed at the bottom, coupled either to the pore PRESSURE of a step of Biot consolidation (unit Biot coefficient,
+ * storage 0.01 and permeability times time step 0.01, drained at the top), which gives a symmetric indefinite system,
+ * or to the TEMPERATURE of a one-way thermo-elastic problem (thermal stress modulus 0.1, unit conductivity and heat
+ * source, fixed on the boundary), which gives a block triangular system. The equations of each node are the three
+ * displacements and the scalar.
+ */
+class BenchmarkCoupledElement : public Element
+{
+public:
+
+    KRATOS_CLASS_POINTER_DEFINITION(BenchmarkCoupledElement);
+
+    static constexpr double YoungModulus = 1.0;
+    static constexpr double PoissonRatio = 0.3;
+    static constexpr double StorageCoefficient = 0.01;
+    static constexpr double PermeabilityTimesTimeStep = 0.01;
+    static constexpr double ThermalStressModulus = 0.1; // (3 lambda + 2 mu) times the thermal expansion coefficient
+    static constexpr double Conductivity = 1.0;
+
+    BenchmarkCoupledElement(IndexType NewId, GeometryType::Pointer pGeometry, PropertiesType::Pointer pProperties, const CoupledProblem Problem)
+    : Element(NewId, pGeometry, pProperties), mProblem(Problem)
+    {}
+
+    Element::Pointer Create(IndexType NewId, NodesArrayType const& ThisNodes, PropertiesType::Pointer pProperties) const override
+    {
+        return Element::Pointer(new BenchmarkCoupledElement(NewId, GetGeometry().Create(ThisNodes), pProperties, mProblem));
+    }
+
+    void EquationIdVector(EquationIdVectorType& rResult, const ProcessInfo& rCurrentProcessInfo) const override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        const Variable<double>& r_scalar = ScalarVariable();
+        rResult.resize(4 * r_geometry.size());
+        for (IndexType i = 0; i < r_geometry.size(); ++i)
+        {
+            rResult[4 * i] = r_geometry[i].GetDof(DISPLACEMENT_X).EquationId();
+            rResult[4 * i + 1] = r_geometry[i].GetDof(DISPLACEMENT_Y).EquationId();
+            rResult[4 * i + 2] = r_geometry[i].GetDof(DISPLACEMENT_Z).EquationId();
+            rResult[4 * i + 3] = r_geometry[i].GetDof(r_scalar).EquationId();
+        }
+    }
+
+    void GetDofList(DofsVectorType& rElementalDofList, const ProcessInfo& rCurrentProcessInfo) const override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        const Variable<double>& r_scalar = ScalarVariable();
+        rElementalDofList.resize(4 * r_geometry.size());
+        for (IndexType i = 0; i < r_geometry.size(); ++i)
+        {
+            rElementalDofList[4 * i] = r_geometry[i].pGetDof(DISPLACEMENT_X);
+            rElementalDofList[4 * i + 1] = r_geometry[i].pGetDof(DISPLACEMENT_Y);
+            rElementalDofList[4 * i + 2] = r_geometry[i].pGetDof(DISPLACEMENT_Z);
+            rElementalDofList[4 * i + 3] = r_geometry[i].pGetDof(r_scalar);
+        }
+    }
+
+    void CalculateLocalSystem(MatrixType& rLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        const SizeType number_of_nodes = r_geometry.size();
+        const SizeType size = 4 * number_of_nodes;
+        // the order 2 integrates the mass matrix of the linear simplices exactly
+        const GeometryData::IntegrationMethod integration_method = GeometryData::IntegrationMethod::GI_GAUSS_2;
+        const GeometryType::IntegrationPointsArrayType& r_integration_points = r_geometry.IntegrationPoints(integration_method);
+        const Matrix& r_N = r_geometry.ShapeFunctionsValues(integration_method);
+        const double lambda = YoungModulus * PoissonRatio / ((1.0 + PoissonRatio) * (1.0 - 2.0 * PoissonRatio));
+        const double mu = 0.5 * YoungModulus / (1.0 + PoissonRatio);
+
+        GeometryType::ShapeFunctionsIntegrationPointsGradientsType DN_DX;
+        Vector det_J;
+        r_geometry.ShapeFunctionsIntegrationPointsGradients(DN_DX, det_J, integration_method);
+
+        if (rLeftHandSideMatrix.size1() != size || rLeftHandSideMatrix.size2() != size)
+            rLeftHandSideMatrix.resize(size, size, false);
+        if (rRightHandSideVector.size() != size)
+            rRightHandSideVector.resize(size, false);
+        noalias(rLeftHandSideMatrix) = ZeroMatrix(size, size);
+        noalias(rRightHandSideVector) = ZeroVector(size);
+
+        for (IndexType g = 0; g < r_integration_points.size(); ++g)
+        {
+            const double weight = r_integration_points[g].Weight() * std::abs(det_J[g]);
+            const Matrix& r_DN_DX = DN_DX[g];
+
+            for (IndexType a = 0; a < number_of_nodes; ++a)
+            {
+                for (IndexType b = 0; b < number_of_nodes; ++b)
+                {
+                    const double gradients = inner_prod(row(r_DN_DX, a), row(r_DN_DX, b));
+                    for (IndexType i = 0; i < 3; ++i)
+                    {
+                        for (IndexType j = 0; j < 3; ++j)
+                            rLeftHandSideMatrix(4 * a + i, 4 * b + j) += weight * (lambda * r_DN_DX(a, i) * r_DN_DX(b, j) + mu * r_DN_DX(a, j) * r_DN_DX(b, i));
+                        rLeftHandSideMatrix(4 * a + i, 4 * b + i) += weight * mu * gradients;
+                    }
+
+                    if (mProblem == CoupledProblem::Consolidation)
+                    {
+                        for (IndexType i = 0; i < 3; ++i)
+                        {
+                            rLeftHandSideMatrix(4 * a + i, 4 * b + 3) -= weight * r_DN_DX(a, i) * r_N(g, b);
+                            rLeftHandSideMatrix(4 * b + 3, 4 * a + i) -= weight * r_DN_DX(a, i) * r_N(g, b);
+                        }
+                        rLeftHandSideMatrix(4 * a + 3, 4 * b + 3) -= weight * (StorageCoefficient * r_N(g, a) * r_N(g, b) + PermeabilityTimesTimeStep * gradients);
+                    }
+                    else
+                    {
+                        for (IndexType i = 0; i < 3; ++i)
+                            rLeftHandSideMatrix(4 * a + i, 4 * b + 3) -= weight * ThermalStressModulus * r_DN_DX(a, i) * r_N(g, b);
+                        rLeftHandSideMatrix(4 * a + 3, 4 * b + 3) += weight * Conductivity * gradients;
+                    }
+                }
+
+                rRightHandSideVector[4 * a + 2] -= weight * r_N(g, a);
+                if (mProblem == CoupledProblem::ThermoElasticity)
+                    rRightHandSideVector[4 * a + 3] += weight * r_N(g, a);
+            }
+        }
+
+        const Variable<double>& r_scalar = ScalarVariable();
+        Vector values(size);
+        for (IndexType a = 0; a < number_of_nodes; ++a)
+        {
+            const array_1d<double, 3>& r_displacement = r_geometry[a].FastGetSolutionStepValue(DISPLACEMENT);
+            for (IndexType i = 0; i < 3; ++i)
+                values[4 * a + i] = r_displacement[i];
+            values[4 * a + 3] = r_geometry[a].FastGetSolutionStepValue(r_scalar);
+        }
+        noalias(rRightHandSideVector) -= prod(rLeftHandSideMatrix, values);
+    }
+
+private:
+
+    CoupledProblem mProblem;
+
+    const Variable<double>& ScalarVariable() const
+    {
+        return (mProblem == CoupledProblem::Consolidation) ? PRESSURE : TEMPERATURE;
+    }
+
+};
+
+enum class CoupledSolver {ILU0, FieldSplitJacobiILU0, FieldSplitGaussSeidelILU0, FieldSplitGaussSeidelLU};
+
+/// The solution of the coupled system by BiCGSTAB with the ILU0 or a field-split preconditioner
+void CoupledSolverBenchmark(BenchmarkState& rState, const CoupledProblem Problem, const CoupledSolver Solver)
+{
+    const std::size_t divisions = rState.Scaled(12);
+    const Variable<double>& r_scalar = (Problem == CoupledProblem::Consolidation) ? PRESSURE : TEMPERATURE;
+
+    ModelPart model_part("Benchmark");
+    model_part.AddNodalSolutionStepVariable(DISPLACEMENT);
+    model_part.AddNodalSolutionStepVariable(r_scalar);
+    BenchmarkUtilities::CreateNodes(model_part, divisions, 3);
+    for (auto it = model_part.NodesBegin(); it != model_part.NodesEnd(); ++it)
+    {
+        it->AddDof(DISPLACEMENT_X);
+        it->AddDof(DISPLACEMENT_Y);
+        it->AddDof(DISPLACEMENT_Z);
+        if (it->Z() < 1.0e-12)
+        {
+            it->Fix(DISPLACEMENT_X);
+            it->Fix(DISPLACEMENT_Y);
+            it->Fix(DISPLACEMENT_Z);
+        }
+        if (Problem == CoupledProblem::Consolidation)
+        {
+            it->AddDof(PRESSURE);
+            if (it->Z() > 1.0 - 1.0e-12)
+                it->Fix(PRESSURE);
+        }
+    }
+
+    const BenchmarkUtilities::ConnectivitiesType connectivities = BenchmarkUtilities::CreateSimplicesConnectivities(divisions, 3);
+    Properties::Pointer p_properties = model_part.pGetProperties(1);
+    const BenchmarkCoupledElement prototype(0, Element::GeometryType::Pointer(
+        new Tetrahedra3D4<ModelPart::NodeType>(Element::GeometryType::PointsArrayType(4, ModelPart::NodeType()))), p_properties, Problem);
+    for (std::size_t e = 0; e < connectivities.size(); ++e)
+    {
+        Element::NodesArrayType nodes;
+        for (std::size_t i = 0; i < connectivities[e].size(); ++i)
+            nodes.push_back(model_part.pGetNode(connectivities[e][i]));
+        model_part.AddElement(prototype.Create(e + 1, nodes, p_properties));
+    }
+
+    SchemeType::Pointer p_scheme(new StaticSchemeType());
+    BenchmarkBuilderAndSolver builder_and_solver(LinearSolverType::Pointer(new SkylineLUSolverType()));
+    BlockBuilderAndSolverType::TSystemMatrixPointerType p_A(new CompressedMatrix(0, 0));
+    BlockBuilderAndSolverType::TSystemVectorPointerType p_x(new Vector(0)), p_b(new Vector(0));
+    builder_and_solver.SetUpDofSet(p_scheme, model_part);
+    builder_and_solver.SetUpSystem(model_part);
+    builder_and_solver.ResizeAndInitializeVectors(p_A, p_x, p_b, model_part.Elements(), model_part.Conditions(), model_part.GetProcessInfo());
+    builder_and_solver.Build(p_scheme, model_part, *p_A, *p_b);
+    builder_and_solver.ApplyDirichletConditions(p_scheme, model_part, *p_A, *p_x, *p_b);
+    CompressedMatrix& A = *p_A;
+    Vector& x = *p_x;
+    Vector& b = *p_b;
+
+    const double tolerance = 1.0e-8;
+    const unsigned int max_iterations = 5000;
+    IterativeSolverType::Pointer p_solver;
+    if (Solver == CoupledSolver::ILU0)
+    {
+        p_solver = IterativeSolverType::Pointer(new BICGSTABSolverType(tolerance, max_iterations, PreconditionerType::Pointer(new ILU0PreconditionerType())));
+    }
+    else
+    {
+        FieldSplitPreconditionerType::Pointer p_preconditioner(new FieldSplitPreconditionerType(
+            (Solver == CoupledSolver::FieldSplitJacobiILU0) ? FieldSplitType::BlockJacobi : FieldSplitType::BlockGaussSeidel));
+
+        // the temperatures do not depend on the displacements, hence they are solved first
+        const bool scalar_first = (Problem == CoupledProblem::ThermoElasticity);
+        std::size_t blocks[2];
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            const bool displacement_block = (scalar_first == (k == 1));
+            if (Solver == CoupledSolver::FieldSplitGaussSeidelLU && displacement_block)
+                blocks[k] = p_preconditioner->AddBlock(LinearSolverType::Pointer(new SkylineLUSolverType()));
+            else
+                blocks[k] = p_preconditioner->AddBlock(PreconditionerType::Pointer(new ILU0PreconditionerType()));
+        }
+        const std::size_t displacement_block = scalar_first ? blocks[1] : blocks[0];
+        const std::size_t scalar_block = scalar_first ? blocks[0] : blocks[1];
+        p_preconditioner->AddVariable(displacement_block, DISPLACEMENT_X);
+        p_preconditioner->AddVariable(displacement_block, DISPLACEMENT_Y);
+        p_preconditioner->AddVariable(displacement_block, DISPLACEMENT_Z);
+        p_preconditioner->AddVariable(scalar_block, r_scalar);
+
+        p_solver = IterativeSolverType::Pointer(new BICGSTABSolverType(tolerance, max_iterations, p_preconditioner));
+    }
+    if (p_solver->AdditionalPhysicalDataIsNeeded())
+        p_solver->ProvideAdditionalData(A, x, b, builder_and_solver.GetDofSet(), model_part);
+
+    // the solvers apply the preconditioner to the right hand side in place
+    const Vector b0 = b;
+    rState.Run([&](){ SparseSpaceType::SetToZero(x); noalias(b) = b0; },
+               [&](){ p_solver->Solve(A, x, b); });
+
+    Vector residual(A.size1());
+    SparseSpaceType::Mult(A, x, residual);
+    noalias(residual) = b0 - residual;
+
+    rState.SetItemsPerRun(A.size1());
+    rState.SetCounter("equations", A.size1());
+    rState.SetCounter("iterations", p_solver->GetIterationsNumber());
+    rState.SetCounter("relative_residual", norm_2(residual) / norm_2(b0));
+}
+
+void AddSolvingBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("solving/ConstructMatrixStructure", ConstructMatrixStructureBenchmark);
+    rSuite.Add("solving/Build", BuildBenchmark);
+    rSuite.Add("solving/Build(large mesh, structured ids)",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::Structured); });
+    rSuite.Add("solving/Build(large mesh, shuffled ids)",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::Shuffled); });
+    rSuite.Add("solving/Build(large mesh, ModelPartReorderingUtility(HilbertCurve))",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::HilbertCurve); });
+    rSuite.Add("solving/Build(large mesh, ModelPartReorderingUtility(ReverseCuthillMcKee))",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::ReverseCuthillMcKee); });
+    rSuite.Add("solving/Build(large mesh, ModelPartReorderingUtility(HilbertCurve), relocated)",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::HilbertCurveRelocated); });
+    rSuite.Add("solving/Build(large mesh, ModelPartReorderingUtility(ReverseCuthillMcKee), relocated)",
+        [](BenchmarkState& rState){ BuildOrderingBenchmark(rState, MeshOrdering::ReverseCuthillMcKeeRelocated); });
+    rSuite.Add("solving/ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation(staged excavation)",
+        [](BenchmarkState& rState){ StagedExcavationBenchmark<BlockDeactivationBuilderAndSolverType>(rState, false); });
+    rSuite.Add("solving/ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation(staged excavation, incremental activation)",
+        [](BenchmarkState& rState){ StagedExcavationBenchmark<BlockDeactivationBuilderAndSolverType>(rState, true); });
+    rSuite.Add("solving/ResidualBasedEliminationBuilderAndSolverDeactivation(staged excavation)",
+        [](BenchmarkState& rState){ StagedExcavationBenchmark<EliminationDeactivationBuilderAndSolverType>(rState, false); });
+    rSuite.Add("solving/ResidualBasedEliminationBuilderAndSolverDeactivation(staged excavation, incremental activation)",
+        [](BenchmarkState& rState){ StagedExcavationBenchmark<EliminationDeactivationBuilderAndSolverType>(rState, true); });
+    rSuite.Add("solving/UblasSpace::Mult", SpMVBenchmark<SparseSpaceType>);
+    rSuite.Add("solving/ParallelUblasSpace::Mult", SpMVBenchmark<ParallelSparseSpaceType>);
+    rSuite.Add("solving/CGSolver+ILU0", CGSolverILU0Benchmark);
+    for (const std::size_t divisions : {16, 24, 32, 48})
+    {
+        const std::string size = "(" + std::to_string(divisions) + " divisions)";
+        rSuite.Add("solving/DeflationUtils::ConstructW" + size,
+                   [divisions](BenchmarkState& rState){ DeflationSetupBenchmark(rState, divisions, false); });
+        rSuite.Add("solving/DeflationUtils::FillDeflatedMatrix" + size,
+                   [divisions](BenchmarkState& rState){ DeflationSetupBenchmark(rState, divisions, true); });
+        rSuite.Add("solving/DeflatedCGSolver" + size,
+                   [divisions](BenchmarkState& rState){ DeflatedCGSolverBenchmark(rState, divisions); });
+    }
+    for (const std::size_t k : {1, 4, 8, 16})
+    {
+        const std::string vectors = "(" + std::to_string(k) + ((k == 1) ? " vector)" : " vectors)");
+        const std::string right_hand_sides = "(" + std::to_string(k) + ((k == 1) ? " right hand side)" : " right hand sides)");
+        rSuite.Add("solving/UblasSpace::Mult" + vectors, [k](BenchmarkState& rState){ SpMMBenchmark(rState, k); });
+        rSuite.Add("solving/CGSolver" + right_hand_sides,
+                   [k](BenchmarkState& rState){ MultipleRightHandSidesBenchmark<CGSolverType>(rState, k); });
+        rSuite.Add("solving/BlockCGSolver" + right_hand_sides,
+                   [k](BenchmarkState& rState){ MultipleRightHandSidesBenchmark<BlockCGSolverType>(rState, k); });
+    }
+    rSuite.Add("solving/BICGSTABSolver(8 right hand sides)",
+               [](BenchmarkState& rState){ MultipleRightHandSidesBenchmark<BICGSTABSolverType>(rState, 8); });
+    rSuite.Add("solving/BlockBICGSTABSolver(8 right hand sides)",
+               [](BenchmarkState& rState){ MultipleRightHandSidesBenchmark<BlockBICGSTABSolverType>(rState, 8); });
+    rSuite.Add("solving/WriteMatrixMarketMatrix", [](BenchmarkState& rState){ MatrixIOBenchmark(rState, false, false); });
+    rSuite.Add("solving/ReadMatrixMarketMatrix", [](BenchmarkState& rState){ MatrixIOBenchmark(rState, false, true); });
+    rSuite.Add("solving/WriteBinaryMatrix", [](BenchmarkState& rState){ MatrixIOBenchmark(rState, true, false); });
+    rSuite.Add("solving/ReadBinaryMatrix", [](BenchmarkState& rState){ MatrixIOBenchmark(rState, true, true); });
+    rSuite.Add("solving/SparseMatrixMultiplicationUtility::TransposeMatrix", TransposeMatrixBenchmark);
+    rSuite.Add("solving/SparseMatrixMultiplicationUtility::MatrixMultiplication", MatrixMultiplicationBenchmark);
+    rSuite.Add("solving/SparseMatrixProductPlan::Multiply", ProductPlanBenchmark);
+    rSuite.Add("solving/Galerkin product (TransposeMatrix, MatrixMultiplication)", GalerkinProductBenchmark);
+    rSuite.Add("solving/Galerkin product (SparseMatrixTripleProductPlan::Initialize)",
+               [](BenchmarkState& rState){ TripleProductPlanBenchmark(rState, true); });
+    rSuite.Add("solving/Galerkin product (SparseMatrixTripleProductPlan::Multiply)",
+               [](BenchmarkState& rState){ TripleProductPlanBenchmark(rState, false); });
+    rSuite.Add("solving/AndCriteria(DisplacementCriteria, ResidualCriteria)",
+               [](BenchmarkState& rState){ ConvergenceCriteriaBenchmark(rState, ConvergenceCheck::DisplacementAndResidual); });
+    rSuite.Add("solving/VariableNormsCriteria(increment and residual)",
+               [](BenchmarkState& rState){ ConvergenceCriteriaBenchmark(rState, ConvergenceCheck::VariableNorms); });
+    rSuite.Add("solving/ResidualBasedNewtonRaphsonStrategy(plasticity)",
+               [](BenchmarkState& rState){ NonlinearStrategyBenchmark(rState, NonlinearStrategy::NewtonRaphson); });
+    rSuite.Add("solving/ResidualBasedNewtonRaphsonStrategy(plasticity, constant system)",
+               [](BenchmarkState& rState){ NonlinearStrategyBenchmark(rState, NonlinearStrategy::ModifiedNewtonRaphson); });
+    rSuite.Add("solving/ResidualBasedQuasiNewtonStrategy(plasticity, BFGS)",
+               [](BenchmarkState& rState){ NonlinearStrategyBenchmark(rState, NonlinearStrategy::BFGS); });
+    rSuite.Add("solving/ResidualBasedQuasiNewtonStrategy(plasticity, Broyden)",
+               [](BenchmarkState& rState){ NonlinearStrategyBenchmark(rState, NonlinearStrategy::Broyden); });
+    rSuite.Add("solving/BICGSTABSolver+ILU0(consolidation)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::Consolidation, CoupledSolver::ILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(consolidation, block Jacobi, ILU0)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::Consolidation, CoupledSolver::FieldSplitJacobiILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(consolidation, block Gauss-Seidel, ILU0)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::Consolidation, CoupledSolver::FieldSplitGaussSeidelILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(consolidation, block Gauss-Seidel, skyline LU)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::Consolidation, CoupledSolver::FieldSplitGaussSeidelLU); });
+    rSuite.Add("solving/BICGSTABSolver+ILU0(thermo-elasticity)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::ThermoElasticity, CoupledSolver::ILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(thermo-elasticity, block Jacobi, ILU0)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::ThermoElasticity, CoupledSolver::FieldSplitJacobiILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(thermo-elasticity, block Gauss-Seidel, ILU0)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::ThermoElasticity, CoupledSolver::FieldSplitGaussSeidelILU0); });
+    rSuite.Add("solving/BICGSTABSolver+FieldSplit(thermo-elasticity, block Gauss-Seidel, skyline LU)",
+               [](BenchmarkState& rState){ CoupledSolverBenchmark(rState, CoupledProblem::ThermoElasticity, CoupledSolver::FieldSplitGaussSeidelLU); });
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
@@ -0,0 +1,427 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/ublas_interface.h"
+#include "utilities/math_utils.h"
+#include "utilities/dual_number.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+typedef Dual<double, 9> DeformationGradientDualType;
+
+/// Deformation gradients around the identity, the 9 components of each one after another
+std::vector<double> CreateDeformationGradients(const std::size_t NumberOfGradients)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-0.2, 0.2);
+
+    std::vector<double> gradients(9 * NumberOfGradients);
+    for (std::size_t g = 0; g < NumberOfGradients; ++g)
+        for (std::size_t k = 0; k < 9; ++k)
+            gradients[9 * g + k] = ((k % 4 == 0) ? 1.0 : 0.0) + distribution(generator);
+    return gradients;
+}
+
+/// The first Piola-Kirchhoff stress of the compressible neo-Hookean material, written once for any scalar type
+template<typename TDataType>
+void NeoHookeanStress(const TDataType* pF, TDataType* pP)
+{
+    const double mu = 1.0;
+    const double lambda = 2.0;
+
+    BoundedMatrix<TDataType, 3, 3> F, F_inv;
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+            F(i, j) = pF[3 * i + j];
+
+    TDataType J;
+    MathUtils<TDataType>::InvertMatrix3(F, F_inv, J);
+
+    using std::log;
+    const TDataType c = lambda * log(J);
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+            pP[3 * i + j] = mu * (F(i, j) - F_inv(j, i)) + c * F_inv(j, i);
+}
+
+/// The tangent dP/dF of one deformation gradient, from one evaluation on dual numbers
+void DualTangent(const double* pF, double* pA)
+{
+    DeformationGradientDualType F[9], P[9];
+    for (std::size_t k = 0; k < 9; ++k)
+        F[k] = DeformationGradientDualType(pF[k], k);
+
+    NeoHookeanStress(F, P);
+
+    for (std::size_t i = 0; i < 9; ++i)
+        for (std::size_t k = 0; k < 9; ++k)
+            pA[9 * i + k] = P[i].dx(k);
+}
+
+/// The tangent dP/dF of one deformation gradient, by forward finite differences
+void FiniteDifferenceTangent(const double* pF, double* pA)
+{
+    const double h = 1.0e-7;
+    double F[9], P[9], P_perturbed[9];
+    std::copy(pF, pF + 9, F);
+
+    NeoHookeanStress(F, P);
+
+    for (std::size_t k = 0; k < 9; ++k)
+    {
+        F[k] += h;
+        NeoHookeanStress(F, P_perturbed);
+        F[k] = pF[k];
+        for (std::size_t i = 0; i < 9; ++i)
+            pA[9 * i + k] = (P_perturbed[i] - P[i]) / h;
+    }
+}
+
+template<class TTangentFunctionType>
+void TangentBenchmark(BenchmarkState& rState, const TTangentFunctionType& rTangent)
+{
+    const std::vector<double> gradients = CreateDeformationGradients(rState.Scaled(20000));
+    const std::size_t number_of_gradients = gradients.size() / 9;
+    std::vector<double> tangents(81 * number_of_gradients);
+
+    rState.Run([&]()
+    {
+        for (std::size_t g = 0; g < number_of_gradients; ++g)
+            rTangent(&gradients[9 * g], &tangents[81 * g]);
+    });
+
+    // the difference to the exact tangent of the dual numbers
+    double max_difference = 0.0;
+    double exact[81];
+    for (std::size_t g = 0; g < number_of_gradients; ++g)
+    {
+        DualTangent(&gradients[9 * g], exact);
+        for (std::size_t i = 0; i < 81; ++i)
+            max_difference = std::max(max_difference, std::abs(tangents[81 * g + i] - exact[i]));
+    }
+
+    rState.SetItemsPerRun(number_of_gradients);
+    rState.SetCounter("max_difference_to_dual", max_difference);
+}
+
+/// The integration point data of an element, with the sparsity of the B of the solids and an isotropic D
+struct ElementIntegrationData
+{
+    std::vector<Matrix> D;
+    std::vector<Matrix> B;
+    std::vector<double> Weights;
+    Matrix N;
+};
+
+std::vector<ElementIntegrationData> CreateElementIntegrationData(const std::size_t StrainSize, const std::size_t NumberOfNodes, const std::size_t NumberOfPoints)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    const std::size_t dimension = (StrainSize == 3) ? 2 : 3;
+
+    Matrix D = ZeroMatrix(StrainSize, StrainSize);
+    for (std::size_t k = 0; k < dimension; ++k)
+    {
+        for (std::size_t l = 0; l < dimension; ++l)
+            D(k, l) = 1.0;
+        D(k, k) = 3.0;
+    }
+    for (std::size_t k = dimension; k < StrainSize; ++k)
+        D(k, k) = 1.0;
+
+    std::vector<ElementIntegrationData> elements(64);
+    for (std::size_t e = 0; e < elements.size(); ++e)
+    {
+        ElementIntegrationData& r_data = elements[e];
+        r_data.D.assign(NumberOfPoints, D);
+        r_data.B.assign(NumberOfPoints, ZeroMatrix(StrainSize, dimension * NumberOfNodes));
+        r_data.Weights.resize(NumberOfPoints);
+        r_data.N.resize(NumberOfPoints, NumberOfNodes, false);
+        for (std::size_t g = 0; g < NumberOfPoints; ++g)
+        {
+            r_data.Weights[g] = 0.5 + 0.25 * distribution(generator);
+            for (std::size_t i = 0; i < NumberOfNodes; ++i)
+            {
+                r_data.N(g, i) = 0.5 + 0.5 * distribution(generator);
+                double DN[3];
+                for (std::size_t d = 0; d < dimension; ++d)
+                    DN[d] = distribution(generator);
+
+                Matrix& r_B = r_data.B[g];
+                const std::size_t c = dimension * i;
+                if (dimension == 2)
+                {
+                    r_B(0, c) = DN[0]; r_B(1, c + 1) = DN[1];
+                    r_B(2, c) = DN[1]; r_B(2, c + 1) = DN[0];
+                }
+                else
+                {
+                    r_B(0, c) = DN[0]; r_B(1, c + 1) = DN[1]; r_B(2, c + 2) = DN[2];
+                    r_B(3, c) = DN[1]; r_B(3, c + 1) = DN[0];
+                    r_B(4, c + 1) = DN[2]; r_B(4, c + 2) = DN[1];
+                    r_B(5, c) = DN[2]; r_B(5, c + 2) = DN[0];
+                }
+            }
+        }
+    }
+    return elements;
+}
+
+/// The stiffness matrices of the elements, by the ublas products of each integration point or by MathUtils::AddBtDBProducts
+void BtDBBenchmark(BenchmarkState& rState, const std::size_t StrainSize, const std::size_t NumberOfNodes, const std::size_t NumberOfPoints, const bool Batched)
+{
+    const std::vector<ElementIntegrationData> elements = CreateElementIntegrationData(StrainSize, NumberOfNodes, NumberOfPoints);
+    const std::size_t number_of_elements = rState.Scaled(200);
+    const std::size_t size = elements[0].B[0].size2();
+
+    Matrix K(size, size);
+    Matrix DB(StrainSize, size);
+    double trace = 0.0;
+    rState.Run([&]()
+    {
+        trace = 0.0;
+        for (std::size_t e = 0; e < number_of_elements; ++e)
+        {
+            const ElementIntegrationData& r_data = elements[e % elements.size()];
+            K.clear();
+            if (Batched)
+                MathUtils<double>::AddBtDBProducts(K, r_data.D, r_data.B, r_data.Weights);
+            else
+                for (std::size_t g = 0; g < NumberOfPoints; ++g)
+                {
+                    noalias(DB) = prod(r_data.D[g], r_data.B[g]);
+                    noalias(K) += r_data.Weights[g] * prod(trans(r_data.B[g]), DB);
+                }
+            trace += K(0, 0) + K(size - 1, size - 1);
+        }
+    });
+
+    KRATOS_ERROR_IF(trace == 0.0) << "The stiffness matrices are zero";
+    rState.SetItemsPerRun(number_of_elements);
+}
+
+/// The mass matrices of the elements, by the ublas outer products of each integration point or by MathUtils::AddNtNProducts
+void NtNBenchmark(BenchmarkState& rState, const std::size_t NumberOfNodes, const std::size_t NumberOfPoints, const bool Batched)
+{
+    const std::vector<ElementIntegrationData> elements = CreateElementIntegrationData(6, NumberOfNodes, NumberOfPoints);
+    const std::size_t number_of_elements = rState.Scaled(2000);
+
+    Matrix M(NumberOfNodes, NumberOfNodes);
+    double trace = 0.0;
+    rState.Run([&]()
+    {
+        trace = 0.0;
+        for (std::size_t e = 0; e < number_of_elements; ++e)
+        {
+            const ElementIntegrationData& r_data = elements[e % elements.size()];
+            M.clear();
+            if (Batched)
+                MathUtils<double>::AddNtNProducts(M, r_data.N, r_data.Weights);
+            else
+                for (std::size_t g = 0; g < NumberOfPoints; ++g)
+                    noalias(M) += r_data.Weights[g] * outer_prod(row(r_data.N, g), row(r_data.N, g));
+            trace += M(0, 0) + M(NumberOfNodes - 1, NumberOfNodes - 1);
+        }
+    });
+
+    KRATOS_ERROR_IF(trace == 0.0) << "The mass matrices are zero";
+    rState.SetItemsPerRun(number_of_elements);
+}
+
+/// The index of the component (i, j) of a symmetric tensor stored as a stress vector: xx, yy, xy in 2D and xx, yy, zz, xy, yz, xz in 3D
+std::size_t SymmetricTensorComponent(const std::size_t Dimension, const std::size_t i, const std::size_t j)
+{
+    if (i == j)
+        return i;
+    if (Dimension == 2)
+        return 2;
+    return (i + j == 1) ? 3 : ((i + j == 3) ? 4 : 5);
+}
+
+/// Random symmetric tensors, every fourth one is p I + q n n' with two repeated eigenvalues as in the triaxial states
+std::vector<double> CreateSymmetricTensors(const std::size_t Dimension, const std::size_t NumberOfTensors)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    const std::size_t number_of_components = (Dimension == 2) ? 3 : 6;
+
+    std::vector<double> tensors(number_of_components * NumberOfTensors);
+    for (std::size_t t = 0; t < NumberOfTensors; ++t)
+    {
+        double* a = &tensors[number_of_components * t];
+        if (t % 4 == 3)
+        {
+            double n[3] = {distribution(generator), distribution(generator), distribution(generator)};
+            const double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            const double p = distribution(generator);
+            const double q = distribution(generator);
+            for (std::size_t i = 0; i < Dimension; ++i)
+                for (std::size_t j = i; j < Dimension; ++j)
+                    a[SymmetricTensorComponent(Dimension, i, j)] = ((i == j) ? p : 0.0) + q * n[i] * n[j] / (norm * norm);
+        }
+        else
+        {
+            for (std::size_t k = 0; k < number_of_components; ++k)
+                a[k] = distribution(generator);
+        }
+    }
+    return tensors;
+}
+
+/// The largest of |A - V D V'| / max|A| and |V'V - I| over the tensors, the eigenvectors are the columns of V stored row by row
+double MaxEigenSystemResidual(const std::size_t Dimension, const std::vector<double>& rTensors, const std::vector<double>& rEigenValues, const std::vector<double>& rEigenVectors)
+{
+    const std::size_t number_of_components = (Dimension == 2) ? 3 : 6;
+    const std::size_t number_of_tensors = rTensors.size() / number_of_components;
+
+    double max_residual = 0.0;
+    for (std::size_t t = 0; t < number_of_tensors; ++t)
+    {
+        const double* a = &rTensors[number_of_components * t];
+        const double* l = &rEigenValues[Dimension * t];
+        const double* v = &rEigenVectors[Dimension * Dimension * t];
+
+        double scale = 0.0;
+        for (std::size_t k = 0; k < number_of_components; ++k)
+            scale = std::max(scale, std::abs(a[k]));
+
+        for (std::size_t i = 0; i < Dimension; ++i)
+        {
+            for (std::size_t j = 0; j < Dimension; ++j)
+            {
+                double vdv = 0.0, vv = 0.0;
+                for (std::size_t k = 0; k < Dimension; ++k)
+                {
+                    vdv += v[Dimension * i + k] * l[k] * v[Dimension * j + k];
+                    vv += v[Dimension * k + i] * v[Dimension * k + j];
+                }
+                max_residual = std::max(max_residual, std::abs(vdv - a[SymmetricTensorComponent(Dimension, i, j)]) / scale);
+                max_residual = std::max(max_residual, std::abs(vv - ((i == j) ? 1.0 : 0.0)));
+            }
+        }
+    }
+    return max_residual;
+}
+
+enum class EigenSystemMethod {GaussSeidel, ClosedForm, Batched, BatchedEigenValues};
+
+/// The eigenvalues and eigenvectors of symmetric tensors by the iterative GaussSeidelEigenSystem or the closed form solutions
+template<std::size_t TDimension>
+void EigenSystemBenchmark(BenchmarkState& rState, const EigenSystemMethod Method)
+{
+    typedef BoundedMatrix<double, TDimension, TDimension> MatrixType;
+
+    const std::size_t number_of_components = (TDimension == 2) ? 3 : 6;
+    const std::vector<double> tensors = CreateSymmetricTensors(TDimension, rState.Scaled(20000));
+    const std::size_t number_of_tensors = tensors.size() / number_of_components;
+    std::vector<double> eigen_values(TDimension * number_of_tensors);
+    std::vector<double> eigen_vectors(TDimension * TDimension * number_of_tensors);
+
+    rState.Run([&]()
+    {
+        if (Method == EigenSystemMethod::Batched || Method == EigenSystemMethod::BatchedEigenValues)
+        {
+            double* p_eigen_vectors = (Method == EigenSystemMethod::Batched) ? eigen_vectors.data() : nullptr;
+            if (TDimension == 2)
+                MathUtils<double>::SymmetricEigenSystems2(number_of_tensors, tensors.data(), eigen_values.data(), p_eigen_vectors);
+            else
+                MathUtils<double>::SymmetricEigenSystems3(number_of_tensors, tensors.data(), eigen_values.data(), p_eigen_vectors);
+            return;
+        }
+
+        MatrixType A, V, D;
+        for (std::size_t t = 0; t < number_of_tensors; ++t)
+        {
+            const double* a = &tensors[number_of_components * t];
+            for (std::size_t i = 0; i < TDimension; ++i)
+                for (std::size_t j = 0; j < TDimension; ++j)
+                    A(i, j) = a[SymmetricTensorComponent(TDimension, i, j)];
+
+            if (Method == EigenSystemMethod::GaussSeidel)
+                MathUtils<double>::GaussSeidelEigenSystem(A, V, D);
+            else if (TDimension == 2)
+                MathUtils<double>::SymmetricEigenSystem2(A, V, D);
+            else
+                MathUtils<double>::SymmetricEigenSystem3(A, V, D);
+
+            for (std::size_t i = 0; i < TDimension; ++i)
+            {
+                eigen_values[TDimension * t + i] = D(i, i);
+                for (std::size_t j = 0; j < TDimension; ++j)
+                    eigen_vectors[TDimension * (TDimension * t + i) + j] = V(i, j);
+            }
+        }
+    });
+
+    if (Method == EigenSystemMethod::BatchedEigenValues)
+    {
+        // the difference to the eigenvalues refined with the eigenvectors
+        std::vector<double> refined_eigen_values(eigen_values.size());
+        if (TDimension == 2)
+            MathUtils<double>::SymmetricEigenSystems2(number_of_tensors, tensors.data(), refined_eigen_values.data(), eigen_vectors.data());
+        else
+            MathUtils<double>::SymmetricEigenSystems3(number_of_tensors, tensors.data(), refined_eigen_values.data(), eigen_vectors.data());
+
+        double max_difference = 0.0;
+        for (std::size_t k = 0; k < eigen_values.size(); ++k)
+            max_difference = std::max(max_difference, std::abs(eigen_values[k] - refined_eigen_values[k]));
+        rState.SetCounter("max_difference_to_refined", max_difference);
+    }
+    else
+    {
+        rState.SetCounter("max_residual", MaxEigenSystemResidual(TDimension, tensors, eigen_values, eigen_vectors));
+    }
+
+    rState.SetItemsPerRun(number_of_tensors);
+}
+
+void AddUtilitiesBenchmarks(BenchmarkSuite& rSuite)
+{
+    rSuite.Add("utilities/Dual<double,9>(neo-Hookean tangent)", [](BenchmarkState& rState){ TangentBenchmark(rState, DualTangent); });
+    rSuite.Add("utilities/FiniteDifference(neo-Hookean tangent)", [](BenchmarkState& rState){ TangentBenchmark(rState, FiniteDifferenceTangent); });
+    rSuite.Add("utilities/ublas B'DB(3x8, 4 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 3, 4, 4, false); });
+    rSuite.Add("utilities/MathUtils::AddBtDBProducts(3x8, 4 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 3, 4, 4, true); });
+    rSuite.Add("utilities/ublas B'DB(6x24, 8 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 6, 8, 8, false); });
+    rSuite.Add("utilities/MathUtils::AddBtDBProducts(6x24, 8 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 6, 8, 8, true); });
+    rSuite.Add("utilities/ublas B'DB(6x81, 27 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 6, 27, 27, false); });
+    rSuite.Add("utilities/MathUtils::AddBtDBProducts(6x81, 27 points)", [](BenchmarkState& rState){ BtDBBenchmark(rState, 6, 27, 27, true); });
+    rSuite.Add("utilities/ublas N'N(27 nodes, 27 points)", [](BenchmarkState& rState){ NtNBenchmark(rState, 27, 27, false); });
+    rSuite.Add("utilities/MathUtils::AddNtNProducts(27 nodes, 27 points)", [](BenchmarkState& rState){ NtNBenchmark(rState, 27, 27, true); });
+    rSuite.Add("utilities/MathUtils::GaussSeidelEigenSystem(2x2)", [](BenchmarkState& rState){ EigenSystemBenchmark<2>(rState, EigenSystemMethod::GaussSeidel); });
+    rSuite.Add("utilities/MathUtils::SymmetricEigenSystem2", [](BenchmarkState& rState){ EigenSystemBenchmark<2>(rState, EigenSystemMethod::ClosedForm); });
+    rSuite.Add("utilities/MathUtils::SymmetricEigenSystems2(batched)", [](BenchmarkState& rState){ EigenSystemBenchmark<2>(rState, EigenSystemMethod::Batched); });
+    rSuite.Add("utilities/MathUtils::GaussSeidelEigenSystem(3x3)", [](BenchmarkState& rState){ EigenSystemBenchmark<3>(rState, EigenSystemMethod::GaussSeidel); });
+    rSuite.Add("utilities/MathUtils::SymmetricEigenSystem3", [](BenchmarkState& rState){ EigenSystemBenchmark<3>(rState, EigenSystemMethod::ClosedForm); });
+    rSuite.Add("utilities/MathUtils::SymmetricEigenSystems3(batched)", [](BenchmarkState& rState){ EigenSystemBenchmark<3>(rState, EigenSystemMethod::Batched); });
+    rSuite.Add("utilities/MathUtils::SymmetricEigenSystems3(batched, eigenvalues only)", [](BenchmarkState& rState){ EigenSystemBenchmark<3>(rState, EigenSystemMethod::BatchedEigenValues); });
+}
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
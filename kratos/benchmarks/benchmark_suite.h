@@ -0,0 +1,307 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BENCHMARK_SUITE_H_INCLUDED )
+#define  KRATOS_BENCHMARK_SUITE_H_INCLUDED
+
+// System includes
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include <iomanip>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/kratos_parameters.h"
+#include "utilities/openmp_utils.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BenchmarkState
+ * @ingroup KratosCore
+ * @brief The state of one benchmark of a BenchmarkSuite
+ * @details The benchmark prepares its data, sized with Scaled, and passes the measured operation to Run.
+ * The operation is run once to warm up, then Repetitions times, each run being timed separately. An
+ * optional setup, which is not timed, is called before each run. The throughput is given by the number
+ * of items processed by a run, and additional values (e.g. the number of iterations) by the counters.
+ */
+class BenchmarkState
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef std::size_t SizeType;
+
+    typedef std::chrono::steady_clock ClockType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    BenchmarkState(const SizeType Repetitions, const double Scale)
+    : mRepetitions(std::max<SizeType>(Repetitions, 1)), mScale(Scale), mItemsPerRun(0.0)
+    {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// The size of the problem for a base size, scaled by the scale of the run
+    SizeType Scaled(const SizeType BaseSize) const
+    {
+        return std::max<SizeType>(static_cast<SizeType>(BaseSize * mScale + 0.5), 1);
+    }
+
+    /// Time rFunction()
+    template<class TFunctionType>
+    void Run(TFunctionType&& rFunction)
+    {
+        Run([](){}, rFunction);
+    }
+
+    /// Time rFunction(), after an untimed call to rSetup() before each run
+    template<class TSetupType, class TFunctionType>
+    void Run(TSetupType&& rSetup, TFunctionType&& rFunction)
+    {
+        mTimes.clear();
+        for (SizeType i = 0; i <= mRepetitions; ++i)
+        {
+            rSetup();
+            const ClockType::time_point start = ClockType::now();
+            rFunction();
+            const ClockType::time_point stop = ClockType::now();
+
+            // the first run is the warm up
+            if (i > 0)
+                mTimes.push_back(std::chrono::duration<double>(stop - start).count());
+        }
+    }
+
+    /// Set the number of items (e.g. nonzeros or nodes) processed by one run
+    void SetItemsPerRun(const double ItemsPerRun)
+    {
+        mItemsPerRun = ItemsPerRun;
+    }
+
+    void SetCounter(const std::string& rName, const double Value)
+    {
+        mCounters[rName] = Value;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    SizeType GetRepetitions() const
+    {
+        return mRepetitions;
+    }
+
+    double GetScale() const
+    {
+        return mScale;
+    }
+
+    const std::vector<double>& GetTimes() const
+    {
+        return mTimes;
+    }
+
+    double GetItemsPerRun() const
+    {
+        return mItemsPerRun;
+    }
+
+    const std::map<std::string, double>& GetCounters() const
+    {
+        return mCounters;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    SizeType mRepetitions;
+
+    double mScale;
+
+    double mItemsPerRun;
+
+    std::vector<double> mTimes;
+
+    std::map<std::string, double> mCounters;
+
+    ///@}
+
+}; // Class BenchmarkState
+
+/**
+ * @class BenchmarkSuite
+ * @ingroup KratosCore
+ * @brief A list of named benchmarks, run with a common number of repetitions and problem scale
+ * @details The results are returned as Parameters, to be written as JSON: the context of the run and, for
+ * each benchmark, the statistics of the times in seconds, the throughput and the counters. A benchmark
+ * which throws is reported with its error message and does not stop the suite.
+ */
+class BenchmarkSuite
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef std::size_t SizeType;
+
+    typedef std::function<void(BenchmarkState&)> BenchmarkFunctionType;
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Add a benchmark. The names are grouped like "group/benchmark"
+    void Add(const std::string& rName, const BenchmarkFunctionType& rFunction)
+    {
+        mNames.push_back(rName);
+        mFunctions.push_back(rFunction);
+    }
+
+    /// The names of the benchmarks containing rFilter
+    std::vector<std::string> GetNames(const std::string& rFilter = "") const
+    {
+        std::vector<std::string> names;
+        for (SizeType i = 0; i < mNames.size(); ++i)
+            if (mNames[i].find(rFilter) != std::string::npos)
+                names.push_back(mNames[i]);
+        return names;
+    }
+
+    /// Run the benchmarks containing rFilter. A summary of each benchmark is printed to rOStream
+    Parameters Run(const std::string& rFilter, const SizeType Repetitions, const double Scale, std::ostream& rOStream) const
+    {
+        Parameters results;
+
+        Parameters context = results.AddEmptyValue("context");
+        char date[32];
+        const std::time_t now = std::time(NULL);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        context.AddString("date", date);
+        context.AddInt("threads", OpenMPUtils::GetNumThreads());
+        context.AddInt("repetitions", static_cast<int>(Repetitions));
+        context.AddDouble("scale", Scale);
+#ifdef NDEBUG
+        context.AddString("build", "release");
+#else
+        context.AddString("build", "debug");
+#endif
+
+        results.AddEmptyArray("benchmarks");
+        for (SizeType i = 0; i < mNames.size(); ++i)
+        {
+            if (mNames[i].find(rFilter) == std::string::npos)
+                continue;
+
+            Parameters result;
+            result.AddString("name", mNames[i]);
+
+            BenchmarkState state(Repetitions, Scale);
+            try
+            {
+                mFunctions[i](state);
+
+                // the summary is printed after the run, since the benchmarked code may print as well
+                rOStream << std::left << std::setw(64) << mNames[i];
+                AddStatistics(state, result, rOStream);
+            }
+            catch (std::exception& e)
+            {
+                result.AddString("error", e.what());
+                rOStream << std::left << std::setw(64) << mNames[i] << "error: " << e.what() << std::endl;
+            }
+
+            results["benchmarks"].Append(result);
+        }
+
+        return results;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    std::vector<std::string> mNames;
+
+    std::vector<BenchmarkFunctionType> mFunctions;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    static void AddStatistics(const BenchmarkState& rState, Parameters& rResult, std::ostream& rOStream)
+    {
+        std::vector<double> times = rState.GetTimes();
+        KRATOS_ERROR_IF(times.empty()) << "The benchmark did not run";
+
+        std::sort(times.begin(), times.end());
+        const SizeType n = times.size();
+        const double median = (n % 2 == 1) ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+        const double mean = std::accumulate(times.begin(), times.end(), 0.0) / n;
+
+        rResult.AddInt("repetitions", static_cast<int>(n));
+        rResult.AddDouble("min_time", times.front());
+        rResult.AddDouble("median_time", median);
+        rResult.AddDouble("mean_time", mean);
+        rResult.AddDouble("max_time", times.back());
+
+        rOStream << std::right << std::scientific << std::setprecision(3) << std::setw(12) << median << " s";
+
+        if (rState.GetItemsPerRun() > 0.0)
+        {
+            rResult.AddDouble("items_per_run", rState.GetItemsPerRun());
+            rResult.AddDouble("items_per_second", (median > 0.0) ? rState.GetItemsPerRun() / median : 0.0);
+            rOStream << std::setw(12) << ((median > 0.0) ? rState.GetItemsPerRun() / median : 0.0) << " items/s";
+        }
+
+        Parameters counters = rResult.AddEmptyValue("counters");
+        for (std::map<std::string, double>::const_iterator it = rState.GetCounters().begin(); it != rState.GetCounters().end(); ++it)
+            counters.AddDouble(it->first, it->second);
+
+        rOStream << std::defaultfloat << std::endl;
+    }
+
+    ///@}
+
+}; // Class BenchmarkSuite
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BENCHMARK_SUITE_H_INCLUDED  defined
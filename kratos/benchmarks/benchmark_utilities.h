@@ -0,0 +1,389 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BENCHMARK_UTILITIES_H_INCLUDED )
+#define  KRATOS_BENCHMARK_UTILITIES_H_INCLUDED
+
+// System includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <algorithm>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/element.h"
+#include "includes/model_part.h"
+#include "includes/kratos_components.h"
+#include "includes/serializer.h"
+#include "includes/variables.h"
+#include "geometries/triangle_2d_3.h"
+#include "geometries/tetrahedra_3d_4.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BenchmarkLaplacianElement
+ * @ingroup KratosCore
+ * @brief A linear Laplacian element on TEMPERATURE with a unit source, giving the benchmarks a symmetric
+ * positive definite system of any simplex mesh.
+ */
+class BenchmarkLaplacianElement : public Element
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    KRATOS_CLASS_POINTER_DEFINITION(BenchmarkLaplacianElement);
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor, for the serializer
+    BenchmarkLaplacianElement() : Element()
+    {}
+
+    BenchmarkLaplacianElement(IndexType NewId, GeometryType::Pointer pGeometry)
+    : Element(NewId, pGeometry)
+    {}
+
+    BenchmarkLaplacianElement(IndexType NewId, GeometryType::Pointer pGeometry, PropertiesType::Pointer pProperties)
+    : Element(NewId, pGeometry, pProperties)
+    {}
+
+    ~BenchmarkLaplacianElement() override {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    Element::Pointer Create(IndexType NewId, NodesArrayType const& ThisNodes, PropertiesType::Pointer pProperties) const override
+    {
+        return Element::Pointer(new BenchmarkLaplacianElement(NewId, GetGeometry().Create(ThisNodes), pProperties));
+    }
+
+    void EquationIdVector(EquationIdVectorType& rResult, const ProcessInfo& rCurrentProcessInfo) const override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        rResult.resize(r_geometry.size());
+        for (IndexType i = 0; i < r_geometry.size(); ++i)
+            rResult[i] = r_geometry[i].GetDof(TEMPERATURE).EquationId();
+    }
+
+    void GetDofList(DofsVectorType& rElementalDofList, const ProcessInfo& rCurrentProcessInfo) const override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        rElementalDofList.resize(r_geometry.size());
+        for (IndexType i = 0; i < r_geometry.size(); ++i)
+            rElementalDofList[i] = r_geometry[i].pGetDof(TEMPERATURE);
+    }
+
+    void CalculateLocalSystem(MatrixType& rLeftHandSideMatrix, VectorType& rRightHandSideVector, const ProcessInfo& rCurrentProcessInfo) override
+    {
+        const GeometryType& r_geometry = GetGeometry();
+        const SizeType number_of_nodes = r_geometry.size();
+        const GeometryData::IntegrationMethod integration_method = r_geometry.GetDefaultIntegrationMethod();
+        const GeometryType::IntegrationPointsArrayType& r_integration_points = r_geometry.IntegrationPoints(integration_method);
+        const Matrix& r_N = r_geometry.ShapeFunctionsValues(integration_method);
+
+        GeometryType::ShapeFunctionsIntegrationPointsGradientsType DN_DX;
+        Vector det_J;
+        r_geometry.ShapeFunctionsIntegrationPointsGradients(DN_DX, det_J, integration_method);
+
+        if (rLeftHandSideMatrix.size1() != number_of_nodes || rLeftHandSideMatrix.size2() != number_of_nodes)
+            rLeftHandSideMatrix.resize(number_of_nodes, number_of_nodes, false);
+        if (rRightHandSideVector.size() != number_of_nodes)
+            rRightHandSideVector.resize(number_of_nodes, false);
+        noalias(rLeftHandSideMatrix) = ZeroMatrix(number_of_nodes, number_of_nodes);
+        noalias(rRightHandSideVector) = ZeroVector(number_of_nodes);
+
+        for (IndexType g = 0; g < r_integration_points.size(); ++g)
+        {
+            const double weight = r_integration_points[g].Weight() * std::abs(det_J[g]);
+            noalias(rLeftHandSideMatrix) += weight * prod(DN_DX[g], trans(DN_DX[g]));
+            for (IndexType i = 0; i < number_of_nodes; ++i)
+                rRightHandSideVector[i] += weight * r_N(g, i);
+        }
+
+        Vector temperatures(number_of_nodes);
+        for (IndexType i = 0; i < number_of_nodes; ++i)
+            temperatures[i] = r_geometry[i].FastGetSolutionStepValue(TEMPERATURE);
+        noalias(rRightHandSideVector) -= prod(rLeftHandSideMatrix, temperatures);
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    std::string Info() const override
+    {
+        return "BenchmarkLaplacianElement";
+    }
+
+    ///@}
+
+}; // Class BenchmarkLaplacianElement
+
+/**
+ * @class BenchmarkUtilities
+ * @ingroup KratosCore
+ * @brief Generation of the structured meshes of the benchmarks
+ * @details The unit square (Dimension 2) or cube (Dimension 3) is divided in Divisions^Dimension cells, each
+ * split in 2 triangles or 6 tetrahedra. The nodes are numbered from 1 with x running fastest, and the
+ * elements from 1 cell by cell. The elements are the BenchmarkLaplacianElement2D3N and
+ * BenchmarkLaplacianElement3D4N, registered by RegisterElements.
+ */
+class BenchmarkUtilities
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef std::size_t SizeType;
+
+    typedef std::size_t IndexType;
+
+    typedef std::vector<std::vector<IndexType> > ConnectivitiesType;
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Register the benchmark elements to the components and the serializer
+    static void RegisterElements()
+    {
+        static const BenchmarkLaplacianElement triangle_prototype(0, Element::GeometryType::Pointer(
+            new Triangle2D3<ModelPart::NodeType>(Element::GeometryType::PointsArrayType(3, ModelPart::NodeType()))));
+        static const BenchmarkLaplacianElement tetrahedron_prototype(0, Element::GeometryType::Pointer(
+            new Tetrahedra3D4<ModelPart::NodeType>(Element::GeometryType::PointsArrayType(4, ModelPart::NodeType()))));
+
+        KRATOS_REGISTER_ELEMENT(ElementName(2), triangle_prototype)
+        KRATOS_REGISTER_ELEMENT(ElementName(3), tetrahedron_prototype)
+    }
+
+    static std::string ElementName(const SizeType Dimension)
+    {
+        return (Dimension == 2) ? "BenchmarkLaplacianElement2D3N" : "BenchmarkLaplacianElement3D4N";
+    }
+
+    static SizeType NumberOfNodes(const SizeType Divisions, const SizeType Dimension)
+    {
+        SizeType number_of_nodes = 1;
+        for (SizeType d = 0; d < Dimension; ++d)
+            number_of_nodes *= Divisions + 1;
+        return number_of_nodes;
+    }
+
+    static void GetNodeCoordinates(const IndexType NodeId, const SizeType Divisions, const SizeType Dimension, double* pCoordinates)
+    {
+        const double h = 1.0 / Divisions;
+        IndexType index = NodeId - 1;
+        for (SizeType d = 0; d < 3; ++d)
+        {
+            pCoordinates[d] = (d < Dimension) ? h * (index % (Divisions + 1)) : 0.0;
+            index /= Divisions + 1;
+        }
+    }
+
+    static bool IsBoundaryNode(const IndexType NodeId, const SizeType Divisions, const SizeType Dimension)
+    {
+        IndexType index = NodeId - 1;
+        for (SizeType d = 0; d < Dimension; ++d)
+        {
+            const IndexType i = index % (Divisions + 1);
+            if (i == 0 || i == Divisions)
+                return true;
+            index /= Divisions + 1;
+        }
+        return false;
+    }
+
+    /// The connectivities (node ids) of the triangles or tetrahedra
+    static ConnectivitiesType CreateSimplicesConnectivities(const SizeType Divisions, const SizeType Dimension)
+    {
+        const SizeType n = Divisions + 1;
+        ConnectivitiesType connectivities;
+
+        if (Dimension == 2)
+        {
+            connectivities.reserve(2 * Divisions * Divisions);
+            for (IndexType j = 0; j < Divisions; ++j)
+                for (IndexType i = 0; i < Divisions; ++i)
+                {
+                    const IndexType a = j * n + i + 1;
+                    connectivities.push_back(std::vector<IndexType>{a, a + 1, a + n + 1});
+                    connectivities.push_back(std::vector<IndexType>{a, a + n + 1, a + n});
+                }
+        }
+        else
+        {
+            // the Kuhn split of the cells around their main diagonal, which is conforming
+            const int tetrahedra[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+            connectivities.reserve(6 * Divisions * Divisions * Divisions);
+            for (IndexType k = 0; k < Divisions; ++k)
+                for (IndexType j = 0; j < Divisions; ++j)
+                    for (IndexType i = 0; i < Divisions; ++i)
+                    {
+                        const IndexType a = (k * n + j) * n + i + 1;
+                        const IndexType corners[8] = {a, a + 1, a + n + 1, a + n, a + n * n, a + n * n + 1, a + n * n + n + 1, a + n * n + n};
+                        for (int t = 0; t < 6; ++t)
+                            connectivities.push_back(std::vector<IndexType>{corners[tetrahedra[t][0]], corners[tetrahedra[t][1]],
+                                                                            corners[tetrahedra[t][2]], corners[tetrahedra[t][3]]});
+                    }
+        }
+
+        return connectivities;
+    }
+
+    /// Create the nodes, with the TEMPERATURE dof fixed on the boundary if the model part has it. If given,
+    /// rStructuredIds holds the structured id of the node with id i + 1 at position i
+    static void CreateNodes(ModelPart& rModelPart, const SizeType Divisions, const SizeType Dimension,
+                            const std::vector<IndexType>& rStructuredIds = std::vector<IndexType>())
+    {
+        const bool has_temperature = rModelPart.GetNodalSolutionStepVariablesList().Has(TEMPERATURE);
+        const SizeType number_of_nodes = NumberOfNodes(Divisions, Dimension);
+
+        double coordinates[3];
+        for (IndexType id = 1; id <= number_of_nodes; ++id)
+        {
+            const IndexType structured_id = rStructuredIds.empty() ? id : rStructuredIds[id - 1];
+            GetNodeCoordinates(structured_id, Divisions, Dimension, coordinates);
+            ModelPart::NodeType::Pointer p_node = rModelPart.CreateNewNode(id, coordinates[0], coordinates[1], coordinates[2]);
+
+            if (has_temperature)
+            {
+                p_node->AddDof(TEMPERATURE);
+                if (IsBoundaryNode(structured_id, Divisions, Dimension))
+                    p_node->Fix(TEMPERATURE);
+            }
+        }
+    }
+
+    /// Create the elements of the registered rElementName, with the properties 1
+    static void CreateElements(ModelPart& rModelPart, const std::string& rElementName, const ConnectivitiesType& rConnectivities)
+    {
+        const Element& r_prototype = KratosComponents<Element>::Get(rElementName);
+        Properties::Pointer p_properties = rModelPart.pGetProperties(1);
+
+        for (IndexType e = 0; e < rConnectivities.size(); ++e)
+        {
+            Element::NodesArrayType nodes;
+            for (IndexType i = 0; i < rConnectivities[e].size(); ++i)
+                nodes.push_back(rModelPart.pGetNode(rConnectivities[e][i]));
+            rModelPart.AddElement(r_prototype.Create(e + 1, nodes, p_properties));
+        }
+    }
+
+    /// Create the model part of a Laplacian problem on TEMPERATURE, fixed on the boundary
+    static void CreateLaplacianModelPart(ModelPart& rModelPart, const SizeType Divisions, const SizeType Dimension)
+    {
+        rModelPart.AddNodalSolutionStepVariable(TEMPERATURE);
+        CreateNodes(rModelPart, Divisions, Dimension);
+        CreateElements(rModelPart, ElementName(Dimension), CreateSimplicesConnectivities(Divisions, Dimension));
+    }
+
+    /// Create the model part of the Laplacian problem with the ids of the nodes and of the elements shuffled, as
+    /// given by an unstructured mesher: consecutive elements are scattered in the mesh. The entities are created
+    /// by increasing id, as read from an input file
+    static void CreateShuffledLaplacianModelPart(ModelPart& rModelPart, const SizeType Divisions, const SizeType Dimension)
+    {
+        rModelPart.AddNodalSolutionStepVariable(TEMPERATURE);
+
+        const std::vector<IndexType> structured_nodes_ids = RandomPermutation(NumberOfNodes(Divisions, Dimension), 1);
+        CreateNodes(rModelPart, Divisions, Dimension, structured_nodes_ids);
+
+        std::vector<IndexType> nodes_ids(structured_nodes_ids.size());
+        for (IndexType i = 0; i < structured_nodes_ids.size(); ++i)
+            nodes_ids[structured_nodes_ids[i] - 1] = i + 1;
+
+        const ConnectivitiesType structured_connectivities = CreateSimplicesConnectivities(Divisions, Dimension);
+        const std::vector<IndexType> structured_elements_ids = RandomPermutation(structured_connectivities.size(), 2);
+        ConnectivitiesType connectivities(structured_connectivities.size());
+        for (IndexType e = 0; e < connectivities.size(); ++e)
+        {
+            connectivities[e] = structured_connectivities[structured_elements_ids[e] - 1];
+            for (IndexType i = 0; i < connectivities[e].size(); ++i)
+                connectivities[e][i] = nodes_ids[connectivities[e][i] - 1];
+        }
+
+        CreateElements(rModelPart, ElementName(Dimension), connectivities);
+    }
+
+    /// The ids from 1 to Size in a random order
+    static std::vector<IndexType> RandomPermutation(const SizeType Size, const unsigned int Seed)
+    {
+        std::vector<IndexType> ids(Size);
+        std::iota(ids.begin(), ids.end(), 1);
+        std::shuffle(ids.begin(), ids.end(), std::mt19937(Seed));
+        return ids;
+    }
+
+    /// Write the mesh of the Laplacian problem as a .mdpa file, with the TEMPERATURE of the boundary nodes
+    static void WriteMdpa(const std::string& rFilename, const SizeType Divisions, const SizeType Dimension)
+    {
+        std::ofstream output(rFilename.c_str());
+        KRATOS_ERROR_IF(!output) << "Error opening output file " << rFilename;
+        output.precision(16);
+
+        const SizeType number_of_nodes = NumberOfNodes(Divisions, Dimension);
+
+        output << "Begin ModelPartData\nEnd ModelPartData\n\n";
+        output << "Begin Properties 1\nEnd Properties\n\n";
+
+        double coordinates[3];
+        output << "Begin Nodes\n";
+        for (IndexType id = 1; id <= number_of_nodes; ++id)
+        {
+            GetNodeCoordinates(id, Divisions, Dimension, coordinates);
+            output << id << " " << coordinates[0] << " " << coordinates[1] << " " << coordinates[2] << "\n";
+        }
+        output << "End Nodes\n\n";
+
+        const ConnectivitiesType connectivities = CreateSimplicesConnectivities(Divisions, Dimension);
+        output << "Begin Elements " << ElementName(Dimension) << "\n";
+        for (IndexType e = 0; e < connectivities.size(); ++e)
+        {
+            output << e + 1 << " 1";
+            for (IndexType i = 0; i < connectivities[e].size(); ++i)
+                output << " " << connectivities[e][i];
+            output << "\n";
+        }
+        output << "End Elements\n\n";
+
+        output << "Begin NodalData TEMPERATURE\n";
+        for (IndexType id = 1; id <= number_of_nodes; ++id)
+            if (IsBoundaryNode(id, Divisions, Dimension))
+                output << id << " 1 0.0\n";
+        output << "End NodalData\n";
+    }
+
+    ///@}
+
+}; // Class BenchmarkUtilities
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BENCHMARK_UTILITIES_H_INCLUDED  defined
@@ -0,0 +1,106 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+// System includes
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// External includes
+
+// Project includes
+#include "includes/kernel.h"
+#include "benchmarks/benchmark_utilities.h"
+#include "benchmarks/kratos_core_benchmarks.h"
+
+using namespace Kratos;
+
+void PrintUsage(const char* pProgram)
+{
+    std::cout << "Usage: " << pProgram << " [options]\n"
+              << "  --filter <text>       run only the benchmarks whose name contains text\n"
+              << "  --repetitions <n>     number of timed runs of each benchmark (default 5)\n"
+              << "  --scale <factor>      scale of the problem sizes (default 1)\n"
+              << "  --output <file>       JSON file of the results (default kratos_core_benchmarks.json)\n"
+              << "  --list                list the benchmarks and exit\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::size_t repetitions = 5;
+    double scale = 1.0;
+    std::string output = "kratos_core_benchmarks.json";
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument(argv[i]);
+        const bool has_value = (i + 1 < argc);
+        if (argument == "--filter" && has_value)
+            filter = argv[++i];
+        else if (argument == "--repetitions" && has_value)
+            repetitions = std::strtoul(argv[++i], NULL, 10);
+        else if (argument == "--scale" && has_value)
+            scale = std::strtod(argv[++i], NULL);
+        else if (argument == "--output" && has_value)
+            output = argv[++i];
+        else if (argument == "--list")
+            list = true;
+        else
+        {
+            PrintUsage(argv[0]);
+            return (argument == "--help") ? 0 : 1;
+        }
+    }
+
+    if (repetitions == 0 || !(scale > 0.0))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    Kernel kernel;
+    kernel.Initialize();
+    BenchmarkUtilities::RegisterElements();
+
+    BenchmarkSuite suite;
+    Benchmarks::AddSolvingBenchmarks(suite);
+    Benchmarks::AddIOBenchmarks(suite);
+    Benchmarks::AddContainersBenchmarks(suite);
+    Benchmarks::AddSearchBenchmarks(suite);
+    Benchmarks::AddModelPartBenchmarks(suite);
+    Benchmarks::AddUtilitiesBenchmarks(suite);
+
+    if (list)
+    {
+        const std::vector<std::string> names = suite.GetNames(filter);
+        for (std::size_t i = 0; i < names.size(); ++i)
+            std::cout << names[i] << std::endl;
+        return 0;
+    }
+
+    const Parameters results = suite.Run(filter, repetitions, scale, std::cout);
+
+    std::ofstream output_file(output.c_str());
+    if (!output_file)
+    {
+        std::cerr << "Error opening output file " << output << std::endl;
+        return 1;
+    }
+    output_file << results.PrettyPrintJsonString() << std::endl;
+    std::cout << "The results are written in " << output << std::endl;
+
+    return 0;
+}
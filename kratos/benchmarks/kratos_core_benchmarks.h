@@ -0,0 +1,59 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_CORE_BENCHMARKS_H_INCLUDED )
+#define  KRATOS_CORE_BENCHMARKS_H_INCLUDED
+
+// System includes
+
+// External includes
+
+// Project includes
+#include "benchmarks/benchmark_suite.h"
+
+
+namespace Kratos
+{
+
+namespace Benchmarks
+{
+
+/// ConstructMatrixStructure, Build, SpMV, CG+ILU0 and convergence checks on the system of a structured Laplacian problem,
+/// SpMM and the CG/BiCGSTAB solvers against their block versions on 1 to 16 right hand sides,
+/// Build on the structured, shuffled and reordered numberings of a large mesh,
+/// Newton-Raphson and quasi-Newton strategies on a plasticity problem, BiCGSTAB with the ILU0 and field-split
+/// preconditioners on coupled consolidation and thermo-elastic problems
+void AddSolvingBenchmarks(BenchmarkSuite& rSuite);
+
+/// ModelPartIO read and Serializer save/load of a structured mesh
+void AddIOBenchmarks(BenchmarkSuite& rSuite);
+
+/// DataValueContainer get/set
+void AddContainersBenchmarks(BenchmarkSuite& rSuite);
+
+/// Construction and searches of the spatial bins
+void AddSearchBenchmarks(BenchmarkSuite& rSuite);
+
+/// Creation of the nodes and elements of a structured mesh, one by one and in bulk, nodal accumulation under the
+/// node locks and by atomic additions, memory report, reordering and relocation of a shuffled mesh
+void AddModelPartBenchmarks(BenchmarkSuite& rSuite);
+
+/// Tangents of a hyperelastic stress by dual numbers and by finite differences, element stiffness and mass integration,
+/// eigen-decomposition of symmetric tensors
+void AddUtilitiesBenchmarks(BenchmarkSuite& rSuite);
+
+}  // namespace Benchmarks.
+
+}  // namespace Kratos.
+
+#endif // KRATOS_CORE_BENCHMARKS_H_INCLUDED  defined
@@ -16,6 +16,7 @@
 
 // System includes
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -755,7 +756,10 @@ public:
         for (auto it = first; it != last; ++it) {
             temp.push_back(GetPointer(it));
         }
-        std::sort(temp.begin(), temp.end(), CompareKey());
+        // the ranges created in order, e.g. by the bulk creation of the model part, need no sorting
+        if (!std::is_sorted(temp.begin(), temp.end(), CompareKey())) {
+            std::sort(temp.begin(), temp.end(), CompareKey());
+        }
         auto new_last = std::unique(temp.begin(), temp.end(), EqualKeyTo());
         SortedInsert(temp.begin(), new_last);
     }
@@ -1073,7 +1077,7 @@ private:
          * @param b The pointer to an object of type `TPointerType`.
          * @return True if the key `a` is less than the extracted key from `b`, false otherwise.
          */
-        bool operator()(key_type a, TPointerType b) const
+        bool operator()(key_type a, const TPointerType& b) const
         {
             return TCompareType()(a, TGetKeyType()(*b));
         }
@@ -1085,7 +1089,7 @@ private:
          * @param b The key of type `key_type`.
          * @return True if the extracted key from `a` is less than the key `b`, false otherwise.
          */
-        bool operator()(TPointerType a, key_type b) const
+        bool operator()(const TPointerType& a, key_type b) const
         {
             return TCompareType()(TGetKeyType()(*a), b);
         }
@@ -1097,7 +1101,7 @@ private:
          * @param b The pointer to the second object of type `TPointerType`.
          * @return True if the extracted key from `a` is less than the extracted key from `b`, false otherwise.
          */
-        bool operator()(TPointerType a, TPointerType b) const
+        bool operator()(const TPointerType& a, const TPointerType& b) const
         {
             return TCompareType()(TGetKeyType()(*a), TGetKeyType()(*b));
         }
@@ -1131,7 +1135,7 @@ private:
         * @param a The pointer to an object of type `TPointerType`.
         * @return True if the stored key is equal to the extracted key from `a`, false otherwise.
         */
-        bool operator()(TPointerType a) const
+        bool operator()(const TPointerType& a) const
         {
             return TEqualType()(mKey, TGetKeyType()(*a));
         }
@@ -1154,7 +1158,7 @@ private:
         * @param b The pointer to the second object of type `TPointerType`.
         * @return True if the extracted key from `a` is equal to the extracted key from `b`, false otherwise.
         */
-        bool operator()(TPointerType a, TPointerType b) const
+        bool operator()(const TPointerType& a, const TPointerType& b) const
         {
             return TEqualType()(TGetKeyType()(*a), TGetKeyType()(*b));
         }
@@ -27,11 +27,14 @@
 
 // System includes
 #include <string>
-// #include <fstream>
 #include <cstdio>
 #include <iostream>
-#include <set>
+#include <vector>
 #include <map>
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
+#include <typeindex>
 
 // External includes
 
@@ -43,7 +46,10 @@
 #include "includes/mesh.h"
 
 #include "rapidjson/filereadstream.h"
-#include "rapidjson/document.h"
+#include "rapidjson/filewritestream.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/error/en.h"
 
 namespace Kratos
 {
@@ -69,8 +75,16 @@ namespace Kratos
 
 /// An IO class for reading and writing a modelpart
 /** This class reads and writes all modelpart data including the meshes.
+The file is parsed with the SAX reader of rapidjson, hence the document is never held in memory: the
+nodes, properties, elements, conditions, meshes and nodal data are created while their arrays are
+parsed. This requires the sections of "model_part" to come in the order Nodes, Properties, Elements,
+Conditions, Meshes, NodalData, as WriteModelPart writes them. The sizes written by WriteModelPart
+("NumberOfNodes" and the "size" of each block of elements or conditions) are used to reserve the
+containers. After the reading, the ids of the nodes, elements and conditions read are made consecutive,
+keeping their order.
+WriteModelPart streams the model part to the file in the same way, without building a document.
 */
-class KratosJsonIO : public IO
+class KratosJsonIO : public IO<>
 {
 public:
     ///@name Type Definitions
@@ -79,12 +93,18 @@ public:
     /// Pointer definition of KratosJsonIO
     KRATOS_CLASS_POINTER_DEFINITION(KratosJsonIO);
 
-    typedef IO BaseType;
+    typedef IO<> BaseType;
+
+    typedef BaseType::ModelPartType ModelPartType;
 
     typedef BaseType::NodeType NodeType;
 
     typedef BaseType::MeshType MeshType;
 
+    typedef BaseType::ElementType ElementType;
+
+    typedef BaseType::ConditionType ConditionType;
+
     typedef BaseType::NodesContainerType NodesContainerType;
 
     typedef BaseType::PropertiesContainerType PropertiesContainerType;
@@ -95,10 +115,16 @@ public:
 
     typedef BaseType::ConnectivitiesContainerType ConnectivitiesContainerType;
 
-//     typedef std::vector<std::ofstream*> OutputFilesContainerType;
+    typedef ModelPartType::PropertiesType PropertiesType;
+
+    typedef ElementType::NodesArrayType NodesArrayType;
+
+    typedef VariableComponent< VectorComponentAdaptor<array_1d<double, 3> > > ComponentType;
 
     typedef std::size_t SizeType;
 
+    typedef std::size_t IndexType;
+
     ///@}
     ///@name Life Cycle
     ///@{
@@ -106,53 +132,89 @@ public:
     /// Constructor with  filenames.
     KratosJsonIO(
         std::string const& Filename,
-        const Flags Options = IO::READ | IO::IGNORE_VARIABLES_ERROR)
-        :IO()
+        const Flags Options = BaseIO::READ | BaseIO::IGNORE_VARIABLES_ERROR)
+        :BaseType()
     {
         mFilename = Filename;
         mOptions = Options;
     }
 
-    virtual void ReadModelPart(ModelPart & rThisModelPart)
-    {
-        //read mFilename
-        FILE* fp = fopen(mFilename.c_str(), "rb"); // non-Windows use "r"
-        char readBuffer[65536];
-        rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-        rapidjson::Document d;
-        d.ParseStream<0, rapidjson::UTF8<>, rapidjson::FileReadStream>(is);
-        fclose(fp);
+    /// Destructor.
+    virtual ~KratosJsonIO() {};
 
-        bool consecutive_reordering = true; //TODO: pass this as a flag in the options
-        if(consecutive_reordering)
-            EnforceConsecutiveOrdering(d);
 
+    ///@}
+    ///@name Operators
+    ///@{
 
 
-        //construct the model part
-        FillModelPart(d, rThisModelPart);
+    ///@}
+    ///@name Operations
+    ///@{
 
-    }
+    void ReadModelPart(ModelPartType& rThisModelPart) override
+    {
+        KRATOS_TRY
 
+        KRATOS_ERROR_IF(rThisModelPart.IsSubModelPart()) << "KratosJsonIO reads into a root model part, "
+            << rThisModelPart.Name() << " is a sub model part";
 
+        //read mFilename
+        FILE* fp = fopen(mFilename.c_str(), "rb"); // non-Windows use "r"
+        KRATOS_ERROR_IF(fp == NULL) << "Error opening the json file " << mFilename;
 
+        char readBuffer[65536];
+        rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
 
-    /// Constructor with filenames.
+        ModelPartReader handler(rThisModelPart);
+        rapidjson::Reader reader;
+        rapidjson::ParseResult result;
+        try
+        {
+            result = reader.Parse(is, handler);
+        }
+        catch(...)
+        {
+            fclose(fp);
+            throw;
+        }
+        fclose(fp);
 
-    /// Destructor.
-    virtual ~KratosJsonIO() {};
+        KRATOS_ERROR_IF(result.IsError()) << "Error parsing the json file " << mFilename << " at offset "
+            << result.Offset() << ": " << rapidjson::GetParseError_En(result.Code());
 
+        bool consecutive_reordering = true; //TODO: pass this as a flag in the options
+        if(consecutive_reordering)
+            handler.EnforceConsecutiveOrdering();
 
-    ///@}
-    ///@name Operators
-    ///@{
+        KRATOS_CATCH("")
+    }
 
+    /// Write the model part in the format read by ReadModelPart. Only the double (and double component) variables are written
+    void WriteModelPart(ModelPartType& rThisModelPart)
+    {
+        KRATOS_TRY
 
-    ///@}
-    ///@name Operations
-    ///@{
+        FILE* fp = fopen(mFilename.c_str(), "wb");
+        KRATOS_ERROR_IF(fp == NULL) << "Error opening the json file " << mFilename;
 
+        char writeBuffer[65536];
+        rapidjson::FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
+        rapidjson::Writer<rapidjson::FileWriteStream> writer(os);
+        try
+        {
+            WriteModelPartObject(rThisModelPart, writer);
+            os.Flush();
+        }
+        catch(...)
+        {
+            fclose(fp);
+            throw;
+        }
+        fclose(fp);
 
+        KRATOS_CATCH("")
+    }
 
     ///@}
     ///@name Access
@@ -195,592 +257,690 @@ public:
     ///@}
 
 protected:
-    ///@name Protected static Member Variables
+    ///@name Protected Classes
     ///@{
 
+    /// The SAX handler of ReadModelPart, which creates the model part while the file is parsed
+    /** The keys of the containers being parsed are kept by depth: the root object is at depth 1, the
+    model_part object at depth 2, the sections at depth 3, and so on. The numbers of a row (a node, an
+    element or a nodal value) are collected and the row is created when its array ends.
+    */
+    class ModelPartReader : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ModelPartReader>
+    {
+    public:
 
-    ///@}
-    ///@name Protected member Variables
-    ///@{
+        enum SectionType { NO_SECTION, NUMBER_OF_NODES, NODES, PROPERTIES, ELEMENTS, CONDITIONS, MESHES, NODAL_DATA };
 
+        typedef std::function<void(NodeType&, double, bool, IndexType)> NodalValueAssignerType;
 
-    ///@}
-    ///@name Protected Operators
-    ///@{
+        ModelPartReader(ModelPartType& rModelPart)
+        : mrModelPart(rModelPart), mDepth(0), mInModelPart(false), mSection(NO_SECTION), mKeys(8)
+        , mpProperties(), mpElementPrototype(NULL), mpConditionPrototype(NULL), mpMesh(NULL)
+        , mStepIndex(0), mHasStepIndex(false), mIsEmpty(rModelPart.NumberOfNodes() == 0 && rModelPart.NumberOfElements() == 0 && rModelPart.NumberOfConditions() == 0)
+        , mIsAppendSorted(false)
+        {}
 
+        bool Null() { return true; }
+        bool Bool(bool Value) { return Number(Value ? 1.0 : 0.0); }
+        bool Int(int Value) { return Number(Value); }
+        bool Uint(unsigned Value) { return Number(Value); }
+        bool Int64(int64_t Value) { return Number(static_cast<double>(Value)); }
+        bool Uint64(uint64_t Value) { return Number(static_cast<double>(Value)); }
+        bool Double(double Value) { return Number(Value); }
 
-    ///@}
-    ///@name Protected Operations
-    ///@{
+        bool String(const char* pValue, rapidjson::SizeType Length, bool Copy)
+        {
+            KRATOS_ERROR_IF(mInModelPart && mSection != NO_SECTION) << "unexpected string \"" << std::string(pValue, Length)
+                << "\" in the section " << mKeys[2] << " of the model_part";
+            return true;
+        }
 
-    ///@}
-    ///@name Protected  Access
-    ///@{
+        bool StartObject() { return StartContainer(); }
+        bool StartArray() { return StartContainer(); }
+        bool EndObject(rapidjson::SizeType MemberCount) { return EndContainer(); }
+        bool EndArray(rapidjson::SizeType ElementCount) { return EndContainer(); }
 
+        bool Key(const char* pKey, rapidjson::SizeType Length, bool Copy)
+        {
+            std::string& r_key = mKeys[mDepth];
+            r_key.assign(pKey, Length);
 
-    ///@}
-    ///@name Protected Inquiry
-    ///@{
+            if(mDepth == 1)
+                mInModelPart = (r_key == "model_part");
+            else if(mInModelPart && mDepth == 2)
+            {
+                mSection = GetSection(r_key);
+                mIsAppendSorted = mIsEmpty;
+            }
+            else if(mInModelPart && mDepth == 3)
+                StartBlock(r_key);
 
+            return true;
+        }
 
-    ///@}
-    ///@name Protected LifeCycle
-    ///@{
+        /// Renumber the nodes, elements and conditions read from 1, keeping their order
+        void EnforceConsecutiveOrdering()
+        {
+            RenumberEntities(mrModelPart.Nodes(), mNodeIds);
+            RenumberEntities(mrModelPart.Elements(), mElementIds);
+            RenumberEntities(mrModelPart.Conditions(), mConditionIds);
 
+            // the entities which are not read keep their ids, hence the order is lost
+            if(!mIsEmpty)
+            {
+                for(IndexType i = 0; i < mrModelPart.NumberOfMeshes(); i++)
+                {
+                    mrModelPart.GetMesh(i).Nodes().Sort();
+                    mrModelPart.GetMesh(i).Elements().Sort();
+                    mrModelPart.GetMesh(i).Conditions().Sort();
+                }
+            }
+        }
 
-    ///@}
+    private:
 
-protected:
-    ///@name Static Member Variables
-    ///@{
+        ModelPartType& mrModelPart;
 
+        std::size_t mDepth;
 
-    ///@}
-    ///@name Member Variables
-    ///@{
+        bool mInModelPart;
 
-    std::string mFilename;
-    Flags mOptions;
+        SectionType mSection;
 
+        std::vector<std::string> mKeys;
 
-    ///@}
-    ///@name Private Operators
-    ///@{
+        std::vector<double> mRow;
 
+        typename PropertiesType::Pointer mpProperties;
 
-    ///@}
-    ///@name Protected Operations
-    ///@{
-    void FillModelPart(rapidjson::Document& d, ModelPart & rThisModelPart)
-    {
-        KRATOS_TRY
+        const ElementType* mpElementPrototype;
 
-        //get the section of the model part related to nodes
-        rapidjson::Value& json_model_part = d["model_part"]; // Using a reference for consecutive access is handy and faster.
+        const ConditionType* mpConditionPrototype;
 
-        //////////////////////////////////////////////read Nodes
-        if(json_model_part.HasMember("Nodes") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection Nodes of the model_part","")
-        {
-            rapidjson::Value& json_nodes = json_model_part["Nodes"]; // Using a reference for consecutive access is handy and faster.
-            if(json_nodes.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Nodes section is not an array as expected!!","")
+        MeshType* mpMesh;
 
-                std::map<std::size_t, std::size_t> nodes_id_map; //create a list of nodes -- Create New node uses insert hence it is slow if input is not ordered
-            for (rapidjson::SizeType i = 0; i < json_nodes.Size(); i++) // rapidjson uses SizeType instead of size_t.
-            {
-                std::size_t node_id =  json_nodes[i][0].GetInt() ;
-                nodes_id_map[ node_id ] = i; //store in the map the position in the array
-            }
+        NodalValueAssignerType mNodalValueAssigner;
 
-            for(std::map<std::size_t, std::size_t>::iterator it = nodes_id_map.begin(); it!= nodes_id_map.end(); it++)
-            {
-                std::size_t pos = it->second;
-//                 KRATOS_WATCH(it->first);
-//                 KRATOS_WATCH(it->second);
-                const rapidjson::Value& node_input = json_nodes[pos];             //obtain the row with the node data
-                rThisModelPart.CreateNewNode( node_input[0].GetInt(), node_input[1].GetDouble(), node_input[2].GetDouble(), node_input[3].GetDouble());
-            }
-            //here nodes are not any more needed in the json so remove them to free the memory
-            d.RemoveMember(json_nodes);
-        }
+        IndexType mStepIndex;
 
-        //////////////////////////////////////////////read Properties
-        if(json_model_part.HasMember("Properties") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection Properties of the model_part","")
-        {
-            const rapidjson::Value& json_properties = json_model_part["Properties"]; // Using a reference for consecutive access is handy and faster.
-            if(json_properties.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Properties section is not a json object as expected!!","")
-                for (rapidjson::Value::ConstMemberIterator itr = json_properties.MemberBegin(); itr != json_properties.MemberEnd(); ++itr)
-                {
-                    unsigned int prop_id = atoi( itr->name.GetString() );
-                    if(itr->value.HasMember("Variables") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection Variables of the Properties subsection of model_part","");
+        bool mHasStepIndex;
 
-                    const rapidjson::Value& prop_variables = itr->value["Variables"];
-                    for (rapidjson::Value::ConstMemberIterator iii = prop_variables.MemberBegin(); iii != prop_variables.MemberEnd(); ++iii)
-                    {
-                        if( CheckAndAssignPropertyValue< Variable<double> >( rThisModelPart.pGetProperties(prop_id), iii->name.GetString(), iii->value) ) {}
-                        else if( CheckAndAssignPropertyValue< Variable<bool> >( rThisModelPart.pGetProperties(prop_id), iii->name.GetString(), iii->value) ) {}
-                        else if( CheckAndAssignPropertyValue< Variable<int> >( rThisModelPart.pGetProperties(prop_id), iii->name.GetString(), iii->value) ) {}
-                        else if( CheckAndAssignPropertyValue< Variable<unsigned int> >( rThisModelPart.pGetProperties(prop_id), iii->name.GetString(), iii->value) ) {}
-                        else
-                        {
-                            typedef VariableComponent< VectorComponentAdaptor<array_1d<double, 3> > > component_type;
-                            if( CheckAndAssignPropertyValue< component_type >( rThisModelPart.pGetProperties(prop_id), iii->name.GetString(), iii->value) ) {}
-                            else
-                            {
-                                KRATOS_THROW_ERROR(std::invalid_argument, "can not read a variable type from the property block -- variable is ",iii->name.GetString());
-                            }
-                        }
-                    }
-                }
-        }
+        std::vector<double> mNodalDataRows;
 
-        //read Elements
-        if(json_model_part.HasMember("Elements"))
-        {
-            const rapidjson::Value& json_elements = json_model_part["Elements"]; // Using a reference for consecutive access is handy and faster.
-            if(json_elements.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Elements section is not a json object as expected!!","")
-                for (rapidjson::Value::ConstMemberIterator itr = json_elements.MemberBegin(); itr != json_elements.MemberEnd(); ++itr)
-                {
-                    std::string element_name = itr->name.GetString();
-                    KRATOS_WATCH(element_name);
-                    if(itr->value["connectivity"].IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the connectivity section of the Elements is not an array as expected!!","")
+        bool mIsEmpty;
 
-                        const rapidjson::Value& connectivity = itr->value["connectivity"];
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        const rapidjson::Value& local_data = connectivity[i];
-                        unsigned int elem_id = local_data[0].GetInt();
-                        unsigned int prop_id = local_data[1].GetInt();
+        bool mIsAppendSorted;
 
-                        unsigned int nnodes = local_data.Size()-2;
-                        std::vector< ModelPart::IndexType > node_ids(nnodes);
-                        for(unsigned int j=0; j<nnodes; j++) node_ids[j]= local_data[j+2].GetInt() ;
+        std::vector<std::pair<IndexType, typename NodeType::Pointer> > mNodeLookup;
 
-                        rThisModelPart.CreateNewElement(element_name, elem_id, node_ids, rThisModelPart.pGetProperties(prop_id) );
-                    }
-                }
-        }
+        std::vector<IndexType> mNodeIds;
 
+        std::vector<IndexType> mElementIds;
 
+        std::vector<IndexType> mConditionIds;
 
-        //read Conditions
-        if(json_model_part.HasMember("Conditions"))
+        static SectionType GetSection(const std::string& rName)
         {
-            const rapidjson::Value& json_conditions = json_model_part["Conditions"]; // Using a reference for consecutive access is handy and faster.
-            if(json_conditions.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Conditions section is not a json object as expected!!","")
-                for (rapidjson::Value::ConstMemberIterator itr = json_conditions.MemberBegin(); itr != json_conditions.MemberEnd(); ++itr)
-                {
-                    std::string condition_name = itr->name.GetString();
-                    if(itr->value["connectivity"].IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the connectivity section of the Conditions is not an array as expected!!","")
-
-                        const rapidjson::Value& connectivity = itr->value["connectivity"];
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        const rapidjson::Value& local_data = connectivity[i];
-                        unsigned int elem_id = local_data[0].GetInt();
-                        unsigned int prop_id = local_data[1].GetInt();
-
-                        unsigned int nnodes = local_data.Size()-2;
-                        std::vector< ModelPart::IndexType > node_ids(nnodes);
-                        for(unsigned int j=0; j<nnodes; j++) node_ids[j]= local_data[j+2].GetInt() ;
+            if(rName == "NumberOfNodes") return NUMBER_OF_NODES;
+            if(rName == "Nodes") return NODES;
+            if(rName == "Properties") return PROPERTIES;
+            if(rName == "Elements") return ELEMENTS;
+            if(rName == "Conditions") return CONDITIONS;
+            if(rName == "Meshes") return MESHES;
+            if(rName == "NodalData") return NODAL_DATA;
+            return NO_SECTION;
+        }
 
-                        rThisModelPart.CreateNewCondition(condition_name, elem_id, node_ids, rThisModelPart.pGetProperties(prop_id) );
-                    }
-                }
+        bool StartContainer()
+        {
+            mDepth++;
+            if(mKeys.size() <= mDepth)
+                mKeys.resize(mDepth + 1);
+            mKeys[mDepth].clear();
+            return true;
         }
 
-        //read Meshes
-        if(json_model_part.HasMember("Meshes"))
+        bool EndContainer()
         {
-            const rapidjson::Value& json_meshes = json_model_part["Meshes"]; // Using a reference for consecutive access is handy and faster.
-            if(json_meshes.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Meshes section is not a json object as expected!!","")
-                for (rapidjson::Value::ConstMemberIterator itr = json_meshes.MemberBegin(); itr != json_meshes.MemberEnd(); ++itr)
+            if(mInModelPart)
+            {
+                switch(mSection)
                 {
-                    //get the mesh
-                    unsigned int mesh_id = atoi( itr->name.GetString() );
-
-                    //TODO: this is UGLY - there should be a better way to create a mesh
-                    unsigned int number_of_meshes = rThisModelPart.GetMeshes().size();
-                    ModelPart::MeshType empty_mesh;
-                    for(ModelPart::IndexType i = number_of_meshes ; i < mesh_id + 1 ; i++)
-                        rThisModelPart.GetMeshes().push_back(empty_mesh.Clone());
-
-                    ModelPart::MeshType& mesh = rThisModelPart.GetMesh(mesh_id);
-
-                    if((itr->value).HasMember("NodePointers"))
+                case NODES:
+                    if(mDepth == 4) CreateNode();
+                    else if(mDepth == 3) EndEntities(mrModelPart.Nodes());
+                    break;
+                case ELEMENTS:
+                    if(mDepth == 6) CreateEntity(*mpElementPrototype, mrModelPart.Elements(), mElementIds);
+                    else if(mDepth == 3) EndEntities(mrModelPart.Elements());
+                    break;
+                case CONDITIONS:
+                    if(mDepth == 6) CreateEntity(*mpConditionPrototype, mrModelPart.Conditions(), mConditionIds);
+                    else if(mDepth == 3) EndEntities(mrModelPart.Conditions());
+                    break;
+                case MESHES:
+                    if(mDepth == 4)
                     {
-                        const rapidjson::Value& json_nodepointers = (itr->value)["NodePointers"];
-                        if(json_nodepointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the NodePointers section is not a json array as expected!!","")
-                            mesh.Nodes().reserve( json_nodepointers.Size() );
-                        KRATOS_WATCH( json_nodepointers.Size() )
-                        for(rapidjson::SizeType i=0; i<json_nodepointers.Size(); i++) mesh.Nodes().push_back( rThisModelPart.pGetNode(  json_nodepointers[i].GetInt()  ));
+                        mpMesh->Nodes().Unique();
+                        mpMesh->Elements().Unique();
+                        mpMesh->Conditions().Unique();
                     }
-
-                    if((itr->value).HasMember("ElementPointers"))
+                    break;
+                case NODAL_DATA:
+                    if(mDepth == 6 && mKeys[4] == "data")
                     {
-                        const rapidjson::Value& json_elementpointers = (itr->value)["ElementPointers"];
-                        if(json_elementpointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the ElementPointers section is not a json array as expected!!","")
-                            mesh.Elements().reserve( json_elementpointers.Size() );
-                        for(rapidjson::SizeType i=0; i<json_elementpointers.Size(); i++) mesh.Elements().push_back( rThisModelPart.pGetElement( json_elementpointers[i].GetInt() ));
+                        // the rows coming before the stepindex are applied at the end of the variable
+                        if(mHasStepIndex)
+                            AssignNodalValue(mRow, mStepIndex);
+                        else
+                            mNodalDataRows.insert(mNodalDataRows.end(), mRow.begin(), mRow.end());
+                        mRow.clear();
                     }
-
-                    if((itr->value).HasMember("ConditionPointers"))
+                    else if(mDepth == 4)
                     {
-                        const rapidjson::Value& json_conditionpointers = (itr->value)["ConditionPointers"];
-                        if(json_conditionpointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the ConditionPointers section is not a json array as expected!!","")
-                            mesh.Conditions().reserve( json_conditionpointers.Size() );
-                        for(rapidjson::SizeType i=0; i<json_conditionpointers.Size(); i++) mesh.Conditions().push_back( rThisModelPart.pGetCondition( json_conditionpointers[i].GetInt() ));
+                        std::vector<double> row(3);
+                        for(SizeType i = 0; i + 2 < mNodalDataRows.size(); i += 3)
+                        {
+                            std::copy(mNodalDataRows.begin() + i, mNodalDataRows.begin() + i + 3, row.begin());
+                            AssignNodalValue(row, mStepIndex);
+                        }
+                        mNodalDataRows.clear();
                     }
-
-                    mesh.Nodes().Unique();
-                    mesh.Elements().Unique();
-                    mesh.Conditions().Unique();
+                    break;
+                default:
+                    break;
                 }
+            }
 
-
+            mDepth--;
+            return true;
         }
 
-
-        //read NodalValues
-        if(json_model_part.HasMember("NodalData"))
+        bool Number(double Value)
         {
+            if(!mInModelPart)
+                return true;
+
+            switch(mSection)
             {
-                const rapidjson::Value& json_nodaldata = json_model_part["NodalData"];
-                if(json_nodaldata.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the NodalData section is not a json object as expected!!","")
-                    for (rapidjson::Value::ConstMemberIterator itr = json_nodaldata.MemberBegin(); itr != json_nodaldata.MemberEnd(); ++itr)
-                    {
-                        std::string variable_name = itr->name.GetString();
+            case NUMBER_OF_NODES:
+                if(mDepth == 2) mrModelPart.Nodes().reserve(mrModelPart.NumberOfNodes() + static_cast<SizeType>(Value));
+                break;
+            case NODES:
+                if(mDepth == 4) mRow.push_back(Value);
+                break;
+            case PROPERTIES:
+                if(mDepth == 5 && mKeys[4] == "Variables") AssignPropertyValue(mKeys[5], Value);
+                break;
+            case ELEMENTS:
+                if(mDepth == 4 && mKeys[4] == "size") mrModelPart.Elements().reserve(mrModelPart.NumberOfElements() + static_cast<SizeType>(Value));
+                else if(mDepth == 6 && mKeys[4] == "connectivity") mRow.push_back(Value);
+                break;
+            case CONDITIONS:
+                if(mDepth == 4 && mKeys[4] == "size") mrModelPart.Conditions().reserve(mrModelPart.NumberOfConditions() + static_cast<SizeType>(Value));
+                else if(mDepth == 6 && mKeys[4] == "connectivity") mRow.push_back(Value);
+                break;
+            case MESHES:
+                if(mDepth == 5) AddToMesh(mKeys[4], static_cast<IndexType>(Value));
+                break;
+            case NODAL_DATA:
+                if(mDepth == 4 && mKeys[4] == "stepindex")
+                {
+                    mStepIndex = static_cast<IndexType>(Value);
+                    mHasStepIndex = true;
+                }
+                else if(mDepth == 6 && mKeys[4] == "data") mRow.push_back(Value);
+                break;
+            default:
+                break;
+            }
 
-                        if(itr->value.HasMember("stepindex") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection stepindex of the NodalData subsection of model_part","");
-                        unsigned int stepindex =  itr->value["stepindex"].GetInt();
+            return true;
+        }
 
-                        if(itr->value.HasMember("data") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection data of the NodalData subsection of model_part","");
-                        const rapidjson::Value& json_nodaldata = itr->value["data"];
+        /// The name of a property, an element or condition, a mesh or a nodal variable starts its block
+        void StartBlock(const std::string& rName)
+        {
+            switch(mSection)
+            {
+            case PROPERTIES:
+                mpProperties = mrModelPart.pGetProperties(std::stoul(rName));
+                break;
+            case ELEMENTS:
+                KRATOS_ERROR_IF_NOT(KratosComponents<ElementType>::Has(rName)) << "the element " << rName << " is not registered";
+                mpElementPrototype = &KratosComponents<ElementType>::Get(rName);
+                break;
+            case CONDITIONS:
+                KRATOS_ERROR_IF_NOT(KratosComponents<ConditionType>::Has(rName)) << "the condition " << rName << " is not registered";
+                mpConditionPrototype = &KratosComponents<ConditionType>::Get(rName);
+                break;
+            case MESHES:
+            {
+                const IndexType mesh_id = std::stoul(rName);
 
-//                     for (rapidjson::Value::ConstMemberIterator iii = json_nodaldata.MemberBegin(); iii != json_nodaldata.MemberEnd(); ++iii)
-//                     {
-//                     for(SizeType i = 0; i<json_nodaldata.Size(); i++)
-                        {
-                            if( CheckAndAssignNodalValue< Variable<double> >( rThisModelPart, variable_name, json_nodaldata, stepindex) ) {}
-                            else if( CheckAndAssignNodalValue_ErrorIfFixed< Variable<bool> >( rThisModelPart, variable_name, json_nodaldata,stepindex) ) {}
-                            else if( CheckAndAssignNodalValue_ErrorIfFixed< Variable<int> >( rThisModelPart, variable_name, json_nodaldata,stepindex) ) {}
-                            else if( CheckAndAssignNodalValue_ErrorIfFixed< Variable<unsigned int> >( rThisModelPart, variable_name, json_nodaldata,stepindex) ) {}
-                            else
-                            {
-                                typedef VariableComponent< VectorComponentAdaptor<array_1d<double, 3> > > component_type;
-                                if( CheckAndAssignNodalComponentValue< component_type >( rThisModelPart, variable_name, json_nodaldata,stepindex) ) {}
-                                else
-                                {
-                                    KRATOS_THROW_ERROR(std::invalid_argument, "can not read a variable type from the property block -- variable is ",variable_name);
-                                }
-                            }
-                        }
-                    }
+                //TODO: this is UGLY - there should be a better way to create a mesh
+                MeshType empty_mesh;
+                for(IndexType i = mrModelPart.GetMeshes().size() ; i < mesh_id + 1 ; i++)
+                    mrModelPart.GetMeshes().push_back(empty_mesh.Clone());
+
+                mpMesh = &mrModelPart.GetMesh(mesh_id);
+                break;
+            }
+            case NODAL_DATA:
+                mNodalValueAssigner = GetNodalValueAssigner(rName);
+                mStepIndex = 0;
+                mHasStepIndex = false;
+                mNodalDataRows.clear();
+                break;
+            default:
+                break;
             }
         }
 
+        void CreateNode()
+        {
+            KRATOS_ERROR_IF(mRow.size() != 4) << "a row of the Nodes section has " << mRow.size() << " values instead of [id, x, y, z]";
 
-        //read ElementalValues
+            const IndexType id = static_cast<IndexType>(mRow[0]);
+            typename NodeType::Pointer p_node(new NodeType(id, mRow[1], mRow[2], mRow[3]));
+            p_node->SetSolutionStepVariablesList(&mrModelPart.GetNodalSolutionStepVariablesList());
+            p_node->SetBufferSize(mrModelPart.GetBufferSize());
+            AppendEntity(mrModelPart.Nodes(), p_node);
+            mNodeLookup.clear();
+            mNodeIds.push_back(id);
 
-        //read ElementalConditions
+            mRow.clear();
+        }
 
-        KRATOS_CATCH("")
-    }
+        template<class TEntityType, class TContainerType>
+        void CreateEntity(const TEntityType& rPrototype, TContainerType& rContainer, std::vector<IndexType>& rIds)
+        {
+            KRATOS_ERROR_IF(mRow.size() < 2) << "a row of the connectivity has " << mRow.size() << " values instead of [id, property, nodes...]";
 
+            const IndexType id = static_cast<IndexType>(mRow[0]);
+            NodesArrayType nodes;
+            for(SizeType i = 2; i < mRow.size(); i++)
+                nodes.push_back(pGetNode(static_cast<IndexType>(mRow[i])));
 
+            AppendEntity(rContainer, rPrototype.Create(id, nodes, mrModelPart.pGetProperties(static_cast<IndexType>(mRow[1]))));
+            rIds.push_back(id);
 
+            mRow.clear();
+        }
 
-    //this function changes the json data structure -- completely independent from the kratos data structure
-    void EnforceConsecutiveOrdering(rapidjson::Document& d)
-    {
+        /// Entities written in ascending order of ids are appended keeping the container sorted, otherwise it is sorted at the end of the section
+        template<class TContainerType>
+        void AppendEntity(TContainerType& rContainer, const typename TContainerType::pointer& pEntity)
+        {
+            if(mIsAppendSorted && (rContainer.empty() || rContainer.back().Id() < pEntity->Id()))
+                rContainer.insert(rContainer.end(), pEntity);
+            else
+            {
+                mIsAppendSorted = false;
+                rContainer.push_back(pEntity);
+            }
+        }
 
-        if(d["model_part"].HasMember("Nodes") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection Nodes of the model_part","");
+        template<class TContainerType>
+        void EndEntities(TContainerType& rContainer)
+        {
+            if(!mIsAppendSorted)
+                rContainer.Unique();
+        }
 
-            rapidjson::Value& json_nodes = d["model_part"]["Nodes"]; // Using a reference for consecutive access is handy and faster.
-        if(json_nodes.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Nodes section is not an array as expected!!","")
+        /// The nodes are looked up by id in a contiguous copy of the ids and pointers, which avoids dereferencing the scattered nodes in the search
+        typename NodeType::Pointer pGetNode(const IndexType Id)
+        {
+            if(mNodeLookup.empty())
+            {
+                NodesContainerType& r_nodes = mrModelPart.Nodes();
+                r_nodes.Sort();
+                mNodeLookup.reserve(r_nodes.size());
+                for(typename NodesContainerType::ptr_iterator it = r_nodes.ptr_begin(); it != r_nodes.ptr_end(); ++it)
+                    mNodeLookup.push_back(std::make_pair((*it)->Id(), *it));
+            }
 
+            typename std::vector<std::pair<IndexType, typename NodeType::Pointer> >::const_iterator it = std::lower_bound(mNodeLookup.begin(), mNodeLookup.end(), Id,
+                [](const std::pair<IndexType, typename NodeType::Pointer>& rEntry, const IndexType Id) { return rEntry.first < Id; });
+            KRATOS_ERROR_IF(it == mNodeLookup.end() || it->first != Id) << "Node index not found: " << Id << ".";
+            return it->second;
+        }
 
-        ///////////////////////////////////////////////////
-        //first ensure that nodes are ordered consecutively
-        ///////////////////////////////////////////////////        //obtain the list of consecutive ids
-        std::set<std::size_t> original_ids_set; //create a list of nodes -- Create New node uses insert hence it is slow if input is not ordered
-        for (rapidjson::SizeType i = 0; i < json_nodes.Size(); i++) // rapidjson uses SizeType instead of size_t.
+        void AddToMesh(const std::string& rKind, const IndexType Id)
         {
-            std::size_t node_id = json_nodes[i][0].GetInt();
-            original_ids_set.insert( node_id ); //store in the map the position in the array
+            if(rKind == "NodePointers")
+                mpMesh->Nodes().push_back(pGetNode(Id));
+            else if(rKind == "ElementPointers")
+                mpMesh->Elements().push_back(mrModelPart.pGetElement(Id));
+            else if(rKind == "ConditionPointers")
+                mpMesh->Conditions().push_back(mrModelPart.pGetCondition(Id));
+            else
+                KRATOS_ERROR << "unknown section " << rKind << " of the mesh " << mKeys[3];
         }
 
-        //generate a map assigning to every original id a new consecutive_id
-        std::map < std::size_t, std::size_t > consecutive_nodeids_map;
-        std::size_t consecutive_id = 1;
-        for(std::set<std::size_t>::iterator it = original_ids_set.begin(); it!= original_ids_set.end(); it++)
+        void AssignPropertyValue(const std::string& rName, const double Value)
         {
-            consecutive_nodeids_map[ *it ] = consecutive_id;
-            consecutive_id++;
+            if( CheckAndAssignPropertyValue< Variable<double> >( rName, Value) ) {}
+            else if( CheckAndAssignPropertyValue< Variable<bool> >( rName, Value) ) {}
+            else if( CheckAndAssignPropertyValue< Variable<int> >( rName, Value) ) {}
+            else if( CheckAndAssignPropertyValue< Variable<unsigned int> >( rName, Value) ) {}
+            else if( CheckAndAssignPropertyValue< ComponentType >( rName, Value) ) {}
+            else
+                KRATOS_ERROR << "can not read a variable type from the property block -- variable is " << rName;
         }
 
-        ///////////////////////////////////////////////////
-        //now order consecutively elements - reuse original_ids_set since it is not needed anymore - note that it requires two loops!
-        ///////////////////////////////////////////////////
-        original_ids_set.clear();
-        if(d["model_part"].HasMember("Elements"))
+        template< class TVarType >
+        bool CheckAndAssignPropertyValue( const std::string& rName, const double Value )
         {
-            rapidjson::Value& json_elements = d["model_part"]["Elements"]; // Using a reference for consecutive access is handy and faster.
-            if(json_elements.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Elements section is not a json object as expected!!","");
-                for (rapidjson::Value::MemberIterator itr = json_elements.MemberBegin(); itr != json_elements.MemberEnd(); ++itr)
-                {
-
-                    rapidjson::Value& connectivity = itr->value["connectivity"];
-
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        rapidjson::Value& local_data = connectivity[i];
-                        std::size_t original_id = local_data[0].GetInt();
-                        original_ids_set.insert(original_id);
-                    }
-                }
+            if( KratosComponents< TVarType >::Has( rName ) )
+            {
+                const TVarType& rVar = KratosComponents< TVarType >::Get( rName );
+                mpProperties->GetValue( rVar ) = static_cast<typename TVarType::Type>(Value);
+                return true;
+            }
+            return false; //variable was not of the given type and nothing was done
         }
-        std::map < std::size_t, std::size_t > consecutive_elementids_map;
-        consecutive_id = 1;
-        for(std::set<std::size_t>::iterator it = original_ids_set.begin(); it!= original_ids_set.end(); it++)
+
+        void AssignNodalValue(const std::vector<double>& rRow, const IndexType StepIndex)
         {
-            consecutive_elementids_map[ *it ] = consecutive_id;
-            consecutive_id++;
+            KRATOS_ERROR_IF(rRow.size() != 3) << "a row of the NodalData section has " << rRow.size() << " values instead of [id, fixed, value]";
+
+            const IndexType node_id = static_cast<IndexType>(rRow[0]);
+            typename NodesContainerType::iterator itnode = mrModelPart.Nodes().find( node_id );
+            KRATOS_ERROR_IF(itnode == mrModelPart.NodesEnd()) << "node not found when assigning NodalData --> Node Id is " << node_id;
+
+            mNodalValueAssigner(*itnode, rRow[2], static_cast<bool>(rRow[1]), StepIndex);
         }
 
-        ///////////////////////////////////////////////////
-        //finally order consecutively conditions - reuse original_ids_set since it is not needed anymore - note that it requires two loops!
-        ///////////////////////////////////////////////////
-        original_ids_set.clear();
-        if(d["model_part"].HasMember("Conditions"))
+        NodalValueAssignerType GetNodalValueAssigner(const std::string& rName)
         {
-            rapidjson::Value& json_conditions = d["model_part"]["Conditions"]; // Using a reference for consecutive access is handy and faster.
-            if(json_conditions.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Conditions section is not a json object as expected!!","");
-                for (rapidjson::Value::MemberIterator itr = json_conditions.MemberBegin(); itr != json_conditions.MemberEnd(); ++itr)
-                {
+            NodalValueAssignerType assigner;
+            if( CheckNodalVariable< Variable<double> >( rName, assigner ) ) {}
+            else if( CheckNodalVariable< Variable<bool> >( rName, assigner ) ) {}
+            else if( CheckNodalVariable< Variable<int> >( rName, assigner ) ) {}
+            else if( CheckNodalVariable< Variable<unsigned int> >( rName, assigner ) ) {}
+            else if( KratosComponents< ComponentType >::Has( rName ) )
+            {
+                const ComponentType& rVar = KratosComponents< ComponentType >::Get( rName );
+                const std::string base_variable_name = rVar.GetSourceVariable().Name();
+                const Variable<array_1d<double,3> >& rVectorBaseVar = KratosComponents< Variable<array_1d<double,3> > >::Get( base_variable_name );
+                KRATOS_ERROR_IF_NOT(mrModelPart.GetNodalSolutionStepVariablesList().Has( rVectorBaseVar ))
+                    << "trying to assign a variable that is not in the model_part - variable name is " << rName;
 
-                    rapidjson::Value& connectivity = itr->value["connectivity"];
+                assigner = [&rVar](NodeType& rNode, double Value, bool IsFixed, IndexType StepIndex)
+                {
+                    rNode.GetSolutionStepValue(rVar, StepIndex) = Value;
+                    if(IsFixed) rNode.Fix(rVar);
+                };
+            }
+            else
+                KRATOS_ERROR << "can not read a variable type from the NodalData block -- variable is " << rName;
 
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        rapidjson::Value& local_data = connectivity[i];
-                        std::size_t original_id = local_data[0].GetInt();
-                        original_ids_set.insert(original_id);
-                    }
-                }
+            return assigner;
         }
-        std::map < std::size_t, std::size_t > consecutive_conditionids_map;
-        consecutive_id = 1;
-        for(std::set<std::size_t>::iterator it = original_ids_set.begin(); it!= original_ids_set.end(); it++)
+
+        template< class TVarType >
+        bool CheckNodalVariable( const std::string& rName, NodalValueAssignerType& rAssigner )
         {
-            consecutive_conditionids_map[ *it ] = consecutive_id;
-            consecutive_id++;
-        }
+            if( KratosComponents< TVarType >::Has( rName ) )
+            {
+                const TVarType& rVar = KratosComponents< TVarType >::Get( rName );
+                KRATOS_ERROR_IF_NOT(mrModelPart.GetNodalSolutionStepVariablesList().Has( rVar ))
+                    << "trying to assign a variable that is not in the model_part - variable name is " << rName;
 
+                rAssigner = [&rVar](NodeType& rNode, double Value, bool IsFixed, IndexType StepIndex)
+                {
+                    rNode.GetSolutionStepValue(rVar, StepIndex) = static_cast<typename TVarType::Type>(Value);
+                    if(IsFixed)
+                        Fix(rNode, rVar);
+                };
+                return true;
+            }
+            return false; //variable was not of the given type and nothing was done
+        }
 
-        //now modify the json data inplace for the new consecutive_nodeids_map
-        for(rapidjson::SizeType i = 0; i < json_nodes.Size(); i++) // rapidjson uses SizeType instead of size_t.
+        template< class TVarType >
+        static void Fix( NodeType& rNode, const TVarType& rVar )
         {
-            json_nodes[i][0].SetInt( consecutive_nodeids_map[ json_nodes[i][0].GetInt() ] );
+            KRATOS_ERROR << "sorry this variable is not of double or component type and can not be fixed -- variable name is " << rVar.Name();
         }
 
-        if(d["model_part"].HasMember("NodalData"))
+        static void Fix( NodeType& rNode, const Variable<double>& rVar )
         {
-            {
-                rapidjson::Value& json_nodaldata = d["model_part"]["NodalData"];
-                if(json_nodaldata.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the NodalData section is not a json object as expected!!","")
-                    for (rapidjson::Value::MemberIterator itr = json_nodaldata.MemberBegin(); itr != json_nodaldata.MemberEnd(); ++itr)
-                    {
-                        if(itr->value.HasMember("data") == false) KRATOS_THROW_ERROR(std::invalid_argument, "missing the subsection data of the NodalData subsection of model_part","");
-                        rapidjson::Value& json_nodaldata = itr->value["data"];
+            rNode.Fix(rVar);
+        }
 
-                        for(rapidjson::SizeType i = 0; i<json_nodaldata.Size(); i++)
-                        {
-                            rapidjson::Value& value = json_nodaldata[i];
+        /// Map the ids read, in their order, to 1, 2, ...
+        template<class TContainerType>
+        static void RenumberEntities(TContainerType& rContainer, std::vector<IndexType>& rIds)
+        {
+            std::sort(rIds.begin(), rIds.end());
+            rIds.erase(std::unique(rIds.begin(), rIds.end()), rIds.end());
 
-                            value[0].SetInt( consecutive_nodeids_map[ value[0].GetInt() ] );
-                        }
-                    }
+            for(typename TContainerType::iterator it = rContainer.begin(); it != rContainer.end(); ++it)
+            {
+                std::vector<IndexType>::iterator it_id = std::lower_bound(rIds.begin(), rIds.end(), it->Id());
+                if(it_id != rIds.end() && *it_id == it->Id())
+                    it->SetId(static_cast<IndexType>(it_id - rIds.begin()) + 1);
             }
         }
 
+    }; // Class ModelPartReader
 
-        //loop over node pointers
-        if(d["model_part"].HasMember("Meshes"))
-        {
-            rapidjson::Value& json_meshes = d["model_part"]["Meshes"]; // Using a reference for consecutive access is handy and faster.
-            if(json_meshes.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Meshes section is not a json object as expected!!","")
-                for (rapidjson::Value::MemberIterator itr = json_meshes.MemberBegin(); itr != json_meshes.MemberEnd(); ++itr)
-                {
-                    //get the mesh
-                    if((itr->value).HasMember("NodePointers"))
-                    {
-                        rapidjson::Value& json_nodepointers = (itr->value)["NodePointers"];
-                        if(json_nodepointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the NodePointers section is not a json array as expected!!","")
-                            for(rapidjson::SizeType i=0; i<json_nodepointers.Size(); i++) json_nodepointers[i].SetInt(  consecutive_nodeids_map[ json_nodepointers[i].GetInt()]  );
-                    }
+    ///@}
+    ///@name Protected static Member Variables
+    ///@{
 
-                    if((itr->value).HasMember("ElementPointers"))
-                    {
-                        rapidjson::Value& json_elementpointers = (itr->value)["ElementPointers"];
-                        if(json_elementpointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the ElementPointers section is not a json array as expected!!","")
-                        for(rapidjson::SizeType i=0; i<json_elementpointers.Size(); i++) json_elementpointers[i].SetInt( consecutive_elementids_map[ json_elementpointers[i].GetInt()] );
-                    }
 
-                    if((itr->value).HasMember("ConditionPointers"))
-                    {
-                        rapidjson::Value& json_conditionpointers = (itr->value)["ConditionPointers"];
-                        if(json_conditionpointers.IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the ConditionPointers section is not a json array as expected!!","")
-                        for(rapidjson::SizeType i=0; i<json_conditionpointers.Size(); i++) json_conditionpointers[i].SetInt( consecutive_elementids_map[ json_conditionpointers[i].GetInt()] );
-                    }
-                }
-        }
+    ///@}
+    ///@name Protected member Variables
+    ///@{
 
-        //loop over nodal data
+    std::string mFilename;
+    Flags mOptions;
 
 
-        //now loop over all Nodes Elements and Conditions and change the ids to the one contained in the values of nodes_id_map
-        if(d["model_part"].HasMember("Elements"))
-        {
-            rapidjson::Value& json_elements = d["model_part"]["Elements"]; // Using a reference for consecutive access is handy and faster.
-            if(json_elements.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Elements section is not a json object as expected!!","")
-                for (rapidjson::Value::MemberIterator itr = json_elements.MemberBegin(); itr != json_elements.MemberEnd(); ++itr)
-                {
+    ///@}
+    ///@name Protected Operators
+    ///@{
 
-                    rapidjson::Value& connectivity = itr->value["connectivity"];
 
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        rapidjson::Value& local_data = connectivity[i];
-                        local_data[0].SetInt( consecutive_elementids_map[ local_data[0].GetInt() ]) ; //change the id of the element
-                        unsigned int nnodes = local_data.Size()-2;
-                        for(unsigned int j=0; j<nnodes; j++) local_data[j+2].SetInt( consecutive_nodeids_map[ local_data[j+2].GetInt() ]) ;
+    ///@}
+    ///@name Protected Operations
+    ///@{
 
-                    }
-                }
+    template<class TWriterType>
+    void WriteModelPartObject(ModelPartType& rThisModelPart, TWriterType& rWriter)
+    {
+        rWriter.StartObject();
+        rWriter.Key("model_part");
+        rWriter.StartObject();
+
+        //write Nodes
+        rWriter.Key("NumberOfNodes");
+        rWriter.Uint64(rThisModelPart.NumberOfNodes());
+        rWriter.Key("Nodes");
+        rWriter.StartArray();
+        for(NodesContainerType::iterator i_node = rThisModelPart.NodesBegin(); i_node != rThisModelPart.NodesEnd(); ++i_node)
+        {
+            rWriter.StartArray();
+            rWriter.Uint64(i_node->Id());
+            rWriter.Double(i_node->X());
+            rWriter.Double(i_node->Y());
+            rWriter.Double(i_node->Z());
+            rWriter.EndArray();
         }
+        rWriter.EndArray();
 
-        //now loop over all Nodes Elements and Conditions and change the ids to the one contained in the values of nodes_id_map
-        if(d["model_part"].HasMember("Conditions"))
+        //write Properties
+        rWriter.Key("Properties");
+        rWriter.StartObject();
+        for(PropertiesContainerType::iterator i_properties = rThisModelPart.PropertiesBegin(); i_properties != rThisModelPart.PropertiesEnd(); ++i_properties)
         {
-            rapidjson::Value& json_elements = d["model_part"]["Conditions"]; // Using a reference for consecutive access is handy and faster.
-            if(json_elements.IsObject() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the Conditions section is not a json object as expected!!","")
-                for (rapidjson::Value::MemberIterator itr = json_elements.MemberBegin(); itr != json_elements.MemberEnd(); ++itr)
+            rWriter.Key(std::to_string(i_properties->Id()).c_str());
+            rWriter.StartObject();
+            rWriter.Key("Variables");
+            rWriter.StartObject();
+            for(DataValueContainer::ConstantIteratorType i_value = i_properties->Data().begin(); i_value != i_properties->Data().end(); ++i_value)
+            {
+                const std::string& name = i_value->first->Name();
+                if(KratosComponents< Variable<double> >::Has(name))
                 {
-                    std::string element_name = itr->name.GetString();
-                    if(itr->value["connectivity"].IsArray() == false) KRATOS_THROW_ERROR(std::invalid_argument, "the connectivity section of the Conditions is not an array as expected!!","");
-
-                    rapidjson::Value& connectivity = itr->value["connectivity"];
-                    for (SizeType i = 0; i < connectivity.Size(); i++)
-                    {
-                        rapidjson::Value& local_data = connectivity[i];
-                        local_data[0].SetInt( consecutive_conditionids_map[ local_data[0].GetInt() ]) ; //change the id of the condition
-                        unsigned int nnodes = local_data.Size()-2;
-                        for(unsigned int j=0; j<nnodes; j++) local_data[j+2].SetInt( consecutive_nodeids_map[ local_data[j+2].GetInt() ]) ;
-
-                    }
+                    rWriter.Key(name.c_str());
+                    rWriter.Double(*static_cast<const double*>(i_value->second));
                 }
+            }
+            rWriter.EndObject();
+            rWriter.EndObject();
         }
+        rWriter.EndObject();
 
+        //write Elements and Conditions
+        rWriter.Key("Elements");
+        WriteEntities(rThisModelPart.Elements(), rWriter);
+        rWriter.Key("Conditions");
+        WriteEntities(rThisModelPart.Conditions(), rWriter);
 
-
-    }
-
-    template< class TVarType >
-    bool CheckAndAssignNodalValue( ModelPart& r_model_part,  std::string variable_name, const rapidjson::Value& json_value, unsigned int stepindex)
-    {
-        if( KratosComponents< TVarType >::Has( variable_name ) )
+        //write Meshes, the mesh 0 is the model part itself
+        if(rThisModelPart.NumberOfMeshes() > 1)
         {
-            const TVarType& rVar = KratosComponents< TVarType >::Get( variable_name );
-            if( r_model_part.GetNodalSolutionStepVariablesList().Has( rVar ) == false )
-                KRATOS_THROW_ERROR(std::runtime_error,"trying to assign a variable that is not in the model_part - variable name is ",variable_name);
-
-            for(rapidjson::SizeType i = 0; i<json_value.Size(); i++) //loop over all the nodes with prescribed velocity
+            rWriter.Key("Meshes");
+            rWriter.StartObject();
+            for(IndexType i = 1; i < rThisModelPart.NumberOfMeshes(); i++)
             {
-                const rapidjson::Value& value = json_value[i];
-
-                unsigned int node_id = value[0].GetInt();
-                bool is_fixed = static_cast<bool>(value[1].GetInt());
-                double double_value = value[2].GetDouble();
-
-                ModelPart::NodesContainerType::iterator itnode = r_model_part.Nodes().find( node_id );
-                if(itnode == r_model_part.NodesEnd() ) KRATOS_THROW_ERROR(std::runtime_error, "node not found when assigning NodalData --> Node Id is ", node_id);
-
-                itnode->GetSolutionStepValue(rVar, stepindex) = double_value;
-                if(is_fixed) itnode->Fix(rVar);
+                MeshType& r_mesh = rThisModelPart.GetMesh(i);
+                rWriter.Key(std::to_string(i).c_str());
+                rWriter.StartObject();
+                WriteIds(r_mesh.Nodes(), "NodePointers", rWriter);
+                WriteIds(r_mesh.Elements(), "ElementPointers", rWriter);
+                WriteIds(r_mesh.Conditions(), "ConditionPointers", rWriter);
+                rWriter.EndObject();
             }
+            rWriter.EndObject();
+        }
 
-            return true;
+        //write NodalData, the current values of the double variables and of the components of the vector variables
+        rWriter.Key("NodalData");
+        rWriter.StartObject();
+        const ModelPartType::VariablesListType& r_variables = rThisModelPart.GetNodalSolutionStepVariablesList();
+        for(ModelPartType::VariablesListType::const_iterator i_variable = r_variables.begin(); i_variable != r_variables.end(); ++i_variable)
+        {
+            const std::string& name = i_variable->Name();
+            if(KratosComponents< Variable<double> >::Has(name))
+                WriteNodalData(rThisModelPart, KratosComponents< Variable<double> >::Get(name), rWriter);
+            else if(KratosComponents< Variable<array_1d<double, 3> > >::Has(name))
+            {
+                const char* components[] = {"_X", "_Y", "_Z"};
+                for(unsigned int i = 0; i < 3; i++)
+                    if(KratosComponents< ComponentType >::Has(name + components[i]))
+                        WriteNodalData(rThisModelPart, KratosComponents< ComponentType >::Get(name + components[i]), rWriter);
+            }
         }
-        return false; //variable was not of the given type and nothing was done
+        rWriter.EndObject();
+
+        rWriter.EndObject();
+        rWriter.EndObject();
     }
 
-    template< class TVarType >
-    bool CheckAndAssignNodalComponentValue( ModelPart& r_model_part,  std::string variable_name, const rapidjson::Value& json_value, unsigned int stepindex)
+    /// Write the entities grouped by their registered names, as {name: {"size": n, "connectivity": [[id, property, nodes...], ...]}}
+    template<class TContainerType, class TWriterType>
+    void WriteEntities(TContainerType& rEntities, TWriterType& rWriter)
     {
-        if( KratosComponents< TVarType >::Has( variable_name ) )
-        {
-            const TVarType& rVar = KratosComponents< TVarType >::Get( variable_name );
-
-            const std::string base_variable_name = rVar.GetSourceVariable().Name();
-            const  Variable<array_1d<double,3> >& rVectorBaseVar = KratosComponents< Variable<array_1d<double,3> > >::Get( base_variable_name );
+        typedef typename TContainerType::data_type EntityType;
 
-            if( r_model_part.GetNodalSolutionStepVariablesList().Has( rVectorBaseVar ) == false )
-                KRATOS_THROW_ERROR(std::runtime_error,"trying to assign a variable that is not in the model_part - variable name is ",variable_name);
+        std::map<std::string, std::vector<const EntityType*> > blocks;
+        std::map<std::pair<std::type_index, std::type_index>, std::string> names;
+        for(typename TContainerType::const_iterator it = rEntities.begin(); it != rEntities.end(); ++it)
+            blocks[GetRegisteredName(*it, names)].push_back(&(*it));
 
-            for(rapidjson::SizeType i = 0; i<json_value.Size(); i++) //loop over all the nodes with prescribed velocity
+        rWriter.StartObject();
+        for(typename std::map<std::string, std::vector<const EntityType*> >::const_iterator i_block = blocks.begin(); i_block != blocks.end(); ++i_block)
+        {
+            rWriter.Key(i_block->first.c_str());
+            rWriter.StartObject();
+            rWriter.Key("size");
+            rWriter.Uint64(i_block->second.size());
+            rWriter.Key("connectivity");
+            rWriter.StartArray();
+            for(SizeType i = 0; i < i_block->second.size(); i++)
             {
-                const rapidjson::Value& value = json_value[i];
-
-                unsigned int node_id = value[0].GetInt();
-                bool is_fixed = static_cast<bool>(value[1].GetInt());
-                double double_value = value[2].GetDouble();
-
-                ModelPart::NodesContainerType::iterator itnode = r_model_part.Nodes().find( node_id );
-                if(itnode == r_model_part.NodesEnd() ) KRATOS_THROW_ERROR(std::runtime_error, "node not found when assigning NodalData --> Node Id is ", node_id);
-
-                itnode->GetSolutionStepValue(rVar, stepindex) = double_value;
-                if(is_fixed) itnode->Fix(rVar);
+                const EntityType& r_entity = *(i_block->second[i]);
+                rWriter.StartArray();
+                rWriter.Uint64(r_entity.Id());
+                rWriter.Uint64(r_entity.GetProperties().Id());
+                for(SizeType j = 0; j < r_entity.GetGeometry().size(); j++)
+                    rWriter.Uint64(r_entity.GetGeometry()[j].Id());
+                rWriter.EndArray();
             }
-
-            return true;
+            rWriter.EndArray();
+            rWriter.EndObject();
         }
-        return false; //variable was not of the given type and nothing was done
+        rWriter.EndObject();
     }
 
-    template< class TVarType >
-    bool CheckAndAssignNodalValue_ErrorIfFixed( ModelPart& r_model_part,  std::string variable_name, const rapidjson::Value& json_value, unsigned int stepindex)
+    /// The name under which the type of the entity, with the type of its geometry, is registered
+    template<class TEntityType>
+    static const std::string& GetRegisteredName(const TEntityType& rEntity, std::map<std::pair<std::type_index, std::type_index>, std::string>& rNames)
     {
-        if( KratosComponents< TVarType >::Has( variable_name ) )
-        {
-            const TVarType& rVar = KratosComponents< TVarType >::Get( variable_name );
-            if( r_model_part.GetNodalSolutionStepVariablesList().Has( rVar ) == false )
-                KRATOS_THROW_ERROR(std::runtime_error,"trying to assign a variable that is not in the model_part - variable name is ",variable_name);
-
-            for(rapidjson::SizeType i = 0; i<json_value.Size(); i++) //loop over all the nodes with prescribed velocity
-            {
-                const rapidjson::Value& value = json_value[i];
+        const std::pair<std::type_index, std::type_index> key(typeid(rEntity), typeid(rEntity.GetGeometry()));
+        typename std::map<std::pair<std::type_index, std::type_index>, std::string>::const_iterator it = rNames.find(key);
+        if(it != rNames.end())
+            return it->second;
 
-                unsigned int node_id = value[0].GetInt();
-                bool is_fixed = static_cast<bool>(value[1].GetInt());
-                double double_value = value[2].GetDouble();
-
-                ModelPart::NodesContainerType::iterator itnode = r_model_part.Nodes().find( node_id );
-                if(itnode == r_model_part.NodesEnd() ) KRATOS_THROW_ERROR(std::runtime_error, "node not found when assigning NodalData --> Node Id is ", node_id);
-
-                itnode->GetSolutionStepValue(rVar, stepindex) = double_value;
-                if(is_fixed)
-                {
-                    std::string err_msg = std::string("variable name is ")+variable_name; //+std::string(" node Id is ") + std::string(itoa(node_id);
-                    KRATOS_THROW_ERROR(std::runtime_error, "sorry this variable is not of double or component type and can not be fixed -- ", err_msg);
-                }
-            }
-
-            return true;
+        for(typename KratosComponents<TEntityType>::ComponentsContainerType::const_iterator i_component = KratosComponents<TEntityType>::GetComponents().begin();
+                i_component != KratosComponents<TEntityType>::GetComponents().end(); ++i_component)
+        {
+            const TEntityType& r_prototype = *(i_component->second);
+            if(typeid(r_prototype) == typeid(rEntity) && r_prototype.pGetGeometry() != nullptr && typeid(r_prototype.GetGeometry()) == typeid(rEntity.GetGeometry()))
+                return rNames[key] = i_component->first;
         }
-        return false; //variable was not of the given type and nothing was done
+
+        KRATOS_ERROR << "the type of " << rEntity.Info() << " with its geometry is not registered, it can not be written";
     }
 
+    template<class TContainerType, class TWriterType>
+    static void WriteIds(TContainerType& rContainer, const char* pKey, TWriterType& rWriter)
+    {
+        rWriter.Key(pKey);
+        rWriter.StartArray();
+        for(typename TContainerType::const_iterator it = rContainer.begin(); it != rContainer.end(); ++it)
+            rWriter.Uint64(it->Id());
+        rWriter.EndArray();
+    }
 
-    template< class TVarType >
-    bool CheckAndAssignPropertyValue( Properties::Pointer pProperty,  std::string variable_name, const rapidjson::Value& json_value)
+    template<class TVarType, class TWriterType>
+    static void WriteNodalData(ModelPartType& rThisModelPart, const TVarType& rVar, TWriterType& rWriter)
     {
-        if( KratosComponents< TVarType >::Has( variable_name ) )
+        rWriter.Key(rVar.Name().c_str());
+        rWriter.StartObject();
+        rWriter.Key("stepindex");
+        rWriter.Uint(0);
+        rWriter.Key("data");
+        rWriter.StartArray();
+        for(NodesContainerType::iterator i_node = rThisModelPart.NodesBegin(); i_node != rThisModelPart.NodesEnd(); ++i_node)
         {
-            const TVarType& rVar = KratosComponents< TVarType >::Get( variable_name );
-            pProperty->GetValue( rVar ) = json_value.GetDouble();
-            return true;
+            rWriter.StartArray();
+            rWriter.Uint64(i_node->Id());
+            rWriter.Int(i_node->IsFixed(rVar) ? 1 : 0);
+            rWriter.Double(i_node->FastGetSolutionStepValue(rVar));
+            rWriter.EndArray();
         }
-        return false; //variable was not of the given type and nothing was done
+        rWriter.EndArray();
+        rWriter.EndObject();
     }
 
+    ///@}
+    ///@name Protected  Access
+    ///@{
+
 
     ///@}
-    ///@name Private  Access
+    ///@name Protected Inquiry
     ///@{
 
 
     ///@}
-    ///@name Private Inquiry
+    ///@name Protected LifeCycle
     ///@{
 
 
@@ -17,8 +17,11 @@
 // System includes
 #include <string>
 #include <iostream>
-#include <map>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
 #include <typeinfo>
+#include <atomic>
 
 // External includes
 
@@ -40,6 +43,8 @@ namespace Kratos
  * to each component and also there is a flexibility to give different names to different
  * states of an object and create them via different prototypes.
  * For example having TriangularThermal and  both
+ * The table is a hash map, so a lookup by name does not compare the name against the names along a tree path.
+ * Callers looking up the same component repeatedly should resolve it once, with pFind or a ComponentHandle.
  * @ingroup KratosCore
  * @author Pooyan Dadvand
  * @tparam TComponentType The type of components to be stored in this table.
@@ -55,7 +60,7 @@ public:
     /// Pointer definition of KratosComponents
     KRATOS_CLASS_POINTER_DEFINITION(KratosComponents);
 
-    typedef std::map<std::string, const TComponentType* > ComponentsContainerType;
+    typedef std::unordered_map<std::string, const TComponentType* > ComponentsContainerType;
     typedef typename ComponentsContainerType::value_type ValueType;
 
     ///@}
@@ -118,6 +123,18 @@ public:
         return *(it_comp->second);
     }
 
+    /**
+     * @brief Looks up a component with the specified name, in a single lookup.
+     * @details This replaces the pair Has(rName) and Get(rName) when the name may not be registered.
+     * @param rName The name of the component to retrieve.
+     * @return A pointer to the component, or nullptr if no component is registered with this name.
+     */
+    static const TComponentType* pFind(const std::string& rName)
+    {
+        typename ComponentsContainerType::const_iterator it_comp = msComponents.find(rName);
+        return (it_comp == msComponents.end()) ? nullptr : it_comp->second;
+    }
+
     /**
      * @brief Registers the function.
      */
@@ -181,8 +198,14 @@ public:
     /// Print object's data.
     virtual void PrintData(std::ostream& rOStream) const
     {
+        std::vector<std::string> names;
+        names.reserve(msComponents.size());
         for(typename ComponentsContainerType::const_iterator i = msComponents.begin() ; i != msComponents.end() ; ++i)
-            rOStream << "    " << i->first << std::endl;
+            names.push_back(i->first);
+        std::sort(names.begin(), names.end());
+
+        for(std::size_t i = 0; i < names.size(); ++i)
+            rOStream << "    " << names[i] << std::endl;
     }
 
     ///@}
@@ -257,7 +280,7 @@ public:
     /// Pointer definition of KratosComponents
     KRATOS_CLASS_POINTER_DEFINITION(KratosComponents);
 
-    typedef std::map<std::string, VariableData*> ComponentsContainerType;
+    typedef std::unordered_map<std::string, VariableData*> ComponentsContainerType;
     typedef ComponentsContainerType::value_type ValueType;
 
     ///@}
@@ -336,6 +359,17 @@ public:
         return it_comp->second;
     }
 
+    /**
+     * @brief Looks up the variable data with the specified name, in a single lookup.
+     * @param rName the name of the variable
+     * @return a pointer to the variable data, or nullptr if no variable is registered with this name
+     */
+    static VariableData* pFind(const std::string& rName)
+    {
+        ComponentsContainerType::const_iterator it_comp = msComponents.find(rName);
+        return (it_comp == msComponents.end()) ? nullptr : it_comp->second;
+    }
+
     /**
      * @brief Registers the function.
      */
@@ -399,8 +433,15 @@ public:
     /// Print object's data.
     virtual void PrintData(std::ostream& rOStream) const
     {
+        std::vector<ComponentsContainerType::const_iterator> components;
+        components.reserve(msComponents.size());
         for(ComponentsContainerType::const_iterator i = msComponents.begin() ; i != msComponents.end() ; ++i)
-            rOStream << "    " << *(i->second) << std::endl;
+            components.push_back(i);
+        std::sort(components.begin(), components.end(),
+            [](ComponentsContainerType::const_iterator i, ComponentsContainerType::const_iterator j) { return i->first < j->first; });
+
+        for(std::size_t i = 0; i < components.size(); ++i)
+            rOStream << "    " << *(components[i]->second) << std::endl;
     }
 
     ///@}
@@ -468,6 +509,96 @@ template<class TComponentType>
 typename KratosComponents<TComponentType>::ComponentsContainerType KratosComponents<TComponentType>::msComponents;
 #endif
 
+/**
+ * @class ComponentHandle
+ * @brief A component of KratosComponents looked up by name once and reused.
+ * @details The name is resolved at the first access, so a handle can be declared (e.g. as a static
+ * or a member) before the component is registered. Use it in place of KratosComponents::Get
+ * inside loops or in functions called repeatedly with the same name. The resolved component is kept in an
+ * atomic pointer, so a handle can be shared by threads; two threads may both look the name up the first time,
+ * but they store the same pointer.
+ * @tparam TComponentType The type of the component.
+ */
+template<class TComponentType>
+class ComponentHandle
+{
+public:
+
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor with the name of the component.
+    explicit ComponentHandle(const std::string& rName) : mName(rName), mpComponent(nullptr) {}
+
+    /// Copy constructor.
+    ComponentHandle(const ComponentHandle& rOther) : mName(rOther.mName), mpComponent(rOther.mpComponent.load(std::memory_order_acquire)) {}
+
+    /// Assignment operator.
+    ComponentHandle& operator=(const ComponentHandle& rOther)
+    {
+        mName = rOther.mName;
+        mpComponent.store(rOther.mpComponent.load(std::memory_order_acquire), std::memory_order_release);
+        return *this;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    /// The component, an error is thrown if it is not registered.
+    const TComponentType& Get() const
+    {
+        const TComponentType* p_component = mpComponent.load(std::memory_order_acquire);
+        if (p_component == nullptr)
+        {
+            p_component = &KratosComponents<TComponentType>::Get(mName);
+            mpComponent.store(p_component, std::memory_order_release);
+        }
+        return *p_component;
+    }
+
+    /// The component, or nullptr if it is not registered.
+    const TComponentType* pGet() const
+    {
+        const TComponentType* p_component = mpComponent.load(std::memory_order_acquire);
+        if (p_component == nullptr)
+        {
+            p_component = KratosComponents<TComponentType>::pFind(mName);
+            if (p_component != nullptr)
+                mpComponent.store(p_component, std::memory_order_release);
+        }
+        return p_component;
+    }
+
+    const std::string& Name() const
+    {
+        return mName;
+    }
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+    bool IsRegistered() const
+    {
+        return pGet() != nullptr;
+    }
+
+    ///@}
+
+private:
+
+    ///@name Member Variables
+    ///@{
+
+    std::string mName;
+
+    mutable std::atomic<const TComponentType*> mpComponent;
+
+    ///@}
+
+}; // Class ComponentHandle
+
 ///@name Input and output
 ///@{
 
@@ -15,6 +15,14 @@
 
 // System includes
 #include <stdio.h>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <complex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
 
 
 // External includes
@@ -29,14 +37,281 @@ extern "C"
 
 
 // Project includes
+#include "utilities/openmp_utils.h"
 
 namespace Kratos
 {
 
+namespace MatrixMarketInternals
+{
+
+/// The conversions between the values of the matrices and vectors and the reals of the files
+template<typename TDataType> struct ValueTraits
+{
+    static constexpr bool IsComplex = false;
+
+    static TDataType FromReals(const double* pReals, const int NumberOfReals)
+    {
+        return (NumberOfReals == 0) ? 1.00 : pReals[0];
+    }
+
+    static void ToReals(const TDataType& rValue, double* pReals)
+    {
+        pReals[0] = rValue;
+    }
+
+    static TDataType Conjugate(const TDataType& rValue)
+    {
+        return rValue;
+    }
+};
+
+template<typename TDataType> struct ValueTraits<std::complex<TDataType> >
+{
+    static constexpr bool IsComplex = true;
+
+    static std::complex<TDataType> FromReals(const double* pReals, const int NumberOfReals)
+    {
+        if (NumberOfReals == 0)
+            return std::complex<TDataType>(1.00, 0.00);
+        return std::complex<TDataType>(pReals[0], (NumberOfReals == 2) ? pReals[1] : 0.00);
+    }
+
+    static void ToReals(const std::complex<TDataType>& rValue, double* pReals)
+    {
+        pReals[0] = rValue.real();
+        pReals[1] = rValue.imag();
+    }
+
+    static std::complex<TDataType> Conjugate(const std::complex<TDataType>& rValue)
+    {
+        return std::conj(rValue);
+    }
+};
+
+/// Read the rest of the file in memory
+inline bool ReadRemaining(FILE* f, std::vector<char>& rBuffer)
+{
+    const long begin = ftell(f);
+    if (begin < 0 || fseek(f, 0, SEEK_END) != 0)
+        return false;
+    const long end = ftell(f);
+    if (end < begin || fseek(f, begin, SEEK_SET) != 0)
+        return false;
+
+    rBuffer.resize(end - begin);
+    return fread(rBuffer.data(), 1, rBuffer.size(), f) == rBuffer.size();
+}
+
+inline void SkipBlanks(const char*& p, const char* pEnd)
+{
+    while (p < pEnd && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+}
+
+template<typename TDataType> inline bool ParseNumber(const char*& p, const char* pEnd, TDataType& rValue)
+{
+    SkipBlanks(p, pEnd);
+    if (p < pEnd && *p == '+')
+        ++p;
+    const std::from_chars_result result = std::from_chars(p, pEnd, rValue);
+    if (result.ec != std::errc())
+        return false;
+    p = result.ptr;
+    return true;
+}
+
+/// A data line is neither empty nor a comment
+inline bool IsDataLine(const char* p, const char* pLineEnd)
+{
+    SkipBlanks(p, pLineEnd);
+    return (p < pLineEnd) && (*p != '%');
+}
+
+inline const char* LineEnd(const char* p, const char* pEnd)
+{
+    const char* line_end = static_cast<const char*>(memchr(p, '\n', pEnd - p));
+    return (line_end == NULL) ? pEnd : line_end;
+}
+
+/**
+ * Parse the first NumberOfLines data lines of the buffer in parallel. The buffer is cut in chunks at line
+ * boundaries, the data lines of each chunk are counted to find their positions, then they are parsed by
+ * rParser(pLineBegin, pLineEnd, Position), which returns false on invalid data.
+ */
+template<class TLineParserType>
+inline bool ParseDataLines(const std::vector<char>& rBuffer, const std::size_t NumberOfLines, TLineParserType& rParser)
+{
+    const char* begin = rBuffer.data();
+    const char* end = begin + rBuffer.size();
+
+    const int number_of_chunks = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(4 * OpenMPUtils::GetNumThreads(), rBuffer.size() >> 16)));
+    std::vector<const char*> bounds(number_of_chunks + 1, end);
+    bounds[0] = begin;
+    for (int k = 1; k < number_of_chunks; ++k)
+    {
+        const char* p = std::max(begin + (rBuffer.size() * k) / number_of_chunks, bounds[k - 1]);
+        p = LineEnd(p, end);
+        bounds[k] = (p < end) ? p + 1 : end;
+    }
+
+    std::vector<std::size_t> offsets(number_of_chunks + 1, 0);
+
+    #pragma omp parallel for
+    for (int k = 0; k < number_of_chunks; ++k)
+    {
+        std::size_t count = 0;
+        for (const char* p = bounds[k]; p < bounds[k + 1]; )
+        {
+            const char* line_end = LineEnd(p, bounds[k + 1]);
+            if (IsDataLine(p, line_end))
+                ++count;
+            p = line_end + 1;
+        }
+        offsets[k + 1] = count;
+    }
+
+    for (int k = 0; k < number_of_chunks; ++k)
+        offsets[k + 1] += offsets[k];
+
+    if (offsets[number_of_chunks] < NumberOfLines)
+        return false;
+
+    int valid = 1;
+
+    #pragma omp parallel for reduction(&&:valid)
+    for (int k = 0; k < number_of_chunks; ++k)
+    {
+        std::size_t position = offsets[k];
+        for (const char* p = bounds[k]; p < bounds[k + 1] && position < NumberOfLines; )
+        {
+            const char* line_end = LineEnd(p, bounds[k + 1]);
+            if (IsDataLine(p, line_end))
+            {
+                if (!rParser(p, line_end, position))
+                    valid = 0;
+                ++position;
+            }
+            p = line_end + 1;
+        }
+    }
+
+    return valid != 0;
+}
+
+inline char* FormatIndex(char* p, const std::size_t Index)
+{
+    return std::to_chars(p, p + 24, Index).ptr;
+}
+
+/// The same as "%22.16e"
+inline char* FormatReal(char* p, const double Value)
+{
+    char* value_end = std::to_chars(p, p + 32, Value, std::chars_format::scientific, 16).ptr;
+    const std::ptrdiff_t length = value_end - p;
+    if (length >= 22)
+        return value_end;
+    memmove(p + 22 - length, p, length);
+    memset(p, ' ', 22 - length);
+    return p + 22;
+}
+
+/**
+ * Write the blocks formatted by rFormatter(Block, rBuffer). The blocks are formatted in parallel by groups
+ * of one block per thread and the group is written in order.
+ */
+template<class TFormatterType>
+inline bool WriteBlocks(FILE* f, const std::size_t NumberOfBlocks, TFormatterType& rFormatter)
+{
+    const int number_of_threads = OpenMPUtils::GetNumThreads();
+    std::vector<std::string> buffers(number_of_threads);
+
+    for (std::size_t first = 0; first < NumberOfBlocks; first += number_of_threads)
+    {
+        const int number_of_blocks = static_cast<int>(std::min<std::size_t>(number_of_threads, NumberOfBlocks - first));
+
+        #pragma omp parallel for
+        for (int k = 0; k < number_of_blocks; ++k)
+            rFormatter(first + k, buffers[k]);
+
+        for (int k = 0; k < number_of_blocks; ++k)
+            if (fwrite(buffers[k].data(), 1, buffers[k].size(), f) != buffers[k].size())
+                return false;
+    }
+
+    return true;
+}
+
+/// The bounds of the rows of a compressed matrix, also when its last rows are not completed
+template<typename CompressedMatrixType> inline void GetRowPointers(const CompressedMatrixType& M, std::vector<std::size_t>& rRowPointers)
+{
+    const std::size_t filled1 = M.filled1();
+    const std::size_t filled2 = M.filled2();
+
+    rRowPointers.resize(M.size1() + 1);
+    for (std::size_t i = 0; i <= M.size1(); ++i)
+        rRowPointers[i] = (i < filled1) ? M.index1_data()[i] : filled2;
+}
+
+/// The binary header: a magic string and the version, the sizes of the index and the scalar, if the values are complex, and the sizes
+struct BinaryHeader
+{
+    char Magic[8];
+    std::uint64_t Version;
+    std::uint64_t IndexSize;
+    std::uint64_t ScalarSize;
+    std::uint64_t IsComplex;
+    std::uint64_t Size1;
+    std::uint64_t Size2;
+    std::uint64_t NonZeros;
+};
+
+const std::uint64_t BinaryVersion = 1;
+
+template<typename TDataType> inline void InitializeBinaryHeader(BinaryHeader& rHeader, const char* pMagic, const std::size_t IndexSize)
+{
+    memset(&rHeader, 0, sizeof(BinaryHeader));
+    memcpy(rHeader.Magic, pMagic, 8);
+    rHeader.Version = BinaryVersion;
+    rHeader.IndexSize = IndexSize;
+    rHeader.ScalarSize = ValueTraits<TDataType>::IsComplex ? sizeof(TDataType) / 2 : sizeof(TDataType);
+    rHeader.IsComplex = ValueTraits<TDataType>::IsComplex ? 1 : 0;
+}
+
+/// Check that the binary header is compatible with the expected one, except for the sizes
+inline bool CheckBinaryHeader(const BinaryHeader& rHeader, const BinaryHeader& rExpected, const char* pFunctionName)
+{
+    if (memcmp(rHeader.Magic, rExpected.Magic, 8) != 0 || rHeader.Version != rExpected.Version)
+    {
+        printf("%s(): invalid binary header.\n", pFunctionName);
+        return false;
+    }
+
+    if (rHeader.IndexSize != rExpected.IndexSize || rHeader.ScalarSize != rExpected.ScalarSize || rHeader.IsComplex != rExpected.IsComplex)
+    {
+        printf("%s(): the file has %d bytes indices and %d bytes %s values, %d bytes indices and %d bytes %s values are expected.\n", pFunctionName,
+               static_cast<int>(rHeader.IndexSize), static_cast<int>(rHeader.ScalarSize), rHeader.IsComplex ? "complex" : "real",
+               static_cast<int>(rExpected.IndexSize), static_cast<int>(rExpected.ScalarSize), rExpected.IsComplex ? "complex" : "real");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace MatrixMarketInternals
+
 // Matrix I/O routines
 
+/**
+ * Read a sparse matrix in the Matrix Market coordinate format. The real, integer, pattern and, for complex
+ * matrices, complex files are supported, as general, symmetric, skew-symmetric or hermitian. The entries are
+ * parsed in parallel and the matrix is built directly in compressed form; duplicated entries keep the last value.
+ */
 template <typename CompressedMatrixType> inline bool ReadMatrixMarketMatrix(const char* FileName, CompressedMatrixType& M)
 {
+    typedef typename CompressedMatrixType::value_type ValueType;
+    typedef MatrixMarketInternals::ValueTraits<ValueType> TraitsType;
+
     // Open MM file for reading
     FILE *f = fopen(FileName, "r");
 
@@ -64,7 +339,7 @@ template <typename CompressedMatrixType> inline bool ReadMatrixMarketMatrix(cons
     }
 
     // Check for supported types of MM file
-    if (!((mm_is_real(mm_code) || mm_is_integer(mm_code) || mm_is_pattern(mm_code)) && mm_is_coordinate(mm_code) && mm_is_sparse(mm_code)))
+    if (!((mm_is_real(mm_code) || mm_is_integer(mm_code) || mm_is_pattern(mm_code) || (mm_is_complex(mm_code) && TraitsType::IsComplex)) && mm_is_coordinate(mm_code) && mm_is_sparse(mm_code)))
     {
         printf("ReadMatrixMarketMatrix(): invalid MatrixMarket type, \"%s\".\n",  mm_typecode_to_str(mm_code));
         fclose(f);
@@ -81,173 +356,163 @@ template <typename CompressedMatrixType> inline bool ReadMatrixMarketMatrix(cons
         return false;
     }
 
-    // Allocate temporary arrays
-    int *I = new int[nnz];
-    int *J = new int[nnz];
-    double *V = new double[nnz];
-
-    // Read MM file
+    // Read the entries
+    std::vector<char> buffer;
+    const bool read = MatrixMarketInternals::ReadRemaining(f, buffer);
+    fclose(f);
 
-    // Pattern file, only non-zero structure
-    if (mm_is_pattern(mm_code))
-        for (int i = 0; i < nnz; i++)
-        {
-            if (fscanf(f, "%d %d", &I[i], &J[i]) != 2)
-            {
-                printf("ReadMatrixMarketMatrix(): invalid data.\n");
-                fclose(f);
+    if (!read)
+    {
+        printf("ReadMatrixMarketMatrix(): unable to read data.\n");
+        return false;
+    }
 
-                delete[] I;
-                delete[] J;
-                delete[] V;
+    const int number_of_reals = mm_is_pattern(mm_code) ? 0 : (mm_is_complex(mm_code) ? 2 : 1);
+    std::vector<int> I(nnz), J(nnz);
+    std::vector<ValueType> V(nnz);
 
+    auto parse_entry = [&](const char* p, const char* pLineEnd, const std::size_t Position) -> bool
+    {
+        double reals[2] = {0.00, 0.00};
+        if (!MatrixMarketInternals::ParseNumber(p, pLineEnd, I[Position]) || !MatrixMarketInternals::ParseNumber(p, pLineEnd, J[Position]))
+            return false;
+        for (int k = 0; k < number_of_reals; ++k)
+            if (!MatrixMarketInternals::ParseNumber(p, pLineEnd, reals[k]))
                 return false;
-            }
-
-            // Adjust to 0-based
-            I[i]--;
-            J[i]--;
 
-            // Set all values to 1.00
-            V[i] = 1.00;
-        }
-    else
-        for (int i = 0; i < nnz; i++)
-        {
-            if (fscanf(f, "%d %d %lg", &I[i], &J[i], &V[i]) != 3)
-            {
-                printf("ReadMatrixMarketMatrix(): invalid data.\n");
-                fclose(f);
+        // Adjust to 0-based
+        if (--I[Position] < 0 || I[Position] >= size1 || --J[Position] < 0 || J[Position] >= size2)
+            return false;
 
-                delete[] I;
-                delete[] J;
-                delete[] V;
+        V[Position] = TraitsType::FromReals(reals, number_of_reals);
+        return true;
+    };
 
-                return false;
-            }
-
-            // Adjust to 0-based
-            I[i]--;
-            J[i]--;
-        }
+    if (!MatrixMarketInternals::ParseDataLines(buffer, nnz, parse_entry))
+    {
+        printf("ReadMatrixMarketMatrix(): invalid data.\n");
+        return false;
+    }
+    std::vector<char>().swap(buffer);
 
-    fclose(f);
+    // The entries of the other triangle
+    const bool mirrored = !mm_is_general(mm_code);
+    const double mirror_sign = mm_is_skew(mm_code) ? -1.00 : 1.00;
+    const bool mirror_conjugate = mm_is_hermitian(mm_code);
 
-    // Second stage
-    int *nz = new int[size1];
+    // Count non-zeros on each line
+    std::vector<std::size_t> row_pointers(size1 + 1, 0);
+    for (int i = 0; i < nnz; i++)
+    {
+        row_pointers[I[i] + 1]++;
+        if (mirrored && I[i] != J[i])
+            row_pointers[J[i] + 1]++;
+    }
 
     for (int i = 0; i < size1; i++)
-        nz[i] = 0;
+        row_pointers[i + 1] += row_pointers[i];
 
-    // Count non-zeros on each line
-    if (mm_is_symmetric(mm_code))
+    // Fill in the rows in the order of the file
+    std::vector<std::size_t> columns(row_pointers[size1]);
+    std::vector<ValueType> values(row_pointers[size1]);
+    {
+        std::vector<std::size_t> filled(row_pointers.begin(), row_pointers.end() - 1);
         for (int i = 0; i < nnz; i++)
         {
-            if (I[i] == J[i])
-                nz[I[i]]++;
-            else
+            std::size_t index = filled[I[i]]++;
+            columns[index] = J[i];
+            values[index] = V[i];
+
+            if (mirrored && I[i] != J[i])
             {
-                nz[I[i]]++;
-                nz[J[i]]++;
+                index = filled[J[i]]++;
+                columns[index] = I[i];
+                values[index] = mirror_sign * (mirror_conjugate ? TraitsType::Conjugate(V[i]) : V[i]);
             }
         }
-    else
-        for (int i = 0; i < nnz; i++)
-            nz[I[i]]++;
+    }
+    std::vector<int>().swap(I);
+    std::vector<int>().swap(J);
+    std::vector<ValueType>().swap(V);
 
-    // Find out total number of non-zeros
-    int nnz2;
+    // Sort the rows by column, the last of the duplicated entries is kept
+    std::vector<std::size_t> row_sizes(size1);
 
-    if (mm_is_symmetric(mm_code))
+    #pragma omp parallel
     {
-        int diagonals = 0;
-
-        for (int i = 0; i < nnz; i++)
-            if (I[i] == J[i])
-                diagonals++;
-
-        nnz2 = diagonals + 2 * (nnz - diagonals);
-    }
-    else
-        nnz2 = nnz;
-
-    // Fill in an almost-CSR data structure
-    int *filled = new int[size1];
-    int *indices = new int[size1];
-    int *columns = new int[nnz2];
-    double *values = new double[nnz2];
+        std::vector<std::pair<std::size_t, std::size_t> > order;
 
-    indices[0] = 0;
-    for (int i = 1; i < size1; i++)
-        indices[i] = indices[i - 1] + nz[i - 1];
+        #pragma omp for
+        for (int i = 0; i < size1; i++)
+        {
+            const std::size_t row_begin = row_pointers[i];
+            const std::size_t row_end = row_pointers[i + 1];
 
-    for (int i = 0; i < size1; i++)
-        filled[i] = 0;
+            bool sorted = true;
+            for (std::size_t k = row_begin + 1; k < row_end && sorted; k++)
+                sorted = columns[k - 1] < columns[k];
 
-    if (mm_is_symmetric(mm_code))
-        for (int i = 0; i < nnz; i++)
-            if (I[i] == J[i])
+            if (!sorted)
             {
-                int index;
-
-                index = indices[I[i]] + filled[I[i]];
-                columns[index] = J[i];
-                values[index] = V[i];
-                filled[I[i]]++;
+                order.clear();
+                for (std::size_t k = row_begin; k < row_end; k++)
+                    order.push_back(std::make_pair(columns[k], k));
+                std::sort(order.begin(), order.end());
+
+                std::vector<ValueType> row_values;
+                row_values.reserve(order.size());
+                std::size_t size = 0;
+                for (std::size_t k = 0; k < order.size(); k++)
+                {
+                    if (k + 1 < order.size() && order[k + 1].first == order[k].first)
+                        continue;
+                    columns[row_begin + size++] = order[k].first;
+                    row_values.push_back(values[order[k].second]);
+                }
+                std::copy(row_values.begin(), row_values.end(), values.begin() + row_begin);
+                row_sizes[i] = size;
             }
             else
-            {
-                int index;
-
-                index = indices[I[i]] + filled[I[i]];
-                columns[index] = J[i];
-                values[index] = V[i];
-                filled[I[i]]++;
-
-                index = indices[J[i]] + filled[J[i]];
-                columns[index] = I[i];
-                values[index] = V[i];
-                filled[J[i]]++;
-            }
-    else
-        for (int i = 0; i < nnz; i++)
-        {
-            int index;
-
-            index = indices[I[i]] + filled[I[i]];
-            columns[index] = J[i];
-            values[index] = V[i];
-            filled[I[i]]++;
+                row_sizes[i] = row_end - row_begin;
         }
+    }
+
+    std::size_t nnz2 = 0;
+    for (int i = 0; i < size1; i++)
+        nnz2 += row_sizes[i];
 
     // Create the matrix
-    CompressedMatrixType *m = new CompressedMatrixType(size1, size2, nnz2);
+    M = CompressedMatrixType(size1, size2, nnz2);
 
-    int k = 0;
+    auto* m_row_pointers = M.index1_data().begin();
+    auto* m_columns = M.index2_data().begin();
+    auto* m_values = M.value_data().begin();
 
+    m_row_pointers[0] = 0;
     for (int i = 0; i < size1; i++)
-        for (int j = 0; j < nz[i]; j++)
-            (*m)(i, columns[indices[i] + j]) = values[k++];
-
-    M = *m;
-
-    delete[] I;
-    delete[] J;
-    delete[] V;
+        m_row_pointers[i + 1] = m_row_pointers[i] + row_sizes[i];
 
-    delete[] filled;
-    delete[] indices;
-    delete[] columns;
-    delete[] values;
-    delete[] nz;
+    #pragma omp parallel for
+    for (int i = 0; i < size1; i++)
+    {
+        std::copy(columns.begin() + row_pointers[i], columns.begin() + row_pointers[i] + row_sizes[i], m_columns + m_row_pointers[i]);
+        std::copy(values.begin() + row_pointers[i], values.begin() + row_pointers[i] + row_sizes[i], m_values + m_row_pointers[i]);
+    }
 
-    delete m;
+    M.set_filled(size1 + 1, nnz2);
 
     return true;
 }
 
+/**
+ * Write a sparse matrix in the Matrix Market coordinate format, real or complex. If Symmetric, only the lower
+ * triangle is written. The rows are formatted in parallel by blocks.
+ */
 template <typename CompressedMatrixType> inline bool WriteMatrixMarketMatrix(const char* FileName, const CompressedMatrixType& M, const bool Symmetric)
 {
+    typedef typename CompressedMatrixType::value_type ValueType;
+    typedef MatrixMarketInternals::ValueTraits<ValueType> TraitsType;
+
     // Open MM file for writing
     FILE *f = fopen(FileName, "w");
 
@@ -264,7 +529,10 @@ template <typename CompressedMatrixType> inline bool WriteMatrixMarketMatrix(con
 
     mm_set_matrix(&mm_code);
     mm_set_coordinate(&mm_code);
-    mm_set_real(&mm_code);
+    if (TraitsType::IsComplex)
+        mm_set_complex(&mm_code);
+    else
+        mm_set_real(&mm_code);
 
     if (Symmetric)
         mm_set_symmetric(&mm_code);
@@ -273,90 +541,167 @@ template <typename CompressedMatrixType> inline bool WriteMatrixMarketMatrix(con
 
     mm_write_banner(f, mm_code);
 
+    std::vector<std::size_t> row_pointers;
+    MatrixMarketInternals::GetRowPointers(M, row_pointers);
+    const auto* columns = M.index2_data().begin();
+    const auto* values = M.value_data().begin();
+    const int size1 = static_cast<int>(M.size1());
+
     // Find out the actual number of non-zeros in case of a symmetric matrix
-    int nnz;
+    std::size_t nnz = row_pointers[size1];
 
     if (Symmetric)
     {
         nnz = 0;
 
-        auto a_iterator = M.begin1();
-
-        for (unsigned int i = 0; i < M.size1(); i++)
-        {
-#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
-            for (auto row_iterator = a_iterator.begin(); row_iterator != a_iterator.end(); ++row_iterator)
-#else
-            for (auto row_iterator = begin(a_iterator, iterator1_tag()); row_iterator != end(a_iterator, iterator1_tag()); ++row_iterator)
-#endif
-            {
-                if (a_iterator.index1() >= row_iterator.index2())
+        #pragma omp parallel for reduction(+:nnz)
+        for (int i = 0; i < size1; i++)
+            for (std::size_t k = row_pointers[i]; k < row_pointers[i + 1]; k++)
+                if (static_cast<std::size_t>(i) >= columns[k])
                     nnz++;
-            }
-
-            a_iterator++;
-        }
     }
-    else
-        nnz = M.nnz();
 
     // Write MM file sizes
     mm_write_mtx_crd_size(f, M.size1(), M.size2(), nnz);
 
-    if (Symmetric)
+    // The blocks of rows, of about the same number of non-zeros
+    const std::size_t block_size = 1 << 16;
+    std::vector<std::size_t> blocks(1, 0);
+    for (int i = 0; i < size1; i++)
+        if (row_pointers[i + 1] - row_pointers[blocks.back()] >= block_size)
+            blocks.push_back(i + 1);
+    if (blocks.back() != static_cast<std::size_t>(size1))
+        blocks.push_back(size1);
+
+    auto format_rows = [&](const std::size_t Block, std::string& rBuffer)
     {
-        auto a_iterator = M.begin1();
+        const std::size_t first_row = blocks[Block];
+        const std::size_t last_row = blocks[Block + 1];
+        rBuffer.resize((row_pointers[last_row] - row_pointers[first_row]) * 96);
 
-        for (unsigned int i = 0; i < M.size1(); i++)
-        {
-#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
-            for (auto row_iterator = a_iterator.begin(); row_iterator != a_iterator.end(); ++row_iterator)
-#else
-            for (auto row_iterator = begin(a_iterator, iterator1_tag()); row_iterator != end(a_iterator, iterator1_tag()); ++row_iterator)
-#endif
+        char* p = &rBuffer[0];
+        for (std::size_t i = first_row; i < last_row; i++)
+            for (std::size_t k = row_pointers[i]; k < row_pointers[i + 1]; k++)
             {
-                int I = a_iterator.index1(), J = row_iterator.index2();
-
-                if (I >= J)
-                    if (fprintf(f, "%d %d %22.16e\n", I + 1, J + 1, *row_iterator) < 0)
-                    {
-                        printf("WriteMatrixMarketMatrix(): unable to write data.\n");
-                        fclose(f);
-                        return false;
-                    }
+                const std::size_t j = columns[k];
+                if (Symmetric && i < j)
+                    continue;
+
+                double reals[2];
+                TraitsType::ToReals(values[k], reals);
+
+                p = MatrixMarketInternals::FormatIndex(p, i + 1);
+                *p++ = ' ';
+                p = MatrixMarketInternals::FormatIndex(p, j + 1);
+                *p++ = ' ';
+                p = MatrixMarketInternals::FormatReal(p, reals[0]);
+                if (TraitsType::IsComplex)
+                {
+                    *p++ = ' ';
+                    p = MatrixMarketInternals::FormatReal(p, reals[1]);
+                }
+                *p++ = '\n';
             }
 
-            a_iterator++;
-        }
+        rBuffer.resize(p - rBuffer.data());
+    };
+
+    if (!MatrixMarketInternals::WriteBlocks(f, blocks.size() - 1, format_rows))
+    {
+        printf("WriteMatrixMarketMatrix(): unable to write data.\n");
+        fclose(f);
+        return false;
     }
-    else
+
+    fclose(f);
+
+    return true;
+}
+
+/**
+ * Read a sparse matrix written by WriteBinaryMatrix. The file must have the index and value types of the matrix.
+ */
+template <typename CompressedMatrixType> inline bool ReadBinaryMatrix(const char* FileName, CompressedMatrixType& M)
+{
+    typedef typename CompressedMatrixType::value_type ValueType;
+
+    FILE *f = fopen(FileName, "rb");
+
+    if (f == NULL)
     {
-        auto a_iterator = M.begin1();
+        printf("ReadBinaryMatrix(): unable to open %s.\n", FileName);
+        return false;
+    }
 
-        for (unsigned int i = 0; i < M.size1(); i++)
-        {
-#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
-            for (auto row_iterator = a_iterator.begin(); row_iterator != a_iterator.end(); ++row_iterator)
-#else
-            for (auto row_iterator = begin(a_iterator, iterator1_tag()); row_iterator != end(a_iterator, iterator1_tag()); ++row_iterator)
-#endif
-            {
-                int I = a_iterator.index1(), J = row_iterator.index2();
+    MatrixMarketInternals::BinaryHeader header, expected;
+    MatrixMarketInternals::InitializeBinaryHeader<ValueType>(expected, "KRBCSRMT", sizeof(*M.index1_data().begin()));
 
-                if (fprintf(f, "%d %d %22.16e\n", I + 1, J + 1, *row_iterator) < 0)
-                {
-                    printf("WriteMatrixMarketMatrix(): unable to write data.\n");
-                    fclose(f);
-                    return false;
-                }
-            }
+    if (fread(&header, sizeof(header), 1, f) != 1 || !MatrixMarketInternals::CheckBinaryHeader(header, expected, "ReadBinaryMatrix"))
+    {
+        fclose(f);
+        return false;
+    }
 
-            a_iterator++;
-        }
+    M = CompressedMatrixType(header.Size1, header.Size2, header.NonZeros);
+
+    const bool read = (fread(M.index1_data().begin(), sizeof(*M.index1_data().begin()), header.Size1 + 1, f) == header.Size1 + 1)
+                   && (fread(M.index2_data().begin(), sizeof(*M.index2_data().begin()), header.NonZeros, f) == header.NonZeros)
+                   && (fread(M.value_data().begin(), sizeof(ValueType), header.NonZeros, f) == header.NonZeros);
+    fclose(f);
+
+    if (!read)
+    {
+        printf("ReadBinaryMatrix(): invalid data.\n");
+        M = CompressedMatrixType();
+        return false;
+    }
+
+    M.set_filled(header.Size1 + 1, header.NonZeros);
+
+    return true;
+}
+
+/**
+ * Write a sparse matrix as its raw compressed arrays (row pointers, columns and values) after a header.
+ * This is much faster than the Matrix Market format, e.g. to dump the system of a given iteration.
+ */
+template <typename CompressedMatrixType> inline bool WriteBinaryMatrix(const char* FileName, const CompressedMatrixType& M)
+{
+    typedef typename CompressedMatrixType::value_type ValueType;
+
+    FILE *f = fopen(FileName, "wb");
+
+    if (f == NULL)
+    {
+        printf("WriteBinaryMatrix(): unable to open %s.\n", FileName);
+        return false;
     }
 
+    typedef typename std::remove_const<typename std::remove_reference<decltype(*M.index1_data().begin())>::type>::type IndexType;
+
+    MatrixMarketInternals::BinaryHeader header;
+    MatrixMarketInternals::InitializeBinaryHeader<ValueType>(header, "KRBCSRMT", sizeof(IndexType));
+
+    std::vector<std::size_t> row_pointers;
+    MatrixMarketInternals::GetRowPointers(M, row_pointers);
+    const std::vector<IndexType> index1(row_pointers.begin(), row_pointers.end());
+
+    header.Size1 = M.size1();
+    header.Size2 = M.size2();
+    header.NonZeros = index1.back();
+
+    const bool written = (fwrite(&header, sizeof(header), 1, f) == 1)
+                      && (fwrite(index1.data(), sizeof(IndexType), index1.size(), f) == index1.size())
+                      && (fwrite(M.index2_data().begin(), sizeof(IndexType), header.NonZeros, f) == header.NonZeros)
+                      && (fwrite(M.value_data().begin(), sizeof(ValueType), header.NonZeros, f) == header.NonZeros);
     fclose(f);
 
+    if (!written)
+    {
+        printf("WriteBinaryMatrix(): unable to write data.\n");
+        return false;
+    }
+
     return true;
 }
 
@@ -364,6 +709,9 @@ template <typename CompressedMatrixType> inline bool WriteMatrixMarketMatrix(con
 
 template <typename VectorType> inline bool ReadMatrixMarketVector(const char* FileName, VectorType& V)
 {
+    typedef typename VectorType::value_type ValueType;
+    typedef MatrixMarketInternals::ValueTraits<ValueType> TraitsType;
+
     // Open MM file for reading
     FILE *f = fopen(FileName, "r");
 
@@ -391,7 +739,7 @@ template <typename VectorType> inline bool ReadMatrixMarketVector(const char* Fi
     }
 
     // Check for supported types of MM file
-    if (!((mm_is_real(mm_code) || mm_is_integer(mm_code)) && mm_is_array(mm_code)))
+    if (!((mm_is_real(mm_code) || mm_is_integer(mm_code) || (mm_is_complex(mm_code) && TraitsType::IsComplex)) && mm_is_array(mm_code)))
     {
         printf("ReadMatrixMarketVector(): invalid MatrixMarket type, \"%s\".\n",  mm_typecode_to_str(mm_code));
         fclose(f);
@@ -416,35 +764,40 @@ template <typename VectorType> inline bool ReadMatrixMarketVector(const char* Fi
         return false;
     }
 
-    VectorType *v = new VectorType(size1);
-    double T;
-
     // Read MM file
+    std::vector<char> buffer;
+    const bool read = MatrixMarketInternals::ReadRemaining(f, buffer);
+    fclose(f);
 
-    for (int i = 0; i < size1; i++)
-    {
-        if (fscanf(f, "%lg", &T) != 1)
-        {
-            printf("ReadMatrixMarketVector(): invalid data.\n");
-            fclose(f);
+    const int number_of_reals = mm_is_complex(mm_code) ? 2 : 1;
+    VectorType v(size1);
 
-            return false;
-        }
+    auto parse_value = [&](const char* p, const char* pLineEnd, const std::size_t Position) -> bool
+    {
+        double reals[2] = {0.00, 0.00};
+        for (int k = 0; k < number_of_reals; ++k)
+            if (!MatrixMarketInternals::ParseNumber(p, pLineEnd, reals[k]))
+                return false;
+        v(Position) = TraitsType::FromReals(reals, number_of_reals);
+        return true;
+    };
 
-        (*v)(i) = T;
+    if (!read || !MatrixMarketInternals::ParseDataLines(buffer, size1, parse_value))
+    {
+        printf("ReadMatrixMarketVector(): invalid data.\n");
+        return false;
     }
 
-    fclose(f);
-
-    V = *v;
-
-    delete v;
+    V.swap(v);
 
     return true;
 }
 
 template <typename VectorType> inline bool WriteMatrixMarketVector(const char* FileName, const VectorType& V)
 {
+    typedef typename VectorType::value_type ValueType;
+    typedef MatrixMarketInternals::ValueTraits<ValueType> TraitsType;
+
     // Open MM file for writing
     FILE *f = fopen(FileName, "w");
 
@@ -461,26 +814,127 @@ template <typename VectorType> inline bool WriteMatrixMarketVector(const char* F
 
     mm_set_matrix(&mm_code);
     mm_set_array(&mm_code);
-    mm_set_real(&mm_code);
+    if (TraitsType::IsComplex)
+        mm_set_complex(&mm_code);
+    else
+        mm_set_real(&mm_code);
 
     mm_write_banner(f, mm_code);
 
     // Write MM file sizes
     mm_write_mtx_array_size(f, V.size(), 1);
 
-    for (unsigned int i = 0; i < V.size(); i++)
-        if (fprintf(f, "%22.16e\n", V(i)) < 0)
+    const std::size_t block_size = 1 << 16;
+
+    auto format_values = [&](const std::size_t Block, std::string& rBuffer)
+    {
+        const std::size_t first = Block * block_size;
+        const std::size_t last = std::min<std::size_t>(first + block_size, V.size());
+        rBuffer.resize((last - first) * 64);
+
+        char* p = &rBuffer[0];
+        for (std::size_t i = first; i < last; i++)
         {
-            printf("WriteMatrixMarketVector(): unable to write data.\n");
-            fclose(f);
-            return false;
+            double reals[2];
+            TraitsType::ToReals(V(i), reals);
+
+            p = MatrixMarketInternals::FormatReal(p, reals[0]);
+            if (TraitsType::IsComplex)
+            {
+                *p++ = ' ';
+                p = MatrixMarketInternals::FormatReal(p, reals[1]);
+            }
+            *p++ = '\n';
         }
 
+        rBuffer.resize(p - rBuffer.data());
+    };
+
+    if (!MatrixMarketInternals::WriteBlocks(f, (V.size() + block_size - 1) / block_size, format_values))
+    {
+        printf("WriteMatrixMarketVector(): unable to write data.\n");
+        fclose(f);
+        return false;
+    }
+
     fclose(f);
 
     return true;
 }
 
+/**
+ * Read a vector written by WriteBinaryVector. The file must have the value type of the vector.
+ */
+template <typename VectorType> inline bool ReadBinaryVector(const char* FileName, VectorType& V)
+{
+    typedef typename VectorType::value_type ValueType;
+
+    FILE *f = fopen(FileName, "rb");
+
+    if (f == NULL)
+    {
+        printf("ReadBinaryVector(): unable to open %s.\n", FileName);
+        return false;
+    }
+
+    MatrixMarketInternals::BinaryHeader header, expected;
+    MatrixMarketInternals::InitializeBinaryHeader<ValueType>(expected, "KRBVECTR", 0);
+
+    if (fread(&header, sizeof(header), 1, f) != 1 || !MatrixMarketInternals::CheckBinaryHeader(header, expected, "ReadBinaryVector"))
+    {
+        fclose(f);
+        return false;
+    }
+
+    VectorType v(header.Size1);
+    const bool read = (header.Size1 == 0) || (fread(&v(0), sizeof(ValueType), header.Size1, f) == header.Size1);
+    fclose(f);
+
+    if (!read)
+    {
+        printf("ReadBinaryVector(): invalid data.\n");
+        return false;
+    }
+
+    V.swap(v);
+
+    return true;
+}
+
+/**
+ * Write a vector as its raw values after a header.
+ */
+template <typename VectorType> inline bool WriteBinaryVector(const char* FileName, const VectorType& V)
+{
+    typedef typename VectorType::value_type ValueType;
+
+    FILE *f = fopen(FileName, "wb");
+
+    if (f == NULL)
+    {
+        printf("WriteBinaryVector(): unable to open %s.\n", FileName);
+        return false;
+    }
+
+    MatrixMarketInternals::BinaryHeader header;
+    MatrixMarketInternals::InitializeBinaryHeader<ValueType>(header, "KRBVECTR", 0);
+    header.Size1 = V.size();
+    header.Size2 = 1;
+    header.NonZeros = V.size();
+
+    const bool written = (fwrite(&header, sizeof(header), 1, f) == 1)
+                      && ((V.size() == 0) || (fwrite(&V(0), sizeof(ValueType), V.size(), f) == V.size()));
+    fclose(f);
+
+    if (!written)
+    {
+        printf("WriteBinaryVector(): unable to write data.\n");
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace Kratos
 
 #endif // KRATOS_MATRIX_MARKET_INTERFACE_H_INCLUDED  defined
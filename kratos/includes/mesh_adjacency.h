@@ -0,0 +1,587 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_MESH_ADJACENCY_H_INCLUDED )
+#define  KRATOS_MESH_ADJACENCY_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "geometries/geometry_data.h"
+#include "includes/kratos_flags.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class MeshAdjacency
+ * @ingroup KratosCore
+ * @brief The adjacency of the nodes, elements and conditions of a model part in compressed (CSR) arrays
+ * @details The nodes, elements and conditions are referred to by their position in the containers of the
+ * model part. The adjacency holds:
+ * - the elements (conditions) of each node, in the order of the container,
+ * - the neighbour nodes of each node, i.e. the other nodes of its elements, in the order they first appear in
+ *   its elements (as the legacy neighbour search gave them),
+ * - the neighbour element (condition) over each face of an element (condition), or NoNeighbour() on the
+ *   boundary. The faces are the edges of the 2D entities and the faces of the 3D ones, in the order used
+ *   by the neighbour search processes.
+ * The faces are matched by hashing: each face is keyed by its sorted corner nodes and stored in the bucket
+ * of its smallest node, so matching only compares the faces of one bucket. All the arrays except the
+ * prefix sums are filled in parallel. The adjacency is a snapshot of the mesh, it must be rebuilt after
+ * remeshing. As in the legacy neighbour search, an entity may have nodes which are not in the nodes of the model
+ * part: these nodes are skipped, they are not neighbours of any node and a face through them has no neighbour.
+ */
+class MeshAdjacency
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of MeshAdjacency
+    KRATOS_CLASS_POINTER_DEFINITION(MeshAdjacency);
+
+    typedef std::size_t IndexType;
+
+    typedef std::size_t SizeType;
+
+    typedef std::vector<IndexType> IndicesType;
+
+    /// The corners of the faces of a geometry type
+    struct FacesTableType
+    {
+        FacesTableType() : NumberOfFaces(0), Corners(NULL) {}
+        FacesTableType(SizeType Size, const int (*pCorners)[4]) : NumberOfFaces(Size), Corners(pCorners) {}
+        SizeType NumberOfFaces;
+        const int (*Corners)[4];
+    };
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    MeshAdjacency() {}
+
+    /// Destructor.
+    virtual ~MeshAdjacency() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// The index of the missing neighbour over a boundary face
+    static constexpr IndexType NoNeighbour()
+    {
+        return std::numeric_limits<IndexType>::max();
+    }
+
+    /**
+     * @brief Build the elements of each node and the neighbour nodes of each node
+     * @param OnlyActiveElements skip the elements which are not ACTIVE
+     */
+    template<class TModelPartType>
+    void BuildNodalAdjacency(TModelPartType& rModelPart, const bool OnlyActiveElements = false)
+    {
+        KRATOS_TRY
+
+        const NodePositionsType node_positions(rModelPart.Nodes());
+
+        IndicesType elements_index, elements_nodes;
+        CollectEntitiesNodes(rModelPart.Elements(), node_positions, OnlyActiveElements, elements_index, elements_nodes, NULL);
+
+        BuildNodeEntities(node_positions.NumberOfNodes(), elements_index, elements_nodes, mNodeElementsIndex, mNodeElements);
+
+        BuildNodeNodes(elements_index, elements_nodes, mNodeElementsIndex, mNodeElements, mNodeNodesIndex, mNodeNodes);
+
+        KRATOS_CATCH("")
+    }
+
+    /**
+     * @brief Build the elements of each node and the neighbour element over each face of the elements
+     * @param OnlyActiveElements skip the elements which are not ACTIVE, they have no face
+     */
+    template<class TModelPartType>
+    void BuildElementalAdjacency(TModelPartType& rModelPart, const bool OnlyActiveElements = false)
+    {
+        KRATOS_TRY
+
+        const NodePositionsType node_positions(rModelPart.Nodes());
+
+        IndicesType elements_index, elements_nodes;
+        std::vector<FacesTableType> elements_faces;
+        CollectEntitiesNodes(rModelPart.Elements(), node_positions, OnlyActiveElements, elements_index, elements_nodes, &elements_faces);
+
+        BuildNodeEntities(node_positions.NumberOfNodes(), elements_index, elements_nodes, mNodeElementsIndex, mNodeElements);
+
+        BuildFaceNeighbours(node_positions.NumberOfNodes(), elements_index, elements_nodes, elements_faces,
+                            mElementNeighboursIndex, mElementNeighbours);
+
+        KRATOS_CATCH("")
+    }
+
+    /**
+     * @brief Build the conditions of each node and the neighbour condition over each face of the conditions
+     * @param WithFaces match the faces of the conditions, which must then be surfaces or 2D entities
+     */
+    template<class TModelPartType>
+    void BuildConditionalAdjacency(TModelPartType& rModelPart, const bool WithFaces = true)
+    {
+        KRATOS_TRY
+
+        const NodePositionsType node_positions(rModelPart.Nodes());
+
+        IndicesType conditions_index, conditions_nodes;
+        std::vector<FacesTableType> conditions_faces;
+        CollectEntitiesNodes(rModelPart.Conditions(), node_positions, false, conditions_index, conditions_nodes,
+                             WithFaces ? &conditions_faces : NULL);
+
+        BuildNodeEntities(node_positions.NumberOfNodes(), conditions_index, conditions_nodes, mNodeConditionsIndex, mNodeConditions);
+
+        if (WithFaces)
+        {
+            BuildFaceNeighbours(node_positions.NumberOfNodes(), conditions_index, conditions_nodes, conditions_faces,
+                                mConditionNeighboursIndex, mConditionNeighbours);
+        }
+        else
+        {
+            IndicesType().swap(mConditionNeighboursIndex);
+            IndicesType().swap(mConditionNeighbours);
+        }
+
+        KRATOS_CATCH("")
+    }
+
+    void Clear()
+    {
+        IndicesType().swap(mNodeElementsIndex);
+        IndicesType().swap(mNodeElements);
+        IndicesType().swap(mNodeNodesIndex);
+        IndicesType().swap(mNodeNodes);
+        IndicesType().swap(mElementNeighboursIndex);
+        IndicesType().swap(mElementNeighbours);
+        IndicesType().swap(mNodeConditionsIndex);
+        IndicesType().swap(mNodeConditions);
+        IndicesType().swap(mConditionNeighboursIndex);
+        IndicesType().swap(mConditionNeighbours);
+    }
+
+    /**
+     * @brief The corner nodes of the faces of a geometry type, in the order of the neighbour search processes
+     * @details The faces are the edges of the triangles and quadrilaterals (also in 3D space) and the faces
+     * of the tetrahedra and hexahedra. Unused corners are -1. A geometry type which is not supported has no face.
+     */
+    static FacesTableType GetFaces(const GeometryData::KratosGeometryType GeometryType)
+    {
+        static const int triangle_faces[3][4] = {{1, 2, -1, -1}, {2, 0, -1, -1}, {0, 1, -1, -1}};
+        static const int quadrilateral_faces[4][4] = {{1, 2, -1, -1}, {2, 3, -1, -1}, {3, 0, -1, -1}, {0, 1, -1, -1}};
+        static const int tetrahedra_faces[4][4] = {{1, 2, 3, -1}, {2, 3, 0, -1}, {3, 0, 1, -1}, {0, 1, 2, -1}};
+        static const int hexahedra_faces[6][4] = {{3, 2, 1, 0}, {0, 1, 5, 4}, {2, 6, 5, 1}, {7, 6, 2, 3}, {7, 3, 0, 4}, {4, 5, 6, 7}};
+
+        switch(GeometryType)
+        {
+            case GeometryData::KratosGeometryType::Kratos_Triangle2D3:
+            case GeometryData::KratosGeometryType::Kratos_Triangle2D6:
+            case GeometryData::KratosGeometryType::Kratos_Triangle3D3:
+            case GeometryData::KratosGeometryType::Kratos_Triangle3D6:
+                return FacesTableType(3, triangle_faces);
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D4:
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D8:
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D9:
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral3D4:
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral3D8:
+            case GeometryData::KratosGeometryType::Kratos_Quadrilateral3D9:
+                return FacesTableType(4, quadrilateral_faces);
+            case GeometryData::KratosGeometryType::Kratos_Tetrahedra3D4:
+            case GeometryData::KratosGeometryType::Kratos_Tetrahedra3D10:
+                return FacesTableType(4, tetrahedra_faces);
+            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D8:
+            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D20:
+            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D27:
+                return FacesTableType(6, hexahedra_faces);
+            default:
+                return FacesTableType(0, NULL);
+        }
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    /// The elements of all the nodes; the elements of node i are in [NodeElementsIndex()[i], NodeElementsIndex()[i+1])
+    const IndicesType& NodeElementsIndex() const {return mNodeElementsIndex;}
+    const IndicesType& NodeElements() const {return mNodeElements;}
+
+    const IndicesType& NodeNodesIndex() const {return mNodeNodesIndex;}
+    const IndicesType& NodeNodes() const {return mNodeNodes;}
+
+    /// The neighbour elements over the faces of all the elements, in the same layout
+    const IndicesType& ElementNeighboursIndex() const {return mElementNeighboursIndex;}
+    const IndicesType& ElementNeighbours() const {return mElementNeighbours;}
+
+    const IndicesType& NodeConditionsIndex() const {return mNodeConditionsIndex;}
+    const IndicesType& NodeConditions() const {return mNodeConditions;}
+
+    const IndicesType& ConditionNeighboursIndex() const {return mConditionNeighboursIndex;}
+    const IndicesType& ConditionNeighbours() const {return mConditionNeighbours;}
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+    bool HasNodalAdjacency() const {return !mNodeNodesIndex.empty();}
+
+    bool HasElementalAdjacency() const {return !mElementNeighboursIndex.empty();}
+
+    bool HasConditionalAdjacency() const {return !mConditionNeighboursIndex.empty();}
+
+    /// The memory held by the arrays, in bytes
+    SizeType MemorySize() const
+    {
+        return sizeof(IndexType) * (mNodeElementsIndex.size() + mNodeElements.size() + mNodeNodesIndex.size() + mNodeNodes.size()
+            + mElementNeighboursIndex.size() + mElementNeighbours.size() + mNodeConditionsIndex.size() + mNodeConditions.size()
+            + mConditionNeighboursIndex.size() + mConditionNeighbours.size());
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        return "MeshAdjacency";
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << "Node-element entries: " << mNodeElements.size() << std::endl;
+        rOStream << "Node-node entries: " << mNodeNodes.size() << std::endl;
+        rOStream << "Element faces: " << mElementNeighbours.size() << std::endl;
+        rOStream << "Node-condition entries: " << mNodeConditions.size() << std::endl;
+        rOStream << "Condition faces: " << mConditionNeighbours.size() << std::endl;
+        rOStream << "Memory size: " << MemorySize() << " bytes" << std::endl;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    IndicesType mNodeElementsIndex, mNodeElements;
+
+    IndicesType mNodeNodesIndex, mNodeNodes;
+
+    IndicesType mElementNeighboursIndex, mElementNeighbours;
+
+    IndicesType mNodeConditionsIndex, mNodeConditions;
+
+    IndicesType mConditionNeighboursIndex, mConditionNeighbours;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// The positions of the nodes in their container, by id. The table is dense unless the ids are sparse.
+    class NodePositionsType
+    {
+    public:
+        template<class TNodesContainerType>
+        explicit NodePositionsType(TNodesContainerType& rNodes) : mNumberOfNodes(rNodes.size())
+        {
+            IndexType max_id = 0;
+            for (typename TNodesContainerType::iterator it = rNodes.begin(); it != rNodes.end(); ++it)
+                max_id = std::max(max_id, static_cast<IndexType>(it->Id()));
+
+            if (max_id <= 4 * mNumberOfNodes + 1024)
+            {
+                mPositions.assign(max_id + 1, NoNeighbour());
+                #pragma omp parallel for
+                for (int i = 0; i < static_cast<int>(mNumberOfNodes); ++i)
+                    mPositions[(rNodes.begin() + i)->Id()] = i;
+            }
+            else
+            {
+                mSortedIds.resize(mNumberOfNodes);
+                #pragma omp parallel for
+                for (int i = 0; i < static_cast<int>(mNumberOfNodes); ++i)
+                    mSortedIds[i] = std::make_pair(static_cast<IndexType>((rNodes.begin() + i)->Id()), static_cast<IndexType>(i));
+                std::sort(mSortedIds.begin(), mSortedIds.end());
+            }
+        }
+
+        SizeType NumberOfNodes() const {return mNumberOfNodes;}
+
+        /// The position of the node, NoNeighbour() if it is not in the container
+        IndexType operator()(const IndexType Id) const
+        {
+            if (mSortedIds.empty())
+                return (Id < mPositions.size()) ? mPositions[Id] : NoNeighbour();
+
+            std::vector<std::pair<IndexType, IndexType> >::const_iterator it = std::lower_bound(mSortedIds.begin(), mSortedIds.end(), std::make_pair(Id, IndexType(0)));
+            return (it != mSortedIds.end() && it->first == Id) ? it->second : NoNeighbour();
+        }
+
+    private:
+        SizeType mNumberOfNodes;
+        IndicesType mPositions;
+        std::vector<std::pair<IndexType, IndexType> > mSortedIds;
+    };
+
+    /**
+     * @brief The positions of the nodes of each entity, in CSR format. The skipped entities have no node and the
+     * nodes which are not in the model part have the position NoNeighbour().
+     * @param pFaces if given, filled with the faces of each entity; the skipped entities have no face
+     */
+    template<class TContainerType>
+    static void CollectEntitiesNodes(TContainerType& rEntities, const NodePositionsType& rNodePositions, const bool OnlyActive,
+                                     IndicesType& rIndex, IndicesType& rNodes, std::vector<FacesTableType>* pFaces)
+    {
+        const SizeType number_of_entities = rEntities.size();
+
+        rIndex.resize(number_of_entities + 1);
+        rIndex[0] = 0;
+        if (pFaces != NULL)
+            pFaces->assign(number_of_entities, FacesTableType());
+
+        // the errors are thrown outside of the parallel regions
+        IndexType invalid_entity = NoNeighbour();
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_entities); ++i)
+        {
+            typename TContainerType::iterator it = rEntities.begin() + i;
+            if (OnlyActive && !it->Is(ACTIVE))
+            {
+                rIndex[i + 1] = 0;
+                continue;
+            }
+
+            rIndex[i + 1] = it->GetGeometry().size();
+            if (pFaces != NULL)
+            {
+                (*pFaces)[i] = GetFaces(it->GetGeometry().GetGeometryType());
+                if ((*pFaces)[i].NumberOfFaces == 0)
+                {
+                    #pragma omp critical
+                    invalid_entity = std::min(invalid_entity, static_cast<IndexType>(i));
+                }
+            }
+        }
+
+        if (invalid_entity != NoNeighbour())
+        {
+            typename TContainerType::iterator it = rEntities.begin() + invalid_entity;
+            KRATOS_ERROR << "The geometry type " << static_cast<int>(it->GetGeometry().GetGeometryType()) << " of entity " << it->Id() << " is invalid";
+        }
+
+        for (IndexType i = 0; i < number_of_entities; ++i)
+            rIndex[i + 1] += rIndex[i];
+
+        rNodes.resize(rIndex[number_of_entities]);
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_entities); ++i)
+        {
+            if (rIndex[i] == rIndex[i + 1])
+                continue;
+
+            typename TContainerType::iterator it = rEntities.begin() + i;
+            for (IndexType k = rIndex[i]; k < rIndex[i + 1]; ++k)
+                rNodes[k] = rNodePositions(it->GetGeometry()[k - rIndex[i]].Id());
+        }
+    }
+
+    /// Transpose the entity-node connectivity, without the nodes which are not in the model part
+    static void BuildNodeEntities(const SizeType NumberOfNodes, const IndicesType& rEntitiesIndex, const IndicesType& rEntitiesNodes,
+                                  IndicesType& rIndex, IndicesType& rEntities)
+    {
+        rIndex.assign(NumberOfNodes + 1, 0);
+        for (IndexType k = 0; k < rEntitiesNodes.size(); ++k)
+            if (rEntitiesNodes[k] != NoNeighbour())
+                ++rIndex[rEntitiesNodes[k] + 1];
+
+        for (IndexType i = 0; i < NumberOfNodes; ++i)
+            rIndex[i + 1] += rIndex[i];
+
+        rEntities.resize(rIndex[NumberOfNodes]);
+        IndicesType position(rIndex.begin(), rIndex.end() - 1);
+        for (IndexType e = 0; e + 1 < rEntitiesIndex.size(); ++e)
+            for (IndexType k = rEntitiesIndex[e]; k < rEntitiesIndex[e + 1]; ++k)
+                if (rEntitiesNodes[k] != NoNeighbour())
+                    rEntities[position[rEntitiesNodes[k]]++] = e;
+    }
+
+    /// The other nodes of the entities of each node, in the order they first appear in the entities of the node.
+    /// The sizes are counted first, then the lists are filled.
+    static void BuildNodeNodes(const IndicesType& rEntitiesIndex, const IndicesType& rEntitiesNodes,
+                               const IndicesType& rNodeEntitiesIndex, const IndicesType& rNodeEntities,
+                               IndicesType& rIndex, IndicesType& rNodes)
+    {
+        const SizeType number_of_nodes = rNodeEntitiesIndex.size() - 1;
+        rIndex.assign(number_of_nodes + 1, 0);
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            if (pass == 1)
+            {
+                for (IndexType i = 0; i < number_of_nodes; ++i)
+                    rIndex[i + 1] += rIndex[i];
+                rNodes.resize(rIndex[number_of_nodes]);
+            }
+
+            #pragma omp parallel
+            {
+                IndicesType neighbours;
+                IndicesType marker(number_of_nodes, NoNeighbour()); // the last node which added the node
+
+                #pragma omp for
+                for (int i = 0; i < static_cast<int>(number_of_nodes); ++i)
+                {
+                    neighbours.clear();
+                    marker[i] = i;
+                    for (IndexType j = rNodeEntitiesIndex[i]; j < rNodeEntitiesIndex[i + 1]; ++j)
+                    {
+                        const IndexType e = rNodeEntities[j];
+                        for (IndexType k = rEntitiesIndex[e]; k < rEntitiesIndex[e + 1]; ++k)
+                        {
+                            const IndexType node = rEntitiesNodes[k];
+                            if (node != NoNeighbour() && marker[node] != static_cast<IndexType>(i))
+                            {
+                                marker[node] = i;
+                                neighbours.push_back(node);
+                            }
+                        }
+                    }
+
+                    if (pass == 0)
+                        rIndex[i + 1] = neighbours.size();
+                    else
+                        std::copy(neighbours.begin(), neighbours.end(), rNodes.begin() + rIndex[i]);
+                }
+            }
+        }
+    }
+
+    /// Match the faces of the entities by their sorted corner nodes
+    static void BuildFaceNeighbours(const SizeType NumberOfNodes, const IndicesType& rEntitiesIndex, const IndicesType& rEntitiesNodes,
+                                    const std::vector<FacesTableType>& rFaces, IndicesType& rIndex, IndicesType& rNeighbours)
+    {
+        typedef std::array<IndexType, 4> FaceKeyType;
+
+        const SizeType number_of_entities = rFaces.size();
+
+        // the number of faces of each entity
+        rIndex.resize(number_of_entities + 1);
+        rIndex[0] = 0;
+        for (IndexType i = 0; i < number_of_entities; ++i)
+            rIndex[i + 1] = rIndex[i] + rFaces[i].NumberOfFaces;
+
+        const SizeType number_of_faces = rIndex[number_of_entities];
+        std::vector<FaceKeyType> keys(number_of_faces);
+        IndicesType faces_entity(number_of_faces);
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_entities); ++i)
+        {
+            const int (*faces)[4] = rFaces[i].Corners;
+            for (IndexType f = rIndex[i]; f < rIndex[i + 1]; ++f)
+            {
+                FaceKeyType& r_key = keys[f];
+                r_key.fill(NoNeighbour());
+                for (std::size_t k = 0; k < 4; ++k)
+                    if (faces[f - rIndex[i]][k] >= 0)
+                        r_key[k] = rEntitiesNodes[rEntitiesIndex[i] + faces[f - rIndex[i]][k]];
+                std::sort(r_key.begin(), r_key.end());
+                faces_entity[f] = i;
+
+                // a face through a node which is not in the model part is not matched
+                for (std::size_t k = 0; k < 4; ++k)
+                    if (faces[f - rIndex[i]][k] >= 0 && rEntitiesNodes[rEntitiesIndex[i] + faces[f - rIndex[i]][k]] == NoNeighbour())
+                        r_key.fill(NoNeighbour());
+            }
+        }
+
+        // the buckets of faces, by their smallest node
+        IndicesType buckets_index(NumberOfNodes + 1, 0), buckets;
+        for (IndexType f = 0; f < number_of_faces; ++f)
+            if (keys[f][0] != NoNeighbour())
+                ++buckets_index[keys[f][0] + 1];
+        for (IndexType i = 0; i < NumberOfNodes; ++i)
+            buckets_index[i + 1] += buckets_index[i];
+        buckets.resize(buckets_index[NumberOfNodes]);
+        IndicesType position(buckets_index.begin(), buckets_index.end() - 1);
+        for (IndexType f = 0; f < number_of_faces; ++f)
+            if (keys[f][0] != NoNeighbour())
+                buckets[position[keys[f][0]]++] = f;
+
+        rNeighbours.assign(number_of_faces, NoNeighbour());
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(NumberOfNodes); ++i)
+        {
+            for (IndexType a = buckets_index[i]; a < buckets_index[i + 1]; ++a)
+            {
+                const IndexType face = buckets[a];
+                for (IndexType b = buckets_index[i]; b < buckets_index[i + 1]; ++b)
+                {
+                    const IndexType other = buckets[b];
+                    if (faces_entity[other] != faces_entity[face] && keys[other] == keys[face])
+                    {
+                        rNeighbours[face] = faces_entity[other];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    ///@}
+
+}; // Class MeshAdjacency
+
+///@}
+
+/// output stream function
+inline std::ostream& operator << (std::ostream& rOStream, const MeshAdjacency& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_MESH_ADJACENCY_H_INCLUDED  defined
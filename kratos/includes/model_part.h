@@ -31,6 +31,7 @@
 #include "includes/element.h"
 #include "includes/condition.h"
 #include "includes/communicator.h"
+#include "includes/mesh_adjacency.h"
 #include "includes/table.h"
 #include "containers/pointer_vector_map.h"
 #include "containers/pointer_hash_map_set.h"
@@ -588,6 +589,11 @@ public:
 
     typename NodeType::Pointer CreateNewNode(IndexType NodeId, NodeType const& rSourceNode, IndexType ThisIndex = 0);
 
+    /** Inserts the nodes of the ids rIds in the current mesh, at once.
+     *  rCoordinates holds the x, y, z of each node one after another. The ids must not exist in the mesh.
+     */
+    typename NodesContainerType::ContainerType CreateNewNodes(const std::vector<IndexType>& rIds, const std::vector<CoordinateType>& rCoordinates, IndexType ThisIndex = 0);
+
     void AssignNode(typename NodeType::Pointer pThisNode, IndexType ThisIndex = 0);
 
     /** Returns if the Node corresponding to it's identifier exists */
@@ -1103,6 +1109,12 @@ public:
      */
     typename ElementType::Pointer CreateNewElement(std::string ElementName, IndexType Id, typename GeometryType::PointsArrayType pElementNodes, PropertiesType::Pointer pProperties, IndexType ThisIndex = 0);
 
+    /** Inserts the elements of the ids rIds in the current mesh, at once.
+     *  rConnectivities holds the node ids of each element one after another. The ids must not exist in the mesh.
+     */
+    typename ElementsContainerType::ContainerType CreateNewElements(const std::string& rElementName, const std::vector<IndexType>& rIds,
+        const std::vector<IndexType>& rConnectivities, PropertiesType::Pointer pProperties, IndexType ThisIndex = 0);
+
     /** Returns the Element::Pointer  corresponding to it's identifier */
     typename ElementType::Pointer pGetElement(IndexType ElementId, IndexType ThisIndex = 0)
     {
@@ -1220,6 +1232,12 @@ public:
         IndexType Id, typename GeometryType::PointsArrayType pConditionNodes,
         PropertiesType::Pointer pProperties, IndexType ThisIndex = 0);
 
+    /** Inserts the conditions of the ids rIds in the current mesh, at once.
+     *  rConnectivities holds the node ids of each condition one after another. The ids must not exist in the mesh.
+     */
+    typename ConditionsContainerType::ContainerType CreateNewConditions(const std::string& rConditionName, const std::vector<IndexType>& rIds,
+        const std::vector<IndexType>& rConnectivities, PropertiesType::Pointer pProperties, IndexType ThisIndex = 0);
+
     /** Returns the Condition::Pointer  corresponding to it's identifier */
     typename ConditionType::Pointer pGetCondition(IndexType ConditionId, IndexType ThisIndex = 0)
     {
@@ -1439,6 +1457,34 @@ public:
         mpCommunicator = pNewCommunicator;
     }
 
+    /// The adjacency of the mesh, built by the neighbour search processes. It is not serialized.
+    MeshAdjacency& GetAdjacency()
+    {
+        KRATOS_ERROR_IF(mpAdjacency == nullptr) << "The model part " << Name() << " has no adjacency";
+        return *mpAdjacency;
+    }
+
+    MeshAdjacency const& GetAdjacency() const
+    {
+        KRATOS_ERROR_IF(mpAdjacency == nullptr) << "The model part " << Name() << " has no adjacency";
+        return *mpAdjacency;
+    }
+
+    MeshAdjacency::Pointer pGetAdjacency()
+    {
+        return mpAdjacency;
+    }
+
+    void SetAdjacency(MeshAdjacency::Pointer pNewAdjacency)
+    {
+        mpAdjacency = pNewAdjacency;
+    }
+
+    bool HasAdjacency() const
+    {
+        return mpAdjacency != nullptr;
+    }
+
     ///@}
     ///@name Operations
     ///@{
@@ -1530,6 +1576,8 @@ private:
 
     typename CommunicatorType::Pointer mpCommunicator; /// The communicator
 
+    MeshAdjacency::Pointer mpAdjacency; /// The adjacency of the mesh, null until a neighbour search builds it
+
     ///@}
     ///@name Private Operators
     ///@{
@@ -1539,6 +1587,19 @@ private:
     ///@name Private Operations
     ///@{
 
+    /// Create the entities of the ids rIds from the prototype, each distinct node of rConnectivities is searched once
+    template<class TEntityType>
+    std::vector<typename TEntityType::Pointer> CreateEntities(const TEntityType& rPrototype, const std::vector<IndexType>& rIds,
+        const std::vector<IndexType>& rConnectivities, PropertiesType::Pointer pProperties);
+
+    /// Whether the ids rIds are strictly ascending and after the last id of the sorted container, hence new
+    template<class TContainerType>
+    bool IdsAreAppended(const TContainerType& rContainer, const std::vector<IndexType>& rIds) const;
+
+    /// Check that the ids rIds are not repeated and are not in the container, before any container is changed
+    template<class TContainerType>
+    void CheckNewIds(const TContainerType& rContainer, const std::vector<IndexType>& rIds, const std::string& rEntityName) const;
+
     template <typename TEntitiesContainerType>
     void AddEntities(TEntitiesContainerType const& Source, TEntitiesContainerType& rDestination, Flags Options)
     {
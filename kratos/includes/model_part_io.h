@@ -16,6 +16,8 @@
 // System includes
 #include <string>
 #include <fstream>
+#include <vector>
+#include <cstdlib>
 
 // External includes
 
@@ -279,6 +281,7 @@ protected:
     std::string mFilename;
     std::fstream mFile;
     Flags mOptions;
+    std::vector<char> mFileBuffer;
 
     ///@}
     ///@name Private Operators
@@ -520,6 +523,19 @@ protected:
         return rValue;
     }
 
+    // The ids and the coordinates are the most frequent values, they are converted without stringstream
+    SizeType& ExtractValue(const std::string& rWord, SizeType& rValue) const
+    {
+        rValue = static_cast<SizeType>(std::strtoull(rWord.c_str(), NULL, 10));
+        return rValue;
+    }
+
+    double& ExtractValue(const std::string& rWord, double& rValue) const
+    {
+        rValue = std::strtod(rWord.c_str(), NULL);
+        return rValue;
+    }
+
     // TODO specialize ExtractValue for complex number, the current form only supports "(x,y)"
 
     ModelPartIO& ReadWord(std::string& Word);
@@ -532,6 +548,8 @@ protected:
 
     char GetCharacter();
 
+    bool GetBufferCharacter(std::streambuf* pBuffer, char& rC);
+
     bool CheckStatement(std::string const& rStatement, std::string const& rGivenWord) const;
 
     void ResetInput();
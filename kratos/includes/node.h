@@ -32,6 +32,7 @@
 #include "containers/variables_list_data_value_container.h"
 #include "utilities/indexed_object.h"
 #include "containers/flags.h"
+#include "includes/striped_lock_table.h"
 
 #include "containers/weak_pointer_vector.h"
 
@@ -125,10 +126,6 @@ public:
         , mInitialPosition()
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     Node(IndexType NewId )
@@ -142,10 +139,6 @@ public:
     {
         KRATOS_ERROR <<  "Calling the default constructor for the node ... illegal operation!!" << std::endl;
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /// 1d constructor.
@@ -159,10 +152,6 @@ public:
         , mInitialPosition(NewX)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /// 2d constructor.
@@ -176,10 +165,6 @@ public:
         , mInitialPosition(NewX, NewY)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /// 3d constructor.
@@ -193,10 +178,6 @@ public:
         , mInitialPosition(NewX, NewY, NewZ)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /// Point constructor.
@@ -210,10 +191,6 @@ public:
         , mInitialPosition(rThisPoint)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /** Copy constructor. Initialize this node with given node.*/
@@ -231,10 +208,6 @@ public:
         // Deep copying the dofs
         for(typename DofsContainerType::const_iterator i_dof = rOtherNode.mDofs.begin() ; i_dof != rOtherNode.mDofs.end() ; i_dof++)
            pAddDof(*i_dof);
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /** Copy constructor from a node with different dimension.*/
@@ -248,10 +221,6 @@ public:
         , mSolutionStepsNodalData(rOtherNode.mSolutionStepsNodalData)
         , mInitialPosition(rOtherNode.mInitialPosition)
     {
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /** Copy constructor from a point with different dimension.*/
@@ -266,10 +235,6 @@ public:
         , mInitialPosition(rThisPoint)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /**
@@ -286,10 +251,6 @@ public:
         , mInitialPosition(rOtherCoordinates)
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
 
@@ -306,10 +267,6 @@ public:
         , mInitialPosition()
     {
         CreateSolutionStepData();
-
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
     /// 3d with variables list and data constructor.
@@ -322,18 +279,12 @@ public:
         , mSolutionStepsNodalData(pVariablesList, ThisData, NewQueueSize)
         , mInitialPosition(NewX, NewY, NewZ)
     {
-#ifdef _OPENMP
-        omp_init_lock(&mnode_lock);
-#endif
     }
 
 
     /// Destructor.
     ~Node() override
     {
-#ifdef _OPENMP
-        omp_destroy_lock(&mnode_lock);
-#endif
     }
 
     void SetId(IndexType NewId) override
@@ -346,27 +297,24 @@ public:
         }
     }
 
+    /// The lock of the node is the one of its stripe in the StripedLockTable, shared with the other nodes of the
+    /// stripe, so a thread must not hold the locks of two nodes at the same time; with KRATOS_DEBUG, SetLock throws
+    /// if it does. Prefer AtomicAdd to accumulate.
 #ifdef _OPENMP
     omp_lock_t& GetLock()
     {
-        return mnode_lock;
+        return StripedLockTable::GetLockObject(this).GetLock();
     }
 #endif
 
     inline void SetLock()
     {
-        //does nothing if openMP is not present
-#ifdef _OPENMP
-        omp_set_lock(&mnode_lock);
-#endif
+        StripedLockTable::SetLock(this);
     }
 
     inline void UnSetLock()
     {
-        //does nothing if openMP is not present
-#ifdef _OPENMP
-        omp_unset_lock(&mnode_lock);
-#endif
+        StripedLockTable::UnSetLock(this);
     }
 
     ///@}
@@ -1006,11 +954,6 @@ protected:
     ///@name Protected member Variables
     ///@{
 
-#ifdef _OPENMP
-    omp_lock_t mnode_lock;
-#endif
-
-
     ///@}
     ///@name Protected Operators
     ///@{
@@ -0,0 +1,125 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_STRIPED_LOCK_TABLE_H_INCLUDED )
+#define  KRATOS_STRIPED_LOCK_TABLE_H_INCLUDED
+
+// System includes
+#include <cstddef>
+#include <cstdint>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/lock_object.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class StripedLockTable
+ * @ingroup KratosCore
+ * @brief A fixed table of locks shared by the objects which are rarely locked, e.g. the nodes
+ * @details The lock of an object is the one of the stripe its address is hashed to, so that the objects do not
+ * store a lock each. The objects of the same stripe exclude each other, hence a thread must not hold the locks of
+ * two objects at the same time (it could wait on itself). The locks are padded to a cache line each.
+ * With KRATOS_DEBUG, SetLock throws if the thread already holds a stripe, instead of deadlocking; the locks taken
+ * directly from GetLockObject are not checked.
+ */
+class KRATOS_API(KRATOS_CORE) StripedLockTable
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    static constexpr std::size_t NumberOfStripesBits = 10;
+
+    static constexpr std::size_t NumberOfStripes = std::size_t(1) << NumberOfStripesBits;
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// The lock of the stripe of the object at pAddress
+    static const LockObject& GetLockObject(const void* pAddress)
+    {
+        return msLocks[Stripe(pAddress)].mLock;
+    }
+
+    /// Lock the stripe of the object at pAddress
+    static void SetLock(const void* pAddress)
+    {
+#ifdef KRATOS_DEBUG
+        KRATOS_ERROR_IF(HeldStripe() != NumberOfStripes) << "The thread holds the lock of the stripe " << HeldStripe()
+            << " and can not lock another object, a thread must not hold the locks of two objects at the same time" << std::endl;
+        HeldStripe() = Stripe(pAddress);
+#endif
+        GetLockObject(pAddress).SetLock();
+    }
+
+    /// Unlock the stripe of the object at pAddress
+    static void UnSetLock(const void* pAddress)
+    {
+        GetLockObject(pAddress).UnSetLock();
+#ifdef KRATOS_DEBUG
+        HeldStripe() = NumberOfStripes;
+#endif
+    }
+
+    /// The stripe of the object at pAddress, by the Fibonacci hashing of the address
+    static std::size_t Stripe(const void* pAddress)
+    {
+        const std::uint64_t address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pAddress));
+        return static_cast<std::size_t>((address * 0x9E3779B97F4A7C15ull) >> (64 - NumberOfStripesBits));
+    }
+
+    ///@}
+
+private:
+    ///@name Private Operations
+    ///@{
+
+#ifdef KRATOS_DEBUG
+    /// The stripe locked by the thread, NumberOfStripes if it holds none
+    static std::size_t& HeldStripe()
+    {
+        static thread_local std::size_t held_stripe = NumberOfStripes;
+        return held_stripe;
+    }
+#endif
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+    struct alignas(64) PaddedLockObject
+    {
+        LockObject mLock;
+    };
+
+    static PaddedLockObject msLocks[NumberOfStripes];
+
+    ///@}
+
+}; // Class StripedLockTable
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_STRIPED_LOCK_TABLE_H_INCLUDED  defined
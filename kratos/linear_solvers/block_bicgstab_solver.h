@@ -0,0 +1,387 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BLOCK_BICGSTAB_SOLVER_H_INCLUDED )
+#define  KRATOS_BLOCK_BICGSTAB_SOLVER_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "linear_solvers/block_iterative_solver.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Globals
+///@{
+
+///@}
+///@name Type Definitions
+///@{
+
+///@}
+///@name  Enum's
+///@{
+
+///@}
+///@name  Functions
+///@{
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BlockBICGSTABSolver
+ * @ingroup KratosCore
+ * @brief Biconjugate gradient stabilized solver for a set of right hand sides sharing the same matrix
+ * @details Each column runs its own BiCGSTAB recurrence, as in BICGSTABSolver, while the two matrix products
+ * of each iteration are done for all the unconverged columns in one pass over the matrix. Converged and
+ * broken down columns are deflated from the working multi-vectors.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType,
+         class TModelPartType,
+         class TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType>,
+         class TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType> >
+class BlockBICGSTABSolver : public BlockIterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of BlockBICGSTABSolver
+    KRATOS_CLASS_POINTER_DEFINITION(BlockBICGSTABSolver);
+
+    typedef BlockIterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType> BaseType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    BlockBICGSTABSolver() {}
+
+    BlockBICGSTABSolver(ValueType NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+    BlockBICGSTABSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+    BlockBICGSTABSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber, typename TPreconditionerType::Pointer pNewPreconditioner) :
+        BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+    /// Copy constructor.
+    BlockBICGSTABSolver(const BlockBICGSTABSolver& Other) : BaseType(Other) {}
+
+    /// Destructor.
+    ~BlockBICGSTABSolver() override {}
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    /// Assignment operator.
+    BlockBICGSTABSolver& operator=(const BlockBICGSTABSolver& Other)
+    {
+        BaseType::operator=(Other);
+        return *this;
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    using BaseType::Solve;
+
+    /** Multi solve method for solving a set of linear systems with same coefficient matrix.
+    @param rA. System matrix
+    @param rX. Solution vectors, stored as columns. it's also the initial guess.
+    @param rB. Right hand side vectors, stored as columns.
+    */
+    bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
+    {
+        const std::size_t size = TDenseSpaceType::Size1(rX);
+        const std::size_t number_of_vectors = TDenseSpaceType::Size2(rX);
+
+        DenseMatrixType x, b;
+        std::vector<ValueType> b_norms;
+        this->InitializeBlockSolve(rA, rX, rB, x, b, b_norms);
+
+        DenseMatrixType r(size, number_of_vectors);
+        this->PreconditionedMult(rA, x, r);
+        noalias(r) = b - r;
+
+        std::vector<DataType> roh0, roh1, rr, rsq, qsqs, qss, alpha, omega, beta;
+        BaseType::ColumnDots(r, r, roh0);
+
+        std::vector<ValueType> residual_norms(number_of_vectors);
+        std::vector<std::size_t> converged(number_of_vectors, 0);
+        std::vector<std::size_t> active(number_of_vectors), keep(number_of_vectors);
+        for (std::size_t k = 0; k < number_of_vectors; ++k)
+        {
+            active[k] = k;
+            residual_norms[k] = std::sqrt(std::abs(roh0[k]));
+            converged[k] = (residual_norms[k] <= this->GetTolerance() * b_norms[k]);
+            keep[k] = !converged[k];
+        }
+
+        // the working multi-vectors only hold the active columns
+        DenseMatrixType xa(x), p(r), rs(r), s, q, qs;
+        const std::vector<DenseMatrixType*> work = {&r, &p, &rs};
+        const std::vector<std::vector<DataType>*> scalars = {&roh0};
+        BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+
+        OpenMPUtils::PartitionVector partition;
+        BaseType::CreateRowsPartition(size, partition);
+        const int number_of_partitions = static_cast<int>(partition.size()) - 1;
+        std::vector<DataType> partial_first, partial_second;
+
+        while (!active.empty() && BaseType::mIterationsNumber < this->GetMaxIterationsNumber())
+        {
+            const std::size_t nactive = active.size();
+            keep.assign(nactive, 1);
+
+            this->PreconditionedMult(rA, p, q);
+
+            BaseType::ColumnDots(rs, q, rsq);
+
+            alpha.resize(nactive);
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                if (std::abs(rsq[k]) <= 1.0e-40)
+                {
+                    alpha[k] = DataType();
+                    keep[k] = 0;
+                }
+                else
+                    alpha[k] = roh0[k] / rsq[k];
+            }
+
+            s.resize(size, nactive, false);
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(size); ++i)
+                for (std::size_t k = 0; k < nactive; ++k)
+                    s(i, k) = r(i, k) - alpha[k] * q(i, k);
+
+            this->PreconditionedMult(rA, s, qs);
+
+            // qs*qs and qs*s in one pass over the rows
+            qsqs.assign(nactive, DataType());
+            qss.assign(nactive, DataType());
+            partial_first.assign(number_of_partitions * nactive, DataType());
+            partial_second.assign(number_of_partitions * nactive, DataType());
+            #pragma omp parallel for
+            for (int t = 0; t < number_of_partitions; ++t)
+            {
+                DataType* local_qsqs = &partial_first[t * nactive];
+                DataType* local_qss = &partial_second[t * nactive];
+                for (int i = partition[t]; i < partition[t+1]; ++i)
+                {
+                    for (std::size_t k = 0; k < nactive; ++k)
+                    {
+                        local_qsqs[k] += qs(i, k) * qs(i, k);
+                        local_qss[k] += qs(i, k) * s(i, k);
+                    }
+                }
+            }
+            BaseType::AddPartialSums(partial_first, qsqs);
+            BaseType::AddPartialSums(partial_second, qss);
+
+            omega.resize(nactive);
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                if (std::abs(qsqs[k]) <= 1.0e-40)
+                {
+                    omega[k] = DataType();
+                    keep[k] = 0;
+                }
+                else
+                    omega[k] = qss[k] / qsqs[k];
+            }
+
+            // x += alpha*p + omega*s, r = s - omega*qs, roh1 = r*rs and r*r in one pass over the rows
+            roh1.assign(nactive, DataType());
+            rr.assign(nactive, DataType());
+            partial_first.assign(number_of_partitions * nactive, DataType());
+            partial_second.assign(number_of_partitions * nactive, DataType());
+            #pragma omp parallel for
+            for (int t = 0; t < number_of_partitions; ++t)
+            {
+                DataType* local = &partial_first[t * nactive];
+                DataType* local_rr = &partial_second[t * nactive];
+                for (int i = partition[t]; i < partition[t+1]; ++i)
+                {
+                    for (std::size_t k = 0; k < nactive; ++k)
+                    {
+                        xa(i, k) += alpha[k] * p(i, k) + omega[k] * s(i, k);
+                        r(i, k) = s(i, k) - omega[k] * qs(i, k);
+                        local[k] += r(i, k) * rs(i, k);
+                        local_rr[k] += r(i, k) * r(i, k);
+                    }
+                }
+            }
+            BaseType::AddPartialSums(partial_first, roh1);
+            BaseType::AddPartialSums(partial_second, rr);
+
+            beta.resize(nactive);
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                if (std::abs(roh0[k]) <= 1.0e-40 || std::abs(omega[k]) <= 1.0e-40)
+                {
+                    beta[k] = DataType();
+                    keep[k] = 0;
+                }
+                else
+                    beta[k] = (roh1[k] * alpha[k]) / (roh0[k] * omega[k]);
+            }
+
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(size); ++i)
+                for (std::size_t k = 0; k < nactive; ++k)
+                    p(i, k) = r(i, k) + beta[k] * (p(i, k) - omega[k] * q(i, k));
+
+            roh0 = roh1;
+
+            BaseType::mIterationsNumber++;
+
+            ValueType max_ratio = 0.0;
+            bool deflate = false;
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                const std::size_t column = active[k];
+                residual_norms[column] = std::sqrt(std::abs(rr[k]));
+                converged[column] = (residual_norms[column] <= this->GetTolerance() * b_norms[column]);
+                if (converged[column])
+                    keep[k] = 0;
+                deflate = deflate || !keep[k];
+                if (b_norms[column] > 0.0)
+                    max_ratio = std::max(max_ratio, residual_norms[column] / b_norms[column]);
+            }
+
+            if (this->GetEchoLevel() > 0)
+            {
+                std::cout << "BlockBICGSTABSolver iteration #" << BaseType::mIterationsNumber
+                          << ", active vectors = " << nactive << ", max normr/normb = " << max_ratio
+                          << ", tol = " << this->GetTolerance() << std::endl;
+            }
+
+            if (deflate)
+                BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+        }
+
+        // the columns which did not converge
+        keep.assign(active.size(), 0);
+        BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+
+        return this->FinalizeBlockSolve(rX, x, b_norms, residual_norms, converged);
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        std::stringstream buffer;
+        buffer << "Block biconjugate gradient stabilized linear solver with " << BaseType::GetPreconditioner()->Info();
+        return  buffer.str();
+    }
+
+    ///@}
+    ///@name Friends
+    ///@{
+
+
+    ///@}
+
+private:
+    ///@name Static Member Variables
+    ///@{
+
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+
+    ///@}
+    ///@name Private Operators
+    ///@{
+
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    ///@}
+    ///@name Private  Access
+    ///@{
+
+
+    ///@}
+    ///@name Private Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Un accessible methods
+    ///@{
+
+
+    ///@}
+
+}; // Class BlockBICGSTABSolver
+
+///@}
+
+///@name Type Definitions
+///@{
+
+
+///@}
+///@name Input and output
+///@{
+
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BLOCK_BICGSTAB_SOLVER_H_INCLUDED  defined
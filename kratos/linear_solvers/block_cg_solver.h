@@ -0,0 +1,334 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BLOCK_CG_SOLVER_H_INCLUDED )
+#define  KRATOS_BLOCK_CG_SOLVER_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "linear_solvers/block_iterative_solver.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Globals
+///@{
+
+///@}
+///@name Type Definitions
+///@{
+
+///@}
+///@name  Enum's
+///@{
+
+///@}
+///@name  Functions
+///@{
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BlockCGSolver
+ * @ingroup KratosCore
+ * @brief Conjugate gradient solver for a set of right hand sides sharing the same matrix
+ * @details The right hand sides are stored as the columns of a row-major multi-vector. Each column runs
+ * its own CG recurrence but the matrix is applied to all the unconverged columns in one pass
+ * (sparse matrix times multi-vector), and the vector updates and dot products are fused over the rows.
+ * Converged columns are deflated, i.e. removed from the working multi-vectors, so the cost per iteration
+ * decreases as the columns converge. The convergence criterion of each column is the same as for CGSolver.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType,
+         class TModelPartType,
+         class TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType>,
+         class TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType> >
+class BlockCGSolver : public BlockIterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of BlockCGSolver
+    KRATOS_CLASS_POINTER_DEFINITION(BlockCGSolver);
+
+    typedef BlockIterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType> BaseType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    BlockCGSolver() {}
+
+    BlockCGSolver(ValueType NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+    BlockCGSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+    BlockCGSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber, typename TPreconditionerType::Pointer pNewPreconditioner) :
+        BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+    /// Copy constructor.
+    BlockCGSolver(const BlockCGSolver& Other) : BaseType(Other) {}
+
+    /// Destructor.
+    ~BlockCGSolver() override {}
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    /// Assignment operator.
+    BlockCGSolver& operator=(const BlockCGSolver& Other)
+    {
+        BaseType::operator=(Other);
+        return *this;
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    using BaseType::Solve;
+
+    /** Multi solve method for solving a set of linear systems with same coefficient matrix.
+    @param rA. System matrix
+    @param rX. Solution vectors, stored as columns. it's also the initial guess.
+    @param rB. Right hand side vectors, stored as columns.
+    */
+    bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
+    {
+        const std::size_t size = TDenseSpaceType::Size1(rX);
+        const std::size_t number_of_vectors = TDenseSpaceType::Size2(rX);
+
+        DenseMatrixType x, b;
+        std::vector<ValueType> b_norms;
+        this->InitializeBlockSolve(rA, rX, rB, x, b, b_norms);
+
+        DenseMatrixType r(size, number_of_vectors);
+        this->PreconditionedMult(rA, x, r);
+        noalias(r) = b - r;
+
+        std::vector<DataType> roh0, roh1, pq, alpha, beta;
+        BaseType::ColumnDots(r, r, roh0);
+
+        std::vector<ValueType> residual_norms(number_of_vectors);
+        std::vector<std::size_t> converged(number_of_vectors, 0);
+        std::vector<std::size_t> active(number_of_vectors), keep(number_of_vectors);
+        for (std::size_t k = 0; k < number_of_vectors; ++k)
+        {
+            active[k] = k;
+            residual_norms[k] = std::sqrt(std::abs(roh0[k]));
+            converged[k] = (residual_norms[k] <= this->GetTolerance() * b_norms[k]);
+            keep[k] = !converged[k] && (std::abs(roh0[k]) >= 1.0e-30);
+        }
+
+        // the working multi-vectors only hold the active columns
+        DenseMatrixType xa(x), p(r), q;
+        const std::vector<DenseMatrixType*> work = {&r, &p};
+        const std::vector<std::vector<DataType>*> scalars = {&roh0};
+        BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+
+        OpenMPUtils::PartitionVector partition;
+        BaseType::CreateRowsPartition(size, partition);
+        const int number_of_partitions = static_cast<int>(partition.size()) - 1;
+        std::vector<DataType> partial_roh1;
+
+        while (!active.empty() && BaseType::mIterationsNumber < this->GetMaxIterationsNumber())
+        {
+            const std::size_t nactive = active.size();
+            keep.assign(nactive, 1);
+
+            this->PreconditionedMult(rA, p, q);
+
+            BaseType::ColumnDots(p, q, pq);
+
+            alpha.resize(nactive);
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                if (std::abs(pq[k]) <= 1.0e-30)
+                {
+                    alpha[k] = DataType();
+                    keep[k] = 0;
+                }
+                else
+                    alpha[k] = roh0[k] / pq[k];
+            }
+
+            // x += alpha*p, r -= alpha*q and roh1 = r*r in one pass over the rows
+            roh1.assign(nactive, DataType());
+            partial_roh1.assign(number_of_partitions * nactive, DataType());
+            #pragma omp parallel for
+            for (int t = 0; t < number_of_partitions; ++t)
+            {
+                DataType* local = &partial_roh1[t * nactive];
+                for (int i = partition[t]; i < partition[t+1]; ++i)
+                {
+                    for (std::size_t k = 0; k < nactive; ++k)
+                    {
+                        xa(i, k) += alpha[k] * p(i, k);
+                        r(i, k) -= alpha[k] * q(i, k);
+                        local[k] += r(i, k) * r(i, k);
+                    }
+                }
+            }
+            BaseType::AddPartialSums(partial_roh1, roh1);
+
+            beta.resize(nactive);
+            for (std::size_t k = 0; k < nactive; ++k)
+                beta[k] = roh1[k] / roh0[k];
+
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(size); ++i)
+                for (std::size_t k = 0; k < nactive; ++k)
+                    p(i, k) = r(i, k) + beta[k] * p(i, k);
+
+            roh0 = roh1;
+
+            BaseType::mIterationsNumber++;
+
+            ValueType max_ratio = 0.0;
+            bool deflate = false;
+            for (std::size_t k = 0; k < nactive; ++k)
+            {
+                const std::size_t column = active[k];
+                residual_norms[column] = std::sqrt(std::abs(roh1[k]));
+                converged[column] = (residual_norms[column] <= this->GetTolerance() * b_norms[column]);
+                if (converged[column] || std::abs(roh1[k]) <= 1.0e-30)
+                    keep[k] = 0;
+                deflate = deflate || !keep[k];
+                if (b_norms[column] > 0.0)
+                    max_ratio = std::max(max_ratio, residual_norms[column] / b_norms[column]);
+            }
+
+            if (this->GetEchoLevel() > 0)
+            {
+                std::cout << "BlockCGSolver iteration #" << BaseType::mIterationsNumber
+                          << ", active vectors = " << nactive << ", max normr/normb = " << max_ratio
+                          << ", tol = " << this->GetTolerance() << std::endl;
+            }
+
+            if (deflate)
+                BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+        }
+
+        // the columns which did not converge
+        keep.assign(active.size(), 0);
+        BaseType::DeflateColumns(x, xa, work, scalars, active, keep);
+
+        return this->FinalizeBlockSolve(rX, x, b_norms, residual_norms, converged);
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        std::stringstream buffer;
+        buffer << "Block conjugate gradient linear solver with " << BaseType::GetPreconditioner()->Info();
+        return  buffer.str();
+    }
+
+    ///@}
+    ///@name Friends
+    ///@{
+
+
+    ///@}
+
+private:
+    ///@name Static Member Variables
+    ///@{
+
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+
+    ///@}
+    ///@name Private Operators
+    ///@{
+
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    ///@}
+    ///@name Private  Access
+    ///@{
+
+
+    ///@}
+    ///@name Private Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Un accessible methods
+    ///@{
+
+
+    ///@}
+
+}; // Class BlockCGSolver
+
+///@}
+
+///@name Type Definitions
+///@{
+
+
+///@}
+///@name Input and output
+///@{
+
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BLOCK_CG_SOLVER_H_INCLUDED  defined
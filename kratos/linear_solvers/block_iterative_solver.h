@@ -0,0 +1,341 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BLOCK_ITERATIVE_SOLVER_H_INCLUDED )
+#define  KRATOS_BLOCK_ITERATIVE_SOLVER_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "linear_solvers/iterative_solver.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Globals
+///@{
+
+///@}
+///@name Type Definitions
+///@{
+
+///@}
+///@name  Enum's
+///@{
+
+///@}
+///@name  Functions
+///@{
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BlockIterativeSolver
+ * @ingroup KratosCore
+ * @brief Base class for the iterative solvers working on several right hand sides at once
+ * @details The right hand sides and the solutions are the columns of row-major multi-vectors, so that the
+ * matrix is applied to all of them in one pass and the vector operations are done row by row. This class
+ * provides the common multi-vector operations, the preconditioning of the system and the deflation of the
+ * converged columns. The single vector Solve is a multi-vector solve with one column.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType,
+         class TModelPartType,
+         class TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType>,
+         class TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType> >
+class BlockIterativeSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of BlockIterativeSolver
+    KRATOS_CLASS_POINTER_DEFINITION(BlockIterativeSolver);
+
+    typedef IterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType> BaseType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    BlockIterativeSolver() {}
+
+    BlockIterativeSolver(ValueType NewMaxTolerance) : BaseType(NewMaxTolerance) {}
+
+    BlockIterativeSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber) : BaseType(NewMaxTolerance, NewMaxIterationsNumber) {}
+
+    BlockIterativeSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber, typename TPreconditionerType::Pointer pNewPreconditioner) :
+        BaseType(NewMaxTolerance, NewMaxIterationsNumber, pNewPreconditioner) {}
+
+    /// Copy constructor.
+    BlockIterativeSolver(const BlockIterativeSolver& Other) : BaseType(Other) {}
+
+    /// Destructor.
+    ~BlockIterativeSolver() override {}
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    /// Assignment operator.
+    BlockIterativeSolver& operator=(const BlockIterativeSolver& Other)
+    {
+        BaseType::operator=(Other);
+        return *this;
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /** Normal solve method.
+    The system is solved as a multi-vector with one column.
+    @param rA. System matrix
+    @param rX. Solution vector. it's also the initial guess.
+    @param rB. Right hand side vector.
+    */
+    bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        if(this->IsNotConsistent(rA, rX, rB))
+            return false;
+
+        DenseMatrixType X(rX.size(), 1), B(rB.size(), 1);
+        TDenseSpaceType::SetColumn(0, X, rX);
+        TDenseSpaceType::SetColumn(0, B, rB);
+
+        const bool is_solved = this->Solve(rA, X, B);
+
+        TDenseSpaceType::GetColumn(0, X, rX);
+
+        return is_solved;
+    }
+
+    bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
+    {
+        return false;
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        std::stringstream buffer;
+        buffer << "Block iterative solver with " << BaseType::GetPreconditioner()->Info();
+        return  buffer.str();
+    }
+
+    ///@}
+
+protected:
+    ///@name Protected Operations
+    ///@{
+
+    /**
+     * @brief Build the preconditioned system for all the columns, as it is done by the single vector solvers
+     * @param rXw the preconditioned initial guesses
+     * @param rBw the preconditioned right hand sides
+     * @param rBNorms the norm of each preconditioned right hand side
+     */
+    void InitializeBlockSolve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB,
+                              DenseMatrixType& rXw, DenseMatrixType& rBw, std::vector<ValueType>& rBNorms)
+    {
+        BaseType::mIterationsNumber = 0;
+        BaseType::mResidualNorm = 0.0;
+        BaseType::mBNorm = 0.0;
+
+        BaseType::GetPreconditioner()->Initialize(rA, rX, rB);
+
+        rXw = rX;
+        rBw = rB;
+        VectorType aux(TDenseSpaceType::Size1(rX));
+        for (std::size_t k = 0; k < TDenseSpaceType::Size2(rX); ++k)
+        {
+            TDenseSpaceType::GetColumn(k, rXw, aux);
+            BaseType::GetPreconditioner()->ApplyInverseRight(aux);
+            TDenseSpaceType::SetColumn(k, rXw, aux);
+
+            TDenseSpaceType::GetColumn(k, rBw, aux);
+            BaseType::GetPreconditioner()->ApplyLeft(aux);
+            TDenseSpaceType::SetColumn(k, rBw, aux);
+        }
+
+        std::vector<DataType> dots;
+        ColumnDots(rBw, rBw, dots);
+        rBNorms.resize(dots.size());
+        for (std::size_t k = 0; k < dots.size(); ++k)
+            rBNorms[k] = std::sqrt(std::abs(dots[k]));
+    }
+
+    /**
+     * @brief Recover the solutions of the original system
+     * @details The column with the largest relative residual is reported as the residual of the solver.
+     * @return true if all the columns converged
+     */
+    bool FinalizeBlockSolve(DenseMatrixType& rX, DenseMatrixType& rXw, const std::vector<ValueType>& rBNorms,
+                            const std::vector<ValueType>& rResidualNorms, const std::vector<std::size_t>& rConverged)
+    {
+        VectorType aux(TDenseSpaceType::Size1(rXw));
+        bool is_solved = true;
+        ValueType worst_ratio = -1.0;
+        for (std::size_t k = 0; k < TDenseSpaceType::Size2(rXw); ++k)
+        {
+            TDenseSpaceType::GetColumn(k, rXw, aux);
+            BaseType::GetPreconditioner()->Finalize(aux);
+            TDenseSpaceType::SetColumn(k, rX, aux);
+
+            is_solved = is_solved && rConverged[k];
+
+            const ValueType ratio = (rBNorms[k] > 0.0) ? rResidualNorms[k] / rBNorms[k] : rResidualNorms[k];
+            if (ratio > worst_ratio)
+            {
+                worst_ratio = ratio;
+                BaseType::mResidualNorm = rResidualNorms[k];
+                BaseType::mBNorm = rBNorms[k];
+            }
+        }
+
+        return is_solved;
+    }
+
+    /**
+     * @brief Remove the dropped columns from the working multi-vectors
+     * @details The solution of each dropped column is copied from rXa to its column rActive[k] in rX. The
+     * other working multi-vectors and the per-column scalars are compacted in the same way.
+     * @param rKeep 0 for each active column which is dropped
+     */
+    static void DeflateColumns(DenseMatrixType& rX, DenseMatrixType& rXa,
+                               const std::vector<DenseMatrixType*>& rWork,
+                               const std::vector<std::vector<DataType>*>& rScalars,
+                               std::vector<std::size_t>& rActive, const std::vector<std::size_t>& rKeep)
+    {
+        std::vector<std::size_t> columns, active;
+        for (std::size_t k = 0; k < rActive.size(); ++k)
+        {
+            if (rKeep[k])
+            {
+                columns.push_back(k);
+                active.push_back(rActive[k]);
+            }
+            else
+            {
+                const std::size_t column = rActive[k];
+                #pragma omp parallel for
+                for (int i = 0; i < static_cast<int>(rX.size1()); ++i)
+                    rX(i, column) = rXa(i, k);
+            }
+        }
+
+        if (columns.size() != rActive.size())
+        {
+            KeepColumns(rXa, columns);
+            for (std::size_t w = 0; w < rWork.size(); ++w)
+                KeepColumns(*rWork[w], columns);
+            for (std::size_t w = 0; w < rScalars.size(); ++w)
+            {
+                std::vector<DataType>& r_scalars = *rScalars[w];
+                for (std::size_t k = 0; k < columns.size(); ++k)
+                    r_scalars[k] = r_scalars[columns[k]];
+                r_scalars.resize(columns.size());
+            }
+        }
+
+        rActive.swap(active);
+    }
+
+    /// The rows of the multi-vectors are split in one partition per thread
+    static void CreateRowsPartition(const std::size_t NumberOfRows, OpenMPUtils::PartitionVector& rPartition)
+    {
+        OpenMPUtils::CreatePartition(OpenMPUtils::GetNumThreads(), static_cast<int>(NumberOfRows), rPartition);
+    }
+
+    /// rSums[k] += rPartialSums[p * rSums.size() + k] for each partition p, added in the order of the partitions
+    /// so that the sums do not depend on the scheduling of the threads
+    static void AddPartialSums(const std::vector<DataType>& rPartialSums, std::vector<DataType>& rSums)
+    {
+        const std::size_t number_of_sums = rSums.size();
+        for (std::size_t p = 0; p < rPartialSums.size() / number_of_sums; ++p)
+            for (std::size_t k = 0; k < number_of_sums; ++k)
+                rSums[k] += rPartialSums[p * number_of_sums + k];
+    }
+
+    /// rDots[k] = rX(:,k) * rY(:,k), computed in one pass over the rows of the multi-vectors
+    static void ColumnDots(const DenseMatrixType& rX, const DenseMatrixType& rY, std::vector<DataType>& rDots)
+    {
+        const std::size_t number_of_vectors = rX.size2();
+        rDots.assign(number_of_vectors, DataType());
+        if (number_of_vectors == 0)
+            return;
+
+        OpenMPUtils::PartitionVector partition;
+        CreateRowsPartition(rX.size1(), partition);
+        const int number_of_partitions = static_cast<int>(partition.size()) - 1;
+        std::vector<DataType> partial_dots(number_of_partitions * number_of_vectors, DataType());
+
+        #pragma omp parallel for
+        for (int t = 0; t < number_of_partitions; ++t)
+        {
+            DataType* local = &partial_dots[t * number_of_vectors];
+            for (int i = partition[t]; i < partition[t+1]; ++i)
+                for (std::size_t k = 0; k < number_of_vectors; ++k)
+                    local[k] += rX(i, k) * rY(i, k);
+        }
+
+        AddPartialSums(partial_dots, rDots);
+    }
+
+    /// Keep only the given columns of the multi-vector, in the given order
+    static void KeepColumns(DenseMatrixType& rX, const std::vector<std::size_t>& rColumns)
+    {
+        DenseMatrixType aux(rX.size1(), rColumns.size());
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(rX.size1()); ++i)
+            for (std::size_t k = 0; k < rColumns.size(); ++k)
+                aux(i, k) = rX(i, rColumns[k]);
+
+        rX.swap(aux);
+    }
+
+    ///@}
+
+}; // Class BlockIterativeSolver
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BLOCK_ITERATIVE_SOLVER_H_INCLUDED  defined
@@ -0,0 +1,842 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BLOCK_LANCZOS_EIGENVALUE_SOLVER_H_INCLUDED )
+#define  KRATOS_BLOCK_LANCZOS_EIGENVALUE_SOLVER_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "linear_solvers/iterative_solver.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Globals
+///@{
+
+///@}
+///@name Type Definitions
+///@{
+
+///@}
+///@name  Enum's
+///@{
+
+///@}
+///@name  Functions
+///@{
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BlockLanczosEigenvalueSolver
+ * @ingroup KratosCore
+ * @brief Thick-restart block Lanczos solver for the generalized symmetric eigenproblem K*x = lambda*M*x
+ * @details The Lanczos process is run in shift-invert mode, i.e. on the operator inv(K - shift*M)*M which
+ * is self-adjoint in the M inner product. The eigenvalues closest to the shift are computed. The shifted
+ * matrix is factorized only once: if the given linear solver supports the reuse of the factorization
+ * (see LinearSolver::FactorizationIsReusable) the factorization is done in InitializeSolutionStep and each
+ * block is back-substituted in PerformSolutionStep, otherwise the multiple right hand sides Solve is called
+ * once per block.
+ * The basis is stored as row-major multi-vectors so that the block operations (projection, orthogonalization
+ * and Ritz vectors update) stream the vectors once and run in parallel over the rows.
+ * The eigenvalues are returned in ascending order and the eigenvectors are stored row-wise, normalized
+ * with respect to M.
+ * @note Only real symmetric K and symmetric positive definite M are supported.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType, class TLinearSolverType,
+         class TModelPartType,
+         class TPreconditionerType = Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType>,
+         class TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType> >
+class BlockLanczosEigenvalueSolver : public IterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of BlockLanczosEigenvalueSolver
+    KRATOS_CLASS_POINTER_DEFINITION(BlockLanczosEigenvalueSolver);
+
+    typedef IterativeSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TPreconditionerType, TReordererType> BaseType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    typedef typename BaseType::DenseVectorType DenseVectorType;
+
+    typedef typename BaseType::SizeType SizeType;
+
+    typedef typename BaseType::IndexType IndexType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    BlockLanczosEigenvalueSolver() {}
+
+    BlockLanczosEigenvalueSolver(ValueType NewMaxTolerance, unsigned int NewMaxIterationsNumber,
+                                 unsigned int NewRequiredEigenvalueNumber, unsigned int NewBlockSize,
+                                 DataType NewShift, typename TLinearSolverType::Pointer pLinearSolver)
+        : BaseType(NewMaxTolerance, NewMaxIterationsNumber)
+        , mRequiredEigenvalueNumber(NewRequiredEigenvalueNumber)
+        , mBlockSize(NewBlockSize)
+        , mShift(NewShift)
+        , mpLinearSolver(pLinearSolver)
+    {}
+
+    /// Copy constructor.
+    BlockLanczosEigenvalueSolver(const BlockLanczosEigenvalueSolver& Other)
+        : BaseType(Other)
+        , mRequiredEigenvalueNumber(Other.mRequiredEigenvalueNumber)
+        , mBlockSize(Other.mBlockSize)
+        , mShift(Other.mShift)
+        , mpLinearSolver(Other.mpLinearSolver)
+    {}
+
+    /// Destructor.
+    ~BlockLanczosEigenvalueSolver() override {}
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    /// Assignment operator.
+    BlockLanczosEigenvalueSolver& operator=(const BlockLanczosEigenvalueSolver& Other)
+    {
+        BaseType::operator=(Other);
+        mRequiredEigenvalueNumber = Other.mRequiredEigenvalueNumber;
+        mBlockSize = Other.mBlockSize;
+        mShift = Other.mShift;
+        mpLinearSolver = Other.mpLinearSolver;
+        return *this;
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    // The thick-restart block Lanczos algorithm
+    void Solve(SparseMatrixType& K,
+               SparseMatrixType& M,
+               DenseVectorType& Eigenvalues,
+               DenseMatrixType& Eigenvectors) override
+    {
+        KRATOS_TRY
+
+        const SizeType size = K.size1();
+        if (size == 0)
+            return;
+
+        // the basis holds a whole number of blocks, the Lanczos relation does not hold for truncated blocks
+        const SizeType nev = std::max<SizeType>(1, std::min<SizeType>(mRequiredEigenvalueNumber, size));
+        SizeType block_size = std::max<SizeType>(1, std::min<SizeType>(mBlockSize, size));
+        const SizeType min_basis = std::max<SizeType>(2*nev, nev + 2*block_size);
+        const SizeType max_basis = std::min<SizeType>(size, block_size * ((min_basis + block_size - 1) / block_size));
+        const SizeType max_iteration = BaseType::GetMaxIterationsNumber();
+        const ValueType tolerance = BaseType::GetTolerance();
+
+        // the shifted operator is factorized only once
+        SparseMatrixType shifted_k(K);
+        if (mShift != 0.0)
+            noalias(shifted_k) = K - mShift*M;
+
+        const bool reuse_factorization = mpLinearSolver->FactorizationIsReusable();
+        VectorType aux_x(size), aux_b(size);
+        if (reuse_factorization)
+        {
+            TSparseSpaceType::SetToZero(aux_x);
+            TSparseSpaceType::SetToZero(aux_b);
+            mpLinearSolver->InitializeSolutionStep(shifted_k, aux_x, aux_b);
+        }
+
+        DenseMatrixType V(size, max_basis);      // M-orthonormal basis
+        DenseMatrixType MV(size, max_basis);     // M*V
+        DenseMatrixType W;                       // operator applied to the last block
+        DenseMatrixType H(max_basis, max_basis); // projected operator V^T*M*inv(K - shift*M)*M*V
+        DenseMatrixType Q, MQ;                   // new block and M*Q
+        DenseMatrixType B;                       // coefficients of the new block
+        noalias(H) = ZeroMatrix(max_basis, max_basis);
+
+        std::mt19937 generator(5489u);
+
+        // starting block
+        DenseMatrixType start(size, block_size);
+        FillRandom(start, generator);
+        SizeType current = OrthonormalizeBlock(M, V, MV, 0, start, block_size, Q, MQ, B, generator);
+        CopyColumns(Q, 0, current, V, 0);
+        CopyColumns(MQ, 0, current, MV, 0);
+        SizeType apply_begin = 0;
+
+        DenseVectorType theta;
+        DenseMatrixType Y;
+        std::vector<SizeType> order;
+
+        SizeType iteration = 0;
+        SizeType number_of_converged = 0;
+        while (true)
+        {
+            // expansion of the Krylov basis, one block at a time
+            while (true)
+            {
+                const SizeType width = current - apply_begin;
+                ApplyOperator(shifted_k, MV, apply_begin, width, W, reuse_factorization, aux_x, aux_b);
+
+                // H(i,j) = (M*v_i)^T * (op*v_j), the rest of the column is filled by symmetry later
+                DenseMatrixType C;
+                TransposeProduct(MV, 0, current, W, 0, width, C);
+                for (SizeType i = 0; i < current; ++i)
+                {
+                    for (SizeType j = 0; j < width; ++j)
+                    {
+                        H(i, apply_begin + j) = C(i, j);
+                        H(apply_begin + j, i) = C(i, j);
+                    }
+                }
+
+                if (current >= max_basis)
+                    break;
+
+                block_size = std::min<SizeType>(width, max_basis - current);
+                const SizeType added = OrthonormalizeBlock(M, V, MV, current, W, block_size, Q, MQ, B, generator);
+                CopyColumns(Q, 0, added, V, current);
+                CopyColumns(MQ, 0, added, MV, current);
+                apply_begin = current;
+                current += added;
+                if (added == 0)
+                    break;
+            }
+
+            // Rayleigh-Ritz on the projected operator
+            SymmetricEigenDecomposition(H, current, theta, Y);
+
+            order.resize(current);
+            for (SizeType i = 0; i < current; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&theta](SizeType a, SizeType b) { return std::abs(theta[a]) > std::abs(theta[b]); });
+
+            // residual block: op*V - V*H = Q*B*E^T, with Q M-orthonormal to V
+            const SizeType last_width = current - apply_begin;
+            SizeType residual_width = 0;
+            if (current < size)
+                residual_width = OrthonormalizeBlock(M, V, MV, current, W, std::min<SizeType>(last_width, size - current), Q, MQ, B, generator);
+
+            // the Ritz residual in the M-norm is |B * Y(last block, k)|
+            number_of_converged = 0;
+            for (SizeType k = 0; k < nev; ++k)
+            {
+                const SizeType col = order[k];
+                ValueType residual = 0.0;
+                for (SizeType i = 0; i < residual_width; ++i)
+                {
+                    DataType sum = 0.0;
+                    for (SizeType j = i; j < B.size2(); ++j)
+                        sum += B(i, j) * Y(apply_begin + j, col);
+                    residual += sum * sum;
+                }
+                residual = std::sqrt(residual);
+
+                if (residual <= tolerance * std::abs(theta[col]))
+                    ++number_of_converged;
+                else
+                    break;
+            }
+
+            ++iteration;
+
+            if (this->GetEchoLevel() > 0)
+                std::cout << "BlockLanczosEigenvalueSolver: restart " << iteration << ", basis size " << current
+                          << ", converged " << number_of_converged << "/" << nev << std::endl;
+
+            if (number_of_converged == nev || iteration >= max_iteration || residual_width == 0)
+                break;
+
+            // thick restart with the best Ritz vectors and the residual block
+            const SizeType target_keep = nev + (max_basis - nev) / 2;
+            const SizeType keep = max_basis - residual_width * std::max<SizeType>(1, (max_basis - target_keep) / residual_width);
+
+            DenseMatrixType Y_keep(current, keep);
+            for (SizeType i = 0; i < current; ++i)
+                for (SizeType k = 0; k < keep; ++k)
+                    Y_keep(i, k) = Y(i, order[k]);
+
+            DenseMatrixType V_r(size, max_basis), MV_r(size, max_basis);
+            Product(V, current, Y_keep, V_r);
+            Product(MV, current, Y_keep, MV_r);
+            CopyColumns(Q, 0, residual_width, V_r, keep);
+            CopyColumns(MQ, 0, residual_width, MV_r, keep);
+            V.swap(V_r);
+            MV.swap(MV_r);
+
+            noalias(H) = ZeroMatrix(max_basis, max_basis);
+            for (SizeType k = 0; k < keep; ++k)
+                H(k, k) = theta[order[k]];
+
+            apply_begin = keep;
+            current = keep + residual_width;
+        }
+
+        if (reuse_factorization)
+            mpLinearSolver->FinalizeSolutionStep(shifted_k, aux_x, aux_b);
+
+        if (number_of_converged < nev)
+            std::cout << "BlockLanczosEigenvalueSolver: only " << number_of_converged << " of " << nev
+                      << " eigenpairs converged after " << iteration << " restarts" << std::endl;
+
+        // lambda = shift + 1/theta, sorted in ascending order
+        std::vector<SizeType> output(order.begin(), order.begin() + nev);
+        std::sort(output.begin(), output.end(), [&theta](SizeType a, SizeType b) { return 1.0/theta[a] < 1.0/theta[b]; });
+
+        if (Eigenvalues.size() != nev)
+            Eigenvalues.resize(nev, false);
+        if (Eigenvectors.size1() != nev || Eigenvectors.size2() != size)
+            Eigenvectors.resize(nev, size, false);
+
+        DenseMatrixType Y_out(current, nev);
+        for (SizeType k = 0; k < nev; ++k)
+        {
+            Eigenvalues[k] = mShift + 1.0/theta[output[k]];
+            for (SizeType i = 0; i < current; ++i)
+                Y_out(i, k) = Y(i, output[k]);
+        }
+
+        DenseMatrixType X;
+        Product(V, current, Y_out, X);
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(size); ++i)
+            for (SizeType k = 0; k < nev; ++k)
+                Eigenvectors(k, i) = X(i, k);
+
+        KRATOS_CATCH("")
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    void SetShift(DataType NewShift)
+    {
+        mShift = NewShift;
+    }
+
+    DataType GetShift() const
+    {
+        return mShift;
+    }
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        std::stringstream buffer;
+        buffer << "Block Lanczos eigenvalue solver with " << mpLinearSolver->Info();
+        return  buffer.str();
+    }
+
+    /// Print information about this object.
+    void PrintInfo(std::ostream& rOStream) const override
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    void PrintData(std::ostream& rOStream) const override
+    {
+        rOStream << "Number of required eigenvalues: " << mRequiredEigenvalueNumber << std::endl;
+        rOStream << "Block size: " << mBlockSize << std::endl;
+        rOStream << "Shift: " << mShift << std::endl;
+    }
+
+    ///@}
+    ///@name Friends
+    ///@{
+
+
+    ///@}
+
+private:
+    ///@name Static Member Variables
+    ///@{
+
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+    unsigned int mRequiredEigenvalueNumber;
+
+    unsigned int mBlockSize;
+
+    DataType mShift;
+
+    typename TLinearSolverType::Pointer mpLinearSolver;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    static void FillRandom(DenseMatrixType& rA, std::mt19937& rGenerator)
+    {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (SizeType i = 0; i < rA.size1(); ++i)
+            for (SizeType j = 0; j < rA.size2(); ++j)
+                rA(i, j) = distribution(rGenerator);
+    }
+
+    /// rC = rA(:, a0:a0+na)^T * rB(:, b0:b0+nb), accumulated per thread over the rows
+    static void TransposeProduct(const DenseMatrixType& rA, SizeType a0, SizeType na,
+                                 const DenseMatrixType& rB, SizeType b0, SizeType nb,
+                                 DenseMatrixType& rC)
+    {
+        rC.resize(na, nb, false);
+        noalias(rC) = ZeroMatrix(na, nb);
+
+        const int nrows = static_cast<int>(rA.size1());
+        #pragma omp parallel
+        {
+            DenseMatrixType local = ZeroMatrix(na, nb);
+
+            #pragma omp for nowait
+            for (int r = 0; r < nrows; ++r)
+            {
+                for (SizeType i = 0; i < na; ++i)
+                {
+                    const DataType a = rA(r, a0 + i);
+                    for (SizeType j = 0; j < nb; ++j)
+                        local(i, j) += a * rB(r, b0 + j);
+                }
+            }
+
+            #pragma omp critical
+            {
+                noalias(rC) += local;
+            }
+        }
+    }
+
+    /// rB(:, b0:b0+nb) -= rA(:, 0:na) * rC
+    static void SubtractProduct(const DenseMatrixType& rA, SizeType na, const DenseMatrixType& rC,
+                                DenseMatrixType& rB, SizeType b0, SizeType nb)
+    {
+        const int nrows = static_cast<int>(rA.size1());
+        #pragma omp parallel for
+        for (int r = 0; r < nrows; ++r)
+        {
+            for (SizeType i = 0; i < na; ++i)
+            {
+                const DataType a = rA(r, i);
+                for (SizeType j = 0; j < nb; ++j)
+                    rB(r, b0 + j) -= a * rC(i, j);
+            }
+        }
+    }
+
+    /// rX = rA(:, 0:na) * rY
+    static void Product(const DenseMatrixType& rA, SizeType na, const DenseMatrixType& rY, DenseMatrixType& rX)
+    {
+        const SizeType ncols = rY.size2();
+        if (rX.size1() != rA.size1() || rX.size2() < ncols)
+            rX.resize(rA.size1(), ncols, false);
+
+        const int nrows = static_cast<int>(rA.size1());
+        #pragma omp parallel for
+        for (int r = 0; r < nrows; ++r)
+        {
+            for (SizeType k = 0; k < ncols; ++k)
+            {
+                DataType sum = 0.0;
+                for (SizeType i = 0; i < na; ++i)
+                    sum += rA(r, i) * rY(i, k);
+                rX(r, k) = sum;
+            }
+        }
+    }
+
+    /// rB(:, b0:b0+n) = rA(:, a0:a0+n)
+    static void CopyColumns(const DenseMatrixType& rA, SizeType a0, SizeType n, DenseMatrixType& rB, SizeType b0)
+    {
+        const int nrows = static_cast<int>(rA.size1());
+        #pragma omp parallel for
+        for (int r = 0; r < nrows; ++r)
+            for (SizeType j = 0; j < n; ++j)
+                rB(r, b0 + j) = rA(r, a0 + j);
+    }
+
+    /// rW = inv(K - shift*M) * MV(:, begin:begin+width)
+    void ApplyOperator(SparseMatrixType& rShiftedK, const DenseMatrixType& rMV, SizeType Begin, SizeType Width,
+                       DenseMatrixType& rW, bool ReuseFactorization, VectorType& rAuxX, VectorType& rAuxB)
+    {
+        const SizeType size = rMV.size1();
+
+        DenseMatrixType rhs(size, Width);
+        CopyColumns(rMV, Begin, Width, rhs, 0);
+
+        if (rW.size1() != size || rW.size2() != Width)
+            rW.resize(size, Width, false);
+
+        if (ReuseFactorization)
+        {
+            for (SizeType j = 0; j < Width; ++j)
+            {
+                TDenseSpaceType::GetColumn(j, rhs, rAuxB);
+                mpLinearSolver->PerformSolutionStep(rShiftedK, rAuxX, rAuxB);
+                TDenseSpaceType::SetColumn(j, rW, rAuxX);
+            }
+        }
+        else
+        {
+            noalias(rW) = ZeroMatrix(size, Width);
+            mpLinearSolver->Solve(rShiftedK, rW, rhs);
+        }
+    }
+
+    /**
+     * @brief M-orthonormalize the first Width columns of rBlock against V(:, 0:Current) and within the block
+     * @details Two passes of block classical Gram-Schmidt are used against the basis and two passes of modified
+     * Gram-Schmidt within the block, so that Block = V*C + Q*B with B upper triangular. Rank deficient columns
+     * get a zero diagonal coefficient and are replaced by random directions, so the basis keeps growing.
+     * rBlock is overwritten.
+     * @return The number of columns stored in rQ
+     */
+    SizeType OrthonormalizeBlock(SparseMatrixType& M, const DenseMatrixType& V, const DenseMatrixType& MV, SizeType Current,
+                                 DenseMatrixType& rBlock, SizeType Width, DenseMatrixType& rQ, DenseMatrixType& rMQ,
+                                 DenseMatrixType& rB, std::mt19937& rGenerator) const
+    {
+        const SizeType size = V.size1();
+        const ValueType breakdown_tolerance = 1.0e-10;
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        rQ.resize(size, Width, false);
+        rMQ.resize(size, Width, false);
+        rB.resize(Width, Width, false);
+        noalias(rB) = ZeroMatrix(Width, Width);
+
+        VectorType q(size), mq(size);
+        std::vector<ValueType> initial_norms(Width);
+        for (SizeType j = 0; j < Width; ++j)
+        {
+            TDenseSpaceType::GetColumn(j, rBlock, q);
+            TSparseSpaceType::Mult(M, q, mq);
+            initial_norms[j] = std::sqrt(std::abs(TSparseSpaceType::Dot(q, mq)));
+        }
+
+        ProjectOut(V, MV, Current, rBlock, Width);
+
+        SizeType added = 0;
+        for (SizeType j = 0; j < Width; ++j)
+        {
+            TDenseSpaceType::GetColumn(j, rBlock, q);
+
+            bool is_random = false;
+            for (unsigned int attempt = 0; attempt < 4; ++attempt)
+            {
+                for (unsigned int pass = 0; pass < 2; ++pass)
+                {
+                    for (SizeType i = 0; i < added; ++i)
+                    {
+                        DataType c = 0.0;
+                        for (SizeType r = 0; r < size; ++r)
+                            c += rMQ(r, i) * q[r];
+                        if (!is_random)
+                            rB(i, j) += c;
+                        for (SizeType r = 0; r < size; ++r)
+                            q[r] -= c * rQ(r, i);
+                    }
+                }
+
+                TSparseSpaceType::Mult(M, q, mq);
+                const ValueType norm = std::sqrt(std::abs(TSparseSpaceType::Dot(q, mq)));
+
+                if (norm > breakdown_tolerance * initial_norms[j] && norm > 0.0)
+                {
+                    if (!is_random)
+                        rB(j, j) = norm;
+                    TSparseSpaceType::InplaceMult(q, 1.0/norm);
+                    TSparseSpaceType::InplaceMult(mq, 1.0/norm);
+                    TDenseSpaceType::SetColumn(added, rQ, q);
+                    TDenseSpaceType::SetColumn(added, rMQ, mq);
+                    ++added;
+                    break;
+                }
+
+                // breakdown: the column is (numerically) in the span of the basis, continue with a random direction
+                is_random = true;
+                DenseMatrixType aux(size, 1);
+                for (SizeType r = 0; r < size; ++r)
+                    aux(r, 0) = distribution(rGenerator);
+                ProjectOut(V, MV, Current, aux, 1);
+                TDenseSpaceType::GetColumn(0, aux, q);
+                TSparseSpaceType::Mult(M, q, mq);
+                initial_norms[j] = std::sqrt(std::abs(TSparseSpaceType::Dot(q, mq)));
+            }
+        }
+
+        return added;
+    }
+
+    /// Two passes of block classical Gram-Schmidt: rBlock -= V*(MV^T*rBlock)
+    static void ProjectOut(const DenseMatrixType& V, const DenseMatrixType& MV, SizeType Current,
+                           DenseMatrixType& rBlock, SizeType Width)
+    {
+        if (Current == 0)
+            return;
+
+        for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+            DenseMatrixType C;
+            TransposeProduct(MV, 0, Current, rBlock, 0, Width, C);
+            SubtractProduct(V, Current, C, rBlock, 0, Width);
+        }
+    }
+
+    /**
+     * @brief Eigen-decomposition of the leading Size x Size block of the symmetric matrix rA
+     * @details Householder reduction to tridiagonal form followed by the implicit QL algorithm (EISPACK tred2/tql2)
+     */
+    static void SymmetricEigenDecomposition(const DenseMatrixType& rA, SizeType Size, DenseVectorType& rD, DenseMatrixType& rV)
+    {
+        const int n = static_cast<int>(Size);
+        rV.resize(Size, Size, false);
+        rD.resize(Size, false);
+        std::vector<double> e(Size, 0.0);
+
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                rV(i, j) = 0.5 * (rA(i, j) + rA(j, i));
+
+        for (int j = 0; j < n; ++j)
+            rD[j] = rV(n-1, j);
+
+        // Householder reduction to tridiagonal form
+        for (int i = n-1; i > 0; --i)
+        {
+            double scale = 0.0;
+            double h = 0.0;
+            for (int k = 0; k < i; ++k)
+                scale += std::abs(rD[k]);
+
+            if (scale == 0.0)
+            {
+                e[i] = rD[i-1];
+                for (int j = 0; j < i; ++j)
+                {
+                    rD[j] = rV(i-1, j);
+                    rV(i, j) = 0.0;
+                    rV(j, i) = 0.0;
+                }
+            }
+            else
+            {
+                for (int k = 0; k < i; ++k)
+                {
+                    rD[k] /= scale;
+                    h += rD[k] * rD[k];
+                }
+                double f = rD[i-1];
+                double g = std::sqrt(h);
+                if (f > 0.0) g = -g;
+                e[i] = scale * g;
+                h = h - f * g;
+                rD[i-1] = f - g;
+                for (int j = 0; j < i; ++j)
+                    e[j] = 0.0;
+
+                for (int j = 0; j < i; ++j)
+                {
+                    f = rD[j];
+                    rV(j, i) = f;
+                    g = e[j] + rV(j, j) * f;
+                    for (int k = j+1; k <= i-1; ++k)
+                    {
+                        g += rV(k, j) * rD[k];
+                        e[k] += rV(k, j) * f;
+                    }
+                    e[j] = g;
+                }
+                f = 0.0;
+                for (int j = 0; j < i; ++j)
+                {
+                    e[j] /= h;
+                    f += e[j] * rD[j];
+                }
+                const double hh = f / (h + h);
+                for (int j = 0; j < i; ++j)
+                    e[j] -= hh * rD[j];
+                for (int j = 0; j < i; ++j)
+                {
+                    f = rD[j];
+                    g = e[j];
+                    for (int k = j; k <= i-1; ++k)
+                        rV(k, j) -= (f * e[k] + g * rD[k]);
+                    rD[j] = rV(i-1, j);
+                    rV(i, j) = 0.0;
+                }
+            }
+            rD[i] = h;
+        }
+
+        // accumulate transformations
+        for (int i = 0; i < n-1; ++i)
+        {
+            rV(n-1, i) = rV(i, i);
+            rV(i, i) = 1.0;
+            const double h = rD[i+1];
+            if (h != 0.0)
+            {
+                for (int k = 0; k <= i; ++k)
+                    rD[k] = rV(k, i+1) / h;
+                for (int j = 0; j <= i; ++j)
+                {
+                    double g = 0.0;
+                    for (int k = 0; k <= i; ++k)
+                        g += rV(k, i+1) * rV(k, j);
+                    for (int k = 0; k <= i; ++k)
+                        rV(k, j) -= g * rD[k];
+                }
+            }
+            for (int k = 0; k <= i; ++k)
+                rV(k, i+1) = 0.0;
+        }
+        for (int j = 0; j < n; ++j)
+        {
+            rD[j] = rV(n-1, j);
+            rV(n-1, j) = 0.0;
+        }
+        rV(n-1, n-1) = 1.0;
+        e[0] = 0.0;
+
+        // implicit QL on the tridiagonal matrix
+        for (int i = 1; i < n; ++i)
+            e[i-1] = e[i];
+        e[n-1] = 0.0;
+
+        double f = 0.0;
+        double tst1 = 0.0;
+        const double eps = std::numeric_limits<double>::epsilon();
+        for (int l = 0; l < n; ++l)
+        {
+            tst1 = std::max(tst1, std::abs(rD[l]) + std::abs(e[l]));
+            int m = l;
+            while (m < n)
+            {
+                if (std::abs(e[m]) <= eps * tst1)
+                    break;
+                ++m;
+            }
+            if (m == n) m = n - 1;
+
+            if (m > l)
+            {
+                do
+                {
+                    double g = rD[l];
+                    double p = (rD[l+1] - g) / (2.0 * e[l]);
+                    double r = std::hypot(p, 1.0);
+                    if (p < 0) r = -r;
+                    rD[l] = e[l] / (p + r);
+                    rD[l+1] = e[l] * (p + r);
+                    const double dl1 = rD[l+1];
+                    double h = g - rD[l];
+                    for (int i = l+2; i < n; ++i)
+                        rD[i] -= h;
+                    f += h;
+
+                    p = rD[m];
+                    double c = 1.0, c2 = c, c3 = c;
+                    const double el1 = e[l+1];
+                    double s = 0.0, s2 = 0.0;
+                    for (int i = m-1; i >= l; --i)
+                    {
+                        c3 = c2;
+                        c2 = c;
+                        s2 = s;
+                        g = c * e[i];
+                        h = c * p;
+                        r = std::hypot(p, e[i]);
+                        e[i+1] = s * r;
+                        s = e[i] / r;
+                        c = p / r;
+                        p = c * rD[i] - s * g;
+                        rD[i+1] = h + s * (c * g + s * rD[i]);
+                        for (int k = 0; k < n; ++k)
+                        {
+                            h = rV(k, i+1);
+                            rV(k, i+1) = s * rV(k, i) + c * h;
+                            rV(k, i) = c * rV(k, i) - s * h;
+                        }
+                    }
+                    p = -s * s2 * c3 * el1 * e[l] / dl1;
+                    e[l] = s * p;
+                    rD[l] = c * p;
+                }
+                while (std::abs(e[l]) > eps * tst1);
+            }
+            rD[l] = rD[l] + f;
+            e[l] = 0.0;
+        }
+    }
+
+    ///@}
+
+}; // Class BlockLanczosEigenvalueSolver
+
+///@}
+
+///@name Type Definitions
+///@{
+
+
+///@}
+///@name Input and output
+///@{
+
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BLOCK_LANCZOS_EIGENVALUE_SOLVER_H_INCLUDED defined
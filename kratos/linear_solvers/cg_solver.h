@@ -168,6 +168,7 @@ public:
             is_solved &= IterativeSolve(rA,x,b);
 
             BaseType::GetPreconditioner()->Finalize(x);
+            TDenseSpaceType::SetColumn(i,rX, x);
         }
 
 // 	  GetTimeTable()->Stop(Info());
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <algorithm>
 
 // External includes
 
@@ -179,6 +180,21 @@ public:
         guess for iterative linear solvers.
         @param rB. Right hand side vector.
      */
+    /** This function is designed to clean up all internal data in the solver.
+     * The deflation structure and the factorization of the reduced matrix are released.
+     */
+    void Clear() override
+    {
+        mw.clear();
+        mAdeflated = SparseMatrixType();
+        mwt_index1.clear();
+        mwt_index2.clear();
+        mfill_map.clear();
+        mFactorization.clear();
+        mfactorized_values.clear();
+        BaseType::Clear();
+    }
+
     bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
     {
         std::cout << "************ DeflatedCGSolver::Solve(SparseMatrixType&, DenseMatrixType&, DenseMatrixType&) not defined! ************" << std::endl;
@@ -266,6 +282,15 @@ private:
     std::vector<int> mw;
     SparseMatrixType mAdeflated;
 
+    // transpose of the deflation matrix and position in mAdeflated of each non-zero of the system matrix
+    std::vector<std::size_t> mwt_index1;
+    std::vector<int> mwt_index2;
+    std::vector<std::size_t> mfill_map;
+
+    // factorization of mAdeflated, kept as long as the values of mAdeflated do not change
+    LUSkylineFactorization<TSparseSpaceType, TDenseSpaceType> mFactorization;
+    std::vector<DataType> mfactorized_values;
+
     //typename LinearSolverType::Pointer  mpLinearSolver;
 
     ///@}
@@ -283,28 +308,32 @@ private:
 
         //construct "coloring" structure and fill reduced matrix structure
         //note that this has to be done only once if the matrix structure is preserved
-        if (massume_constant_structure == false || mw.size() == 0)
+        if (massume_constant_structure == false || mw.size() == 0 || mfill_map.size() != rA.nnz())
         {
 //             std::cout << "constructing the W matrix and the reduced size one" << std::endl;
             DeflationUtilsType::ConstructW(mmax_reduced_size, rA, mw, mAdeflated);
+            DeflationUtilsType::ConstructWtranspose(mw, mAdeflated.size1(), mwt_index1, mwt_index2);
+            DeflationUtilsType::ConstructFillMap(rA, mw, mwt_index1, mwt_index2, mAdeflated, mfill_map);
+            mfactorized_values.clear();
         }
 
         //fill reduced matrix mmAdeflated
-        DeflationUtilsType::FillDeflatedMatrix(rA, mw, mAdeflated);
+        DeflationUtilsType::FillDeflatedMatrix(rA, mwt_index1, mwt_index2, mfill_map, mAdeflated);
 
         std::size_t reduced_size = mAdeflated.size1();
 
 //         std::cout << "within solver: full size=" << full_size << " reduced_size=" << reduced_size << " deflation factor = " << double(full_size) / double(reduced_size) << std::endl;
 
-        // To save some time, we do the factorization once, and do the solve several times.
-        // When this is available through the LinearSolver interface, replace this.
-
-        LUSkylineFactorization<TSparseSpaceType, TDenseSpaceType> Factorization;
-
-        //mpLinearSolver = LinearSolverType::Pointer(new SkylineLUFactorizationSolver<TSparseSpaceType, TDenseSpaceType>);
-
-        Factorization.copyFromCSRMatrix(mAdeflated);
-        Factorization.factorize();
+        // The factorization is done once, and the solve several times. It is kept for the next solves
+        // as long as the reduced matrix does not change.
+        const auto& r_deflated_values = mAdeflated.value_data();
+        if (mFactorization.size == 0 || mfactorized_values.size() != r_deflated_values.size()
+                || !std::equal(r_deflated_values.begin(), r_deflated_values.end(), mfactorized_values.begin()))
+        {
+            mFactorization.copyFromCSRMatrix(mAdeflated);
+            mFactorization.factorize();
+            mfactorized_values.assign(r_deflated_values.begin(), r_deflated_values.end());
+        }
 
 //         std::cout << "********** Factorization done!" << std::endl;
 
@@ -320,11 +349,11 @@ private:
 //             std::cout << "********** ||r|| = " << TSparseSpaceType::TwoNorm(r) << std::endl;
 
         // th = W^T * r -> form reduced problem
-        DeflationUtilsType::ApplyWtranspose(mw, r, th);
+        DeflationUtilsType::ApplyWtranspose(mwt_index1, mwt_index2, r, th);
         // 	TSparseSpaceType::TransposeMult(W, r, th);
 
         // Solve mAdeflated * th = dh
-        Factorization.backForwardSolve(reduced_size, th, dh);
+        mFactorization.backForwardSolve(reduced_size, th, dh);
 
         // t = W * dh -> transfer reduced problem to large scale one
         DeflationUtilsType::ApplyW(mw, dh, t);
@@ -344,11 +373,11 @@ private:
         this->PreconditionedMult(rA, r, t);
 
         // th = W^T * t
-        DeflationUtilsType::ApplyWtranspose(mw, t, th);
+        DeflationUtilsType::ApplyWtranspose(mwt_index1, mwt_index2, t, th);
         //	TSparseSpaceType::TransposeMult(W, t, th);
 
         // Solve mAdeflated * th = dh
-        Factorization.backForwardSolve(reduced_size, th, dh);
+        mFactorization.backForwardSolve(reduced_size, th, dh);
 
         // p = W * dh
         DeflationUtilsType::ApplyW(mw, dh, p);
@@ -397,11 +426,11 @@ private:
             TSparseSpaceType::Mult(rA, r, t);
 
             // th = W^T * t
-            DeflationUtilsType::ApplyWtranspose(mw, t, th);
+            DeflationUtilsType::ApplyWtranspose(mwt_index1, mwt_index2, t, th);
             // 	    TSparseSpaceType::TransposeMult(W, t, th);
 
             // Solve mAdeflated * th = dh
-            Factorization.backForwardSolve(reduced_size, th, dh);
+            mFactorization.backForwardSolve(reduced_size, th, dh);
 
             // t = W * dh
             DeflationUtilsType::ApplyW(mw, dh, t);
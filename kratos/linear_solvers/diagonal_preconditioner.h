@@ -151,6 +151,21 @@ public:
         ApplyLeft(rY);
     }
 
+    void Mult(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rY) override
+    {
+        DenseMatrixType temp(rX.size1(), rX.size2());
+        int i;
+        #pragma omp parallel for private(i)
+        for(i = 0 ; i < int(rX.size1()) ; ++i)
+            for(unsigned int k = 0 ; k < rX.size2() ; ++k)
+                temp(i, k) = rX(i, k) * mDiagonal[i];
+        TSparseSpaceType::Mult(rA, temp, rY);
+        #pragma omp parallel for private(i)
+        for(i = 0 ; i < int(rY.size1()) ; ++i)
+            for(unsigned int k = 0 ; k < rY.size2() ; ++k)
+                rY(i, k) *= mDiagonal[i];
+    }
+
     void TransposeMult(SparseMatrixType& rA, VectorType& rX, VectorType& rY) override
     {
         int i;
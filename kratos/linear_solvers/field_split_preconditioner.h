@@ -0,0 +1,499 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_FIELD_SPLIT_PRECONDITIONER_H_INCLUDED )
+#define  KRATOS_FIELD_SPLIT_PRECONDITIONER_H_INCLUDED
+
+// System includes
+#include <map>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "containers/variable_data.h"
+#include "linear_solvers/preconditioner.h"
+#include "linear_solvers/linear_solver.h"
+
+
+namespace Kratos
+{
+
+///@name  Enum's
+///@{
+
+/// The sweep of the FieldSplitPreconditioner over its blocks
+enum class FieldSplitType
+{
+    BlockJacobi,        // the blocks are solved independently
+    BlockGaussSeidel    // the coupling to the blocks solved before is subtracted from the right hand side of a block
+};
+
+///@}
+///@name Kratos Classes
+///@{
+
+///@name  Preconditioners
+///@{
+
+/// FieldSplitPreconditioner class.
+/** Block preconditioner of the systems with several fields, e.g. the displacements and the pressures, or the
+ * displacements and the temperatures. The equations are split in blocks by the variables of their dofs (the dofs of a
+ * variable which was not added to a block are in the block 0), and each diagonal block is inverted by its own inner
+ * preconditioner (e.g. ILU0) or linear solver (e.g. a direct solver). The blocks are identified from the dof set once
+ * per pattern of the matrix, and the diagonal blocks are extracted once per pattern, afterwards only their values are
+ * copied from the system matrix. The off-diagonal blocks of the block Gauss-Seidel sweep are not extracted, only the
+ * positions of their entries in the system matrix are kept with the pattern. A copy of the row starts and column
+ * indices of the matrix is kept to detect a change of the pattern, which costs one pass over the indices per Initialize.
+ * A direct inner solver which can reuse its factorization is factorized once per Initialize; other inner solvers
+ * solve the block at each application, which makes the preconditioner variable and needs a flexible outer solver.
+ * The block Gauss-Seidel preconditioner is not symmetric, hence it is meant for BiCGSTAB, TFQMR or GMRES.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType, class TModelPartType>
+class FieldSplitPreconditioner : public Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Counted pointer of FieldSplitPreconditioner
+    KRATOS_CLASS_POINTER_DEFINITION(FieldSplitPreconditioner);
+
+    typedef Preconditioner<TSparseSpaceType, TDenseSpaceType, TModelPartType> BaseType;
+
+    typedef LinearSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType> LinearSolverType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    typedef typename BaseType::ModelPartType ModelPartType;
+
+    typedef typename BaseType::IndexType IndexType;
+
+    typedef typename BaseType::SizeType SizeType;
+
+    typedef VariableData::KeyType KeyType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    FieldSplitPreconditioner(FieldSplitType Type = FieldSplitType::BlockGaussSeidel)
+    : mType(Type), mpA(nullptr), mPatternIsInitialized(false)
+    {
+    }
+
+    /// Destructor.
+    ~FieldSplitPreconditioner() override {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Add a block inverted by the preconditioner, and return its index
+    std::size_t AddBlock(typename BaseType::Pointer pPreconditioner)
+    {
+        mBlocks.push_back(Block());
+        mBlocks.back().pPreconditioner = pPreconditioner;
+        mBlockOfEquation.clear();
+        return mBlocks.size() - 1;
+    }
+
+    /// Add a block inverted by the linear solver, and return its index
+    std::size_t AddBlock(typename LinearSolverType::Pointer pSolver)
+    {
+        mBlocks.push_back(Block());
+        mBlocks.back().pSolver = pSolver;
+        mBlockOfEquation.clear();
+        return mBlocks.size() - 1;
+    }
+
+    /// Add the dofs of the variable (e.g. PRESSURE) to the block
+    void AddVariable(std::size_t BlockIndex, const VariableData& rVariable)
+    {
+        if (BlockIndex >= mBlocks.size())
+            KRATOS_ERROR << "Block " << BlockIndex << " does not exist, the number of blocks is " << mBlocks.size();
+        mVariableBlocks[rVariable.Key()] = BlockIndex;
+        mBlockOfEquation.clear();
+    }
+
+    bool AdditionalPhysicalDataIsNeeded() override
+    {
+        return true;
+    }
+
+    /// Assign the equations to the blocks; the extraction of the blocks is redone if the assignment changed
+    void ProvideAdditionalData(
+        SparseMatrixType& rA,
+        VectorType& rX,
+        VectorType& rB,
+        typename ModelPartType::DofsArrayType& rdof_set,
+        ModelPartType& r_model_part
+    ) override
+    {
+        const SizeType size = TSparseSpaceType::Size1(rA);
+        std::vector<unsigned int> block_of_equation(size, 0);
+        for (auto it = rdof_set.begin(); it != rdof_set.end(); ++it)
+        {
+            if (it->EquationId() < size)
+            {
+                auto it_block = mVariableBlocks.find(it->GetVariable().Key());
+                if (it_block != mVariableBlocks.end())
+                    block_of_equation[it->EquationId()] = it_block->second;
+            }
+        }
+
+        if (block_of_equation != mBlockOfEquation)
+        {
+            mBlockOfEquation.swap(block_of_equation);
+            mPatternIsInitialized = false;
+        }
+    }
+
+    /** FieldSplitPreconditioner Initialize
+    Extract the diagonal blocks of rA, or only copy their values if the pattern of rA did not change, and initialize
+    the inner preconditioners and solvers
+    @param rA  system matrix.
+    @param rX Unknows vector
+    @param rB Right side linear system of equations.
+    */
+    void Initialize(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        if (mBlocks.empty())
+            KRATOS_ERROR << "FieldSplitPreconditioner has no blocks";
+        if (mBlockOfEquation.size() != TSparseSpaceType::Size1(rA))
+            KRATOS_ERROR << "The blocks of the equations are not known, ProvideAdditionalData must be called with the dof set before the solution";
+
+        if (PatternHasChanged(rA))
+            InitializePattern(rA);
+
+        mpA = &rA;
+        CopyBlockValues(rA);
+
+        for (auto& r_block : mBlocks)
+        {
+            if (r_block.Equations.empty())
+                continue;
+            if (r_block.pPreconditioner != nullptr)
+                r_block.pPreconditioner->Initialize(r_block.A, r_block.X, r_block.B);
+            else if (r_block.pSolver->FactorizationIsReusable())
+                r_block.pSolver->InitializeSolutionStep(r_block.A, r_block.X, r_block.B);
+        }
+    }
+
+    void Initialize(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
+    {
+        VectorType x(TDenseSpaceType::Size1(rX)), b(TDenseSpaceType::Size1(rB));
+        Initialize(rA, x, b);
+    }
+
+    void Clear() override
+    {
+        for (auto& r_block : mBlocks)
+        {
+            if (r_block.pPreconditioner != nullptr)
+                r_block.pPreconditioner->Clear();
+            else
+                r_block.pSolver->Clear();
+            r_block.Equations.clear();
+            r_block.ValuePositions.clear();
+            r_block.CouplingRowStarts.clear();
+            r_block.CouplingPositions.clear();
+            r_block.CouplingColumns.clear();
+            r_block.A = SparseMatrixType();
+        }
+        mBlockOfEquation.clear();
+        mLocalIndex.clear();
+        mpA = nullptr;
+        mRowStarts.clear();
+        mColumnIndices.clear();
+        mPatternIsInitialized = false;
+    }
+
+    void Mult(SparseMatrixType& rA, VectorType& rX, VectorType& rY) override
+    {
+        TSparseSpaceType::Mult(rA, rX, rY);
+        ApplyLeft(rY);
+    }
+
+    void Mult(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rY) override
+    {
+        TSparseSpaceType::Mult(rA, rX, rY);
+        this->ApplyLeftToColumns(rY);
+    }
+
+    /** Apply the inverse of the block diagonal (block Jacobi) or of the block lower triangle (block Gauss-Seidel)
+    of the system matrix, with the diagonal blocks inverted by the inner preconditioners and solvers
+    @param rX  Unknows of preconditioner suystem
+    */
+    VectorType& ApplyLeft(VectorType& rX) override
+    {
+        // the rows of the blocks are disjoint, hence the blocks can be solved in place: the right hand side of a
+        // block is read before its rows are overwritten, and the Gauss-Seidel coupling only reads the rows of the
+        // blocks which were solved before
+        for (std::size_t b = 0; b < mBlocks.size(); ++b)
+        {
+            Block& r_block = mBlocks[b];
+            const int block_size = static_cast<int>(r_block.Equations.size());
+            if (block_size == 0)
+                continue;
+
+            if (mType == FieldSplitType::BlockGaussSeidel && b > 0)
+            {
+                const auto& r_values = mpA->value_data();
+
+                #pragma omp parallel for
+                for (int k = 0; k < block_size; ++k)
+                {
+                    DataType value = rX[r_block.Equations[k]];
+                    for (IndexType j = r_block.CouplingRowStarts[k]; j < r_block.CouplingRowStarts[k + 1]; ++j)
+                        value -= r_values[r_block.CouplingPositions[j]] * rX[r_block.CouplingColumns[j]];
+                    r_block.B[k] = value;
+                }
+            }
+            else
+            {
+                #pragma omp parallel for
+                for (int k = 0; k < block_size; ++k)
+                    r_block.B[k] = rX[r_block.Equations[k]];
+            }
+
+            if (r_block.pPreconditioner != nullptr)
+            {
+                TSparseSpaceType::Copy(r_block.B, r_block.X);
+                r_block.pPreconditioner->ApplyLeft(r_block.X);
+                r_block.pPreconditioner->ApplyRight(r_block.X);
+            }
+            else if (r_block.pSolver->FactorizationIsReusable())
+            {
+                r_block.pSolver->PerformSolutionStep(r_block.A, r_block.X, r_block.B);
+            }
+            else
+            {
+                TSparseSpaceType::SetToZero(r_block.X);
+                r_block.pSolver->Solve(r_block.A, r_block.X, r_block.B);
+            }
+
+            #pragma omp parallel for
+            for (int k = 0; k < block_size; ++k)
+                rX[r_block.Equations[k]] = r_block.X[k];
+        }
+
+        return rX;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    std::size_t NumberOfBlocks() const
+    {
+        return mBlocks.size();
+    }
+
+    /// The number of equations of the block
+    std::size_t BlockSize(std::size_t BlockIndex) const
+    {
+        return mBlocks[BlockIndex].Equations.size();
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Return information about this object.
+    std::string Info() const override
+    {
+        return "FieldSplitPreconditioner";
+    }
+
+    /// Print information about this object.
+    void PrintInfo(std::ostream& OStream) const override
+    {
+        OStream << Info();
+    }
+
+    void PrintData(std::ostream& OStream) const override
+    {
+        OStream << (mType == FieldSplitType::BlockJacobi ? "block Jacobi" : "block Gauss-Seidel") << " sweep over " << mBlocks.size() << " blocks:";
+        for (std::size_t b = 0; b < mBlocks.size(); ++b)
+        {
+            OStream << std::endl << "    block " << b << ": " << mBlocks[b].Equations.size() << " equations, "
+                    << (mBlocks[b].pPreconditioner != nullptr ? mBlocks[b].pPreconditioner->Info() : mBlocks[b].pSolver->Info());
+        }
+    }
+
+    ///@}
+
+private:
+    ///@name Type Definitions
+    ///@{
+
+    struct Block
+    {
+        typename BaseType::Pointer pPreconditioner;
+        typename LinearSolverType::Pointer pSolver;
+        std::vector<IndexType> Equations;       // the rows of the block in the system, in increasing order
+        std::vector<IndexType> ValuePositions;  // the positions of the entries of A in the values of the system matrix
+        std::vector<IndexType> CouplingRowStarts;   // the entries of the rows of the block in the columns of the
+        std::vector<IndexType> CouplingPositions;   // blocks before it, for the block Gauss-Seidel sweep: their
+        std::vector<IndexType> CouplingColumns;     // positions in the values of the system matrix and their columns
+        SparseMatrixType A;                     // the diagonal block
+        VectorType X;
+        VectorType B;
+    };
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+    FieldSplitType mType;
+
+    std::vector<Block> mBlocks;
+
+    std::map<KeyType, std::size_t> mVariableBlocks;
+
+    std::vector<unsigned int> mBlockOfEquation;
+
+    std::vector<IndexType> mLocalIndex; // the row of each equation in its block
+
+    SparseMatrixType* mpA; // the system matrix of the last Initialize, for the off-diagonal blocks
+
+    std::vector<IndexType> mRowStarts; // the pattern the blocks were extracted from
+
+    std::vector<IndexType> mColumnIndices;
+
+    bool mPatternIsInitialized;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// Extract the pattern of the diagonal blocks and the positions of their entries in the system matrix
+    void InitializePattern(SparseMatrixType& rA)
+    {
+        const SizeType size = TSparseSpaceType::Size1(rA);
+        const auto& r_row_indices = rA.index1_data();
+        const auto& r_column_indices = rA.index2_data();
+
+        for (auto& r_block : mBlocks)
+            r_block.Equations.clear();
+
+        mLocalIndex.resize(size);
+        for (IndexType i = 0; i < size; ++i)
+        {
+            Block& r_block = mBlocks[mBlockOfEquation[i]];
+            mLocalIndex[i] = r_block.Equations.size();
+            r_block.Equations.push_back(i);
+        }
+
+        for (std::size_t b = 0; b < mBlocks.size(); ++b)
+        {
+            Block& r_block = mBlocks[b];
+            const SizeType block_size = r_block.Equations.size();
+
+            r_block.ValuePositions.clear();
+            r_block.CouplingRowStarts.assign(1, 0);
+            r_block.CouplingPositions.clear();
+            r_block.CouplingColumns.clear();
+            for (IndexType k = 0; k < block_size; ++k)
+            {
+                const IndexType row = r_block.Equations[k];
+                for (IndexType j = r_row_indices[row]; j < r_row_indices[row + 1]; ++j)
+                {
+                    const IndexType column = r_column_indices[j];
+                    if (mBlockOfEquation[column] == b)
+                    {
+                        r_block.ValuePositions.push_back(j);
+                    }
+                    else if (mType == FieldSplitType::BlockGaussSeidel && mBlockOfEquation[column] < b)
+                    {
+                        r_block.CouplingPositions.push_back(j);
+                        r_block.CouplingColumns.push_back(column);
+                    }
+                }
+                r_block.CouplingRowStarts.push_back(r_block.CouplingPositions.size());
+            }
+
+            // the local columns follow the order of the global ones, hence the rows of the block stay sorted
+            r_block.A = SparseMatrixType(block_size, block_size);
+            r_block.A.reserve(r_block.ValuePositions.size(), false);
+            for (IndexType k = 0; k < block_size; ++k)
+            {
+                const IndexType row = r_block.Equations[k];
+                for (IndexType j = r_row_indices[row]; j < r_row_indices[row + 1]; ++j)
+                    if (mBlockOfEquation[r_column_indices[j]] == b)
+                        r_block.A.push_back(k, mLocalIndex[r_column_indices[j]], DataType());
+            }
+
+            if (r_block.X.size() != block_size)
+                r_block.X.resize(block_size, false);
+            if (r_block.B.size() != block_size)
+                r_block.B.resize(block_size, false);
+            TSparseSpaceType::SetToZero(r_block.X);
+            TSparseSpaceType::SetToZero(r_block.B);
+
+            if (r_block.pPreconditioner == nullptr && block_size != 0)
+                r_block.pSolver->Initialize(r_block.A, r_block.X, r_block.B);
+        }
+
+        mRowStarts.assign(rA.index1_data().begin(), rA.index1_data().begin() + size + 1);
+        mColumnIndices.assign(rA.index2_data().begin(), rA.index2_data().begin() + rA.nnz());
+        mPatternIsInitialized = true;
+    }
+
+    /// Compare the row starts and the column indices of rA with the ones of the pattern the blocks were extracted from
+    bool PatternHasChanged(const SparseMatrixType& rA) const
+    {
+        if (!mPatternIsInitialized || mRowStarts.size() != TSparseSpaceType::Size1(rA) + 1 || mColumnIndices.size() != rA.nnz())
+            return true;
+        return !std::equal(mRowStarts.begin(), mRowStarts.end(), rA.index1_data().begin())
+            || !std::equal(mColumnIndices.begin(), mColumnIndices.end(), rA.index2_data().begin());
+    }
+
+    /// Copy the values of the diagonal blocks from the system matrix
+    void CopyBlockValues(const SparseMatrixType& rA)
+    {
+        const auto& r_values = rA.value_data();
+        for (auto& r_block : mBlocks)
+        {
+            auto& r_block_values = r_block.A.value_data();
+            const int number_of_entries = static_cast<int>(r_block.ValuePositions.size());
+
+            #pragma omp parallel for
+            for (int k = 0; k < number_of_entries; ++k)
+                r_block_values[k] = r_values[r_block.ValuePositions[k]];
+        }
+    }
+
+    ///@}
+
+}; // Class FieldSplitPreconditioner
+
+///@}
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_FIELD_SPLIT_PRECONDITIONER_H_INCLUDED  defined
@@ -144,6 +144,12 @@ public:
         ApplyLeft(rY);
     }
 
+    void Mult(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rY) override
+    {
+        TSparseSpaceType::Mult(rA, rX, rY);
+        this->ApplyLeftToColumns(rY);
+    }
+
     void TransposeMult(SparseMatrixType& rA, VectorType& rX, VectorType& rY) override
     {
         VectorType z = rX;
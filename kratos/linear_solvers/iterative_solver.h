@@ -437,6 +437,12 @@ protected:
         GetPreconditioner()->TransposeMult(rA, rX, rY);
     }
 
+    /// Multi-vector version of PreconditionedMult, the columns of rX and rY are the vectors
+    void PreconditionedMult(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rY)
+    {
+        GetPreconditioner()->Mult(rA, rX, rY);
+    }
+
     ///@}
     ///@name Protected  Access
     ///@{
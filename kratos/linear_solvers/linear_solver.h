@@ -250,6 +250,15 @@ public:
                         DenseMatrixType& Eigenvectors)
     {}
 
+    /** This function tells if the solver keeps the factorization computed in InitializeSolutionStep,
+     * so that PerformSolutionStep can be called repeatedly with different right hand sides until
+     * FinalizeSolutionStep is called. Eigenvalue solvers use this to factorize the shifted matrix only once.
+     */
+    virtual bool FactorizationIsReusable()
+    {
+        return false;
+    }
+
     /** Some solvers may require a minimum degree of knowledge of the structure of the matrix. To make an example
      * when solving a mixed u-p problem, it is important to identify the row associated to v and p.
      * another example is the automatic prescription of rotation null-space for smoothed-aggregation solvers
@@ -0,0 +1,448 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_MIXED_PRECISION_SOLVER_H_INCLUDED )
+#define  KRATOS_MIXED_PRECISION_SOLVER_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <cmath>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "linear_solvers/linear_solver.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Globals
+///@{
+
+///@}
+///@name Type Definitions
+///@{
+
+///@}
+///@name  Enum's
+///@{
+
+///@}
+///@name  Functions
+///@{
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class MixedPrecisionSolver
+ * @ingroup KratosCore
+ * @brief Iterative refinement of a solution computed by a lower precision linear solver
+ * @details A copy of the system matrix is kept in the data type of TLowSparseSpaceType (typically float) and the
+ * inner solver, with its preconditioner, works only on this copy. The residual is computed with the original
+ * matrix in the working precision and the correction solved by the inner solver is added to the solution,
+ * until the relative residual in the working precision is below the tolerance. The inner solver then only needs
+ * a loose tolerance. If the inner solver can reuse its factorization, the copy is factorized only once per solve.
+ * The matrix is converted once per solve: the copy made by ProvideAdditionalData is used by the next Solve, and the
+ * multi-vector Solve uses one copy for all the columns.
+ */
+template<class TSparseSpaceType, class TDenseSpaceType,
+         class TModelPartType,
+         class TLowSparseSpaceType, class TLowDenseSpaceType,
+         class TReordererType = Reorderer<TSparseSpaceType, TDenseSpaceType> >
+class MixedPrecisionSolver : public LinearSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TReordererType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of MixedPrecisionSolver
+    KRATOS_CLASS_POINTER_DEFINITION(MixedPrecisionSolver);
+
+    typedef LinearSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TReordererType> BaseType;
+
+    typedef LinearSolver<TLowSparseSpaceType, TLowDenseSpaceType, TModelPartType,
+                         Reorderer<TLowSparseSpaceType, TLowDenseSpaceType> > InnerSolverType;
+
+    typedef typename BaseType::DataType DataType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    typedef typename BaseType::SparseMatrixType SparseMatrixType;
+
+    typedef typename BaseType::VectorType VectorType;
+
+    typedef typename BaseType::DenseMatrixType DenseMatrixType;
+
+    typedef typename BaseType::ModelPartType ModelPartType;
+
+    typedef typename TLowSparseSpaceType::DataType LowDataType;
+
+    typedef typename TLowSparseSpaceType::MatrixType LowSparseMatrixType;
+
+    typedef typename TLowSparseSpaceType::VectorType LowVectorType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor.
+    MixedPrecisionSolver(typename InnerSolverType::Pointer pInnerSolver, ValueType NewTolerance, unsigned int NewMaxIterationsNumber)
+        : mpInnerSolver(pInnerSolver), mTolerance(NewTolerance), mMaxIterationsNumber(NewMaxIterationsNumber)
+        , mIterationsNumber(0), mResidualNorm(0.0), mBNorm(0.0), mLowMatrixIsUpToDate(false)
+    {}
+
+    /// Copy constructor.
+    MixedPrecisionSolver(const MixedPrecisionSolver& Other) : BaseType(Other)
+        , mpInnerSolver(Other.mpInnerSolver), mTolerance(Other.mTolerance), mMaxIterationsNumber(Other.mMaxIterationsNumber)
+        , mIterationsNumber(0), mResidualNorm(0.0), mBNorm(0.0), mLowMatrixIsUpToDate(false)
+    {}
+
+    /// Destructor.
+    ~MixedPrecisionSolver() override {}
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    /// Assignment operator.
+    MixedPrecisionSolver& operator=(const MixedPrecisionSolver& Other)
+    {
+        BaseType::operator=(Other);
+        mpInnerSolver = Other.mpInnerSolver;
+        mTolerance = Other.mTolerance;
+        mMaxIterationsNumber = Other.mMaxIterationsNumber;
+        mLowMatrixIsUpToDate = false;
+        return *this;
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    bool AdditionalPhysicalDataIsNeeded() override
+    {
+        return mpInnerSolver->AdditionalPhysicalDataIsNeeded();
+    }
+
+    void ProvideAdditionalData(
+        SparseMatrixType& rA,
+        VectorType& rX,
+        VectorType& rB,
+        typename ModelPartType::DofsArrayType& rdof_set,
+        ModelPartType& r_model_part
+    ) override
+    {
+        CopyToLowPrecision(rA, mLowA);
+        CopyToLowPrecision(rX, mLowX);
+        CopyToLowPrecision(rB, mLowB);
+        mLowMatrixIsUpToDate = true;
+        mpInnerSolver->ProvideAdditionalData(mLowA, mLowX, mLowB, rdof_set, r_model_part);
+    }
+
+    void Clear() override
+    {
+        mpInnerSolver->Clear();
+        mLowA = LowSparseMatrixType();
+        mLowX = LowVectorType();
+        mLowB = LowVectorType();
+        mLowMatrixIsUpToDate = false;
+    }
+
+    /** Normal solve method.
+    Solves the linear system Ax=b and puts the result on SystemVector& rX.
+    rX is also th initial guess.
+    @param rA. System matrix
+    @param rX. Solution vector. it's also the initial guess.
+    @param rB. Right hand side vector.
+    */
+    bool Solve(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        if(this->IsNotConsistent(rA, rX, rB))
+            return false;
+
+        UpdateLowPrecisionMatrix(rA);
+        return RefinementSolve(rA, rX, rB);
+    }
+
+    /** Multi solve method for solving a set of linear systems with same coefficient matrix.
+    Each column is refined separately, with the same lower precision copy of the matrix.
+    @param rA. System matrix
+    @param rX. Solution vectors, stored as columns. it's also the initial guess.
+    @param rB. Right hand side vectors, stored as columns.
+    */
+    bool Solve(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rB) override
+    {
+        if(this->IsNotConsistent(rA, rX, rB))
+            return false;
+
+        UpdateLowPrecisionMatrix(rA);
+
+        bool is_solved = true;
+        VectorType x(TDenseSpaceType::Size1(rX)), b(TDenseSpaceType::Size1(rB));
+        for (std::size_t k = 0; k < TDenseSpaceType::Size2(rX); ++k)
+        {
+            TDenseSpaceType::GetColumn(k, rX, x);
+            TDenseSpaceType::GetColumn(k, rB, b);
+            is_solved = RefinementSolve(rA, x, b) && is_solved;
+            TDenseSpaceType::SetColumn(k, rX, x);
+        }
+
+        return is_solved;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    void SetTolerance(ValueType NewTolerance) override
+    {
+        mTolerance = NewTolerance;
+    }
+
+    ValueType GetTolerance() const override
+    {
+        return mTolerance;
+    }
+
+    void SetMaxIterationsNumber(unsigned int NewMaxIterationsNumber)
+    {
+        mMaxIterationsNumber = NewMaxIterationsNumber;
+    }
+
+    unsigned int GetMaxIterationsNumber() const
+    {
+        return mMaxIterationsNumber;
+    }
+
+    /// Number of refinement steps, i.e. inner solves, of the last solve
+    unsigned int GetIterationsNumber() const
+    {
+        return mIterationsNumber;
+    }
+
+    ValueType GetResidualNorm() const
+    {
+        return mResidualNorm;
+    }
+
+    typename InnerSolverType::Pointer GetInnerSolver() const
+    {
+        return mpInnerSolver;
+    }
+
+    /// Memory in bytes used by the lower precision copy of the system matrix
+    std::size_t GetLowPrecisionMatrixMemory() const
+    {
+        return mLowA.index1_data().size() * sizeof(typename LowSparseMatrixType::size_type)
+             + mLowA.index2_data().size() * sizeof(typename LowSparseMatrixType::size_type)
+             + mLowA.value_data().size() * sizeof(LowDataType);
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        std::stringstream buffer;
+        buffer << "Mixed precision solver (" << DataTypeToString<LowDataType>::Get() << ") with " << mpInnerSolver->Info();
+        return  buffer.str();
+    }
+
+    /// Print information about this object.
+    void PrintInfo(std::ostream& rOStream) const override
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    void PrintData(std::ostream& rOStream) const override
+    {
+        rOStream << "Refinement steps: " << mIterationsNumber << std::endl;
+        rOStream << "Residual norm: " << mResidualNorm << ", normb: " << mBNorm << std::endl;
+        rOStream << "Lower precision matrix memory: " << GetLowPrecisionMatrixMemory() << " bytes" << std::endl;
+        mpInnerSolver->PrintData(rOStream);
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    typename InnerSolverType::Pointer mpInnerSolver;
+
+    ValueType mTolerance;
+
+    unsigned int mMaxIterationsNumber;
+
+    unsigned int mIterationsNumber;
+
+    ValueType mResidualNorm;
+
+    ValueType mBNorm;
+
+    LowSparseMatrixType mLowA;
+
+    LowVectorType mLowX;
+
+    LowVectorType mLowB;
+
+    bool mLowMatrixIsUpToDate;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// The matrix is converted to the lower precision, unless ProvideAdditionalData has just done it
+    void UpdateLowPrecisionMatrix(const SparseMatrixType& rA)
+    {
+        if (!mLowMatrixIsUpToDate)
+            CopyToLowPrecision(rA, mLowA);
+        mLowMatrixIsUpToDate = false;
+    }
+
+    /// The iterative refinement of rX, with the lower precision copy of rA already in mLowA
+    bool RefinementSolve(SparseMatrixType& rA, VectorType& rX, VectorType& rB)
+    {
+        const std::size_t size = TSparseSpaceType::Size(rX);
+
+        mIterationsNumber = 0;
+        mBNorm = TSparseSpaceType::TwoNorm(rB);
+        if (mBNorm == 0.0)
+        {
+            TSparseSpaceType::SetToZero(rX);
+            mResidualNorm = 0.0;
+            return true;
+        }
+
+        if (TLowSparseSpaceType::Size(mLowX) != size)
+        {
+            mLowX.resize(size, false);
+            mLowB.resize(size, false);
+        }
+
+        const bool reuse_factorization = mpInnerSolver->FactorizationIsReusable();
+        if (reuse_factorization)
+            mpInnerSolver->InitializeSolutionStep(mLowA, mLowX, mLowB);
+
+        VectorType r(size);
+        bool is_solved = false;
+        while (true)
+        {
+            // residual in the working precision
+            TSparseSpaceType::Mult(rA, rX, r);
+            TSparseSpaceType::ScaleAndAdd(1.0, rB, -1.0, r);
+            mResidualNorm = TSparseSpaceType::TwoNorm(r);
+
+            if (this->GetEchoLevel() > 0)
+            {
+                std::cout << "MixedPrecisionSolver refinement #" << mIterationsNumber << ", normr/normb = "
+                          << mResidualNorm / mBNorm << ", tol = " << mTolerance << std::endl;
+            }
+
+            is_solved = (mResidualNorm <= mTolerance * mBNorm);
+            if (is_solved || mIterationsNumber >= mMaxIterationsNumber)
+                break;
+
+            // the correction is solved for the normalized residual, so that the lower precision does not underflow
+            const ValueType scale = mResidualNorm;
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(size); ++i)
+            {
+                mLowB[i] = static_cast<LowDataType>(r[i] / scale);
+                mLowX[i] = LowDataType();
+            }
+
+            if (reuse_factorization)
+                mpInnerSolver->PerformSolutionStep(mLowA, mLowX, mLowB);
+            else
+                mpInnerSolver->Solve(mLowA, mLowX, mLowB);
+
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(size); ++i)
+                rX[i] += scale * static_cast<DataType>(mLowX[i]);
+
+            ++mIterationsNumber;
+        }
+
+        if (reuse_factorization)
+            mpInnerSolver->FinalizeSolutionStep(mLowA, mLowX, mLowB);
+
+        return is_solved;
+    }
+
+    /// Copy the matrix in the lower precision. The storage of the copy is reused if the number of non-zeros does not change.
+    static void CopyToLowPrecision(const SparseMatrixType& rA, LowSparseMatrixType& rLowA)
+    {
+        const std::size_t nnz = rA.nnz();
+        if (rLowA.size1() != rA.size1() || rLowA.size2() != rA.size2() || rLowA.nnz() != nnz)
+            rLowA = LowSparseMatrixType(rA.size1(), rA.size2(), nnz);
+
+        const std::size_t number_of_row_entries = rA.filled1();
+        for (std::size_t i = 0; i < number_of_row_entries; ++i)
+            rLowA.index1_data()[i] = rA.index1_data()[i];
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(nnz); ++i)
+        {
+            rLowA.index2_data()[i] = rA.index2_data()[i];
+            rLowA.value_data()[i] = static_cast<LowDataType>(rA.value_data()[i]);
+        }
+
+        rLowA.set_filled(rA.filled1(), rA.filled2());
+    }
+
+    static void CopyToLowPrecision(const VectorType& rX, LowVectorType& rLowX)
+    {
+        if (rLowX.size() != rX.size())
+            rLowX.resize(rX.size(), false);
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(rX.size()); ++i)
+            rLowX[i] = static_cast<LowDataType>(rX[i]);
+    }
+
+    ///@}
+
+}; // Class MixedPrecisionSolver
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+template<class TSparseSpaceType, class TDenseSpaceType, class TModelPartType,
+         class TLowSparseSpaceType, class TLowDenseSpaceType, class TReordererType>
+inline std::ostream& operator << (std::ostream& rOStream,
+                                  const MixedPrecisionSolver<TSparseSpaceType, TDenseSpaceType, TModelPartType, TLowSparseSpaceType, TLowDenseSpaceType, TReordererType>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_MIXED_PRECISION_SOLVER_H_INCLUDED  defined
@@ -207,6 +207,15 @@ public:
         ApplyLeft(rY);
     }
 
+    /** Multi-vector version of Mult, the columns of rX and rY are the vectors.
+    This base class is the identity preconditioner, so the matrix is applied to all the vectors in one pass.
+    Derived preconditioners override it, e.g. by applying ApplyLeft to the columns of rY with ApplyLeftToColumns.
+    */
+    virtual void Mult(SparseMatrixType& rA, DenseMatrixType& rX, DenseMatrixType& rY)
+    {
+        TSparseSpaceType::Mult(rA, rX, rY);
+    }
+
     virtual void TransposeMult(SparseMatrixType& rA, VectorType& rX, VectorType& rY)
     {
         VectorType z = rX;
@@ -316,6 +325,17 @@ protected:
     ///@name Protected Operations
     ///@{
 
+    /// Apply ApplyLeft to each column of rX
+    void ApplyLeftToColumns(DenseMatrixType& rX)
+    {
+        VectorType aux(TDenseSpaceType::Size1(rX));
+        for (unsigned int i = 0; i < TDenseSpaceType::Size2(rX); ++i)
+        {
+            TDenseSpaceType::GetColumn(i, rX, aux);
+            ApplyLeft(aux);
+            TDenseSpaceType::SetColumn(i, rX, aux);
+        }
+    }
 
     ///@}
     ///@name Protected  Access
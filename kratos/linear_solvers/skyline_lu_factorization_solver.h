@@ -568,6 +568,48 @@ public:
     /// Destructor.
     ~SkylineLUFactorizationSolver() override {}
 
+    /** Factorize the matrix and keep the factorization for the subsequent calls to PerformSolutionStep
+    @param rA. System matrix
+    @param rX. Solution vector.
+    @param rB. Right hand side vector.
+    */
+    void InitializeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        mFactorization.copyFromCSRMatrix(rA);
+        mFactorization.factorize();
+    }
+
+    /** Back substitution with the factorization computed in InitializeSolutionStep
+    @param rA. System matrix
+    @param rX. Solution vector.
+    @param rB. Right hand side vector.
+    */
+    void PerformSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        if (mFactorization.size == 0)
+            KRATOS_ERROR << "The factorization is not available. InitializeSolutionStep must be called first";
+
+        mFactorization.backForwardSolve(TSparseSpaceType::Size(rX), rB, rX);
+    }
+
+    /// Release the factorization
+    void FinalizeSolutionStep(SparseMatrixType& rA, VectorType& rX, VectorType& rB) override
+    {
+        mFactorization.clear();
+    }
+
+    /// Release the factorization
+    void Clear() override
+    {
+        mFactorization.clear();
+    }
+
+    /// The factorization is kept between InitializeSolutionStep and FinalizeSolutionStep
+    bool FactorizationIsReusable() override
+    {
+        return true;
+    }
+
     /** Normal solve method.
     Solves the linear system Ax=b and puts the result on SystemVector& rX.
     rX is also th initial guess for iterative methods.
@@ -651,6 +693,7 @@ public:
 
 private:
 
+    LUSkylineFactorization<TSparseSpaceType, TDenseSpaceType> mFactorization;
 
     /*        void CopyFromCSRMatrix(SparseMatrixType A)
             {
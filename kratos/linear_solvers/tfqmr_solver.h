@@ -141,6 +141,7 @@ public:
 
 
             BaseType::GetPreconditioner()->Finalize(x);
+            TDenseSpaceType::SetColumn(i,rX, x);
         }
 
 
@@ -0,0 +1,197 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_DIVIDE_INPUT_TO_PARTITIONS_PROCESS_H_INCLUDED )
+#define  KRATOS_DIVIDE_INPUT_TO_PARTITIONS_PROCESS_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/io.h"
+#include "processes/process.h"
+#include "processes/graph_coloring_process.h"
+#include "utilities/mesh_partitioning_utility.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class DivideInputToPartitionsProcess
+ * @ingroup KratosCore
+ * @brief Divide the input of an IO into partitions without external partitioner
+ * @details The nodes and the connectivities of the elements and conditions are read from the IO and
+ * partitioned by MeshPartitioningUtility. The graph of the neighbour partitions is colored by
+ * GraphColoringProcess and the IO writes one input per partition with IO::DivideInputToPartitions.
+ * The node ids must be consecutive from 1.
+ */
+template<class TModelPartType>
+class DivideInputToPartitionsProcess : public Process
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of DivideInputToPartitionsProcess
+    KRATOS_CLASS_POINTER_DEFINITION(DivideInputToPartitionsProcess);
+
+    typedef IO<TModelPartType> IOType;
+
+    typedef typename IOType::SizeType SizeType;
+
+    typedef typename IOType::IndexType IndexType;
+
+    typedef typename IOType::NodesContainerType NodesContainerType;
+
+    typedef typename IOType::ConnectivitiesContainerType ConnectivitiesContainerType;
+
+    typedef typename IOType::GraphType GraphType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor.
+    DivideInputToPartitionsProcess(IOType& rIO, SizeType NumberOfPartitions, int Verbosity = 0)
+    : mrIO(rIO), mPartitioner(NumberOfPartitions), mVerbosity(Verbosity)
+    {}
+
+    /// Destructor.
+    ~DivideInputToPartitionsProcess() override {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    void Execute() override
+    {
+        KRATOS_TRY
+
+        NodesContainerType nodes;
+        mrIO.ReadNodes(nodes);
+
+        std::vector<MeshPartitioningUtility::PointType> coordinates(nodes.size());
+        for (typename NodesContainerType::iterator it = nodes.begin(); it != nodes.end(); ++it)
+        {
+            KRATOS_ERROR_IF(it->Id() == 0 || it->Id() > nodes.size())
+                << "Node " << it->Id() << " is found among " << nodes.size() << " nodes, the node ids must be consecutive from 1";
+
+            MeshPartitioningUtility::PointType& r_point = coordinates[it->Id() - 1];
+            r_point[0] = it->X();
+            r_point[1] = it->Y();
+            r_point[2] = it->Z();
+        }
+        nodes.clear();
+
+        ConnectivitiesContainerType elements_connectivities, conditions_connectivities;
+        mrIO.ReadElementsConnectivities(elements_connectivities);
+        mrIO.ReadConditionsConnectivities(conditions_connectivities);
+
+        mPartitioner.Partition(coordinates, elements_connectivities, conditions_connectivities);
+
+        const SizeType number_of_partitions = mPartitioner.GetNumberOfPartitions();
+
+        GraphType domains_graph = mPartitioner.GetDomainsGraph();
+        GraphType domains_colored_graph;
+        int number_of_colors = 0;
+        GraphColoringProcess(number_of_partitions, domains_graph, domains_colored_graph, number_of_colors).Execute();
+
+        if (mVerbosity > 0)
+        {
+            std::cout << "DivideInputToPartitionsProcess: " << number_of_partitions << " partitions, "
+                      << number_of_colors << " colors" << std::endl;
+            mPartitioner.PrintData(std::cout);
+        }
+
+        mrIO.DivideInputToPartitions(number_of_partitions, domains_colored_graph,
+                                     mPartitioner.GetNodesPartitions(),
+                                     mPartitioner.GetElementsPartitions(),
+                                     mPartitioner.GetConditionsPartitions(),
+                                     mPartitioner.GetNodesAllPartitions(),
+                                     mPartitioner.GetElementsAllPartitions(),
+                                     mPartitioner.GetConditionsAllPartitions());
+
+        KRATOS_CATCH("")
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    /// The partitioner, holding the partitions and their quality after Execute
+    const MeshPartitioningUtility& GetPartitioner() const
+    {
+        return mPartitioner;
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        return "DivideInputToPartitionsProcess";
+    }
+
+    /// Print information about this object.
+    void PrintInfo(std::ostream& rOStream) const override
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    void PrintData(std::ostream& rOStream) const override
+    {
+        mPartitioner.PrintData(rOStream);
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    IOType& mrIO;
+
+    MeshPartitioningUtility mPartitioner;
+
+    int mVerbosity;
+
+    ///@}
+    ///@name Un accessible methods
+    ///@{
+
+    /// Assignment operator.
+    DivideInputToPartitionsProcess& operator=(DivideInputToPartitionsProcess const& rOther);
+
+    /// Copy constructor.
+    DivideInputToPartitionsProcess(DivideInputToPartitionsProcess const& rOther);
+
+    ///@}
+
+}; // Class DivideInputToPartitionsProcess
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_DIVIDE_INPUT_TO_PARTITIONS_PROCESS_H_INCLUDED  defined
@@ -51,7 +51,9 @@ namespace Kratos
 ///@{
 
 /// Short class definition.
-/** Detail class definition.
+/** Fills NEIGHBOUR_CONDITIONS of the nodes and, with TDim = 3, the neighbour conditions over the edges of each
+surface condition: over the edges 1-2, 2-0 and 0-1 of the triangles and 1-2, 2-3, 3-0 and 0-1 of the
+quadrilaterals, with an empty pointer over a boundary edge.
 */
 class FindConditionsNeighboursProcess
     : public Process
@@ -97,58 +99,64 @@ public:
     ///@name Operations
     ///@{
 
+    /// The neighbours are filled from the adjacency of the model part, which is rebuilt in parallel.
+    /// In 3D the neighbour of a condition over a boundary edge is empty.
     void Execute() override
     {
+        KRATOS_TRY
+
         NodesContainerType& rNodes = mr_model_part.Nodes();
         ConditionsContainerType& rConds = mr_model_part.Conditions();
 
-        //first of all the neighbour nodes and conditions array are initialized to the guessed size
-        //and empties the old entries
-        for(NodesContainerType::iterator in = rNodes.begin(); in!=rNodes.end(); in++)
-        {
-            (in->GetValue(NEIGHBOUR_CONDITIONS)).reserve(mavg_conds);
-            WeakPointerVector<Condition >& rC = in->GetValue(NEIGHBOUR_CONDITIONS);
-            rC.erase(rC.begin(),rC.end() );
-        }
-        for(ConditionsContainerType::iterator ic = rConds.begin(); ic!=rConds.end(); ic++)
-        {
-            (ic->GetValue(NEIGHBOUR_CONDITIONS)).reserve(3);
-            WeakPointerVector<Condition >& rC = ic->GetValue(NEIGHBOUR_CONDITIONS);
-            rC.erase(rC.begin(),rC.end() );
-        }
+        if (!mr_model_part.HasAdjacency())
+            mr_model_part.SetAdjacency(MeshAdjacency::Pointer(new MeshAdjacency()));
+
+        MeshAdjacency& rAdjacency = mr_model_part.GetAdjacency();
+        rAdjacency.BuildConditionalAdjacency(mr_model_part, mTDim == 3);
+
+        const MeshAdjacency::IndicesType& node_conditions_index = rAdjacency.NodeConditionsIndex();
+        const MeshAdjacency::IndicesType& node_conditions = rAdjacency.NodeConditions();
 
         //add the neighbour conditions to all the nodes in the mesh
-        for(ConditionsContainerType::iterator ic = rConds.begin(); ic!=rConds.end(); ic++)
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(rNodes.size()); ++i)
         {
-            Condition::GeometryType& pGeom = ic->GetGeometry();
-            for(unsigned int i = 0; i < pGeom.size(); i++)
-            {
-                //KRATOS_WATCH( pGeom[i] );
-                (pGeom[i].GetValue(NEIGHBOUR_CONDITIONS)).push_back( Condition::WeakPointer( *(ic.base()) ) );
-                //KRATOS_WATCH( (pGeom[i].GetValue(NEIGHBOUR_CONDITIONS)).size() );
-            }
+            WeakPointerVector<Condition >& rC = (rNodes.begin() + i)->GetValue(NEIGHBOUR_CONDITIONS);
+            rC.clear();
+            rC.reserve(node_conditions_index[i + 1] - node_conditions_index[i]);
+            for(std::size_t k = node_conditions_index[i]; k < node_conditions_index[i + 1]; ++k)
+                rC.push_back( Condition::WeakPointer( *(rConds.ptr_begin() + node_conditions[k]) ) );
         }
 
-        //adding the neighbouring conditions to the condition
-        //loop over faces
+        //adding the neighbouring conditions over the edges of the condition
         if (mTDim==3)
         {
-            for(ConditionsContainerType::iterator ic = rConds.begin(); ic!=rConds.end(); ic++)
+            const MeshAdjacency::IndicesType& condition_neighbours_index = rAdjacency.ConditionNeighboursIndex();
+            const MeshAdjacency::IndicesType& condition_neighbours = rAdjacency.ConditionNeighbours();
+
+            #pragma omp parallel for
+            for(int i = 0; i < static_cast<int>(rConds.size()); ++i)
             {
-                //face nodes
-                Geometry<Node<3> >& geom = (ic)->GetGeometry();
-                //vector of the 3 faces around the given face
-                (ic->GetValue(NEIGHBOUR_CONDITIONS)).resize(3);
-                WeakPointerVector< Condition >& neighb_faces = ic->GetValue(NEIGHBOUR_CONDITIONS);
-                //neighb_face is the vector containing pointers to the three faces around ic
-                //neighb_face[0] = neighbour face over edge 1-2 of element ic;
-                //neighb_face[1] = neighbour face over edge 2-0 of element ic;
-                //neighb_face[2] = neighbour face over edge 0-1 of element ic;
-                neighb_faces(0) = CheckForNeighbourFaces(geom[1].Id(), geom[2].Id(), geom[1].GetValue(NEIGHBOUR_CONDITIONS), ic->Id());
-                neighb_faces(1) = CheckForNeighbourFaces(geom[2].Id(), geom[0].Id(), geom[2].GetValue(NEIGHBOUR_CONDITIONS), ic->Id());
-                neighb_faces(2) = CheckForNeighbourFaces(geom[0].Id(), geom[1].Id(), geom[0].GetValue(NEIGHBOUR_CONDITIONS), ic->Id());
+                WeakPointerVector< Condition >& neighb_faces = (rConds.begin() + i)->GetValue(NEIGHBOUR_CONDITIONS);
+                neighb_faces.clear();
+                neighb_faces.reserve(condition_neighbours_index[i + 1] - condition_neighbours_index[i]);
+                for(std::size_t k = condition_neighbours_index[i]; k < condition_neighbours_index[i + 1]; ++k)
+                {
+                    if (condition_neighbours[k] == MeshAdjacency::NoNeighbour())
+                        neighb_faces.push_back( Condition::WeakPointer() );
+                    else
+                        neighb_faces.push_back( Condition::WeakPointer( *(rConds.ptr_begin() + condition_neighbours[k]) ) );
+                }
             }
         }
+        else
+        {
+            #pragma omp parallel for
+            for(int i = 0; i < static_cast<int>(rConds.size()); ++i)
+                (rConds.begin() + i)->GetValue(NEIGHBOUR_CONDITIONS).clear();
+        }
+
+        KRATOS_CATCH("")
     }
 
 
@@ -269,26 +277,6 @@ private:
 
     }
 
-    Condition::WeakPointer CheckForNeighbourFaces (unsigned int Id_1, unsigned int Id_2, WeakPointerVector< Condition >& neighbour_face, unsigned int face)
-    {
-        //look for the faces around node Id_1
-        for( WeakPointerVector< Condition >::iterator i =neighbour_face.begin(); i != neighbour_face.end(); i++)
-        {
-            //look for the nodes of the neighbour faces
-            Geometry<Node<3> >& neigh_face_geometry = (i)->GetGeometry();
-            for( unsigned int node_i = 0 ; node_i < neigh_face_geometry.size(); node_i++)
-            {
-                if (neigh_face_geometry[node_i].Id() == Id_2)
-                {
-                    if(i->Id() != face)
-                    {
-                        return *(i.base());
-                    }
-                }
-            }
-        }
-        return Condition::WeakPointer();
-    }
     ///@}
     ///@name Private Operations
     ///@{
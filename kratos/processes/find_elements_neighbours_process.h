@@ -97,136 +97,62 @@ public:
     ///@name Operations
     ///@{
 
+    /// The neighbours are filled from the adjacency of the model part, which is rebuilt in parallel.
+    /// Only the ACTIVE elements are considered; an element is its own neighbour over a boundary face.
     void Execute() override
     {
+        KRATOS_TRY
+
         NodesContainerType& rNodes = mr_model_part.Nodes();
         ElementsContainerType& rElems = mr_model_part.Elements();
 
-        //first of all the neighbour nodes and elements array are initialized to the guessed size
-        //and empties the old entries
-        for(NodesContainerType::iterator in = rNodes.begin(); in!=rNodes.end(); in++)
-        {
-            (in->GetValue(NEIGHBOUR_ELEMENTS)).reserve(mavg_elems);
-            WeakPointerVector<Element >& rE = in->GetValue(NEIGHBOUR_ELEMENTS);
-            rE.erase(rE.begin(),rE.end() );
-        }
-        for(ElementsContainerType::iterator ie = rElems.begin(); ie!=rElems.end(); ie++)
-        {
-            if(!ie->Is(ACTIVE)) continue;
-            (ie->GetValue(NEIGHBOUR_ELEMENTS)).reserve(NumberOfNeighbours(ie->GetGeometry().GetGeometryType()));
-            WeakPointerVector<Element >& rE = ie->GetValue(NEIGHBOUR_ELEMENTS);
-            rE.erase(rE.begin(),rE.end() );
-        }
+        if (!mr_model_part.HasAdjacency())
+            mr_model_part.SetAdjacency(MeshAdjacency::Pointer(new MeshAdjacency()));
+
+        MeshAdjacency& rAdjacency = mr_model_part.GetAdjacency();
+        if (mTDim == 2 || mTDim == 3)
+            rAdjacency.BuildElementalAdjacency(mr_model_part, true);
+        else
+            rAdjacency.BuildNodalAdjacency(mr_model_part, true);
+
+        const MeshAdjacency::IndicesType& node_elements_index = rAdjacency.NodeElementsIndex();
+        const MeshAdjacency::IndicesType& node_elements = rAdjacency.NodeElements();
 
         //add the neighbour elements to all the nodes in the mesh
-        for(ElementsContainerType::iterator ie = rElems.begin(); ie!=rElems.end(); ie++)
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(rNodes.size()); ++i)
         {
-            if(!ie->Is(ACTIVE)) continue;
-            Element::GeometryType& pGeom = ie->GetGeometry();
-            for(unsigned int i = 0; i < pGeom.size(); i++)
-            {
-                //KRATOS_WATCH( pGeom[i] );
-                (pGeom[i].GetValue(NEIGHBOUR_ELEMENTS)).push_back( Element::WeakPointer( *(ie.base()) ) );
-                //KRATOS_WATCH( (pGeom[i].GetValue(NEIGHBOUR_CONDITIONS)).size() );
-            }
+            WeakPointerVector<Element >& rE = (rNodes.begin() + i)->GetValue(NEIGHBOUR_ELEMENTS);
+            rE.clear();
+            rE.reserve(node_elements_index[i + 1] - node_elements_index[i]);
+            for(std::size_t k = node_elements_index[i]; k < node_elements_index[i + 1]; ++k)
+                rE.push_back( Element::WeakPointer( *(rElems.ptr_begin() + node_elements[k]) ) );
         }
 
-        //adding the neighbouring conditions to the condition
-        //loop over faces
-        if (mTDim==2)
-        {
-            for(ElementsContainerType::iterator ie = rElems.begin(); ie!=rElems.end(); ie++)
-            {
-                if(!ie->Is(ACTIVE)) continue;
-
-                //face nodes
-                Geometry<Node<3> >& geom = (ie)->GetGeometry();
-
-                if(geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Triangle2D3 || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Triangle2D6)
-                {
-                    //vector of the 3 faces around the given face
-                    (ie->GetValue(NEIGHBOUR_ELEMENTS)).resize(3);
-                    WeakPointerVector< Element >& neighb_elems = ie->GetValue(NEIGHBOUR_ELEMENTS);
-                    //neighb_face is the vector containing pointers to the three faces around ic
-                    //neighb_face[0] = neighbour face over edge 1-2 of element ic;
-                    //neighb_face[1] = neighbour face over edge 2-0 of element ic;
-                    //neighb_face[2] = neighbour face over edge 0-1 of element ic;
-                    neighb_elems(0) = CheckForNeighbourElems(geom[1].Id(), geom[2].Id(), geom[1].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(1) = CheckForNeighbourElems(geom[2].Id(), geom[0].Id(), geom[2].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(2) = CheckForNeighbourElems(geom[0].Id(), geom[1].Id(), geom[0].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                }
-                else if(geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Quadrilateral2D4
-                    || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Quadrilateral2D8
-                    || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Quadrilateral2D9)
-                {
-                    //vector of the 3 faces around the given face
-                    (ie->GetValue(NEIGHBOUR_ELEMENTS)).resize(4);
-                    WeakPointerVector< Element >& neighb_elems = ie->GetValue(NEIGHBOUR_ELEMENTS);
-                    //neighb_face is the vector containing pointers to the three faces around ic
-                    //neighb_face[0] = neighbour face over edge 1-2 of element ic;
-                    //neighb_face[1] = neighbour face over edge 2-3 of element ic;
-                    //neighb_face[2] = neighbour face over edge 3-0 of element ic;
-                    //neighb_face[3] = neighbour face over edge 0-1 of element ic;
-                    neighb_elems(0) = CheckForNeighbourElems(geom[1].Id(), geom[2].Id(), geom[1].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(1) = CheckForNeighbourElems(geom[2].Id(), geom[3].Id(), geom[2].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(2) = CheckForNeighbourElems(geom[3].Id(), geom[0].Id(), geom[3].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(3) = CheckForNeighbourElems(geom[0].Id(), geom[1].Id(), geom[0].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                }
-                else
-                {
-                    std::stringstream ss;
-                    ss << "The geometry type " << static_cast<int>(geom.GetGeometryType()) << " is invalid";
-                    KRATOS_THROW_ERROR(std::logic_error, ss.str(), "")
-                }
-            }
-        }
-        if (mTDim==3)
+        if (mTDim != 2 && mTDim != 3)
+            return;
+
+        const MeshAdjacency::IndicesType& element_neighbours_index = rAdjacency.ElementNeighboursIndex();
+        const MeshAdjacency::IndicesType& element_neighbours = rAdjacency.ElementNeighbours();
+
+        //adding the neighbouring elements over the faces of the element
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(rElems.size()); ++i)
         {
-            for(ElementsContainerType::iterator ie = rElems.begin(); ie!=rElems.end(); ie++)
+            ElementsContainerType::iterator ie = rElems.begin() + i;
+            if(!ie->Is(ACTIVE)) continue;
+
+            WeakPointerVector< Element >& neighb_elems = ie->GetValue(NEIGHBOUR_ELEMENTS);
+            neighb_elems.clear();
+            neighb_elems.reserve(element_neighbours_index[i + 1] - element_neighbours_index[i]);
+            for(std::size_t k = element_neighbours_index[i]; k < element_neighbours_index[i + 1]; ++k)
             {
-                if(!ie->Is(ACTIVE)) continue;
-
-                //face nodes
-                Geometry<Node<3> >& geom = (ie)->GetGeometry();
-
-                if(geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Tetrahedra3D4
-                    || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Tetrahedra3D10)
-                {
-                    //vector of the 3 faces around the given face
-                    (ie->GetValue(NEIGHBOUR_ELEMENTS)).resize(4);
-                    WeakPointerVector< Element >& neighb_elems = ie->GetValue(NEIGHBOUR_ELEMENTS);
-                    //neighb_face is the vector containing pointers to the three faces around ic
-                    //neighb_face[0] = neighbour face over edge 1-2 of element ic;
-                    //neighb_face[1] = neighbour face over edge 2-0 of element ic;
-                    //neighb_face[2] = neighbour face over edge 0-1 of element ic;
-                    neighb_elems(0) = CheckForNeighbourElemsTetra(geom[1].Id(), geom[2].Id(), geom[3].Id(), geom[1].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(1) = CheckForNeighbourElemsTetra(geom[2].Id(), geom[3].Id(), geom[0].Id(), geom[2].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(2) = CheckForNeighbourElemsTetra(geom[3].Id(), geom[0].Id(), geom[1].Id(), geom[3].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(3) = CheckForNeighbourElemsTetra(geom[0].Id(), geom[1].Id(), geom[2].Id(), geom[0].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                }
-                else if(geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Hexahedra3D8
-                    || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Hexahedra3D20
-                    || geom.GetGeometryType() == GeometryData::KratosGeometryType::Kratos_Hexahedra3D27)
-                {
-                    //vector of the 3 faces around the given face
-                    (ie->GetValue(NEIGHBOUR_ELEMENTS)).resize(6);
-                    WeakPointerVector< Element >& neighb_elems = ie->GetValue(NEIGHBOUR_ELEMENTS);
-                    //neighb_face is the vector containing pointers to the three faces around ic
-                    neighb_elems(0) = CheckForNeighbourElemsHexa(geom[3].Id(), geom[2].Id(), geom[1].Id(), geom[0].Id(), geom[3].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(1) = CheckForNeighbourElemsHexa(geom[0].Id(), geom[1].Id(), geom[5].Id(), geom[4].Id(), geom[0].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(2) = CheckForNeighbourElemsHexa(geom[2].Id(), geom[6].Id(), geom[5].Id(), geom[1].Id(), geom[2].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(3) = CheckForNeighbourElemsHexa(geom[7].Id(), geom[6].Id(), geom[2].Id(), geom[3].Id(), geom[7].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(4) = CheckForNeighbourElemsHexa(geom[7].Id(), geom[3].Id(), geom[0].Id(), geom[4].Id(), geom[7].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                    neighb_elems(5) = CheckForNeighbourElemsHexa(geom[4].Id(), geom[5].Id(), geom[6].Id(), geom[7].Id(), geom[4].GetValue(NEIGHBOUR_ELEMENTS), ie);
-                }
-                else
-                {
-                    std::stringstream ss;
-                    ss << "The geometry type " << static_cast<int>(geom.GetGeometryType()) << " is invalid";
-                    KRATOS_THROW_ERROR(std::logic_error, ss.str(), "")
-                }
+                const std::size_t neighbour = (element_neighbours[k] == MeshAdjacency::NoNeighbour()) ? i : element_neighbours[k];
+                neighb_elems.push_back( Element::WeakPointer( *(rElems.ptr_begin() + neighbour) ) );
             }
         }
+
+        KRATOS_CATCH("")
     }
 
 
@@ -347,107 +273,6 @@ private:
 
     }
 
-    Element::WeakPointer CheckForNeighbourElems (const unsigned int& Id_1, const unsigned int& Id_2,
-        WeakPointerVector< Element >& neighbour_elem, ElementsContainerType::iterator elem)
-    {
-        //look for the faces around node Id_1
-        for( WeakPointerVector< Element >::iterator i = neighbour_elem.begin(); i != neighbour_elem.end(); i++)
-        {
-            //look for the nodes of the neighbour faces
-            Geometry<Node<3> >& neigh_elem_geometry = (i)->GetGeometry();
-            for( unsigned int node_i = 0 ; node_i < neigh_elem_geometry.size(); node_i++)
-            {
-                if (neigh_elem_geometry[node_i].Id() == Id_2)
-                {
-                    if(i->Id() != elem->Id())
-                    {
-                        return *(i.base());
-                    }
-                }
-            }
-        }
-        return *(elem.base());
-    }
-
-    Element::WeakPointer CheckForNeighbourElemsTetra (const unsigned int& Id_1,
-        const unsigned int& Id_2, const unsigned int& Id_3,
-        WeakPointerVector< Element >& neighbour_elem, ElementsContainerType::iterator elem)
-    {
-        //look for the faces around node Id_1
-        for( WeakPointerVector< Element >::iterator i = neighbour_elem.begin(); i != neighbour_elem.end(); i++)
-        {
-            //look for the nodes of the neighbour faces
-            Geometry<Node<3> >& neigh_elem_geometry = (i)->GetGeometry();
-            for( unsigned int node_i = 0 ; node_i < neigh_elem_geometry.size(); node_i++)
-            {
-                if (neigh_elem_geometry[node_i].Id() == Id_2)
-                {
-                    for( unsigned int node_j = 0 ; node_j < neigh_elem_geometry.size(); node_j++)
-                    {
-                        if (neigh_elem_geometry[node_j].Id() == Id_3)
-                            if(i->Id() != elem->Id())
-                            {
-                                return *(i.base());
-                            }
-                    }
-                }
-            }
-        }
-        return *(elem.base());
-    }
-
-    Element::WeakPointer CheckForNeighbourElemsHexa (const unsigned int& Id_1,
-        const unsigned int& Id_2, const unsigned int& Id_3, const unsigned int& Id_4,
-        WeakPointerVector< Element >& neighbour_elem, ElementsContainerType::iterator elem)
-    {
-        //look for the faces around node Id_1
-        for( WeakPointerVector< Element >::iterator i = neighbour_elem.begin(); i != neighbour_elem.end(); i++)
-        {
-            //look for the nodes of the neighbour faces
-            Geometry<Node<3> >& neigh_elem_geometry = (i)->GetGeometry();
-            for( unsigned int node_i = 0 ; node_i < neigh_elem_geometry.size(); node_i++)
-            {
-                if (neigh_elem_geometry[node_i].Id() == Id_2)
-                {
-                    for( unsigned int node_j = 0 ; node_j < neigh_elem_geometry.size(); node_j++)
-                    {
-                        if (neigh_elem_geometry[node_j].Id() == Id_3)
-                        {
-                            for( unsigned int node_k = 0 ; node_k < neigh_elem_geometry.size(); node_k++)
-                            {
-                                if (neigh_elem_geometry[node_k].Id() == Id_4)
-                                    if(i->Id() != elem->Id())
-                                    {
-                                        return *(i.base());
-                                    }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        return *(elem.base());
-    }
-
-    /// Get the number of neighbours of a specific geometry type. It is typically the same as number of element edges.
-    static int NumberOfNeighbours(const GeometryData::KratosGeometryType& rGeometryType)
-    {
-        switch(rGeometryType)
-        {
-            case GeometryData::KratosGeometryType::Kratos_Triangle2D3: return 3;
-            case GeometryData::KratosGeometryType::Kratos_Triangle2D6: return 3;
-            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D4: return 4;
-            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D8: return 4;
-            case GeometryData::KratosGeometryType::Kratos_Quadrilateral2D9: return 4;
-            case GeometryData::KratosGeometryType::Kratos_Tetrahedra3D4: return 4;
-            case GeometryData::KratosGeometryType::Kratos_Tetrahedra3D10: return 4;
-            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D8: return 6;
-            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D20: return 6;
-            case GeometryData::KratosGeometryType::Kratos_Hexahedra3D27: return 6;
-            default: return 0;
-        }
-    }
-
     ///@}
     ///@name Private Operations
     ///@{
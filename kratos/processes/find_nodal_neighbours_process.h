@@ -96,54 +96,45 @@ public:
     ///@name Operations
     ///@{
 
+    /// The neighbours are filled from the adjacency of the model part, which is rebuilt in parallel
     void Execute() override
     {
+        KRATOS_TRY
+
         NodesContainerType& rNodes = mr_model_part.Nodes();
         ElementsContainerType& rElems = mr_model_part.Elements();
 
-        //first of all the neighbour nodes and elements array are initialized to the guessed size
-        //and empties the old entries
-        for(NodesContainerType::iterator in = rNodes.begin(); in!=rNodes.end(); in++)
-        {
-            (in->GetValue(NEIGHBOUR_NODES)).reserve(mavg_nodes);
-            WeakPointerVector<Node<3> >& rN = in->GetValue(NEIGHBOUR_NODES);
-            rN.erase(rN.begin(),rN.end() );
+        if (!mr_model_part.HasAdjacency())
+            mr_model_part.SetAdjacency(MeshAdjacency::Pointer(new MeshAdjacency()));
 
-            (in->GetValue(NEIGHBOUR_ELEMENTS)).reserve(mavg_elems);
-            WeakPointerVector<Element >& rE = in->GetValue(NEIGHBOUR_ELEMENTS);
-            rE.erase(rE.begin(),rE.end() );
-        }
+        MeshAdjacency& rAdjacency = mr_model_part.GetAdjacency();
+        rAdjacency.BuildNodalAdjacency(mr_model_part);
 
-        //add the neighbour elements to all the nodes in the mesh
-        for(ElementsContainerType::iterator ie = rElems.begin(); ie!=rElems.end(); ie++)
-        {
-            Element::GeometryType& pGeom = ie->GetGeometry();
-            for(unsigned int i = 0; i < pGeom.size(); i++)
-            {
-                //KRATOS_WATCH( pGeom[i] );
-                (pGeom[i].GetValue(NEIGHBOUR_ELEMENTS)).push_back( Element::WeakPointer( *(ie.base()) ) );
-                //KRATOS_WATCH( (pGeom[i].GetValue(NEIGHBOUR_ELEMENTS)).size() );
-            }
-        }
+        const MeshAdjacency::IndicesType& node_elements_index = rAdjacency.NodeElementsIndex();
+        const MeshAdjacency::IndicesType& node_elements = rAdjacency.NodeElements();
+        const MeshAdjacency::IndicesType& node_nodes_index = rAdjacency.NodeNodesIndex();
+        const MeshAdjacency::IndicesType& node_nodes = rAdjacency.NodeNodes();
 
-        //adding the neighbouring nodes
-        for(NodesContainerType::iterator in = rNodes.begin(); in!=rNodes.end(); in++)
+        //the neighbour elements are in the order of the elements container and the neighbour nodes in the order they first appear in them
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(rNodes.size()); ++i)
         {
+            NodesContainerType::iterator in = rNodes.begin() + i;
+
             WeakPointerVector<Element >& rE = in->GetValue(NEIGHBOUR_ELEMENTS);
+            rE.clear();
+            rE.reserve(node_elements_index[i + 1] - node_elements_index[i]);
+            for(std::size_t k = node_elements_index[i]; k < node_elements_index[i + 1]; ++k)
+                rE.push_back( Element::WeakPointer( *(rElems.ptr_begin() + node_elements[k]) ) );
 
-            for(unsigned int ie = 0; ie < rE.size(); ie++)
-            {
-                Element::GeometryType& pGeom = rE[ie].GetGeometry();
-                for(unsigned int i = 0; i < pGeom.size(); i++)
-                {
-                    if(pGeom[i].Id() != in->Id() )
-                    {
-                        Element::NodeType::WeakPointer temp = pGeom(i);
-                        AddUniqueWeakPointer< Node<3> >(in->GetValue(NEIGHBOUR_NODES), temp);
-                    }
-                }
-            }
+            WeakPointerVector<Node<3> >& rN = in->GetValue(NEIGHBOUR_NODES);
+            rN.clear();
+            rN.reserve(node_nodes_index[i + 1] - node_nodes_index[i]);
+            for(std::size_t k = node_nodes_index[i]; k < node_nodes_index[i + 1]; ++k)
+                rN.push_back( Node<3>::WeakPointer( *(rNodes.ptr_begin() + node_nodes[k]) ) );
         }
+
+        KRATOS_CATCH("")
     }
 
     void ClearNeighbours()
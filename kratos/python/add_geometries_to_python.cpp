@@ -22,6 +22,9 @@
 #include "includes/node.h"
 #include "geometries/geometry.h"
 #include "geometries/triangle_2d_3.h"
+#include "geometries/triangle_3d_3.h"
+#include "geometries/quadrilateral_3d_4.h"
+#include "geometries/tetrahedra_3d_4.h"
 #include "python/add_geometries_to_python.h"
 #include "python/bounded_vector_python_interface.h"
 #include "python/vector_scalar_operator_python.h"
@@ -66,6 +69,15 @@ void  AddGeometriesToPython()
     class_<Triangle2D3<Node<3> >, Triangle2D3<Node<3> >::Pointer, bases< GeometryType > >("Triangle2D3", init<Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer>())
     ;
 
+    class_<Triangle3D3<Node<3> >, Triangle3D3<Node<3> >::Pointer, bases< GeometryType > >("Triangle3D3", init<Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer>())
+    ;
+
+    class_<Quadrilateral3D4<Node<3> >, Quadrilateral3D4<Node<3> >::Pointer, bases< GeometryType > >("Quadrilateral3D4", init<Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer>())
+    ;
+
+    class_<Tetrahedra3D4<Node<3> >, Tetrahedra3D4<Node<3> >::Pointer, bases< GeometryType > >("Tetrahedra3D4", init<Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer, Node<3>::Pointer>())
+    ;
+
 
 //     class_<GeometryType, GeometryType::Pointer, bases<PointerVector< Node<3> > > >("Geometry", init<>())
 //      .def(init< GeometryType::PointsArrayType& >())
@@ -217,9 +217,10 @@ void AddIOToPython()
     AddModelPartIOToPython<GComplexModelPart>("GComplex");
 
 #ifdef JSON_INCLUDED
-    class_<KratosJsonIO, KratosJsonIO::Pointer, bases<BaseIO>, boost::noncopyable>(
+    class_<KratosJsonIO, KratosJsonIO::Pointer, bases<IO<> >, boost::noncopyable>(
          "JsonIO",init<std::string const&>())
         .def(init<std::string const&, const Flags>())
+        .def("WriteModelPart", &KratosJsonIO::WriteModelPart)
     ;
 #endif
 
@@ -48,9 +48,10 @@ bool HasVariable(Kernel& rKernel, const std::string& variable_name)
 template< class TVariableType >
 const TVariableType& GetVariable(Kernel& rKernel, const std::string& variable_name)
 {
-    if(KratosComponents<TVariableType>::Has(variable_name))
+    const TVariableType* p_variable = KratosComponents<TVariableType>::pFind(variable_name);
+    if(p_variable != nullptr)
     {
-        return KratosComponents<TVariableType>::Get(variable_name);
+        return *p_variable;
     }
 
     return TVariableType::StaticObject();
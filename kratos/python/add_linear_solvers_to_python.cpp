@@ -33,6 +33,8 @@
 #include "linear_solvers/deflated_cg_solver.h"
 #include "linear_solvers/bicgstab_solver.h"
 #include "linear_solvers/tfqmr_solver.h"
+#include "linear_solvers/block_cg_solver.h"
+#include "linear_solvers/block_bicgstab_solver.h"
 #include "includes/dof.h"
 #include "spaces/ublas_space.h"
 #ifdef _OPENMP
@@ -49,9 +51,12 @@
 #include "linear_solvers/diagonal_preconditioner.h"
 #include "linear_solvers/ilu0_preconditioner.h"
 #include "linear_solvers/ilu_preconditioner.h"
+#include "linear_solvers/field_split_preconditioner.h"
 //#include "linear_solvers/superlu_solver.h"
 #include "linear_solvers/power_iteration_eigenvalue_solver.h"
+#include "linear_solvers/block_lanczos_eigenvalue_solver.h"
 #include "linear_solvers/deflated_gmres_solver.h"
+#include "linear_solvers/mixed_precision_solver.h"
 
 
 
@@ -98,12 +103,16 @@ void AddLinearSolversToPythonImpl(const std::string& Prefix)
     typedef MixedUPLinearSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> MixedUPLinearSolverType;
     typedef BICGSTABSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> BICGSTABSolverType;
     typedef TFQMRSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> TFQMRSolverType;
+    typedef BlockCGSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> BlockCGSolverType;
+    typedef BlockBICGSTABSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> BlockBICGSTABSolverType;
     typedef ScalingSolver<SparseSpaceType, LocalSpaceType, ModelPartType, ReordererType> ScalingSolverType;
     typedef PowerIterationEigenvalueSolver<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPartType, PreconditionerType, ReordererType> PowerIterationEigenvalueSolverType;
     typedef DeflatedGMRESSolver<SparseSpaceType, LocalSpaceType, ModelPartType, PreconditionerType, ReordererType> DeflatedGMRESSolverType;
 
     bool (LinearSolverType::*pointer_to_solve)(typename LinearSolverType::SparseMatrixType& rA,
             typename LinearSolverType::VectorType& rX, typename LinearSolverType::VectorType& rB) = &LinearSolverType::Solve;
+    bool (LinearSolverType::*pointer_to_multi_solve)(typename LinearSolverType::SparseMatrixType& rA,
+            typename LinearSolverType::DenseMatrixType& rX, typename LinearSolverType::DenseMatrixType& rB) = &LinearSolverType::Solve;
 
     using namespace boost::python;
 
@@ -132,6 +141,19 @@ void AddLinearSolversToPythonImpl(const std::string& Prefix)
     .def(self_ns::str(self))
     ;
 
+    typedef FieldSplitPreconditioner<SparseSpaceType, LocalSpaceType, TModelPartType> FieldSplitPreconditionerType;
+    std::size_t (FieldSplitPreconditionerType::*pointer_to_add_preconditioner_block)(typename PreconditionerType::Pointer) = &FieldSplitPreconditionerType::AddBlock;
+    std::size_t (FieldSplitPreconditionerType::*pointer_to_add_solver_block)(typename LinearSolverType::Pointer) = &FieldSplitPreconditionerType::AddBlock;
+    class_<FieldSplitPreconditionerType, typename FieldSplitPreconditionerType::Pointer, bases<PreconditionerType> >((Prefix + "FieldSplitPreconditioner").c_str())
+    .def(init<FieldSplitType>())
+    .def("AddBlock", pointer_to_add_preconditioner_block)
+    .def("AddBlock", pointer_to_add_solver_block)
+    .def("AddVariable", &FieldSplitPreconditionerType::AddVariable)
+    .def("NumberOfBlocks", &FieldSplitPreconditionerType::NumberOfBlocks)
+    .def("BlockSize", &FieldSplitPreconditionerType::BlockSize)
+    .def(self_ns::str(self))
+    ;
+
     //****************************************************************************************************
     //linear solvers
     //****************************************************************************************************
@@ -162,6 +184,20 @@ void AddLinearSolversToPythonImpl(const std::string& Prefix)
     .def("SetTolerance",&BICGSTABSolverType::SetTolerance)
     ;
 
+    class_<BlockCGSolverType, typename BlockCGSolverType::Pointer, bases<IterativeSolverType> >((Prefix + "BlockCGSolver").c_str())
+    .def(init<ValueType>())
+    .def(init<ValueType, unsigned int>())
+    .def(init<ValueType, unsigned int, typename PreconditionerType::Pointer>())
+    .def("Solve", pointer_to_multi_solve)
+    ;
+
+    class_<BlockBICGSTABSolverType, typename BlockBICGSTABSolverType::Pointer, bases<IterativeSolverType> >((Prefix + "BlockBICGSTABSolver").c_str())
+    .def(init<ValueType>())
+    .def(init<ValueType, unsigned int>())
+    .def(init<ValueType, unsigned int, typename PreconditionerType::Pointer>())
+    .def("Solve", pointer_to_multi_solve)
+    ;
+
     class_<TFQMRSolverType, typename TFQMRSolverType::Pointer, bases<IterativeSolverType> >((Prefix + "TFQMRSolver").c_str())
     .def(init<ValueType>())
     .def(init<ValueType, unsigned int>())
@@ -202,14 +238,123 @@ void AddLinearSolversToPythonImpl(const std::string& Prefix)
     ;
 }
 
+/// Eigenvalue solvers which are only available for real symmetric problems
+template<typename TSparseSpaceType, typename TLocalSpaceType, typename TModelPartType>
+void AddRealEigenvalueSolversToPythonImpl(const std::string& Prefix)
+{
+    typedef TSparseSpaceType SparseSpaceType;
+    typedef typename SparseSpaceType::DataType DataType;
+    typedef typename SparseSpaceType::ValueType ValueType;
+    typedef TLocalSpaceType LocalSpaceType;
+    typedef Reorderer<SparseSpaceType, LocalSpaceType> ReordererType;
+    typedef TModelPartType ModelPartType;
+    typedef Preconditioner<SparseSpaceType, LocalSpaceType, ModelPartType> PreconditionerType;
+
+    typedef LinearSolver<SparseSpaceType, LocalSpaceType, ModelPartType, ReordererType> LinearSolverType;
+    typedef BlockLanczosEigenvalueSolver<SparseSpaceType, LocalSpaceType, LinearSolverType, ModelPartType, PreconditionerType, ReordererType> BlockLanczosEigenvalueSolverType;
+
+    using namespace boost::python;
+
+    class_<BlockLanczosEigenvalueSolverType, typename BlockLanczosEigenvalueSolverType::Pointer, bases<LinearSolverType> >((Prefix + "BlockLanczosEigenvalueSolver").c_str())
+    .def(init<ValueType, unsigned int, unsigned int, unsigned int, DataType, typename LinearSolverType::Pointer>())
+    .def("SetShift", &BlockLanczosEigenvalueSolverType::SetShift)
+    .def("GetShift", &BlockLanczosEigenvalueSolverType::GetShift)
+    ;
+}
+
+/// Lower precision solvers, which are only used as inner solvers of the mixed precision solver
+template<typename TSparseSpaceType, typename TLocalSpaceType, typename TLowSparseSpaceType, typename TLowLocalSpaceType, typename TModelPartType>
+void AddMixedPrecisionSolversToPythonImpl(const std::string& Prefix, const std::string& LowPrefix)
+{
+    typedef typename TSparseSpaceType::ValueType ValueType;
+    typedef typename TLowSparseSpaceType::ValueType LowValueType;
+    typedef Reorderer<TLowSparseSpaceType, TLowLocalSpaceType> LowReordererType;
+    typedef Preconditioner<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType> LowPreconditionerType;
+    typedef DiagonalPreconditioner<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType> LowDiagonalPreconditionerType;
+    typedef ILU0Preconditioner<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType> LowILU0PreconditionerType;
+
+    typedef LinearSolver<TSparseSpaceType, TLocalSpaceType, TModelPartType> LinearSolverType;
+    typedef LinearSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowReordererType> LowLinearSolverType;
+    typedef IterativeSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowPreconditionerType, LowReordererType> LowIterativeSolverType;
+    typedef CGSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowPreconditionerType, LowReordererType> LowCGSolverType;
+    typedef BICGSTABSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowPreconditionerType, LowReordererType> LowBICGSTABSolverType;
+    typedef DirectSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowReordererType> LowDirectSolverType;
+    typedef SkylineLUFactorizationSolver<TLowSparseSpaceType, TLowLocalSpaceType, TModelPartType, LowReordererType> LowSkylineLUFactorizationSolverType;
+    typedef MixedPrecisionSolver<TSparseSpaceType, TLocalSpaceType, TModelPartType, TLowSparseSpaceType, TLowLocalSpaceType> MixedPrecisionSolverType;
+
+    using namespace boost::python;
+
+    class_<LowPreconditionerType, typename LowPreconditionerType::Pointer>((LowPrefix + "Preconditioner").c_str())
+    .def(self_ns::str(self))
+    ;
+
+    class_<LowDiagonalPreconditionerType, typename LowDiagonalPreconditionerType::Pointer, bases<LowPreconditionerType> >((LowPrefix + "DiagonalPreconditioner").c_str())
+    .def(self_ns::str(self))
+    ;
+
+    class_<LowILU0PreconditionerType, typename LowILU0PreconditionerType::Pointer, bases<LowPreconditionerType> >((LowPrefix + "ILU0Preconditioner").c_str())
+    .def(self_ns::str(self))
+    ;
+
+    class_<LowLinearSolverType, typename LowLinearSolverType::Pointer, boost::noncopyable>((LowPrefix + "LinearSolver").c_str(), no_init)
+    .def("SetEchoLevel", &LowLinearSolverType::SetEchoLevel)
+    .def(self_ns::str(self))
+    ;
+
+    class_<LowIterativeSolverType, typename LowIterativeSolverType::Pointer, bases<LowLinearSolverType>, boost::noncopyable>((LowPrefix + "IterativeSolver").c_str(), no_init)
+    ;
+
+    class_<LowCGSolverType, typename LowCGSolverType::Pointer, bases<LowIterativeSolverType> >((LowPrefix + "CGSolver").c_str())
+    .def(init<LowValueType>())
+    .def(init<LowValueType, unsigned int>())
+    .def(init<LowValueType, unsigned int, typename LowPreconditionerType::Pointer>())
+    ;
+
+    class_<LowBICGSTABSolverType, typename LowBICGSTABSolverType::Pointer, bases<LowIterativeSolverType> >((LowPrefix + "BICGSTABSolver").c_str())
+    .def(init<LowValueType>())
+    .def(init<LowValueType, unsigned int>())
+    .def(init<LowValueType, unsigned int, typename LowPreconditionerType::Pointer>())
+    ;
+
+    class_<LowDirectSolverType, typename LowDirectSolverType::Pointer, bases<LowLinearSolverType>, boost::noncopyable>((LowPrefix + "DirectSolver").c_str(), no_init)
+    ;
+
+    class_<LowSkylineLUFactorizationSolverType, typename LowSkylineLUFactorizationSolverType::Pointer, bases<LowDirectSolverType> >((LowPrefix + "SkylineLUFactorizationSolver").c_str())
+    .def(init< >())
+    ;
+
+    class_<MixedPrecisionSolverType, typename MixedPrecisionSolverType::Pointer, bases<LinearSolverType>, boost::noncopyable>((Prefix + "MixedPrecisionSolver").c_str(), init<typename LowLinearSolverType::Pointer, ValueType, unsigned int>())
+    .def("SetTolerance", &MixedPrecisionSolverType::SetTolerance)
+    .def("GetTolerance", &MixedPrecisionSolverType::GetTolerance)
+    .def("SetMaxIterationsNumber", &MixedPrecisionSolverType::SetMaxIterationsNumber)
+    .def("GetMaxIterationsNumber", &MixedPrecisionSolverType::GetMaxIterationsNumber)
+    .def("GetIterationsNumber", &MixedPrecisionSolverType::GetIterationsNumber)
+    .def("GetResidualNorm", &MixedPrecisionSolverType::GetResidualNorm)
+    .def("GetLowPrecisionMatrixMemory", &MixedPrecisionSolverType::GetLowPrecisionMatrixMemory)
+    ;
+}
+
 void AddLinearSolversToPython()
 {
     typedef KRATOS_DOUBLE_TYPE DataType;
     typedef UblasSpace<DataType, CompressedMatrix, Vector> SparseSpaceType;
     typedef UblasSpace<DataType, Matrix, Vector> LocalSpaceType;
 
+    using namespace boost::python;
+
+    enum_<FieldSplitType>("FieldSplitType")
+    .value("BlockJacobi", FieldSplitType::BlockJacobi)
+    .value("BlockGaussSeidel", FieldSplitType::BlockGaussSeidel)
+    ;
+
     AddReorderersToPythonImpl<SparseSpaceType, LocalSpaceType>("");
     AddLinearSolversToPythonImpl<SparseSpaceType, LocalSpaceType, ModelPart>("");
+    AddRealEigenvalueSolversToPythonImpl<SparseSpaceType, LocalSpaceType, ModelPart>("");
+
+    typedef UblasSpace<float, compressed_matrix<float>, vector<float> > FloatSparseSpaceType;
+    typedef UblasSpace<float, matrix<float>, vector<float> > FloatLocalSpaceType;
+
+    AddMixedPrecisionSolversToPythonImpl<SparseSpaceType, LocalSpaceType, FloatSparseSpaceType, FloatLocalSpaceType, ModelPart>("", "Float");
 
     //nothing will be compiled if an openmp compiler is not found
 #ifdef _OPENMP
@@ -218,6 +363,7 @@ void AddLinearSolversToPython()
     typedef UblasSpace<DataType, Matrix, Vector> ParallelLocalSpaceType;
 
     AddLinearSolversToPythonImpl<ParallelSpaceType, ParallelLocalSpaceType, ModelPart>("Parallel");
+    AddRealEigenvalueSolversToPythonImpl<ParallelSpaceType, ParallelLocalSpaceType, ModelPart>("Parallel");
 #endif
 
     typedef KRATOS_COMPLEX_TYPE ComplexType;
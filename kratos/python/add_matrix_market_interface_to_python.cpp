@@ -49,6 +49,12 @@ void  AddMatrixMarketInterfaceToPython()
     def("ReadMatrixMarketVector", ReadMatrixMarketVector <Kratos::Vector>);
     def("WriteMatrixMarketVector", WriteMatrixMarketVector <Kratos::Vector>);
 
+    def("ReadBinaryMatrix", ReadBinaryMatrix <Kratos::CompressedMatrix>);
+    def("WriteBinaryMatrix", WriteBinaryMatrix <Kratos::CompressedMatrix>);
+
+    def("ReadBinaryVector", ReadBinaryVector <Kratos::Vector>);
+    def("WriteBinaryVector", WriteBinaryVector <Kratos::Vector>);
+
 }
 
 }  // namespace Python.
@@ -612,6 +612,7 @@ void AddMeshToPython(const std::string& Prefix)
 
     class_<ElementType, typename ElementType::Pointer, bases<typename ElementType::BaseType> >
     ((Prefix+"Element").c_str(), init<IndexType>())
+    .def(init<IndexType, typename ElementType::GeometryType::Pointer, typename ElementType::PropertiesType::Pointer>())
     .add_property("Properties", GetPropertiesFromEntity<ElementType>, SetPropertiesForEntity<ElementType>)
     .def("__setitem__", SetValueHelperFunction< ElementType, Variable< array_1d<DataType, 3>  > >)
     .def("__getitem__", GetValueHelperFunction< ElementType, Variable< array_1d<DataType, 3>  > >)
@@ -743,6 +744,7 @@ void AddMeshToPython(const std::string& Prefix)
 
     class_<ConditionType, typename ConditionType::Pointer, bases<typename ConditionType::BaseType> >
     ((Prefix+"Condition").c_str(), init<int>())
+    .def(init<IndexType, typename ConditionType::GeometryType::Pointer, typename ConditionType::PropertiesType::Pointer>())
     .add_property("Properties", GetPropertiesFromEntity<ConditionType>, SetPropertiesForEntity<ConditionType>)
     .def("__setitem__", SetValueHelperFunction< ConditionType, Variable< array_1d<DataType, 3>  > >)
     .def("__getitem__", GetValueHelperFunction< ConditionType, Variable< array_1d<DataType, 3>  > >)
@@ -59,6 +59,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "includes/model_part.h"
 #include "python/add_model_part_to_python.h"
 #include "python/pointer_vector_set_python_interface.h"
+#include "python/python_buffer_interface.h"
 #include "includes/process_info.h"
 #include "utilities/constraint_utilities.h"
 
@@ -793,6 +794,316 @@ bool CommunicatorAssembleNonHistoricalData(TCommunicatorType& rCommunicator, Var
     return rCommunicator.AssembleNonHistoricalData(ThisVariable);
 }
 
+/// Copy of a value to/from the items of a buffer, for the bulk access to the data of a container
+template<typename TValueType>
+struct BulkValueTraits
+{
+    typedef TValueType ScalarType;
+    static constexpr std::size_t Size = 1;
+    static void Get(const TValueType& rValue, ScalarType* pData) { *pData = rValue; }
+    static void Set(TValueType& rValue, const ScalarType* pData) { rValue = *pData; }
+};
+
+template<typename TDataType>
+struct BulkValueTraits<array_1d<TDataType, 3> >
+{
+    typedef TDataType ScalarType;
+    static constexpr std::size_t Size = 3;
+    static void Get(const array_1d<TDataType, 3>& rValue, ScalarType* pData) { for (std::size_t k = 0; k < 3; ++k) pData[k] = rValue[k]; }
+    static void Set(array_1d<TDataType, 3>& rValue, const ScalarType* pData) { for (std::size_t k = 0; k < 3; ++k) rValue[k] = pData[k]; }
+};
+
+/// Fill a new buffer with Getter(item, pData) for each item of the container, in parallel
+template<typename TScalarType, class TContainerType, class TGetterType>
+boost::python::object GetBulkData(TContainerType& rContainer, const std::size_t NumberOfComponents, const TGetterType& rGetter)
+{
+    TScalarType* p_data;
+    boost::python::object buffer = CreatePythonBuffer(rContainer.size(), NumberOfComponents, p_data);
+
+    #pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(rContainer.size()); ++i)
+        rGetter(*(rContainer.begin() + i), p_data + i * NumberOfComponents);
+
+    return buffer;
+}
+
+/// Call Setter(item, pData) for each item of the container with the items of the given buffer, in parallel
+template<typename TScalarType, class TContainerType, class TSetterType>
+void SetBulkData(TContainerType& rContainer, const std::size_t NumberOfComponents, const boost::python::object& rBuffer, const TSetterType& rSetter)
+{
+    PythonBufferView<TScalarType> view(rBuffer, false);
+    view.CheckSize(rContainer.size() * NumberOfComponents);
+    const TScalarType* p_data = view.data();
+
+    #pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(rContainer.size()); ++i)
+        rSetter(*(rContainer.begin() + i), p_data + i * NumberOfComponents);
+}
+
+template<class TModelPartType>
+boost::python::object ModelPartGetNodalCoordinates(TModelPartType& rModelPart)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    return GetBulkData<typename NodeType::CoordinateType>(rModelPart.Nodes(), 3,
+        [](const NodeType& rNode, typename NodeType::CoordinateType* pData) { for (std::size_t k = 0; k < 3; ++k) pData[k] = rNode[k]; });
+}
+
+template<class TModelPartType>
+void ModelPartSetNodalCoordinates(TModelPartType& rModelPart, const boost::python::object& rBuffer)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    SetBulkData<typename NodeType::CoordinateType>(rModelPart.Nodes(), 3, rBuffer,
+        [](NodeType& rNode, const typename NodeType::CoordinateType* pData) { for (std::size_t k = 0; k < 3; ++k) rNode[k] = pData[k]; });
+}
+
+template<class TModelPartType>
+boost::python::object ModelPartGetNodalInitialCoordinates(TModelPartType& rModelPart)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    return GetBulkData<typename NodeType::CoordinateType>(rModelPart.Nodes(), 3,
+        [](NodeType& rNode, typename NodeType::CoordinateType* pData) { for (std::size_t k = 0; k < 3; ++k) pData[k] = rNode.GetInitialPosition()[k]; });
+}
+
+template<class TModelPartType>
+void ModelPartSetNodalInitialCoordinates(TModelPartType& rModelPart, const boost::python::object& rBuffer)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    SetBulkData<typename NodeType::CoordinateType>(rModelPart.Nodes(), 3, rBuffer,
+        [](NodeType& rNode, const typename NodeType::CoordinateType* pData) { rNode.SetInitialPosition(pData[0], pData[1], pData[2]); });
+}
+
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetNodalSolutionStepValues2(TModelPartType& rModelPart, const TVariableType& rVariable, typename TModelPartType::IndexType SolutionStepIndex)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    typedef BulkValueTraits<typename TVariableType::Type> TraitsType;
+
+    KRATOS_ERROR_IF(rModelPart.NumberOfNodes() > 0 && !rModelPart.NodesBegin()->SolutionStepsDataHas(rVariable))
+        << rVariable.Name() << " is not a solution step variable of " << rModelPart.Name();
+
+    return GetBulkData<typename TraitsType::ScalarType>(rModelPart.Nodes(), TraitsType::Size,
+        [&rVariable, SolutionStepIndex](NodeType& rNode, typename TraitsType::ScalarType* pData) { TraitsType::Get(rNode.FastGetSolutionStepValue(rVariable, SolutionStepIndex), pData); });
+}
+
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetNodalSolutionStepValues1(TModelPartType& rModelPart, const TVariableType& rVariable)
+{
+    return ModelPartGetNodalSolutionStepValues2(rModelPart, rVariable, 0);
+}
+
+template<class TModelPartType, class TVariableType>
+void ModelPartSetNodalSolutionStepValues2(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer, typename TModelPartType::IndexType SolutionStepIndex)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    typedef BulkValueTraits<typename TVariableType::Type> TraitsType;
+
+    KRATOS_ERROR_IF(rModelPart.NumberOfNodes() > 0 && !rModelPart.NodesBegin()->SolutionStepsDataHas(rVariable))
+        << rVariable.Name() << " is not a solution step variable of " << rModelPart.Name();
+
+    SetBulkData<typename TraitsType::ScalarType>(rModelPart.Nodes(), TraitsType::Size, rBuffer,
+        [&rVariable, SolutionStepIndex](NodeType& rNode, const typename TraitsType::ScalarType* pData) { TraitsType::Set(rNode.FastGetSolutionStepValue(rVariable, SolutionStepIndex), pData); });
+}
+
+template<class TModelPartType, class TVariableType>
+void ModelPartSetNodalSolutionStepValues1(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    ModelPartSetNodalSolutionStepValues2(rModelPart, rVariable, rBuffer, 0);
+}
+
+/// Non-historical values of the nodes, elements or conditions
+template<class TContainerType, class TVariableType>
+boost::python::object ContainerGetValues(TContainerType& rContainer, const TVariableType& rVariable)
+{
+    typedef BulkValueTraits<typename TVariableType::Type> TraitsType;
+    return GetBulkData<typename TraitsType::ScalarType>(rContainer, TraitsType::Size,
+        [&rVariable](typename TContainerType::value_type& rItem, typename TraitsType::ScalarType* pData) { TraitsType::Get(rItem.GetValue(rVariable), pData); });
+}
+
+template<class TContainerType, class TVariableType>
+void ContainerSetValues(TContainerType& rContainer, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    typedef BulkValueTraits<typename TVariableType::Type> TraitsType;
+    SetBulkData<typename TraitsType::ScalarType>(rContainer, TraitsType::Size, rBuffer,
+        [&rVariable](typename TContainerType::value_type& rItem, const typename TraitsType::ScalarType* pData) { TraitsType::Set(rItem.GetValue(rVariable), pData); });
+}
+
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetNodalValues(TModelPartType& rModelPart, const TVariableType& rVariable)
+{
+    return ContainerGetValues(rModelPart.Nodes(), rVariable);
+}
+
+template<class TModelPartType, class TVariableType>
+void ModelPartSetNodalValues(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    ContainerSetValues(rModelPart.Nodes(), rVariable, rBuffer);
+}
+
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetElementalValues(TModelPartType& rModelPart, const TVariableType& rVariable)
+{
+    return ContainerGetValues(rModelPart.Elements(), rVariable);
+}
+
+template<class TModelPartType, class TVariableType>
+void ModelPartSetElementalValues(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    ContainerSetValues(rModelPart.Elements(), rVariable, rBuffer);
+}
+
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetConditionalValues(TModelPartType& rModelPart, const TVariableType& rVariable)
+{
+    return ContainerGetValues(rModelPart.Conditions(), rVariable);
+}
+
+template<class TModelPartType, class TVariableType>
+void ModelPartSetConditionalValues(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    ContainerSetValues(rModelPart.Conditions(), rVariable, rBuffer);
+}
+
+/// 1 for the nodes where the dof of the variable is fixed, 0 otherwise
+template<class TModelPartType, class TVariableType>
+boost::python::object ModelPartGetNodalFixity(TModelPartType& rModelPart, const TVariableType& rVariable)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    return GetBulkData<int>(rModelPart.Nodes(), 1,
+        [&rVariable](NodeType& rNode, int* pData) { *pData = rNode.IsFixed(rVariable) ? 1 : 0; });
+}
+
+/// Fix the dof of the variable on the nodes where the buffer is not 0, free it elsewhere
+template<class TModelPartType, class TVariableType>
+void ModelPartSetNodalFixity(TModelPartType& rModelPart, const TVariableType& rVariable, const boost::python::object& rBuffer)
+{
+    typedef typename TModelPartType::NodeType NodeType;
+    SetBulkData<int>(rModelPart.Nodes(), 1, rBuffer,
+        [&rVariable](NodeType& rNode, const int* pData) { if (*pData) rNode.Fix(rVariable); else rNode.Free(rVariable); });
+}
+
+/// The ids of the nodes of each element or condition. All of them must have the same number of nodes.
+template<class TContainerType>
+boost::python::object ContainerGetConnectivity(TContainerType& rContainer)
+{
+    const std::size_t number_of_nodes = (rContainer.size() > 0) ? rContainer.begin()->GetGeometry().size() : 0;
+    for (auto it = rContainer.begin(); it != rContainer.end(); ++it)
+    {
+        KRATOS_ERROR_IF(it->GetGeometry().size() != number_of_nodes)
+            << "The connectivity can only be given for entities with the same number of nodes, "
+            << it->Id() << " has " << it->GetGeometry().size() << " nodes instead of " << number_of_nodes;
+    }
+
+    return GetBulkData<long long>(rContainer, number_of_nodes,
+        [number_of_nodes](typename TContainerType::value_type& rItem, long long* pData) {
+            for (std::size_t k = 0; k < number_of_nodes; ++k) pData[k] = rItem.GetGeometry()[k].Id();
+        });
+}
+
+template<class TModelPartType>
+boost::python::object ModelPartGetElementConnectivity(TModelPartType& rModelPart)
+{
+    return ContainerGetConnectivity(rModelPart.Elements());
+}
+
+template<class TModelPartType>
+boost::python::object ModelPartGetConditionConnectivity(TModelPartType& rModelPart)
+{
+    return ContainerGetConnectivity(rModelPart.Conditions());
+}
+
+/// The ids of a buffer of integers
+template<class TIndexType>
+std::vector<TIndexType> GetBufferIds(const boost::python::object& rBuffer)
+{
+    PythonBufferView<long long> view(rBuffer, false);
+    const long long* p_negative = std::find_if(view.data(), view.data() + view.size(), [](long long Id) { return Id < 0; });
+    KRATOS_ERROR_IF(p_negative != view.data() + view.size()) << "The ids can not be negative, " << *p_negative << " is given" << std::endl;
+    return std::vector<TIndexType>(view.data(), view.data() + view.size());
+}
+
+/// Create the nodes of the buffer of ids, with the x, y, z of each node one after another in the buffer of coordinates
+template<class TModelPartType>
+void ModelPartCreateNewNodes(TModelPartType& rModelPart, const boost::python::object& rIds, const boost::python::object& rCoordinates)
+{
+    typedef typename TModelPartType::CoordinateType CoordinateType;
+    const std::vector<typename TModelPartType::IndexType> ids = GetBufferIds<typename TModelPartType::IndexType>(rIds);
+
+    PythonBufferView<CoordinateType> view(rCoordinates, false);
+    view.CheckSize(3 * ids.size());
+    rModelPart.CreateNewNodes(ids, std::vector<CoordinateType>(view.data(), view.data() + view.size()));
+}
+
+/// Create the elements of the buffer of ids, with the node ids of each element one after another in the buffer of connectivities
+template<class TModelPartType>
+void ModelPartCreateNewElements(TModelPartType& rModelPart, const std::string& rElementName, const boost::python::object& rIds,
+        const boost::python::object& rConnectivities, Properties::Pointer pProperties)
+{
+    typedef typename TModelPartType::IndexType IndexType;
+    rModelPart.CreateNewElements(rElementName, GetBufferIds<IndexType>(rIds), GetBufferIds<IndexType>(rConnectivities), pProperties);
+}
+
+/// Create the conditions of the buffer of ids, with the node ids of each condition one after another in the buffer of connectivities
+template<class TModelPartType>
+void ModelPartCreateNewConditions(TModelPartType& rModelPart, const std::string& rConditionName, const boost::python::object& rIds,
+        const boost::python::object& rConnectivities, Properties::Pointer pProperties)
+{
+    typedef typename TModelPartType::IndexType IndexType;
+    rModelPart.CreateNewConditions(rConditionName, GetBufferIds<IndexType>(rIds), GetBufferIds<IndexType>(rConnectivities), pProperties);
+}
+
+/// Bulk access to the data of the whole containers through buffers, e.g. numpy arrays. The getters return
+/// a new buffer and the setters take any contiguous buffer with the right size and type.
+template<class TModelPartType, class TClassType>
+void AddModelPartBulkDataAccessToPython(TClassType& rModelPartClass)
+{
+    typedef typename TModelPartType::DataType DataType;
+    typedef Variable<DataType> DoubleVariableType;
+    typedef Variable<array_1d<DataType, 3> > Array1DVariableType;
+    typedef typename TModelPartType::VariableComponentType VariableComponentType;
+
+    rModelPartClass
+    .def("GetNodalCoordinates", ModelPartGetNodalCoordinates<TModelPartType>)
+    .def("SetNodalCoordinates", ModelPartSetNodalCoordinates<TModelPartType>)
+    .def("GetNodalInitialCoordinates", ModelPartGetNodalInitialCoordinates<TModelPartType>)
+    .def("SetNodalInitialCoordinates", ModelPartSetNodalInitialCoordinates<TModelPartType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues1<TModelPartType, DoubleVariableType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues1<TModelPartType, Array1DVariableType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues1<TModelPartType, VariableComponentType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues2<TModelPartType, DoubleVariableType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues2<TModelPartType, Array1DVariableType>)
+    .def("GetNodalSolutionStepValues", ModelPartGetNodalSolutionStepValues2<TModelPartType, VariableComponentType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues1<TModelPartType, DoubleVariableType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues1<TModelPartType, Array1DVariableType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues1<TModelPartType, VariableComponentType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues2<TModelPartType, DoubleVariableType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues2<TModelPartType, Array1DVariableType>)
+    .def("SetNodalSolutionStepValues", ModelPartSetNodalSolutionStepValues2<TModelPartType, VariableComponentType>)
+    .def("GetNodalValues", ModelPartGetNodalValues<TModelPartType, DoubleVariableType>)
+    .def("GetNodalValues", ModelPartGetNodalValues<TModelPartType, Array1DVariableType>)
+    .def("GetNodalValues", ModelPartGetNodalValues<TModelPartType, VariableComponentType>)
+    .def("SetNodalValues", ModelPartSetNodalValues<TModelPartType, DoubleVariableType>)
+    .def("SetNodalValues", ModelPartSetNodalValues<TModelPartType, Array1DVariableType>)
+    .def("SetNodalValues", ModelPartSetNodalValues<TModelPartType, VariableComponentType>)
+    .def("GetElementalValues", ModelPartGetElementalValues<TModelPartType, DoubleVariableType>)
+    .def("GetElementalValues", ModelPartGetElementalValues<TModelPartType, Array1DVariableType>)
+    .def("SetElementalValues", ModelPartSetElementalValues<TModelPartType, DoubleVariableType>)
+    .def("SetElementalValues", ModelPartSetElementalValues<TModelPartType, Array1DVariableType>)
+    .def("GetConditionalValues", ModelPartGetConditionalValues<TModelPartType, DoubleVariableType>)
+    .def("GetConditionalValues", ModelPartGetConditionalValues<TModelPartType, Array1DVariableType>)
+    .def("SetConditionalValues", ModelPartSetConditionalValues<TModelPartType, DoubleVariableType>)
+    .def("SetConditionalValues", ModelPartSetConditionalValues<TModelPartType, Array1DVariableType>)
+    .def("GetNodalFixity", ModelPartGetNodalFixity<TModelPartType, DoubleVariableType>)
+    .def("GetNodalFixity", ModelPartGetNodalFixity<TModelPartType, VariableComponentType>)
+    .def("SetNodalFixity", ModelPartSetNodalFixity<TModelPartType, DoubleVariableType>)
+    .def("SetNodalFixity", ModelPartSetNodalFixity<TModelPartType, VariableComponentType>)
+    .def("GetElementConnectivity", ModelPartGetElementConnectivity<TModelPartType>)
+    .def("GetConditionConnectivity", ModelPartGetConditionConnectivity<TModelPartType>)
+    .def("CreateNewNodes", ModelPartCreateNewNodes<TModelPartType>)
+    .def("CreateNewElements", ModelPartCreateNewElements<TModelPartType>)
+    .def("CreateNewConditions", ModelPartCreateNewConditions<TModelPartType>)
+    ;
+}
+
 template<class TModelPartType>
 void AddModelPartToPythonImpl(const std::string& Prefix)
 {
@@ -848,7 +1159,8 @@ void AddModelPartToPythonImpl(const std::string& Prefix)
 
     PointerVectorSetPythonInterface<typename TModelPartType::MasterSlaveConstraintContainerType>::CreateInterface((Prefix + "MasterSlaveConstraintsArray").c_str());
 
-    class_<TModelPartType, bases<DataValueContainer, Flags> >((Prefix + "ModelPart").c_str(), init<>())
+    class_<TModelPartType, bases<DataValueContainer, Flags> > model_part_class((Prefix + "ModelPart").c_str(), init<>());
+    model_part_class
     .def(init<std::string const&>())
     .add_property("Name", GetModelPartName<TModelPartType>, SetModelPartName<TModelPartType>)
     .add_property("Type", GetModelPartType<TModelPartType>)
@@ -992,6 +1304,10 @@ void AddModelPartToPythonImpl(const std::string& Prefix)
     .def(self_ns::str(self))
     ;
 
+    // the buffers are only available for real data
+    if constexpr (std::is_floating_point<DataType>::value && std::is_floating_point<typename TModelPartType::CoordinateType>::value)
+        AddModelPartBulkDataAccessToPython<TModelPartType>(model_part_class);
+
     class_<typename TModelPartType::DofsArrayType, boost::noncopyable>((Prefix + "DofsArrayType").c_str(), init<>());
 }
 
@@ -24,6 +24,7 @@
 #include "processes/find_nodal_neighbours_process.h"
 #include "processes/find_conditions_neighbours_process.h"
 #include "processes/find_elements_neighbours_process.h"
+#include "processes/divide_input_to_partitions_process.h"
 
 namespace Kratos
 {
@@ -31,6 +32,56 @@ namespace Kratos
 namespace Python
 {
 
+std::size_t DivideInputToPartitionsProcessGetEdgeCut(DivideInputToPartitionsProcess<ModelPart>& rDummy)
+{
+    return rDummy.GetPartitioner().GetEdgeCut();
+}
+
+std::size_t DivideInputToPartitionsProcessGetNumberOfInterfaceNodes(DivideInputToPartitionsProcess<ModelPart>& rDummy)
+{
+    return rDummy.GetPartitioner().GetNumberOfInterfaceNodes();
+}
+
+double DivideInputToPartitionsProcessGetElementsImbalance(DivideInputToPartitionsProcess<ModelPart>& rDummy)
+{
+    return rDummy.GetPartitioner().GetElementsImbalance();
+}
+
+double DivideInputToPartitionsProcessGetNodesImbalance(DivideInputToPartitionsProcess<ModelPart>& rDummy)
+{
+    return rDummy.GetPartitioner().GetNodesImbalance();
+}
+
+/// The ids of the neighbours found by the neighbour search processes, 0 for a missing neighbour
+template<class TEntityType>
+boost::python::list GetNeighboursIds(const WeakPointerVector<TEntityType>& rNeighbours)
+{
+    boost::python::list ids;
+    for (std::size_t i = 0; i < rNeighbours.size(); ++i)
+        ids.append(rNeighbours(i).expired() ? 0 : rNeighbours(i).lock()->Id());
+    return ids;
+}
+
+boost::python::list FindNodalNeighboursProcessGetNeighbourNodesIds(FindNodalNeighboursProcess& rDummy, ModelPart::NodeType& rNode)
+{
+    return GetNeighboursIds(rNode.GetValue(NEIGHBOUR_NODES));
+}
+
+boost::python::list FindNodalNeighboursProcessGetNeighbourElementsIds(FindNodalNeighboursProcess& rDummy, ModelPart::NodeType& rNode)
+{
+    return GetNeighboursIds(rNode.GetValue(NEIGHBOUR_ELEMENTS));
+}
+
+boost::python::list FindElementalNeighboursProcessGetNeighbourElementsIds(FindElementalNeighboursProcess& rDummy, Element& rElement)
+{
+    return GetNeighboursIds(rElement.GetValue(NEIGHBOUR_ELEMENTS));
+}
+
+boost::python::list FindConditionsNeighboursProcessGetNeighbourConditionsIds(FindConditionsNeighboursProcess& rDummy, Condition& rCondition)
+{
+    return GetNeighboursIds(rCondition.GetValue(NEIGHBOUR_CONDITIONS));
+}
+
 void  AddProcessesToPython()
 {
     using namespace boost::python;
@@ -50,16 +101,30 @@ void  AddProcessesToPython()
     class_<FindNodalNeighboursProcess, bases<Process> >("FindNodalNeighboursProcess",
             init<ModelPart&, int, int>())
     .def("ClearNeighbours",&FindNodalNeighboursProcess::ClearNeighbours)
+    .def("GetNeighbourNodesIds", &FindNodalNeighboursProcessGetNeighbourNodesIds)
+    .def("GetNeighbourElementsIds", &FindNodalNeighboursProcessGetNeighbourElementsIds)
     ;
 
     class_<FindConditionsNeighboursProcess, bases<Process> >("FindConditionsNeighboursProcess",
             init<ModelPart&, int, int>())
     .def("ClearNeighbours",&FindConditionsNeighboursProcess::ClearNeighbours)
+    .def("GetNeighbourConditionsIds", &FindConditionsNeighboursProcessGetNeighbourConditionsIds)
     ;
 
     class_<FindElementalNeighboursProcess, bases<Process> >("FindElementalNeighboursProcess",
             init<ModelPart&, int, int>())
     .def("ClearNeighbours",&FindElementalNeighboursProcess::ClearNeighbours)
+    .def("GetNeighbourElementsIds", &FindElementalNeighboursProcessGetNeighbourElementsIds)
+    ;
+
+    typedef DivideInputToPartitionsProcess<ModelPart> DivideInputToPartitionsProcessType;
+    class_<DivideInputToPartitionsProcessType, bases<Process>, boost::noncopyable>("DivideInputToPartitionsProcess",
+            init<IO<ModelPart>&, std::size_t>())
+    .def(init<IO<ModelPart>&, std::size_t, int>())
+    .def("GetEdgeCut", &DivideInputToPartitionsProcessGetEdgeCut)
+    .def("GetNumberOfInterfaceNodes", &DivideInputToPartitionsProcessGetNumberOfInterfaceNodes)
+    .def("GetElementsImbalance", &DivideInputToPartitionsProcessGetElementsImbalance)
+    .def("GetNodesImbalance", &DivideInputToPartitionsProcessGetNodesImbalance)
     ;
 }
 
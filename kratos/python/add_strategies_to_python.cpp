@@ -42,6 +42,7 @@
 #include "solving_strategies/strategies/solving_strategy.h"
 #include "solving_strategies/strategies/residualbased_linear_strategy.h"
 #include "solving_strategies/strategies/residualbased_newton_raphson_strategy.h"
+#include "solving_strategies/strategies/residualbased_quasi_newton_strategy.h"
 #include "solving_strategies/strategies/adaptive_residualbased_newton_raphson_strategy.h"
 #include "solving_strategies/strategies/explicit_strategy.h"
 //#include "solving_strategies/strategies/residualbased_arc_lenght_strategy.h"
@@ -56,6 +57,7 @@
 #include "solving_strategies/convergencecriterias/displacement_criteria.h"
 #include "solving_strategies/convergencecriterias/incremental_displacement_criteria.h"
 #include "solving_strategies/convergencecriterias/residual_criteria.h"
+#include "solving_strategies/convergencecriterias/variable_norms_criteria.h"
 #include "solving_strategies/convergencecriterias/and_criteria.h"
 #include "solving_strategies/convergencecriterias/or_criteria.h"
 //#include "solving_strategies/convergencecriterias/and_criteria.h"
@@ -162,6 +164,26 @@ namespace Kratos
                     .def("GetBuilderAndSolver", &ResidualBasedNewtonRaphsonStrategyType::GetBuilderAndSolver)
                     ;
 
+            if constexpr (std::is_floating_point<DataType>::value)
+            {
+                typedef ResidualBasedQuasiNewtonStrategy< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > ResidualBasedQuasiNewtonStrategyType;
+                class_< ResidualBasedQuasiNewtonStrategyType, bases< ResidualBasedNewtonRaphsonStrategyType >, boost::noncopyable >
+                        ((Prefix+"ResidualBasedQuasiNewtonStrategy").c_str(), init < TModelPartType&, typename BaseSchemeType::Pointer, typename LinearSolverType::Pointer, typename ConvergenceCriteriaType::Pointer, int, bool, bool, bool >())
+                        .def(init < TModelPartType&, typename BaseSchemeType::Pointer, typename LinearSolverType::Pointer, typename ConvergenceCriteriaType::Pointer, typename BuilderAndSolverType::Pointer, int, bool, bool, bool >())
+                        .def("SetUpdateType", &ResidualBasedQuasiNewtonStrategyType::SetUpdateType)
+                        .def("GetUpdateType", &ResidualBasedQuasiNewtonStrategyType::GetUpdateType)
+                        .def("SetMaxNumberOfUpdates", &ResidualBasedQuasiNewtonStrategyType::SetMaxNumberOfUpdates)
+                        .def("GetMaxNumberOfUpdates", &ResidualBasedQuasiNewtonStrategyType::GetMaxNumberOfUpdates)
+                        .def("SetStallFactor", &ResidualBasedQuasiNewtonStrategyType::SetStallFactor)
+                        .def("GetStallFactor", &ResidualBasedQuasiNewtonStrategyType::GetStallFactor)
+                        .def("SetMaxLineSearchIterations", &ResidualBasedQuasiNewtonStrategyType::SetMaxLineSearchIterations)
+                        .def("GetMaxLineSearchIterations", &ResidualBasedQuasiNewtonStrategyType::GetMaxLineSearchIterations)
+                        .def("SetRefreshTangentAtEachStep", &ResidualBasedQuasiNewtonStrategyType::SetRefreshTangentAtEachStep)
+                        .def("GetRefreshTangentAtEachStep", &ResidualBasedQuasiNewtonStrategyType::GetRefreshTangentAtEachStep)
+                        .def("GetNumberOfFactorizations", &ResidualBasedQuasiNewtonStrategyType::GetNumberOfFactorizations)
+                        ;
+            }
+
             typedef AdaptiveResidualBasedNewtonRaphsonStrategy< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > AdaptiveResidualBasedNewtonRaphsonStrategyType;
             class_< AdaptiveResidualBasedNewtonRaphsonStrategyType, bases< BaseSolvingStrategyType >, boost::noncopyable >
                     ((Prefix+"AdaptiveResidualBasedNewtonRaphsonStrategy").c_str(),
@@ -245,6 +267,18 @@ namespace Kratos
                     bases<ConvergenceCriteriaType>, boost::noncopyable >
                     ((Prefix+"ResidualCriteria").c_str(), init< ValueType, ValueType>());
 
+            typedef VariableNormsCriteria<SparseSpaceType, LocalSpaceType, TModelPartType> VariableNormsCriteriaType;
+            class_<VariableNormsCriteriaType, bases<ConvergenceCriteriaType>, boost::noncopyable >
+                    ((Prefix+"VariableNormsCriteria").c_str(), init< ValueType, ValueType>())
+                    .def(init< ValueType, ValueType, VariableNormsCombination>())
+                    .def("AddGroup", &VariableNormsCriteriaType::AddGroup)
+                    .def("AddVariable", &VariableNormsCriteriaType::AddVariable)
+                    .def("NumberOfGroups", &VariableNormsCriteriaType::NumberOfGroups)
+                    .def("GetIncrementNorm", &VariableNormsCriteriaType::GetIncrementNorm)
+                    .def("GetSolutionNorm", &VariableNormsCriteriaType::GetSolutionNorm)
+                    .def("GetResidualNorm", &VariableNormsCriteriaType::GetResidualNorm)
+                    ;
+
             class_<And_Criteria<SparseSpaceType, LocalSpaceType, TModelPartType>,
                     bases<ConvergenceCriteriaType>, boost::noncopyable >
                     ((Prefix+"AndCriteria").c_str(), init<typename ConvergenceCriteriaType::Pointer, typename ConvergenceCriteriaType::Pointer> ());
@@ -292,7 +326,10 @@ namespace Kratos
             class_< ResidualBasedEliminationBuilderAndSolverType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedEliminationBuilderAndSolver").c_str(), init< typename LinearSolverType::Pointer > ());
 
             typedef ResidualBasedEliminationBuilderAndSolverDeactivation< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > ResidualBasedEliminationBuilderAndSolverDeactivationType;
-            class_< ResidualBasedEliminationBuilderAndSolverDeactivationType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedEliminationBuilderAndSolverDeactivation").c_str(), init< typename LinearSolverType::Pointer > ());
+            class_< ResidualBasedEliminationBuilderAndSolverDeactivationType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedEliminationBuilderAndSolverDeactivation").c_str(), init< typename LinearSolverType::Pointer > ())
+                    .def("SetIncrementalActivationFlag", &ResidualBasedEliminationBuilderAndSolverDeactivationType::SetIncrementalActivationFlag)
+                    .def("GetIncrementalActivationFlag", &ResidualBasedEliminationBuilderAndSolverDeactivationType::GetIncrementalActivationFlag)
+                    ;
 
             typedef ResidualBasedBlockBuilderAndSolver< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > ResidualBasedBlockBuilderAndSolverType;
             class_< ResidualBasedBlockBuilderAndSolverType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedBlockBuilderAndSolver").c_str(), init< typename LinearSolverType::Pointer > ());
@@ -304,7 +341,10 @@ namespace Kratos
             class_< ResidualBasedBlockBuilderAndSolverWithConstraintsElementWiseType, bases<ResidualBasedBlockBuilderAndSolverWithConstraintsType>, boost::noncopyable > ((Prefix+"ResidualBasedBlockBuilderAndSolverWithConstraintsElementWise").c_str(), init< typename LinearSolverType::Pointer > ());
 
             typedef ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationType;
-            class_< ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation").c_str(), init< typename LinearSolverType::Pointer > ());
+            class_< ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation").c_str(), init< typename LinearSolverType::Pointer > ())
+                    .def("SetIncrementalActivationFlag", &ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationType::SetIncrementalActivationFlag)
+                    .def("GetIncrementalActivationFlag", &ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationType::GetIncrementalActivationFlag)
+                    ;
 
             typedef ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWise< SparseSpaceType, LocalSpaceType, LinearSolverType, TModelPartType > ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWiseType;
             class_< ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWiseType, bases<BuilderAndSolverType>, boost::noncopyable > ((Prefix+"ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWise").c_str(), init< typename LinearSolverType::Pointer > ());
@@ -318,6 +358,18 @@ namespace Kratos
             typedef UblasSpace<KRATOS_COMPLEX_TYPE, ComplexCompressedMatrix, ComplexVector> ComplexSparseSpaceType;
             typedef UblasSpace<KRATOS_COMPLEX_TYPE, ComplexMatrix, ComplexVector> ComplexLocalSpaceType;
 
+            enum_<QuasiNewtonUpdateType>("QuasiNewtonUpdateType")
+            .value("BFGS", QuasiNewtonUpdateType::BFGS)
+            .value("Broyden", QuasiNewtonUpdateType::Broyden)
+            ;
+
+            enum_<VariableNormsCombination>("VariableNormsCombination")
+            .value("Increment", VariableNormsCombination::Increment)
+            .value("Residual", VariableNormsCombination::Residual)
+            .value("IncrementAndResidual", VariableNormsCombination::IncrementAndResidual)
+            .value("IncrementOrResidual", VariableNormsCombination::IncrementOrResidual)
+            ;
+
             AddStrategiesToPythonImpl<SparseSpaceType, LocalSpaceType, ModelPart>("");
             AddStrategiesToPythonImpl<ComplexSparseSpaceType, ComplexLocalSpaceType, ComplexModelPart>("Complex");
             AddStrategiesToPythonImpl<ComplexSparseSpaceType, ComplexLocalSpaceType, GComplexModelPart>("GComplex");
@@ -25,6 +25,8 @@
 #include "utilities/constraint_utilities.h"
 #include "utilities/timer.h"
 #include "utilities/geometry_tester.h"
+#include "utilities/memory_usage_utility.h"
+#include "utilities/model_part_reordering_utility.h"
 
 
 namespace Kratos
@@ -65,6 +67,34 @@ namespace Kratos
                     .def("RunTest", &GeometryTesterUtility::RunTest)
                     ;
 
+            class_<MemoryUsageUtility<ModelPart>, boost::noncopyable > ("MemoryUsageUtility", init< >())
+                    .def("Report", &MemoryUsageUtility<ModelPart>::Report)
+                    .staticmethod("Report")
+                    ;
+
+            enum_<ModelPartReorderingType>("ModelPartReorderingType")
+                    .value("HilbertCurve", ModelPartReorderingType::HilbertCurve)
+                    .value("ReverseCuthillMcKee", ModelPartReorderingType::ReverseCuthillMcKee)
+                    ;
+
+            typedef ModelPartReorderingUtility<ModelPart> ModelPartReorderingUtilityType;
+            class_<ModelPartReorderingUtilityType, ModelPartReorderingUtilityType::Pointer, boost::noncopyable > ("ModelPartReorderingUtility", init< >())
+                    .def(init<ModelPartReorderingType>())
+                    .def("Reorder", &ModelPartReorderingUtilityType::Reorder)
+                    .def("RestoreIds", &ModelPartReorderingUtilityType::RestoreIds)
+                    .def("Relocate", &ModelPartReorderingUtilityType::Relocate)
+                    .staticmethod("Relocate")
+                    .def("Clear", &ModelPartReorderingUtilityType::Clear)
+                    .def("IsReordered", &ModelPartReorderingUtilityType::IsReordered)
+                    .def("GetOriginalNodeId", &ModelPartReorderingUtilityType::GetOriginalNodeId)
+                    .def("GetOriginalElementId", &ModelPartReorderingUtilityType::GetOriginalElementId)
+                    .def("GetOriginalConditionId", &ModelPartReorderingUtilityType::GetOriginalConditionId)
+                    .def("GetNodeId", &ModelPartReorderingUtilityType::GetNodeId)
+                    .def("GetElementId", &ModelPartReorderingUtilityType::GetElementId)
+                    .def("GetConditionId", &ModelPartReorderingUtilityType::GetConditionId)
+                    .def(self_ns::str(self))
+                    ;
+
             class_<ConstraintUtilities<ModelPart>, boost::noncopyable > ("ConstraintUtilities", init< >())
                     .def("PrintConstraint", &ConstraintUtilities_PrintConstraint<ConstraintUtilities<ModelPart> >)
                     ;
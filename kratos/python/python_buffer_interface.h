@@ -0,0 +1,137 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_PYTHON_BUFFER_INTERFACE_H_INCLUDED )
+#define  KRATOS_PYTHON_BUFFER_INTERFACE_H_INCLUDED
+
+// System includes
+#include <cstring>
+#include <type_traits>
+
+// External includes
+#include <boost/python.hpp>
+
+// Project includes
+#include "includes/define.h"
+
+
+namespace Kratos
+{
+
+namespace Python
+{
+
+/// The format character of the buffer protocol (the same as in the struct module) for a C++ type
+template<typename TDataType> struct PythonBufferFormat;
+template<> struct PythonBufferFormat<float> { static constexpr const char* Get() {return "f";} };
+template<> struct PythonBufferFormat<double> { static constexpr const char* Get() {return "d";} };
+template<> struct PythonBufferFormat<int> { static constexpr const char* Get() {return "i";} };
+template<> struct PythonBufferFormat<long long> { static constexpr const char* Get() {return "q";} };
+
+/**
+ * @class PythonBufferView
+ * @brief Access to the contiguous data of a Python object supporting the buffer protocol, e.g. a numpy array
+ * @details The buffer must be C-contiguous and its items must have the size of TDataType. Integer buffers
+ * are accepted for any signed integer format of the right size, since numpy does not use the same format
+ * character for int64 on all the platforms. The buffer is released when the view is destroyed.
+ */
+template<typename TDataType>
+class PythonBufferView
+{
+public:
+
+    PythonBufferView(const boost::python::object& rObject, const bool Writable)
+    {
+        int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+        if (Writable)
+            flags |= PyBUF_WRITABLE;
+
+        if (PyObject_GetBuffer(rObject.ptr(), &mView, flags) != 0)
+            boost::python::throw_error_already_set();
+
+        const char* format = (mView.format == NULL) ? "B" : mView.format;
+        if (*format == '@' || *format == '=' || *format == '<')
+            ++format;
+
+        bool compatible = (static_cast<std::size_t>(mView.itemsize) == sizeof(TDataType));
+        if (std::is_floating_point<TDataType>::value)
+            compatible = compatible && (std::strcmp(format, PythonBufferFormat<TDataType>::Get()) == 0);
+        else
+            compatible = compatible && (std::strlen(format) == 1) && (std::strchr("bhilq", *format) != NULL);
+
+        if (!compatible)
+        {
+            const std::string given(format);
+            PyBuffer_Release(&mView);
+            KRATOS_ERROR << "The buffer has format '" << given << "', a contiguous buffer of '"
+                         << PythonBufferFormat<TDataType>::Get() << "' is expected";
+        }
+    }
+
+    ~PythonBufferView()
+    {
+        PyBuffer_Release(&mView);
+    }
+
+    PythonBufferView(const PythonBufferView&) = delete;
+
+    PythonBufferView& operator=(const PythonBufferView&) = delete;
+
+    TDataType* data() const
+    {
+        return static_cast<TDataType*>(mView.buf);
+    }
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(mView.len / mView.itemsize);
+    }
+
+    /// Throw if the buffer does not hold Size items
+    void CheckSize(const std::size_t Size) const
+    {
+        KRATOS_ERROR_IF(size() != Size) << "The buffer has " << size() << " items, " << Size << " are expected";
+    }
+
+private:
+
+    Py_buffer mView;
+
+};
+
+/**
+ * @brief Create a new C-contiguous buffer with NumberOfRows x NumberOfColumns items of TDataType
+ * @details The buffer is a memoryview of a bytearray, so numpy.asarray uses it without copy. A buffer
+ * with one column, or without items (memoryview can not have zeros in its shape), is one-dimensional.
+ * @param rData the address of the first item, to be filled by the caller
+ */
+template<typename TDataType>
+boost::python::object CreatePythonBuffer(const std::size_t NumberOfRows, const std::size_t NumberOfColumns, TDataType*& rData)
+{
+    using namespace boost::python;
+
+    const std::size_t size = NumberOfRows * NumberOfColumns;
+    object bytes(handle<>(PyByteArray_FromStringAndSize(NULL, static_cast<Py_ssize_t>(size * sizeof(TDataType)))));
+    rData = reinterpret_cast<TDataType*>(PyByteArray_AsString(bytes.ptr()));
+
+    object view(handle<>(PyMemoryView_FromObject(bytes.ptr())));
+    if (NumberOfColumns == 1 || size == 0)
+        return view.attr("cast")(PythonBufferFormat<TDataType>::Get());
+    return view.attr("cast")(PythonBufferFormat<TDataType>::Get(), make_tuple(NumberOfRows, NumberOfColumns));
+}
+
+}  // namespace Python.
+
+}  // namespace Kratos.
+
+#endif // KRATOS_PYTHON_BUFFER_INTERFACE_H_INCLUDED  defined
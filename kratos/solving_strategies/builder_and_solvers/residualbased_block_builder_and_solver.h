@@ -37,6 +37,7 @@
 // #define EXPORT_LHS_MATRIX
 // #define EXPORT_RHS_VECTOR
 // #define EXPORT_SOL_VECTOR
+// #define EXPORT_SYSTEM_BINARY // export the system in the binary compressed format instead of Matrix Market
 
 //#define ENABLE_LOG
 #define QUERY_DOF_EQUATION_ID
@@ -421,15 +422,25 @@ public:
 
         #ifdef EXPORT_LHS_MATRIX
         std::stringstream lhs_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".bin";
+        WriteBinaryMatrix(lhs_filename.str().c_str(), A);
+        #else
         lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".mm";
         WriteMatrixMarketMatrix(lhs_filename.str().c_str(), A, false);
         #endif
+        #endif
 
         #ifdef EXPORT_RHS_VECTOR
         std::stringstream rhs_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".bin";
+        WriteBinaryVector(rhs_filename.str().c_str(), b);
+        #else
         rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".mm";
         WriteMatrixMarketVector(rhs_filename.str().c_str(), b);
         #endif
+        #endif
 
         ++mLocalCounter;
 
@@ -617,9 +628,14 @@ public:
 
         #ifdef EXPORT_SOL_VECTOR
         std::stringstream dx_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".bin";
+        WriteBinaryVector(dx_filename.str().c_str(), Dx);
+        #else
         dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".mm";
         WriteMatrixMarketVector(dx_filename.str().c_str(), Dx);
         #endif
+        #endif
 
         KRATOS_CATCH("")
     }
@@ -662,9 +678,14 @@ public:
 
         #ifdef EXPORT_SOL_VECTOR
         std::stringstream dx_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".bin";
+        WriteBinaryVector(dx_filename.str().c_str(), Dx);
+        #else
         dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".mm";
         WriteMatrixMarketVector(dx_filename.str().c_str(), Dx);
         #endif
+        #endif
 
         KRATOS_CATCH("")
     }
@@ -985,17 +1006,19 @@ public:
         //refresh RHS to have the correct reactions
         BuildRHSNoDirichlet(pScheme, r_model_part, b);
 
-        int i;
+        const int ndofs = static_cast<int>(BaseType::mDofSet.size());
 
-        typename DofsArrayType::ptr_iterator it2;
         //updating variables
-        for (it2 = BaseType::mDofSet.ptr_begin(); it2 != BaseType::mDofSet.ptr_end(); ++it2)
+        #pragma omp parallel for firstprivate(ndofs)
+        for (int k = 0; k < ndofs; k++)
         {
-            if ((*it2)->IsFixed())
+            typename DofsArrayType::iterator dof_iterator = BaseType::mDofSet.begin() + k;
+
+            if (dof_iterator->IsFixed())
             {
-                i = (*it2)->EquationId();
+                const std::size_t i = dof_iterator->EquationId();
 
-                (*it2)->GetSolutionStepReactionValue() = -b[i];
+                dof_iterator->GetSolutionStepReactionValue() = -b[i];
             }
         }
     }
@@ -1671,5 +1694,6 @@ private:
 #undef EXPORT_LHS_MATRIX
 #undef EXPORT_RHS_VECTOR
 #undef EXPORT_SOL_VECTOR
+#undef EXPORT_SYSTEM_BINARY
 
 #endif /* KRATOS_RESIDUAL_BASED_BLOCK_BUILDER_AND_SOLVER  defined */
@@ -28,6 +28,7 @@
 #include "utilities/timer.h"
 #include "utilities/openmp_utils.h"
 #include "includes/kratos_flags.h"
+#include "includes/key_hash.h"
 #include "utilities/sparse_matrix_multiplication_utility.h"
 
 
@@ -63,6 +64,11 @@ namespace Kratos
  * Imposition of the dirichlet conditions is naturally dealt with as the residual already contains
  * this information.
  * Calculation of the reactions involves a cost very similiar to the calculation of the total residual
+ * In the incremental activation mode (see SetIncrementalActivationFlag) the dof set, the equation numbering
+ * and the matrix structure are built once for all elements and conditions, regardless of their ACTIVE flag.
+ * The dofs not touched by any active entity end up with an empty row, which is replaced by an identity row
+ * in ApplyDirichletConditions. Hence a change of activation only touches the values of the system, and the
+ * structure is rebuilt only when the set of elements/conditions of the model part changes.
  * @author Riccardo Rossi
  */
 template<class TSparseSpace,
@@ -141,6 +147,9 @@ public:
     explicit ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation(
         typename TLinearSolver::Pointer pNewLinearSystemSolver)
         : BaseType(pNewLinearSystemSolver)
+        , mIncrementalActivation(false)
+        , mSupersetSignature(0)
+        , mSupersetChanged(true)
     {
     }
 
@@ -688,6 +697,27 @@ public:
             std::cout << "ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation: " << "Setting up the dofs" << std::endl;
         }
 
+        std::size_t superset_signature = 0;
+        if (mIncrementalActivation)
+        {
+            superset_signature = ComputeSupersetSignature(rModelPart);
+
+            // the superset of entities is unchanged, the dof set is reused whatever the activation is
+            if (superset_signature == mSupersetSignature && mAllDofs.size() != 0)
+            {
+                BaseType::mDofSet = mAllDofs;
+                BaseType::mDofSetIsInitialized = true;
+                mSupersetChanged = false;
+
+                if ( this->GetEchoLevel() > 1 && rModelPart.GetCommunicator().MyPID() == 0)
+                {
+                    std::cout << "ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation: " << "Superset is unchanged, reuse the dof set" << std::endl;
+                }
+
+                return;
+            }
+        }
+
         DofsVectorType dof_list, second_dof_list; // NOTE: The second dof list is only used on constraints to include master/slave relations
 
         ProcessInfo& r_current_process_info = rModelPart.GetProcessInfo();
@@ -767,12 +797,21 @@ public:
             }
         }
 
-        Doftemp.Unique();
-
-        BaseType::mDofSet = Doftemp;
-
         mAllDofs.Unique();
 
+        if (mIncrementalActivation)
+        {
+            // all the dofs of the superset enter the system, inactive ones are handled by identity rows
+            BaseType::mDofSet = mAllDofs;
+            mSupersetSignature = superset_signature;
+            mSupersetChanged = true;
+        }
+        else
+        {
+            Doftemp.Unique();
+            BaseType::mDofSet = Doftemp;
+        }
+
         //Throws an exception if there are no Degrees Of Freedom involved in the analysis
         if(BaseType::mDofSet.size() == 0)
         {
@@ -826,6 +865,13 @@ public:
             std::cout << "ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation: " << "Entering SetUpSystem" << std::endl;
         }
 
+        // the numbering of the superset is kept by the dofs
+        if (mIncrementalActivation && !mSupersetChanged)
+        {
+            BaseType::mEquationSystemSize = BaseType::mDofSet.size();
+            return;
+        }
+
         // initialize the equation id for every dofs in the system. This is to avoid any untouched dofs when the elements are deactivated.
         for (typename DofsArrayType::iterator dof_iterator = mAllDofs.begin(); dof_iterator != mAllDofs.end(); ++dof_iterator)
         {
@@ -884,10 +930,25 @@ public:
         TSystemVectorType& b = *pb;
 
         //resizing the system vectors and matrix
-        if (A.size1() == 0 || BaseType::GetReshapeMatrixFlag() == true) //if the matrix is not initialized
+        if (mIncrementalActivation && !mSupersetChanged && mSupersetColIndices.size() != 0)
+        {
+            // the structure of the superset is still valid, only restore it if the matrix was cleared
+            if (A.size1() != BaseType::mEquationSystemSize || A.nnz() != mSupersetColIndices.size())
+                RestoreSupersetMatrixStructure(A);
+        }
+        else if (A.size1() == 0 || BaseType::GetReshapeMatrixFlag() == true || mIncrementalActivation) //if the matrix is not initialized or the superset has changed
         {
             A.resize(BaseType::mEquationSystemSize, BaseType::mEquationSystemSize, false);
             ConstructMatrixStructure(A, rModelPart);
+
+            if (mIncrementalActivation)
+            {
+                mSupersetRowIndices.resize(A.size1() + 1);
+                std::copy(A.index1_data().begin(), A.index1_data().begin() + A.size1() + 1, mSupersetRowIndices.begin());
+                mSupersetColIndices.resize(A.nnz());
+                std::copy(A.index2_data().begin(), A.index2_data().begin() + A.nnz(), mSupersetColIndices.begin());
+                mSupersetChanged = false;
+            }
         }
         else
         {
@@ -1105,6 +1166,12 @@ public:
         mT.resize(0,0,false);
         mConstantVector.resize(0,false);
 
+        // in incremental activation mode the superset dof set and structure survive the clearing
+        if (!mIncrementalActivation)
+        {
+            ClearSuperset();
+        }
+
         if (this->GetEchoLevel() > 0)
         {
             std::cout << "ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivation Clear Function called" << std::endl;
@@ -1130,6 +1197,28 @@ public:
     ///@name Access
     ///@{
 
+    /**
+     * @brief Enable/disable the incremental activation mode
+     * @details In this mode the dof set, the equation numbering and the matrix structure are built for
+     * all the elements and conditions, whatever their ACTIVE flag. A change of activation then only
+     * modifies the values of the system. A full rebuild is performed only when the elements or
+     * conditions of the model part change.
+     */
+    void SetIncrementalActivationFlag(bool flag)
+    {
+        if (flag != mIncrementalActivation)
+        {
+            ClearSuperset();
+            BaseType::mDofSetIsInitialized = false;
+        }
+        mIncrementalActivation = flag;
+    }
+
+    bool GetIncrementalActivationFlag() const
+    {
+        return mIncrementalActivation;
+    }
+
     ///@}
     ///@name Inquiry
     ///@{
@@ -1175,6 +1264,7 @@ protected:
     std::vector<IndexType> mSlaveIds;  /// The equation ids of the slaves
     std::vector<IndexType> mMasterIds; /// The equation ids of the master
     std::unordered_set<IndexType> mInactiveSlaveDofs; /// The set containing the inactive slave dofs
+    bool mIncrementalActivation;       /// Flag to keep the dof set and the matrix structure of all entities, whatever the activation
 
     ///@}
     ///@name Protected Operators
@@ -1184,6 +1274,22 @@ protected:
     ///@name Protected Operations
     ///@{
 
+    /**
+     * @brief Check if an entity contributes to the matrix structure
+     * @details In incremental activation mode all entities contribute, since the structure is built for the superset
+     */
+    template<class TEntityType>
+    bool IsInStructure(const TEntityType& rEntity) const
+    {
+        if (mIncrementalActivation)
+            return true;
+
+        if (rEntity.IsDefined(ACTIVE))
+            return rEntity.Is(ACTIVE);
+
+        return true;
+    }
+
     void ConstructMasterSlaveConstraintsStructure(ModelPartType& rModelPart)
     {
         if (rModelPart.MasterSlaveConstraints().size() > 0) {
@@ -1560,15 +1666,9 @@ protected:
 
         typename ElementType::EquationIdVectorType ids(3, 0);
 
-        bool element_is_active;
         for(auto it = r_elements_array.begin(); it != r_elements_array.end(); ++it)
         {
-            element_is_active = true;
-            if( it->IsDefined(ACTIVE) ) {
-                element_is_active = it->Is(ACTIVE);
-            }
-
-            if (!element_is_active)
+            if (!IsInStructure(*it))
                 continue;
 
             it->EquationIdVector(ids, CurrentProcessInfo);
@@ -1581,15 +1681,9 @@ protected:
             }
         }
 
-        bool condition_is_active;
         for(auto it = r_conditions_array.begin(); it != r_conditions_array.end(); ++it)
         {
-            condition_is_active = true;
-            if( it->IsDefined(ACTIVE) ) {
-                condition_is_active = it->Is(ACTIVE);
-            }
-
-            if (!condition_is_active)
+            if (!IsInStructure(*it))
                 continue;
 
             it->EquationIdVector(ids, CurrentProcessInfo);
@@ -1728,6 +1822,11 @@ private:
 
     DofsArrayType mAllDofs;
 
+    std::size_t mSupersetSignature; /// Signature of the elements/conditions used to build the superset
+    bool mSupersetChanged; /// Flag to tell that the superset was (re)built in the last SetUpDofSet
+    typename TSystemMatrixType::index_array_type mSupersetRowIndices; /// Cached row pointers of the superset structure
+    typename TSystemMatrixType::index_array_type mSupersetColIndices; /// Cached column indices of the superset structure
+
     ///@}
     ///@name Private Operators
     ///@{
@@ -1736,6 +1835,54 @@ private:
     ///@name Private Operations
     ///@{
 
+    /// Compute a hash of the ids and connectivities of all the elements and conditions of the model part
+    std::size_t ComputeSupersetSignature(const ModelPartType& rModelPart) const
+    {
+        HashType seed = 0;
+
+        HashCombine(seed, rModelPart.Elements().size());
+        for (auto it = rModelPart.Elements().begin(); it != rModelPart.Elements().end(); ++it)
+        {
+            HashCombine(seed, it->Id());
+            for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+                HashCombine(seed, it->GetGeometry()[i].Id());
+        }
+
+        HashCombine(seed, rModelPart.Conditions().size());
+        for (auto it = rModelPart.Conditions().begin(); it != rModelPart.Conditions().end(); ++it)
+        {
+            HashCombine(seed, it->Id());
+            for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+                HashCombine(seed, it->GetGeometry()[i].Id());
+        }
+
+        return seed;
+    }
+
+    /// Rebuild the (zero-valued) matrix structure from the cached superset structure
+    void RestoreSupersetMatrixStructure(TSystemMatrixType& A) const
+    {
+        const std::size_t nnz = mSupersetColIndices.size();
+
+        A = CompressedMatrixType(BaseType::mEquationSystemSize, BaseType::mEquationSystemSize, nnz);
+
+        std::copy(mSupersetRowIndices.begin(), mSupersetRowIndices.end(), A.index1_data().begin());
+        std::copy(mSupersetColIndices.begin(), mSupersetColIndices.end(), A.index2_data().begin());
+        std::fill(A.value_data().begin(), A.value_data().begin() + nnz, zero);
+
+        A.set_filled(BaseType::mEquationSystemSize + 1, nnz);
+    }
+
+    /// Clear the cached superset, forcing a full rebuild at the next SetUpDofSet
+    void ClearSuperset()
+    {
+        mAllDofs = DofsArrayType();
+        mSupersetSignature = 0;
+        mSupersetChanged = true;
+        mSupersetRowIndices.resize(0);
+        mSupersetColIndices.resize(0);
+    }
+
     inline void AddUnique(std::vector<std::size_t>& v, const std::size_t& candidate)
     {
         std::vector<std::size_t>::iterator i = v.begin();
@@ -359,15 +359,9 @@ class ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWise
         typename ElementType::EquationIdVectorType ids(3, 0);
 
         const auto& r_elements_array = rModelPart.Elements();
-        bool element_is_active;
         for(auto it = r_elements_array.ptr_begin(); it != r_elements_array.ptr_end(); ++it)
         {
-            element_is_active = true;
-            if( (*it)->IsDefined(ACTIVE) ) {
-                element_is_active = (*it)->Is(ACTIVE);
-            }
-
-            if (!element_is_active)
+            if (!BaseType::IsInStructure(*(*it)))
                 continue;
 
             (*it)->EquationIdVector(ids, CurrentProcessInfo);
@@ -382,15 +376,9 @@ class ResidualBasedBlockBuilderAndSolverWithConstraintsDeactivationElementWise
         }
 
         const auto& r_conditions_array = rModelPart.Conditions();
-        bool condition_is_active;
         for(auto it = r_conditions_array.ptr_begin(); it != r_conditions_array.ptr_end(); ++it)
         {
-            condition_is_active = true;
-            if( (*it)->IsDefined(ACTIVE) ) {
-                condition_is_active = (*it)->Is(ACTIVE);
-            }
-
-            if (!condition_is_active)
+            if (!BaseType::IsInStructure(*(*it)))
                 continue;
 
             (*it)->EquationIdVector(ids, CurrentProcessInfo);
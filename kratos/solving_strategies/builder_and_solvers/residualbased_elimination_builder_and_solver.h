@@ -912,22 +912,20 @@ public:
         //refresh RHS to have the correct reactions
         BuildRHS(pScheme, r_model_part, b);
 
-        int i;
-        int systemsize = BaseType::mDofSet.size() - TSparseSpace::Size(*BaseType::mpReactionsVector);
+        const int systemsize = BaseType::mDofSet.size() - TSparseSpace::Size(*BaseType::mpReactionsVector);
+        const int ndofs = static_cast<int>(BaseType::mDofSet.size());
 
-        typename DofsArrayType::ptr_iterator it2;
-        // KRATOS_WATCH(*BaseType::mpReactionsVector);
         //updating variables
         TSystemVectorType& ReactionsVector = *BaseType::mpReactionsVector;
-        for (it2 = BaseType::mDofSet.ptr_begin(); it2 != BaseType::mDofSet.ptr_end(); ++it2)
+        #pragma omp parallel for firstprivate(ndofs, systemsize)
+        for (int k = 0; k < ndofs; k++)
         {
-            if ((*it2)->IsFixed())
+            typename DofsArrayType::iterator dof_iterator = BaseType::mDofSet.begin() + k;
+
+            if (dof_iterator->IsFixed())
             {
-                i = (*it2)->EquationId();
-                i -= systemsize;
-                /*KRATOS_WATCH((*it2)->GetSolutionStepReactionValue());
-                KRATOS_WATCH(ReactionsVector[i]);*/
-                (*it2)->GetSolutionStepReactionValue() = ReactionsVector[i];
+                const int i = static_cast<int>(dof_iterator->EquationId()) - systemsize;
+                dof_iterator->GetSolutionStepReactionValue() = ReactionsVector[i];
             }
         }
     }
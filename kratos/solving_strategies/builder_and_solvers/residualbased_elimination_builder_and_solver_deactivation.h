@@ -65,6 +65,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "includes/matrix_market_interface.h"
 #include "includes/kratos_flags.h"
 #include "includes/deprecated_variables.h"
+#include "includes/key_hash.h"
 #include "utilities/timer.h"
 #include "utilities/openmp_utils.h"
 #include "solving_strategies/builder_and_solvers/builder_and_solver.h"
@@ -80,6 +81,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 // #define EXPORT_LHS_MATRIX_SAMPLING
 // #define EXPORT_RHS_VECTOR_SAMPLING
 // #define EXPORT_SOL_VECTOR_SAMPLING
+// #define EXPORT_SYSTEM_BINARY // export the system in the binary compressed format instead of Matrix Market
 //#define EXPORT_NODE_INFO
 
 #define DOF_ENUMERATION_STRAIGHT
@@ -177,6 +179,12 @@ this information.
 
 Calculation of the reactions involves a cost very similiar to the calculation of the total residual
 
+In the incremental activation mode (see SetIncrementalActivationFlag) the dof set is built for all elements
+and conditions, regardless of their activation, as the matrix structure already is. The equations touched only
+by inactive entities get the average diagonal in Build (MODIFY_INACTIVE_PART_OF_THE_MATRIX). The dof set, the
+numbering and the matrix structure are kept as long as the elements/conditions of the model part and the
+fixity of the dofs are unchanged, so a change of activation only touches the values of the system.
+
 \URL[Example of use html]{ extended_documentation/no_ex_of_use.html}
 
 \URL[Example of use pdf]{ extended_documentation/no_ex_of_use.pdf}
@@ -264,6 +272,10 @@ public:
         #endif
         mLocalCounter = 0;
         mStepCounter = 0;
+        mIncrementalActivation = false;
+        mSupersetSignature = 0;
+        mFixitySignature = 0;
+        mSupersetChanged = true;
     }
 
     /** Destructor.
@@ -887,31 +899,51 @@ public:
 
         #ifdef EXPORT_LHS_MATRIX
         std::stringstream lhs_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".bin";
+        WriteBinaryMatrix(lhs_filename.str().c_str(), A);
+        #else
         lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".mm";
         WriteMatrixMarketMatrix(lhs_filename.str().c_str(), A, false);
         #endif
+        #endif
 
         #ifdef EXPORT_LHS_MATRIX_SAMPLING
         if(mLocalCounter == 0 && mStepCounter == 0)
         {
             std::stringstream lhs_filename;
+            #ifdef EXPORT_SYSTEM_BINARY
+            lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".bin";
+            WriteBinaryMatrix(lhs_filename.str().c_str(), A);
+            #else
             lhs_filename << "A_" << mStepCounter << "." << mLocalCounter << ".mm";
             WriteMatrixMarketMatrix(lhs_filename.str().c_str(), A, false);
+            #endif
         }
         #endif
 
         #ifdef EXPORT_RHS_VECTOR
         std::stringstream rhs_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".bin";
+        WriteBinaryVector(rhs_filename.str().c_str(), b);
+        #else
         rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".mm";
         WriteMatrixMarketVector(rhs_filename.str().c_str(), b);
         #endif
+        #endif
 
         #ifdef EXPORT_RHS_VECTOR_SAMPLING
         if(mLocalCounter == 0 && mStepCounter == 0)
         {
             std::stringstream rhs_filename;
+            #ifdef EXPORT_SYSTEM_BINARY
+            rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".bin";
+            WriteBinaryVector(rhs_filename.str().c_str(), b);
+            #else
             rhs_filename << "b_" << mStepCounter << "." << mLocalCounter << ".mm";
             WriteMatrixMarketVector(rhs_filename.str().c_str(), b);
+            #endif
         }
         #endif
 
@@ -1089,16 +1121,26 @@ public:
         if(mLocalCounter == 1 && mStepCounter == 0)
         {
             std::stringstream dx_filename;
+            #ifdef EXPORT_SYSTEM_BINARY
+            dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".bin";
+            WriteBinaryVector(dx_filename.str().c_str(), Dx);
+            #else
             dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".mm";
             WriteMatrixMarketVector(dx_filename.str().c_str(), Dx);
+            #endif
         }
         #endif
 
         #ifdef EXPORT_SOL_VECTOR
         std::stringstream dx_filename;
+        #ifdef EXPORT_SYSTEM_BINARY
+        dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".bin";
+        WriteBinaryVector(dx_filename.str().c_str(), Dx);
+        #else
         dx_filename << "dx_" << mStepCounter << "." << mLocalCounter-1 << ".mm";
         WriteMatrixMarketVector(dx_filename.str().c_str(), Dx);
         #endif
+        #endif
 
         KRATOS_CATCH("")
     }
@@ -1353,6 +1395,22 @@ public:
         KRATOS_TRY
 
         std::cout << "setting up the dofs" << std::endl;
+
+        HashType superset_signature = 0;
+        if (mIncrementalActivation)
+        {
+            superset_signature = ComputeSupersetSignature(r_model_part);
+
+            // the superset of entities is unchanged, the dof set is reused whatever the activation is
+            if (superset_signature == mSupersetSignature && mAllDofs.size() != 0)
+            {
+                BaseType::mDofSet = mAllDofs;
+                BaseType::mDofSetIsInitialized = true;
+                std::cout << "superset is unchanged, reuse the dof set" << std::endl;
+                return;
+            }
+        }
+
         Timer::Start("SetUpDofSet");
 
         // obtain the dofs from elements
@@ -1416,9 +1474,19 @@ public:
         KRATOS_WATCH(pConditions.size());
         KRATOS_WATCH(num_active_conditions)
 
-        Doftemp.Unique();
-
-        BaseType::mDofSet = Doftemp;
+        if (mIncrementalActivation)
+        {
+            // all the dofs of the superset enter the system
+            mAllDofs.Unique();
+            BaseType::mDofSet = mAllDofs;
+            mSupersetSignature = superset_signature;
+            mSupersetChanged = true;
+        }
+        else
+        {
+            Doftemp.Unique();
+            BaseType::mDofSet = Doftemp;
+        }
 
         KRATOS_WATCH(mAllDofs.size())
         KRATOS_WATCH(BaseType::mDofSet.size())
@@ -1451,6 +1519,9 @@ public:
         ModelPartType& r_model_part
     ) override
     {
+        if (EquationNumberingIsUnchanged())
+            return;
+
         // initialize the equation id for every dofs in the system. This is to avoid any untouched dofs when the elements are deactivated.
         for (typename DofsArrayType::iterator dof_iterator = mAllDofs.begin(); dof_iterator != mAllDofs.end(); ++dof_iterator)
         {
@@ -1500,6 +1571,9 @@ public:
         MY_LOG_TRACE << "DOF_ENUMERATION_STRAIGHT" << std::endl;
         #endif
 
+        if (EquationNumberingIsUnchanged())
+            return;
+
         // initialize the equation id for every dofs in the system. This is to avoid any untouched dofs when the elements are deactivated.
         for (typename DofsArrayType::iterator dof_iterator = mAllDofs.begin(); dof_iterator != mAllDofs.end(); ++dof_iterator)
         {
@@ -1556,6 +1630,9 @@ public:
         MY_LOG_TRACE << "DOF_ENUMERATION_FULL_STRAIGHT" << std::endl;
         #endif
 
+        if (EquationNumberingIsUnchanged())
+            return;
+
         // initialize the equation id for every dofs in the system. This is to avoid any untouched dofs when the elements are deactivated.
         for (typename DofsArrayType::iterator dof_iterator = mAllDofs.begin(); dof_iterator != mAllDofs.end(); ++dof_iterator)
         {
@@ -1641,10 +1718,13 @@ public:
         TSystemVectorType& b  = *pb;
 
         //resizing the system vectors and matrix; also construct the structure of the stiffness matrix a priori for inserting element later on
-        if (A.size1() == 0 || BaseType::GetReshapeMatrixFlag() == true) //if the matrix is not initialized
+        //in incremental activation mode the structure of the superset is kept until the superset or the numbering changes
+        const bool reshape = mIncrementalActivation ? mSupersetChanged : BaseType::GetReshapeMatrixFlag();
+        if (A.size1() == 0 || reshape == true) //if the matrix is not initialized
         {
             A.resize(BaseType::mEquationSystemSize,BaseType::mEquationSystemSize,false);
             ConstructMatrixStructure(A,rElements,rConditions,CurrentProcessInfo);
+            mSupersetChanged = false;
         }
         else
         {
@@ -1784,6 +1864,32 @@ public:
     /**@name Access */
     /*@{ */
 
+    /**
+     * Enable/disable the incremental activation mode. In this mode the dof set and the equation numbering
+     * are built for all the elements and conditions, whatever their activation, and they are kept together
+     * with the matrix structure until the elements/conditions of the model part or the fixity change.
+     */
+    void SetIncrementalActivationFlag(bool flag)
+    {
+        #if !defined(_OPENMP) || !defined(MODIFY_INACTIVE_PART_OF_THE_MATRIX)
+        KRATOS_ERROR_IF(flag) << "The incremental activation requires the modification of the inactive part of the matrix in the parallel Build" << std::endl;
+        #endif
+
+        if (flag != mIncrementalActivation)
+        {
+            mAllDofs = DofsArrayType();
+            mSupersetSignature = 0;
+            mFixitySignature = 0;
+            mSupersetChanged = true;
+            BaseType::mDofSetIsInitialized = false;
+        }
+        mIncrementalActivation = flag;
+    }
+
+    bool GetIncrementalActivationFlag() const
+    {
+        return mIncrementalActivation;
+    }
 
     /*@} */
     /**@name Inquiry */
@@ -2130,6 +2236,11 @@ private:
 
     DofsArrayType mAllDofs; // carry all possible dofs in the mesh
 
+    bool mIncrementalActivation; // keep the dof set, the numbering and the matrix structure of all entities, whatever the activation
+    HashType mSupersetSignature; // signature of the elements/conditions used to build the superset
+    HashType mFixitySignature; // signature of the fixity of the dofs used for the numbering
+    bool mSupersetChanged; // the superset or its numbering was rebuilt, hence the matrix structure must be rebuilt
+
     #ifdef ENABLE_LOG
     boost::log::sources::severity_logger<boost::log::trivial::severity_level> m_log_level;
     #endif
@@ -2143,6 +2254,50 @@ private:
     /**@name Private Operations*/
     /*@{ */
 
+    //**************************************************************************
+    // compute a hash of the ids and connectivities of all the elements and conditions of the model part
+    HashType ComputeSupersetSignature(const ModelPartType& r_model_part) const
+    {
+        HashType seed = 0;
+
+        HashCombine(seed, r_model_part.Elements().size());
+        for (auto it = r_model_part.Elements().begin(); it != r_model_part.Elements().end(); ++it)
+        {
+            HashCombine(seed, it->Id());
+            for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+                HashCombine(seed, it->GetGeometry()[i].Id());
+        }
+
+        HashCombine(seed, r_model_part.Conditions().size());
+        for (auto it = r_model_part.Conditions().begin(); it != r_model_part.Conditions().end(); ++it)
+        {
+            HashCombine(seed, it->Id());
+            for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+                HashCombine(seed, it->GetGeometry()[i].Id());
+        }
+
+        return seed;
+    }
+
+    //**************************************************************************
+    // in incremental activation mode, check if the numbering of the superset can be kept, i.e. the superset
+    // and the fixity of its dofs are unchanged. Otherwise the matrix structure is marked to be rebuilt.
+    bool EquationNumberingIsUnchanged()
+    {
+        if (!mIncrementalActivation)
+            return false;
+
+        HashType fixity_signature = 0;
+        for (typename DofsArrayType::iterator dof_iterator = BaseType::mDofSet.begin(); dof_iterator != BaseType::mDofSet.end(); ++dof_iterator)
+            HashCombine(fixity_signature, dof_iterator->IsFixed());
+
+        const bool is_unchanged = !mSupersetChanged && fixity_signature == mFixitySignature;
+        mFixitySignature = fixity_signature;
+        if (!is_unchanged)
+            mSupersetChanged = true;
+
+        return is_unchanged;
+    }
 
     //**************************************************************************
     void AssembleLHS_CompleteOnFreeRows(
@@ -2252,6 +2407,7 @@ private:
 #undef EXPORT_LHS_MATRIX
 #undef EXPORT_RHS_VECTOR
 #undef EXPORT_SOL_VECTOR
+#undef EXPORT_SYSTEM_BINARY
 #undef EXPORT_LHS_MATRIX_SAMPLING
 #undef EXPORT_RHS_VECTOR_SAMPLING
 #undef ACCOUNT_DOFS_FOR_CONDITION
@@ -354,15 +354,21 @@ private:
         //        mReferenceDispNorm += temp*temp;
         //    }
         //}
-        for(typename DofsArrayType::iterator i_dof = rDofSet.begin() ; i_dof != rDofSet.end() ; ++i_dof)
+        const int ndofs = static_cast<int>(rDofSet.size());
+        const typename DofsArrayType::iterator dofs_begin = rDofSet.begin();
+        ValueType reference_disp_norm = ValueType();
+
+        #pragma omp parallel for firstprivate(ndofs, dofs_begin) reduction(+:reference_disp_norm)
+        for(int k = 0; k < ndofs; ++k)
         {
+            typename DofsArrayType::iterator i_dof = dofs_begin + k;
             if(i_dof->IsFree())
             {
                 ValueType temp = std::abs(i_dof->GetSolutionStepValue());
-                mReferenceDispNorm += temp*temp;
+                reference_disp_norm += temp*temp;
             }
         }
-        mReferenceDispNorm = std::sqrt(mReferenceDispNorm);
+        mReferenceDispNorm = std::sqrt(reference_disp_norm);
     }
 
     /*@} */
@@ -0,0 +1,434 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_VARIABLE_NORMS_CRITERIA )
+#define  KRATOS_VARIABLE_NORMS_CRITERIA
+
+
+/* System includes */
+#include <map>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+
+
+/* External includes */
+
+
+/* Project includes */
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "solving_strategies/convergencecriterias/convergence_criteria.h"
+
+namespace Kratos
+{
+
+/**@name  Enum's */
+/*@{ */
+
+/// The norms checked by the VariableNormsCriteria for each group of dofs
+enum class VariableNormsCombination
+{
+    Increment,              // ||Dx||/||x|| <= ratio or ||Dx||/n < absolute
+    Residual,               // ||b||/||b0|| <= ratio or ||b||/n < absolute
+    IncrementAndResidual,   // both the increment and the residual are converged
+    IncrementOrResidual     // either the increment or the residual is converged
+};
+
+/*@} */
+/**@name Kratos Classes */
+/*@{ */
+
+/**
+ * Convergence criteria on the norms of the increment and of the residual by groups of dofs, e.g. the displacements
+ * and the pressures. The dofs are sorted to their groups by their variable; the dofs whose variable was not added to
+ * a group are in the group 0, which takes the tolerances of the constructor. The equation ids, the groups and the
+ * addresses of the current values of the free dofs are cached at the beginning of the solution step, so that all the
+ * norms of all the groups are computed from one parallel pass over these arrays, without looking up the values in
+ * the nodes and without computing the norms of Dx, x and b over the whole vectors. A group is
+ * converged according to the combination of its norms, and the criteria is satisfied when all the groups are
+ * converged. The partial norms of the threads are added in a fixed order,
+ * so that the result does not depend on the scheduling of the threads.
+ */
+template<class TSparseSpace,
+         class TDenseSpace,
+         class TModelPartType
+         >
+class VariableNormsCriteria : virtual public ConvergenceCriteria< TSparseSpace, TDenseSpace, TModelPartType >
+{
+public:
+    /**@name Type Definitions */
+    /*@{ */
+
+    KRATOS_CLASS_POINTER_DEFINITION( VariableNormsCriteria );
+
+    typedef ConvergenceCriteria< TSparseSpace, TDenseSpace, TModelPartType > BaseType;
+
+    typedef TSparseSpace SparseSpaceType;
+
+    typedef typename BaseType::ValueType ValueType;
+
+    typedef typename BaseType::TDataType TDataType;
+
+    typedef typename BaseType::DofType DofType;
+
+    typedef typename BaseType::DofsArrayType DofsArrayType;
+
+    typedef typename BaseType::ModelPartType ModelPartType;
+
+    typedef typename BaseType::TSystemMatrixType TSystemMatrixType;
+
+    typedef typename BaseType::TSystemVectorType TSystemVectorType;
+
+    typedef VariableData::KeyType KeyType;
+
+    /*@} */
+    /**@name Life Cycle
+    */
+    /*@{ */
+
+    /** Constructor.
+    @param RatioTolerance the relative tolerance of the dofs of the group 0
+    @param AlwaysConvergedNorm the absolute tolerance of the dofs of the group 0
+    @param Combination the norms which are checked for each group
+    */
+    VariableNormsCriteria(
+        ValueType RatioTolerance,
+        ValueType AlwaysConvergedNorm,
+        VariableNormsCombination Combination = VariableNormsCombination::Increment)
+        : BaseType()
+        , mCombination(Combination)
+        , mInitialResidualIsSet(false)
+        , mNumberOfDofs(0)
+        , mpFirstFreeDof(nullptr)
+    {
+        AddGroup("others", RatioTolerance, AlwaysConvergedNorm);
+    }
+
+    /** Destructor.
+    */
+    ~VariableNormsCriteria() override {}
+
+    /*@} */
+    /**@name Operators
+    */
+    /*@{ */
+
+    /*Criterias that need to be called after getting the solution */
+    bool PostCriteria(
+        ModelPartType& r_model_part,
+        DofsArrayType& rDofSet,
+        const TSystemMatrixType& A,
+        const TSystemVectorType& Dx,
+        const TSystemVectorType& b
+    ) override
+    {
+        if (SparseSpaceType::Size(Dx) == 0) //in this case all the dofs are imposed
+            return true;
+
+        // the cached values are those of the current step of the nodes, the buffer moves with the steps
+        if (rDofSet.size() != mNumberOfDofs || (mpFirstFreeDof != nullptr && &mpFirstFreeDof->GetSolutionStepValue() != mFreeDofsValues[0]))
+            InitializeFreeDofs(rDofSet);
+
+        CalculateNorms(Dx, b);
+
+        if (!mInitialResidualIsSet)
+        {
+            for (auto& r_group : mGroups)
+                r_group.InitialResidualNorm = r_group.ResidualNorm;
+            mInitialResidualIsSet = true;
+        }
+
+        bool is_converged = true;
+        ValueType max_ratio = 0.0;
+        ValueType residual_norm = 0.0;
+        SizeType number_of_free_dofs = 0;
+        for (auto& r_group : mGroups)
+        {
+            if (r_group.NumberOfDofs == 0)
+                continue;
+
+            const ValueType n = static_cast<ValueType>(r_group.NumberOfDofs);
+
+            const ValueType increment_ratio = Ratio(r_group.IncrementNorm, r_group.SolutionNorm);
+            const bool increment_converged = increment_ratio <= r_group.RatioTolerance || r_group.IncrementNorm / n < r_group.AlwaysConvergedNorm;
+
+            const ValueType residual_ratio = Ratio(r_group.ResidualNorm, r_group.InitialResidualNorm);
+            const bool residual_converged = residual_ratio <= r_group.RatioTolerance || r_group.ResidualNorm / n < r_group.AlwaysConvergedNorm;
+
+            bool group_converged;
+            switch (mCombination)
+            {
+                case VariableNormsCombination::Increment:
+                    group_converged = increment_converged;
+                    max_ratio = std::max(max_ratio, increment_ratio);
+                    break;
+                case VariableNormsCombination::Residual:
+                    group_converged = residual_converged;
+                    max_ratio = std::max(max_ratio, residual_ratio);
+                    break;
+                case VariableNormsCombination::IncrementAndResidual:
+                    group_converged = increment_converged && residual_converged;
+                    max_ratio = std::max(max_ratio, std::max(increment_ratio, residual_ratio));
+                    break;
+                default:
+                    group_converged = increment_converged || residual_converged;
+                    max_ratio = std::max(max_ratio, std::min(increment_ratio, residual_ratio));
+            }
+
+            is_converged = is_converged && group_converged;
+            residual_norm += r_group.ResidualNorm * r_group.ResidualNorm;
+            number_of_free_dofs += r_group.NumberOfDofs;
+
+            if (this->GetEchoLevel() == 1)
+                std::cout << "VARIABLE NORMS CRITERION :: " << r_group.Name << " (" << r_group.NumberOfDofs << " dofs) :: [ ||Dx||/||x|| = " << increment_ratio
+                          << "; ||b||/||b0|| = " << residual_ratio << "; ||b||/n = " << r_group.ResidualNorm / n
+                          << "; Expected tol = " << r_group.RatioTolerance << "; ]" << (group_converged ? " converged" : "") << std::endl;
+        }
+
+        r_model_part.GetProcessInfo()[CONVERGENCE_RATIO] = max_ratio;
+        r_model_part.GetProcessInfo()[RESIDUAL_NORM] = std::sqrt(residual_norm) / static_cast<ValueType>(std::max(number_of_free_dofs, SizeType(1)));
+
+        if (is_converged && this->GetEchoLevel() == 1)
+            std::cout << "Convergence is achieved" << std::endl;
+
+        return is_converged;
+    }
+
+    void Initialize(
+        ModelPartType& r_model_part
+    ) override
+    {
+        BaseType::mConvergenceCriteriaIsInitialized = true;
+    }
+
+    void InitializeSolutionStep(
+        ModelPartType& r_model_part,
+        DofsArrayType& rDofSet,
+        const TSystemMatrixType& A,
+        const TSystemVectorType& Dx,
+        const TSystemVectorType& b
+    ) override
+    {
+        // the dof set and the fixity may change between the steps
+        InitializeFreeDofs(rDofSet);
+        mInitialResidualIsSet = false;
+    }
+
+    /*@} */
+    /**@name Operations */
+    /*@{ */
+
+    /// Add a group of dofs with its tolerances, and return its index
+    std::size_t AddGroup(const std::string& Name, ValueType RatioTolerance, ValueType AlwaysConvergedNorm)
+    {
+        mGroups.push_back(Group());
+        mGroups.back().Name = Name;
+        mGroups.back().RatioTolerance = RatioTolerance;
+        mGroups.back().AlwaysConvergedNorm = AlwaysConvergedNorm;
+        mNumberOfDofs = 0; // the groups of the dofs are sorted again
+        return mGroups.size() - 1;
+    }
+
+    /// Add the dofs of the variable (e.g. DISPLACEMENT_X) to the group
+    void AddVariable(std::size_t GroupIndex, const VariableData& rVariable)
+    {
+        if (GroupIndex >= mGroups.size())
+            KRATOS_ERROR << "Group " << GroupIndex << " does not exist, the number of groups is " << mGroups.size();
+        mVariableGroups[rVariable.Key()] = GroupIndex;
+        mNumberOfDofs = 0;
+    }
+
+    /*@} */
+    /**@name Access */
+    /*@{ */
+
+    std::size_t NumberOfGroups() const
+    {
+        return mGroups.size();
+    }
+
+    /// The norms of the group at the last check
+    ValueType GetIncrementNorm(std::size_t GroupIndex) const
+    {
+        return mGroups[GroupIndex].IncrementNorm;
+    }
+
+    ValueType GetSolutionNorm(std::size_t GroupIndex) const
+    {
+        return mGroups[GroupIndex].SolutionNorm;
+    }
+
+    ValueType GetResidualNorm(std::size_t GroupIndex) const
+    {
+        return mGroups[GroupIndex].ResidualNorm;
+    }
+
+    /*@} */
+    /**@name Input and output */
+    /*@{ */
+
+    /// Turn back information as a string.
+    std::string Info() const override
+    {
+        return "VariableNormsCriteria";
+    }
+
+    /*@} */
+
+private:
+    /**@name Type Definitions */
+    /*@{ */
+
+    typedef std::size_t SizeType;
+
+    struct Group
+    {
+        std::string Name;
+        ValueType RatioTolerance = 0.0;
+        ValueType AlwaysConvergedNorm = 0.0;
+        SizeType NumberOfDofs = 0;
+        ValueType IncrementNorm = 0.0;
+        ValueType SolutionNorm = 0.0;
+        ValueType ResidualNorm = 0.0;
+        ValueType InitialResidualNorm = 0.0;
+    };
+
+    /*@} */
+    /**@name Member Variables */
+    /*@{ */
+
+    VariableNormsCombination mCombination;
+
+    bool mInitialResidualIsSet;
+
+    std::vector<Group> mGroups;
+
+    std::map<KeyType, std::size_t> mVariableGroups;
+
+    SizeType mNumberOfDofs; // the size of the dof set the free dofs were taken from
+
+    const DofType* mpFirstFreeDof;
+
+    std::vector<std::size_t> mFreeDofsRows;
+
+    std::vector<const TDataType*> mFreeDofsValues;
+
+    std::vector<unsigned int> mFreeDofsGroups;
+
+    /*@} */
+    /**@name Private Operations*/
+    /*@{ */
+
+    static ValueType Ratio(ValueType Norm, ValueType ReferenceNorm)
+    {
+        if (Norm == 0.0)
+            return 0.0;
+        if (ReferenceNorm == 0.0)
+            return std::numeric_limits<ValueType>::max();
+        return Norm / ReferenceNorm;
+    }
+
+    /// Cache the equation ids, the values and the groups of the free dofs
+    void InitializeFreeDofs(DofsArrayType& rDofSet)
+    {
+        mpFirstFreeDof = nullptr;
+        mFreeDofsRows.clear();
+        mFreeDofsValues.clear();
+        mFreeDofsGroups.clear();
+        mFreeDofsRows.reserve(rDofSet.size());
+        mFreeDofsValues.reserve(rDofSet.size());
+        mFreeDofsGroups.reserve(rDofSet.size());
+
+        for (auto& r_group : mGroups)
+            r_group.NumberOfDofs = 0;
+
+        for (typename DofsArrayType::iterator i_dof = rDofSet.begin(); i_dof != rDofSet.end(); ++i_dof)
+        {
+            if (i_dof->IsFree())
+            {
+                auto it = mVariableGroups.find(i_dof->GetVariable().Key());
+                const unsigned int group = (it == mVariableGroups.end()) ? 0 : it->second;
+                if (mpFirstFreeDof == nullptr)
+                    mpFirstFreeDof = &(*i_dof);
+                mFreeDofsRows.push_back(i_dof->EquationId());
+                mFreeDofsValues.push_back(&i_dof->GetSolutionStepValue());
+                mFreeDofsGroups.push_back(group);
+                ++mGroups[group].NumberOfDofs;
+            }
+        }
+
+        mNumberOfDofs = rDofSet.size();
+    }
+
+    /// Compute the norms of Dx, x and b of all groups in one pass over the free dofs
+    void CalculateNorms(const TSystemVectorType& Dx, const TSystemVectorType& b)
+    {
+        const std::size_t number_of_groups = mGroups.size();
+        const int number_of_dofs = static_cast<int>(mFreeDofsRows.size());
+        const bool has_residual = (SparseSpaceType::Size(b) != 0);
+
+        const int number_of_threads = OpenMPUtils::GetNumThreads();
+        std::vector<int> dofs_partition;
+        OpenMPUtils::CreatePartition(number_of_threads, number_of_dofs, dofs_partition);
+
+        // the sums of squares of Dx, x and b of each group, for each partition
+        std::vector<ValueType> partial_sums(3 * number_of_groups * number_of_threads, 0.0);
+
+        #pragma omp parallel for
+        for (int k = 0; k < number_of_threads; ++k)
+        {
+            ValueType* sums = &partial_sums[3 * number_of_groups * k];
+            for (int i = dofs_partition[k]; i < dofs_partition[k+1]; ++i)
+            {
+                const std::size_t row = mFreeDofsRows[i];
+                ValueType* group_sums = sums + 3 * mFreeDofsGroups[i];
+
+                const ValueType dx = std::abs(Dx[row]);
+                const ValueType x = std::abs(*mFreeDofsValues[i]);
+                group_sums[0] += dx * dx;
+                group_sums[1] += x * x;
+                if (has_residual)
+                {
+                    const ValueType r = std::abs(b[row]);
+                    group_sums[2] += r * r;
+                }
+            }
+        }
+
+        // combine the partitions in a fixed order
+        for (std::size_t g = 0; g < number_of_groups; ++g)
+        {
+            ValueType sums[3] = {0.0, 0.0, 0.0};
+            for (int k = 0; k < number_of_threads; ++k)
+                for (int j = 0; j < 3; ++j)
+                    sums[j] += partial_sums[3 * (number_of_groups * k + g) + j];
+
+            mGroups[g].IncrementNorm = std::sqrt(sums[0]);
+            mGroups[g].SolutionNorm = std::sqrt(sums[1]);
+            mGroups[g].ResidualNorm = std::sqrt(sums[2]);
+        }
+    }
+
+    /*@} */
+
+}; /* Class VariableNormsCriteria */
+
+/*@} */
+
+}  /* namespace Kratos.*/
+
+#endif /* KRATOS_VARIABLE_NORMS_CRITERIA  defined */
@@ -0,0 +1,598 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_RESIDUALBASED_QUASI_NEWTON_STRATEGY_H_INCLUDED )
+#define  KRATOS_RESIDUALBASED_QUASI_NEWTON_STRATEGY_H_INCLUDED
+
+// System includes
+#include <cmath>
+#include <deque>
+#include <iostream>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "solving_strategies/strategies/residualbased_newton_raphson_strategy.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/// The secant update of the inverse of the tangent
+enum class QuasiNewtonUpdateType
+{
+    /// Limited memory BFGS, for symmetric tangents
+    BFGS,
+    /// Broyden's "good" update, for unsymmetric tangents
+    Broyden
+};
+
+/**
+ * @class ResidualBasedQuasiNewtonStrategy
+ * @ingroup KratosCore
+ * @brief Newton-Raphson with one factorized tangent corrected by secant updates
+ * @details The tangent is built and factorized once and kept over the iterations and the solution steps. Each
+ * iteration the correction is the back substitution with the factorization, corrected by the limited memory BFGS
+ * (two loop recursion) or Broyden (product form) updates of the pairs s = du, y = -db of the previous iterations. The
+ * step length along the correction is found by a line search on the projection d'b of the residual onto the
+ * correction d, and the residual of the accepted step is the one of the next iteration. The tangent is rebuilt and
+ * refactorized when the residual does not decrease by the stall factor, when the BFGS curvature s'y is not positive
+ * and, if set, at each solution step. Without updates and with the tangent refreshed each iteration the strategy is
+ * the ResidualBasedNewtonRaphsonStrategy.
+ * The scheme, the builder and solver and the convergence criteria are used as in ResidualBasedNewtonRaphsonStrategy,
+ * except that the residual passed to PostCriteria is always the one of the updated state, as with GetActualizeRHSflag().
+ * The factorization is kept by the linear solvers for which FactorizationIsReusable() is true, e.g.
+ * SkylineLUFactorizationSolver, the other ones solve with the kept tangent each iteration.
+ * Only real systems are supported.
+ */
+template<class TSparseSpace,
+         class TDenseSpace,
+         class TLinearSolver,
+         class TModelPartType
+         >
+class ResidualBasedQuasiNewtonStrategy
+    : public ResidualBasedNewtonRaphsonStrategy<TSparseSpace, TDenseSpace, TLinearSolver, TModelPartType>
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    KRATOS_CLASS_POINTER_DEFINITION(ResidualBasedQuasiNewtonStrategy);
+
+    typedef ResidualBasedNewtonRaphsonStrategy<TSparseSpace, TDenseSpace, TLinearSolver, TModelPartType> BaseType;
+
+    typedef typename BaseType::TBuilderAndSolverType TBuilderAndSolverType;
+
+    typedef typename BaseType::TConvergenceCriteriaType TConvergenceCriteriaType;
+
+    typedef typename BaseType::TDataType TDataType;
+
+    typedef TSparseSpace SparseSpaceType;
+
+    typedef typename BaseType::ModelPartType ModelPartType;
+
+    typedef typename BaseType::TSchemeType TSchemeType;
+
+    typedef typename BaseType::DofsArrayType DofsArrayType;
+
+    typedef typename BaseType::TSystemMatrixType TSystemMatrixType;
+
+    typedef typename BaseType::TSystemVectorType TSystemVectorType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    ResidualBasedQuasiNewtonStrategy(
+        ModelPartType& model_part,
+        typename TSchemeType::Pointer pScheme,
+        typename TLinearSolver::Pointer pNewLinearSolver,
+        typename TConvergenceCriteriaType::Pointer pNewConvergenceCriteria,
+        int MaxIterations = 30,
+        bool CalculateReactions = false,
+        bool ReformDofSetAtEachStep = false,
+        bool MoveMeshFlag = false
+    )
+        : BaseType(model_part, pScheme, pNewLinearSolver, pNewConvergenceCriteria, MaxIterations, CalculateReactions, ReformDofSetAtEachStep, MoveMeshFlag)
+    {
+        InitializeQuasiNewtonParameters();
+    }
+
+    ResidualBasedQuasiNewtonStrategy(
+        ModelPartType& model_part,
+        typename TSchemeType::Pointer pScheme,
+        typename TLinearSolver::Pointer pNewLinearSolver,
+        typename TConvergenceCriteriaType::Pointer pNewConvergenceCriteria,
+        typename TBuilderAndSolverType::Pointer pNewBuilderAndSolver,
+        int MaxIterations = 30,
+        bool CalculateReactions = false,
+        bool ReformDofSetAtEachStep = false,
+        bool MoveMeshFlag = false
+    )
+        : BaseType(model_part, pScheme, pNewLinearSolver, pNewConvergenceCriteria, pNewBuilderAndSolver, MaxIterations, CalculateReactions, ReformDofSetAtEachStep, MoveMeshFlag)
+    {
+        InitializeQuasiNewtonParameters();
+    }
+
+    ~ResidualBasedQuasiNewtonStrategy() override
+    {
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Release the factorization and the updates, the tangent is rebuilt at the next iteration
+    void Clear() override
+    {
+        KRATOS_TRY
+
+        ReleaseTangent();
+        BaseType::Clear();
+
+        KRATOS_CATCH("")
+    }
+
+    /**
+    Solves the current step. This function returns true if a solution has been found, false otherwise.
+    */
+    bool SolveSolutionStep() override
+    {
+        KRATOS_TRY
+
+        typename TSchemeType::Pointer pScheme = this->GetScheme();
+        typename TBuilderAndSolverType::Pointer pBuilderAndSolver = this->GetBuilderAndSolver();
+        ModelPartType& r_model_part = this->GetModelPart();
+
+        DofsArrayType& rDofSet = pBuilderAndSolver->GetDofSet();
+
+        TSystemMatrixType& rA = *(this->mpA);
+        TSystemVectorType& rDx = *(this->mpDx);
+        TSystemVectorType& rb = *(this->mpb);
+
+        if (SparseSpaceType::Size(rDx) == 0)
+        {
+            std::cout << "ATTENTION: no free DOFs!! " << std::endl;
+            return BaseType::SolveSolutionStep();
+        }
+
+        const std::size_t system_size = SparseSpaceType::Size(rDx);
+        TSystemVectorType b_old(system_size), d(system_size);
+
+        // the updates of the previous step do not apply to the new one
+        mS.clear();
+        mY.clear();
+        mRho.clear();
+
+        unsigned int iteration_number = 1;
+        r_model_part.GetProcessInfo()[NL_ITERATION_NUMBER] = iteration_number;
+        pScheme->InitializeNonLinIteration(r_model_part, rA, rDx, rb);
+        bool is_converged = this->mpConvergenceCriteria->PreCriteria(r_model_part, rDofSet, rA, rDx, rb);
+
+        // the residual of the predicted state, with the tangent if it is not kept from the previous step
+        // the system is resized when the dof set is reformed
+        if (mTangentIsFactorized == false || mRefreshTangentAtEachStep == true || this->mReformDofSetAtEachStep == true)
+        {
+            RefreshTangent(pScheme, r_model_part, rA, rDx, rb);
+        }
+        else
+        {
+            SparseSpaceType::SetToZero(rb);
+            pBuilderAndSolver->BuildRHS(pScheme, r_model_part, rb);
+        }
+
+        while (true)
+        {
+            // the correction d = H b and the line search along it, which leaves in rb the residual of the new state
+            ApplyInverseTangent(rA, rb, d);
+            SparseSpaceType::Copy(rb, b_old);
+            const TDataType step = LineSearch(pScheme, r_model_part, rA, d, rb);
+
+            // the step s = step d
+            SparseSpaceType::Assign(rDx, step, d);
+
+            if (this->MoveMeshFlag() == true) BaseType::MoveMesh();
+
+            pScheme->FinalizeNonLinIteration(r_model_part, rA, rDx, rb);
+
+            if (is_converged == true)
+            {
+                if (iteration_number == 1)
+                    this->mpConvergenceCriteria->InitializeSolutionStep(r_model_part, rDofSet, rA, rDx, rb);
+
+                is_converged = this->mpConvergenceCriteria->PostCriteria(r_model_part, rDofSet, rA, rDx, rb);
+            }
+
+            if (is_converged == true || iteration_number >= this->mMaxIterationNumber)
+                break;
+
+            ++iteration_number;
+            r_model_part.GetProcessInfo()[NL_ITERATION_NUMBER] = iteration_number;
+
+            // the secant pair y = b_old - b, or a fresh tangent if the iterations stall
+            const TDataType norm_b_old = SparseSpaceType::TwoNorm(b_old);
+            const TDataType norm_b = SparseSpaceType::TwoNorm(rb);
+            SparseSpaceType::ScaleAndAdd(1.0, b_old, -1.0, rb, b_old);
+            if (norm_b > mStallFactor * norm_b_old || AddUpdate(rDx, b_old) == false)
+            {
+                if (this->GetEchoLevel() > 1)
+                    std::cout << "ResidualBasedQuasiNewtonStrategy: refresh of the tangent at iteration " << iteration_number
+                              << ", residual ratio " << norm_b / norm_b_old << std::endl;
+                RefreshTangent(pScheme, r_model_part, rA, rDx, rb);
+            }
+
+            pScheme->InitializeNonLinIteration(r_model_part, rA, rDx, rb);
+            is_converged = this->mpConvergenceCriteria->PreCriteria(r_model_part, rDofSet, rA, rDx, rb);
+        }
+
+        if (this->GetEchoLevel() > 0 && r_model_part.GetCommunicator().MyPID() == 0)
+            std::cout << "ResidualBasedQuasiNewtonStrategy: " << iteration_number << " iterations, "
+                      << mNumberOfFactorizations << " factorizations in total" << std::endl;
+
+        if (iteration_number >= this->mMaxIterationNumber && is_converged == false && r_model_part.GetCommunicator().MyPID() == 0)
+            this->MaxIterationsExceeded();
+
+        if (this->mCalculateReactionsFlag == true)
+        {
+            pBuilderAndSolver->CalculateReactions(pScheme, r_model_part, rA, rDx, rb);
+        }
+
+        return is_converged;
+
+        KRATOS_CATCH("")
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    void SetUpdateType(const QuasiNewtonUpdateType UpdateType)
+    {
+        mUpdateType = UpdateType;
+    }
+
+    QuasiNewtonUpdateType GetUpdateType() const
+    {
+        return mUpdateType;
+    }
+
+    /// The number of the secant pairs kept, BFGS drops the oldest one and Broyden restarts from the tangent when it is reached
+    void SetMaxNumberOfUpdates(const unsigned int MaxNumberOfUpdates)
+    {
+        mMaxNumberOfUpdates = MaxNumberOfUpdates;
+    }
+
+    unsigned int GetMaxNumberOfUpdates() const
+    {
+        return mMaxNumberOfUpdates;
+    }
+
+    /// The tangent is refreshed when the norm of the residual is not reduced below StallFactor times the previous one
+    void SetStallFactor(const double StallFactor)
+    {
+        mStallFactor = StallFactor;
+    }
+
+    double GetStallFactor() const
+    {
+        return mStallFactor;
+    }
+
+    /// The maximum number of residual evaluations of the line search after the full step, 0 to take the full steps
+    void SetMaxLineSearchIterations(const unsigned int MaxLineSearchIterations)
+    {
+        mMaxLineSearchIterations = MaxLineSearchIterations;
+    }
+
+    unsigned int GetMaxLineSearchIterations() const
+    {
+        return mMaxLineSearchIterations;
+    }
+
+    void SetRefreshTangentAtEachStep(const bool RefreshTangentAtEachStep)
+    {
+        mRefreshTangentAtEachStep = RefreshTangentAtEachStep;
+    }
+
+    bool GetRefreshTangentAtEachStep() const
+    {
+        return mRefreshTangentAtEachStep;
+    }
+
+    /// The number of times the tangent was built and factorized
+    std::size_t GetNumberOfFactorizations() const
+    {
+        return mNumberOfFactorizations;
+    }
+
+    ///@}
+
+protected:
+    ///@name Member Variables
+    ///@{
+
+    QuasiNewtonUpdateType mUpdateType;
+
+    unsigned int mMaxNumberOfUpdates;
+
+    double mStallFactor;
+
+    unsigned int mMaxLineSearchIterations;
+
+    /// The line search stops when |d'b| is reduced below this factor times its value at the start of the step
+    double mLineSearchTolerance;
+
+    bool mRefreshTangentAtEachStep;
+
+    bool mTangentIsFactorized;
+
+    std::size_t mNumberOfFactorizations;
+
+    /// The steps s of the updates
+    std::deque<TSystemVectorType> mS;
+
+    /// The residual changes y of BFGS, or the vectors u = (s - H y) / (s'H y) of Broyden
+    std::deque<TSystemVectorType> mY;
+
+    /// 1 / s'y of BFGS
+    std::deque<TDataType> mRho;
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Build the tangent and the residual of the current state, factorize the tangent and drop the updates
+    virtual void RefreshTangent(
+        typename TSchemeType::Pointer pScheme,
+        ModelPartType& r_model_part,
+        TSystemMatrixType& rA,
+        TSystemVectorType& rDx,
+        TSystemVectorType& rb)
+    {
+        KRATOS_TRY
+
+        typename TBuilderAndSolverType::Pointer pBuilderAndSolver = this->GetBuilderAndSolver();
+
+        ReleaseTangent();
+
+        SparseSpaceType::SetToZero(rA);
+        SparseSpaceType::SetToZero(rDx);
+        SparseSpaceType::SetToZero(rb);
+
+        pBuilderAndSolver->Build(pScheme, r_model_part, rA, rb);
+        pBuilderAndSolver->ApplyDirichletConditions(pScheme, r_model_part, rA, rDx, rb);
+
+        if (this->mpLinearSolver->AdditionalPhysicalDataIsNeeded())
+            this->mpLinearSolver->ProvideAdditionalData(rA, rDx, rb, pBuilderAndSolver->GetDofSet(), r_model_part);
+
+        if (this->mpLinearSolver->FactorizationIsReusable())
+            this->mpLinearSolver->InitializeSolutionStep(rA, rDx, rb);
+
+        mTangentIsFactorized = true;
+        ++mNumberOfFactorizations;
+
+        KRATOS_CATCH("")
+    }
+
+    /// Release the factorization of the linear solver and drop the updates
+    void ReleaseTangent()
+    {
+        if (mTangentIsFactorized == true && this->mpLinearSolver->FactorizationIsReusable())
+        {
+            this->mpLinearSolver->FinalizeSolutionStep(*(this->mpA), *(this->mpDx), *(this->mpb));
+        }
+        mTangentIsFactorized = false;
+
+        mS.clear();
+        mY.clear();
+        mRho.clear();
+    }
+
+    /// x = A0^-1 b with the factorized tangent A0
+    void SolveTangent(TSystemMatrixType& rA, TSystemVectorType& rb, TSystemVectorType& rx)
+    {
+        SparseSpaceType::SetToZero(rx);
+        if (SparseSpaceType::TwoNorm(rb) == 0.0)
+            return;
+
+        if (this->mpLinearSolver->FactorizationIsReusable())
+            this->mpLinearSolver->PerformSolutionStep(rA, rx, rb);
+        else
+            this->mpLinearSolver->Solve(rA, rx, rb);
+    }
+
+    /// x = H b, with H the updated inverse of the tangent
+    void ApplyInverseTangent(TSystemMatrixType& rA, const TSystemVectorType& rb, TSystemVectorType& rx)
+    {
+        const std::size_t number_of_updates = mS.size();
+
+        if (mUpdateType == QuasiNewtonUpdateType::BFGS)
+        {
+            // two loop recursion
+            TSystemVectorType q(rb);
+            std::vector<TDataType> alpha(number_of_updates);
+            for (std::size_t i = number_of_updates; i-- > 0;)
+            {
+                alpha[i] = mRho[i] * SparseSpaceType::Dot(mS[i], q);
+                SparseSpaceType::UnaliasedAdd(q, -alpha[i], mY[i]);
+            }
+
+            SolveTangent(rA, q, rx);
+
+            for (std::size_t i = 0; i < number_of_updates; ++i)
+            {
+                const TDataType beta = mRho[i] * SparseSpaceType::Dot(mY[i], rx);
+                SparseSpaceType::UnaliasedAdd(rx, alpha[i] - beta, mS[i]);
+            }
+        }
+        else
+        {
+            // H = (I + u_k s_k') ... (I + u_0 s_0') A0^-1
+            TSystemVectorType b(rb);
+            SolveTangent(rA, b, rx);
+
+            for (std::size_t i = 0; i < number_of_updates; ++i)
+                SparseSpaceType::UnaliasedAdd(rx, SparseSpaceType::Dot(mS[i], rx), mY[i]);
+        }
+    }
+
+    /// Store the secant pair s, y. Returns false if the pair cannot be used and the tangent has to be refreshed
+    bool AddUpdate(const TSystemVectorType& rS, const TSystemVectorType& rY)
+    {
+        if (mMaxNumberOfUpdates == 0)
+            return true;
+
+        const TDataType sy = SparseSpaceType::Dot(rS, rY);
+
+        if (mUpdateType == QuasiNewtonUpdateType::BFGS)
+        {
+            // the curvature condition keeps H positive definite
+            if (!(sy > 1.0e-12 * SparseSpaceType::TwoNorm(rS) * SparseSpaceType::TwoNorm(rY)))
+                return false;
+
+            if (mS.size() == mMaxNumberOfUpdates)
+            {
+                mS.pop_front();
+                mY.pop_front();
+                mRho.pop_front();
+            }
+            mS.push_back(rS);
+            mY.push_back(rY);
+            mRho.push_back(1.0 / sy);
+        }
+        else
+        {
+            // restart from the tangent when the memory is full
+            if (mS.size() == mMaxNumberOfUpdates)
+            {
+                mS.clear();
+                mY.clear();
+            }
+
+            // u = (s - H y) / (s'H y)
+            TSystemVectorType u(SparseSpaceType::Size(rS));
+            ApplyInverseTangent(*(this->mpA), rY, u);
+            const TDataType sHy = SparseSpaceType::Dot(rS, u);
+            if (!(std::abs(sHy) > 1.0e-12 * SparseSpaceType::TwoNorm(rS) * SparseSpaceType::TwoNorm(u)))
+                return false;
+
+            SparseSpaceType::ScaleAndAdd(1.0 / sHy, rS, -1.0 / sHy, u);
+            mS.push_back(rS);
+            mY.push_back(u);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Update the solution along rd by the step that reduces the projection G = d'b of the residual onto rd
+     * @details The full step is taken if it reduces |G| below the line search tolerance, otherwise the step is
+     * corrected by the secant (regula falsi once the root is bracketed) of G, limited to [0.1, 4]. rb is the residual
+     * of the accepted step.
+     * @return The step length
+     */
+    TDataType LineSearch(
+        typename TSchemeType::Pointer pScheme,
+        ModelPartType& r_model_part,
+        TSystemMatrixType& rA,
+        TSystemVectorType& rd,
+        TSystemVectorType& rb)
+    {
+        KRATOS_TRY
+
+        typename TBuilderAndSolverType::Pointer pBuilderAndSolver = this->GetBuilderAndSolver();
+        DofsArrayType& rDofSet = pBuilderAndSolver->GetDofSet();
+        TSystemVectorType& rDx = *(this->mpDx);
+
+        const TDataType g_0 = SparseSpaceType::Dot(rd, rb);
+
+        // the full step
+        TDataType step = 1.0;
+        SparseSpaceType::Copy(rd, rDx);
+        pScheme->Update(r_model_part, rDofSet, rA, rDx, rb);
+        SparseSpaceType::SetToZero(rb);
+        pBuilderAndSolver->BuildRHS(pScheme, r_model_part, rb);
+
+        TDataType g = SparseSpaceType::Dot(rd, rb);
+        TDataType previous_step = 0.0, previous_g = g_0;
+        bool is_bracketed = false;
+
+        for (unsigned int k = 0; k < mMaxLineSearchIterations; ++k)
+        {
+            if (std::abs(g) <= mLineSearchTolerance * std::abs(g_0) || g == previous_g)
+                break;
+
+            TDataType new_step = step - g * (step - previous_step) / (g - previous_g);
+            if (!(new_step >= 0.1)) new_step = 0.1;
+            if (new_step > 4.0) new_step = 4.0;
+            if (new_step == step)
+                break;
+
+            // the increment from the current step to the new one
+            SparseSpaceType::Assign(rDx, new_step - step, rd);
+            pScheme->Update(r_model_part, rDofSet, rA, rDx, rb);
+            SparseSpaceType::SetToZero(rb);
+            pBuilderAndSolver->BuildRHS(pScheme, r_model_part, rb);
+            const TDataType new_g = SparseSpaceType::Dot(rd, rb);
+
+            // keep the last two points bracketing the root once it is found (regula falsi)
+            if (is_bracketed == false || (new_g > 0.0) != (g > 0.0))
+            {
+                previous_step = step;
+                previous_g = g;
+            }
+            is_bracketed = is_bracketed || ((new_g > 0.0) != (g > 0.0));
+            step = new_step;
+            g = new_g;
+        }
+
+        if (this->GetEchoLevel() > 1 && step != 1.0)
+            std::cout << "ResidualBasedQuasiNewtonStrategy: line search step " << step << std::endl;
+
+        return step;
+
+        KRATOS_CATCH("")
+    }
+
+    ///@}
+
+private:
+    ///@name Private Operations
+    ///@{
+
+    void InitializeQuasiNewtonParameters()
+    {
+        mUpdateType = QuasiNewtonUpdateType::BFGS;
+        mMaxNumberOfUpdates = 20;
+        mStallFactor = 0.9;
+        mMaxLineSearchIterations = 5;
+        mLineSearchTolerance = 0.5;
+        mRefreshTangentAtEachStep = false;
+        mTangentIsFactorized = false;
+        mNumberOfFactorizations = 0;
+    }
+
+    ///@}
+
+}; // Class ResidualBasedQuasiNewtonStrategy
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_RESIDUALBASED_QUASI_NEWTON_STRATEGY_H_INCLUDED  defined
@@ -40,10 +40,19 @@ namespace Kratos
 
     void Kernel::Initialize()
     {
-        unsigned int j = 0;
-        for(KratosComponents<VariableData>::ComponentsContainerType::iterator i = KratosComponents<VariableData>::GetComponents().begin() ;
+        // the keys follow the alphabetical order of the names, independent of the order of registration
+        typedef KratosComponents<VariableData>::ComponentsContainerType::iterator VariableIteratorType;
+        std::vector<VariableIteratorType> variables;
+        variables.reserve(KratosComponents<VariableData>::Size());
+        for(VariableIteratorType i = KratosComponents<VariableData>::GetComponents().begin() ;
                 i != KratosComponents<VariableData>::GetComponents().end() ; i++)
-            i->second->SetKey(++j);
+            variables.push_back(i);
+        std::sort(variables.begin(), variables.end(),
+            [](VariableIteratorType i, VariableIteratorType j) { return i->first < j->first; });
+
+        unsigned int j = 0;
+        for(std::size_t i = 0; i < variables.size(); i++)
+            variables[i]->second->SetKey(++j);
     }
 
     void Kernel::AddApplication(KratosApplication& NewApplication)
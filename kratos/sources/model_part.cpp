@@ -13,7 +13,8 @@
 //
 
 // System includes
-
+#include <algorithm>
+#include <functional>
 
 // External includes
 
@@ -565,6 +566,49 @@ typename ModelPartImpl<TNodeType>::NodeType::Pointer ModelPartImpl<TNodeType>::C
     return p_new_node;
 }
 
+template<class TNodeType>
+typename ModelPartImpl<TNodeType>::NodesContainerType::ContainerType ModelPartImpl<TNodeType>::CreateNewNodes(const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds,
+        const std::vector<CoordinateType>& rCoordinates, typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
+{
+    KRATOS_ERROR_IF(rCoordinates.size() != 3 * rIds.size()) << "The " << rIds.size() << " nodes need " << 3 * rIds.size()
+        << " coordinates, " << rCoordinates.size() << " are given" << std::endl;
+
+    NodesContainerType& r_nodes = GetMesh(ThisIndex).Nodes();
+
+    if (IsSubModelPart())
+    {
+        ModelPartImpl<TNodeType>* pParentModelPart = dynamic_cast<ModelPartImpl<TNodeType>*>(mpParentModelPart);
+        KRATOS_ERROR_IF(pParentModelPart == nullptr) << "The parent ModelPart is not the same type as the current ModelPart" << std::endl;
+        //the root checks the ids before any model part is changed, the new nodes are then new in this one too
+        typename NodesContainerType::ContainerType new_nodes = pParentModelPart->CreateNewNodes(rIds, rCoordinates, ThisIndex);
+        r_nodes.insert(new_nodes.begin(), new_nodes.end());
+
+        return new_nodes;
+    }
+
+    //ids ascending after the last node are new, they are appended while the new node is still in the cache
+    const bool append = IdsAreAppended(r_nodes, rIds);
+    if (!append)
+        CheckNewIds(r_nodes, rIds, "node");
+
+    //create the new nodes
+    typename NodesContainerType::ContainerType new_nodes(rIds.size());
+    for (IndexType i = 0; i < rIds.size(); ++i)
+    {
+        new_nodes[i] = typename NodeType::Pointer(new NodeType(rIds[i], rCoordinates[3 * i], rCoordinates[3 * i + 1], rCoordinates[3 * i + 2]));
+        new_nodes[i]->SetSolutionStepVariablesList(mpVariablesList);
+        new_nodes[i]->SetBufferSize(mBufferSize);
+        if (append)
+            r_nodes.insert(r_nodes.end(), new_nodes[i]);
+    }
+
+    //otherwise insert them at once, which sorts the new nodes once instead of searching the position of each one
+    if (!append)
+        r_nodes.insert(new_nodes.begin(), new_nodes.end());
+
+    return new_nodes;
+}
+
 template<class TNodeType>
 void ModelPartImpl<TNodeType>::AssignNode(typename ModelPartImpl<TNodeType>::NodeType::Pointer pThisNode,
         typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
@@ -819,6 +863,75 @@ void ModelPartImpl<TNodeType>::RemovePropertiesFromAllLevels(typename ModelPartI
     RemoveProperties(pThisProperties, ThisIndex);
 }
 
+template<class TNodeType>
+template<class TContainerType>
+bool ModelPartImpl<TNodeType>::IdsAreAppended(const TContainerType& rContainer, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds) const
+{
+    if (rIds.empty())
+        return true;
+
+    if (std::adjacent_find(rIds.begin(), rIds.end(), std::greater_equal<IndexType>()) != rIds.end())
+        return false;
+
+    return rContainer.empty() || (rContainer.IsSorted() && rIds.front() > rContainer.back().Id());
+}
+
+template<class TNodeType>
+template<class TContainerType>
+void ModelPartImpl<TNodeType>::CheckNewIds(const TContainerType& rContainer, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds,
+        const std::string& rEntityName) const
+{
+    std::vector<IndexType> sorted_ids(rIds);
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+
+    typename std::vector<IndexType>::const_iterator i_repeated = std::adjacent_find(sorted_ids.begin(), sorted_ids.end());
+    KRATOS_ERROR_IF(i_repeated != sorted_ids.end()) << "The new " << rEntityName << " id " << *i_repeated << " is repeated" << std::endl;
+
+    for (IndexType i = 0; i < sorted_ids.size(); ++i)
+        KRATOS_ERROR_IF(rContainer.find(sorted_ids[i]) != rContainer.end()) << "The new " << rEntityName << " id " << sorted_ids[i]
+            << " already exists in " << Name() << std::endl;
+}
+
+template<class TNodeType>
+template<class TEntityType>
+std::vector<typename TEntityType::Pointer> ModelPartImpl<TNodeType>::CreateEntities(const TEntityType& rPrototype,
+        const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rConnectivities,
+        typename ModelPartImpl<TNodeType>::PropertiesType::Pointer pProperties)
+{
+    std::vector<typename TEntityType::Pointer> new_entities(rIds.size());
+    if (rIds.empty())
+        return new_entities;
+
+    const SizeType number_of_entity_nodes = rConnectivities.size() / rIds.size();
+    KRATOS_ERROR_IF(number_of_entity_nodes * rIds.size() != rConnectivities.size()) << "The " << rConnectivities.size()
+        << " connectivities are not the same number of nodes for each of the " << rIds.size() << " entities" << std::endl;
+    KRATOS_ERROR_IF(rPrototype.pGetGeometry() != nullptr && rPrototype.GetGeometry().size() != 0 && rPrototype.GetGeometry().size() != number_of_entity_nodes)
+        << "The entities are given " << number_of_entity_nodes << " nodes, the geometry of the prototype has " << rPrototype.GetGeometry().size() << std::endl;
+
+    //search each distinct node once, in the order of the nodes container
+    std::vector<IndexType> node_ids(rConnectivities);
+    std::sort(node_ids.begin(), node_ids.end());
+    node_ids.erase(std::unique(node_ids.begin(), node_ids.end()), node_ids.end());
+
+    std::vector<typename NodeType::Pointer> id_nodes(node_ids.size());
+    for (IndexType i = 0; i < node_ids.size(); ++i)
+    {
+        typename NodesContainerType::iterator i_node = Nodes().find(node_ids[i]);
+        KRATOS_ERROR_IF(i_node == Nodes().end()) << "Node index not found: " << node_ids[i] << std::endl;
+        id_nodes[i] = *(i_node.base());
+    }
+
+    for (IndexType e = 0; e < rIds.size(); ++e)
+    {
+        typename GeometryType::PointsArrayType entity_nodes;
+        for (IndexType i = e * number_of_entity_nodes; i < (e + 1) * number_of_entity_nodes; ++i)
+            entity_nodes.push_back(id_nodes[std::lower_bound(node_ids.begin(), node_ids.end(), rConnectivities[i]) - node_ids.begin()]);
+        new_entities[e] = rPrototype.Create(rIds[e], entity_nodes, pProperties);
+    }
+
+    return new_entities;
+}
+
 template<class TNodeType>
 void ModelPartImpl<TNodeType>::AddElement(typename ModelPartImpl<TNodeType>::ElementType::Pointer pNewElement,
         typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
@@ -882,6 +995,37 @@ typename ModelPartImpl<TNodeType>::ElementType::Pointer ModelPartImpl<TNodeType>
     return p_element;
 }
 
+template<class TNodeType>
+typename ModelPartImpl<TNodeType>::ElementsContainerType::ContainerType ModelPartImpl<TNodeType>::CreateNewElements(const std::string& rElementName,
+        const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rConnectivities,
+        typename ModelPartImpl<TNodeType>::PropertiesType::Pointer pProperties, typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
+{
+    ElementsContainerType& r_elements = GetMesh(ThisIndex).Elements();
+
+    if (IsSubModelPart())
+    {
+        ModelPartImpl<TNodeType>* pParentModelPart = dynamic_cast<ModelPartImpl<TNodeType>*>(mpParentModelPart);
+        KRATOS_ERROR_IF(pParentModelPart == nullptr) << "The parent ModelPart is not the same type as the current ModelPart" << std::endl;
+        //the root checks the ids before any model part is changed
+        typename ElementsContainerType::ContainerType new_elements = pParentModelPart->CreateNewElements(rElementName, rIds, rConnectivities, pProperties, ThisIndex);
+        r_elements.insert(new_elements.begin(), new_elements.end());
+
+        return new_elements;
+    }
+
+    if (!IdsAreAppended(r_elements, rIds))
+        CheckNewIds(r_elements, rIds, "element");
+
+    //create the new elements from the element resolved once
+    const ElementType& r_clone_element = KratosComponents<ElementType>::Get(rElementName);
+    typename ElementsContainerType::ContainerType new_elements = CreateEntities(r_clone_element, rIds, rConnectivities, pProperties);
+
+    //insert them at once
+    r_elements.insert(new_elements.begin(), new_elements.end());
+
+    return new_elements;
+}
+
 template<class TNodeType>
 void ModelPartImpl<TNodeType>::RemoveElement(typename ModelPartImpl<TNodeType>::IndexType ElementId,
         typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
@@ -1323,6 +1467,37 @@ void ModelPartImpl<TNodeType>::AddCondition(typename ModelPartImpl<TNodeType>::C
     GetMesh(ThisIndex).AddCondition(pNewCondition);
 }
 
+template<class TNodeType>
+typename ModelPartImpl<TNodeType>::ConditionsContainerType::ContainerType ModelPartImpl<TNodeType>::CreateNewConditions(const std::string& rConditionName,
+        const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rIds, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& rConnectivities,
+        typename ModelPartImpl<TNodeType>::PropertiesType::Pointer pProperties, typename ModelPartImpl<TNodeType>::IndexType ThisIndex)
+{
+    ConditionsContainerType& r_conditions = GetMesh(ThisIndex).Conditions();
+
+    if (IsSubModelPart())
+    {
+        ModelPartImpl<TNodeType>* pParentModelPart = dynamic_cast<ModelPartImpl<TNodeType>*>(mpParentModelPart);
+        KRATOS_ERROR_IF(pParentModelPart == nullptr) << "The parent ModelPart is not the same type as the current ModelPart" << std::endl;
+        //the root checks the ids before any model part is changed
+        typename ConditionsContainerType::ContainerType new_conditions = pParentModelPart->CreateNewConditions(rConditionName, rIds, rConnectivities, pProperties, ThisIndex);
+        r_conditions.insert(new_conditions.begin(), new_conditions.end());
+
+        return new_conditions;
+    }
+
+    if (!IdsAreAppended(r_conditions, rIds))
+        CheckNewIds(r_conditions, rIds, "condition");
+
+    //create the new conditions from the condition resolved once
+    const ConditionType& r_clone_condition = KratosComponents<ConditionType>::Get(rConditionName);
+    typename ConditionsContainerType::ContainerType new_conditions = CreateEntities(r_clone_condition, rIds, rConnectivities, pProperties);
+
+    //insert them at once
+    r_conditions.insert(new_conditions.begin(), new_conditions.end());
+
+    return new_conditions;
+}
+
 template<class TNodeType>
 typename ModelPartImpl<TNodeType>::ConditionType::Pointer ModelPartImpl<TNodeType>::CreateNewCondition(std::string ConditionName,
     typename ModelPartImpl<TNodeType>::IndexType Id, const std::vector<typename ModelPartImpl<TNodeType>::IndexType>& ConditionNodeIds,
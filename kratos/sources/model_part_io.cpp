@@ -23,7 +23,11 @@ namespace Kratos
         , mBaseFilename(Filename)
         , mFilename(Filename + ".mdpa")
         , mOptions(Options)
+        , mFileBuffer(1 << 20)
     {
+        // the input is read character by character, through a buffer large enough to make it a few big reads
+        mFile.rdbuf()->pubsetbuf(mFileBuffer.data(), mFileBuffer.size());
+
         if (mOptions.Is(BaseType::READ))
         {
             mFile.open(mFilename.c_str(), std::fstream::in);
@@ -550,11 +554,17 @@ namespace Kratos
         std::string word;
         OutputFilesContainerType output_files;
 
+        // each partition is written through its own large buffer, up to 256 MB in total
+        const SizeType buffer_size = std::max<SizeType>(1 << 16, std::min<SizeType>(1 << 22, (1 << 28) / std::max<SizeType>(NumberOfPartitions, 1)));
+        std::vector<std::vector<char> > output_buffers(NumberOfPartitions, std::vector<char>(buffer_size));
+
         for(SizeType i = 0 ; i < NumberOfPartitions ; i++)
         {
             std::stringstream buffer;
             buffer << mBaseFilename << "_" << i << ".mdpa";
-            std::ofstream* p_ofstream = new std::ofstream(buffer.str().c_str());
+            std::ofstream* p_ofstream = new std::ofstream();
+            p_ofstream->rdbuf()->pubsetbuf(output_buffers[i].data(), buffer_size);
+            p_ofstream->open(buffer.str().c_str());
             if(!(*p_ofstream))
                 KRATOS_ERROR << "Error opening output file " << buffer.str();
 
@@ -1271,15 +1281,24 @@ namespace Kratos
 
         ReadWord(variable_name);
 
-        VariablesList r_modelpart_nodal_variables_list = rThisModelPart.GetNodalSolutionStepVariablesList();
+        const typename ModelPartType::VariablesListType& r_modelpart_nodal_variables_list = rThisModelPart.GetNodalSolutionStepVariablesList();
+
+        // each table is searched once, the variable found is used for the check and the reading
+        const Flags* p_flag;
+        const Variable<int>* p_int_variable;
+        const Variable<DataType>* p_variable;
+        const array_1d_component_type* p_component;
+        const Variable<array_1d<DataType, 3> >* p_array_1d_variable;
+        const Variable<Matrix>* p_matrix_variable;
+        const Variable<Vector>* p_vector_variable;
 
-        if(KratosComponents<Flags >::Has(variable_name))
+        if((p_flag = KratosComponents<Flags >::pFind(variable_name)) != nullptr)
         {
-            ReadNodalFlags(rThisNodes, static_cast<Flags const& >(KratosComponents<Flags >::Get(variable_name)));
+            ReadNodalFlags(rThisNodes, *p_flag);
         }
-        else if(KratosComponents<Variable<int> >::Has(variable_name))
+        else if((p_int_variable = KratosComponents<Variable<int> >::pFind(variable_name)) != nullptr)
         {
-            bool has_been_added = r_modelpart_nodal_variables_list.Has(KratosComponents<Variable<int> >::Get(variable_name)) ;
+            bool has_been_added = r_modelpart_nodal_variables_list.Has(*p_int_variable) ;
             if( !has_been_added && mOptions.Is(BaseType::IGNORE_VARIABLES_ERROR) ) {
                 std::cout<<std::endl<<"WARNING: Skipping NodalData block. Variable "<<variable_name<<" has not been added to ModelPartType '"<<rThisModelPart.Name()<<"'"<<std::endl<<std::endl;
                 SkipBlock("NodalData");
@@ -1290,12 +1309,12 @@ namespace Kratos
             }
             else
             {
-                ReadNodalScalarVariableData(rThisNodes, static_cast<Variable<int> const& >(KratosComponents<Variable<int> >::Get(variable_name)));
+                ReadNodalScalarVariableData(rThisNodes, *p_int_variable);
             }
         }
-        else if(KratosComponents<Variable<DataType> >::Has(variable_name))
+        else if((p_variable = KratosComponents<Variable<DataType> >::pFind(variable_name)) != nullptr)
         {
-            bool has_been_added = r_modelpart_nodal_variables_list.Has(KratosComponents<Variable<DataType> >::Get(variable_name)) ;
+            bool has_been_added = r_modelpart_nodal_variables_list.Has(*p_variable) ;
             if( !has_been_added && mOptions.Is(BaseType::IGNORE_VARIABLES_ERROR) ) {
                 std::cout<<std::endl<<"WARNING: Skipping NodalData block. Variable "<<variable_name<<" has not been added to ModelPartType '"<<rThisModelPart.Name()<<"'"<<std::endl<<std::endl;
                 SkipBlock("NodalData");
@@ -1306,18 +1325,19 @@ namespace Kratos
             }
             else
             {
-                ReadNodalDofVariableData(rThisNodes, static_cast<Variable<DataType> const& >(KratosComponents<Variable<DataType> >::Get(variable_name)));
+                ReadNodalDofVariableData(rThisNodes, *p_variable);
             }
         }
-        else if(KratosComponents<array_1d_component_type>::Has(variable_name))
+        else if((p_component = KratosComponents<array_1d_component_type>::pFind(variable_name)) != nullptr)
         {
-            ReadNodalDofVariableData(rThisNodes, static_cast<array_1d_component_type const& >(KratosComponents<array_1d_component_type>::Get(variable_name)));
+            ReadNodalDofVariableData(rThisNodes, *p_component);
         }
-        else if(KratosComponents<Variable<array_1d<DataType, 3> > >::Has(variable_name))
+        else if((p_array_1d_variable = KratosComponents<Variable<array_1d<DataType, 3> > >::pFind(variable_name)) != nullptr)
         {
-            bool has_been_added = r_modelpart_nodal_variables_list.Has(KratosComponents<Variable<array_1d<DataType, 3> > >::Get(variable_name)) ;
+            bool has_been_added = r_modelpart_nodal_variables_list.Has(*p_array_1d_variable) ;
             if( !has_been_added && mOptions.Is(BaseType::IGNORE_VARIABLES_ERROR) ) {
                 std::cout<<std::endl<<"WARNING: Skipping NodalData block. Variable "<<variable_name<<" has not been added to ModelPartType '"<<rThisModelPart.Name()<<"'"<<std::endl<<std::endl;
+                SkipBlock("NodalData");
             }
             else if (!has_been_added)
             {
@@ -1325,16 +1345,16 @@ namespace Kratos
             }
             else
             {
-                ReadNodalVectorialVariableData(rThisNodes, static_cast<Variable<array_1d<DataType, 3> > const& >(KratosComponents<Variable<array_1d<DataType, 3> > >::Get(variable_name)), Vector(3));
+                ReadNodalVectorialVariableData(rThisNodes, *p_array_1d_variable, Vector(3));
             }
         }
-        else if(KratosComponents<Variable<Matrix> >::Has(variable_name))
+        else if((p_matrix_variable = KratosComponents<Variable<Matrix> >::pFind(variable_name)) != nullptr)
         {
-            ReadNodalVectorialVariableData(rThisNodes, static_cast<Variable<Matrix > const& >(KratosComponents<Variable<Matrix> >::Get(variable_name)), Matrix(3,3));
+            ReadNodalVectorialVariableData(rThisNodes, *p_matrix_variable, Matrix(3,3));
         }
-        else if(KratosComponents<Variable<Vector> >::Has(variable_name))
+        else if((p_vector_variable = KratosComponents<Variable<Vector> >::pFind(variable_name)) != nullptr)
         {
-            ReadNodalVectorialVariableData(rThisNodes, static_cast<Variable<Vector > const& >(KratosComponents<Variable<Vector> >::Get(variable_name)), Vector(3));
+            ReadNodalVectorialVariableData(rThisNodes, *p_vector_variable, Vector(3));
         }
         else if(KratosComponents<VariableData>::Has(variable_name))
         {
@@ -2679,6 +2699,7 @@ namespace Kratos
         WriteInAllFiles(OutputFiles, "Begin Nodes \n");
 
         SizeType id;
+        std::string node_data;
 
         while(!mFile.eof())
         {
@@ -2694,14 +2715,13 @@ namespace Kratos
                              << " [Line " << mNumberOfLines << " ]";
             }
 
-            std::stringstream node_data;
-            node_data << ReorderedNodeId(id) << '\t'; // id
+            node_data = std::to_string(ReorderedNodeId(id)) + '\t'; // id
             ReadWord(word);
-            node_data << word << '\t'; // x
+            node_data.append(word) += '\t'; // x
             ReadWord(word);
-            node_data << word << '\t'; // y
+            node_data.append(word) += '\t'; // y
             ReadWord(word);
-            node_data << word << '\n'; // z
+            node_data.append(word) += '\n'; // z
 
             for(SizeType i = 0 ; i < NodesAllPartitions[ReorderedNodeId(id)-1].size() ; i++)
             {
@@ -2712,7 +2732,7 @@ namespace Kratos
                                  << " for node " << id << " [Line " << mNumberOfLines << " ]";
                 }
 
-                *(OutputFiles[partition_id]) << node_data.str();
+                OutputFiles[partition_id]->write(node_data.data(), node_data.size());
             }
 
         }
@@ -2750,6 +2770,7 @@ namespace Kratos
         WriteInAllFiles(OutputFiles, "Begin Elements " +  element_name);
 
         SizeType id;
+        std::string element_data;
 
         while(!mFile.eof())
         {
@@ -2764,17 +2785,16 @@ namespace Kratos
                              << " [Line " << mNumberOfLines << " ]";
             }
 
-            std::stringstream element_data;
-            element_data << '\n' << ReorderedElementId(id) << '\t'; // id
+            element_data = '\n' + std::to_string(ReorderedElementId(id)) + '\t'; // id
             ReadWord(word); // Reading the properties id;
-            element_data << word << '\t'; // properties id
+            element_data.append(word) += '\t'; // properties id
 
             for(SizeType i = 0 ; i < number_of_nodes ; i++)
             {
                 ReadWord(word); // Reading the node id;
                 SizeType node_id;
                 ExtractValue(word, node_id);
-                element_data << ReorderedNodeId(node_id) << '\t'; // node id
+                element_data.append(std::to_string(ReorderedNodeId(node_id))) += '\t'; // node id
             }
 
 
@@ -2787,7 +2807,7 @@ namespace Kratos
                                  << " for node " << id << " [Line " << mNumberOfLines << " ]";
                 }
 
-                *(OutputFiles[partition_id]) << element_data.str();
+                OutputFiles[partition_id]->write(element_data.data(), element_data.size());
             }
 
         }
@@ -2824,6 +2844,7 @@ namespace Kratos
         WriteInAllFiles(OutputFiles, "Begin Conditions " +  condition_name);
 
         SizeType id;
+        std::string condition_data;
 
         while(!mFile.eof())
         {
@@ -2838,17 +2859,16 @@ namespace Kratos
                              << " [Line " << mNumberOfLines << " ]";
             }
 
-            std::stringstream condition_data;
-            condition_data << '\n' << ReorderedConditionId(id) << '\t'; // id
+            condition_data = '\n' + std::to_string(ReorderedConditionId(id)) + '\t'; // id
             ReadWord(word); // Reading the properties id;
-            condition_data << word << '\t'; // properties id
+            condition_data.append(word) += '\t'; // properties id
 
             for(SizeType i = 0 ; i < number_of_nodes ; i++)
             {
                 ReadWord(word); // Reading the node id;
                 SizeType node_id;
                 ExtractValue(word, node_id);
-                condition_data << ReorderedNodeId(node_id) << '\t'; // node id
+                condition_data.append(std::to_string(ReorderedNodeId(node_id))) += '\t'; // node id
             }
 
 
@@ -2861,7 +2881,7 @@ namespace Kratos
                                  << " for node " << id << " [Line " << mNumberOfLines << " ]";
                 }
 
-                *(OutputFiles[partition_id]) << condition_data.str();
+                OutputFiles[partition_id]->write(condition_data.data(), condition_data.size());
             }
 
         }
@@ -2943,6 +2963,7 @@ namespace Kratos
         SizeType id;
 
         std::string word;
+        std::string node_data;
 
         while(!mFile.eof())
         {
@@ -2958,12 +2979,11 @@ namespace Kratos
                              << " [Line " << mNumberOfLines << " ]";
             }
 
-            std::stringstream node_data;
-            node_data << ReorderedNodeId(id) << '\t'; // id
+            node_data = std::to_string(ReorderedNodeId(id)) + '\t'; // id
             ReadWord(word);
-            node_data << word << '\t'; // is fixed
+            node_data.append(word) += '\t'; // is fixed
             ReadWord(word);
-            node_data << word << '\n'; // value
+            node_data.append(word) += '\n'; // value
 
             for(SizeType i = 0 ; i < NodesAllPartitions[ReorderedNodeId(id)-1].size() ; i++)
             {
@@ -2974,7 +2994,7 @@ namespace Kratos
                                  << " for node " << id << " [Line " << mNumberOfLines << " ]";
                 }
 
-                *(OutputFiles[partition_id]) << node_data.str();
+                OutputFiles[partition_id]->write(node_data.data(), node_data.size());
             }
         }
 
@@ -3202,10 +3222,9 @@ namespace Kratos
                              << " [Line " << mNumberOfLines << " ]";
             }
 
-            std::stringstream entity_data;
-            entity_data << index << '\t'; // id
+            std::string entity_data = std::to_string(index) + '\t'; // id
             ReadWord(word);
-            entity_data << word <<'\n'; // value
+            entity_data.append(word) += '\n'; // value
 
             for(SizeType i = 0 ; i < EntitiesPartitions[index-1].size() ; i++)
             {
@@ -3216,7 +3235,7 @@ namespace Kratos
                                  << " for entity " << id << " [Line " << mNumberOfLines << " ]";
                 }
 
-                *(OutputFiles[partition_id]) << entity_data.str();
+                OutputFiles[partition_id]->write(entity_data.data(), entity_data.size());
             }
         }
 
@@ -3763,26 +3782,31 @@ namespace Kratos
     template<class TModelPartType>
     char ModelPartIO<TModelPartType>::GetCharacter() //Getting the next character skipping comments
     {
+        // the characters are taken directly from the buffer of the file, without the sentry of the stream
+        // functions; the stream state is set as get() would do at the end of the file
+        typedef std::fstream::traits_type traits_type;
+        std::streambuf* p_buffer = mFile.rdbuf();
+
         char c;
-        if(mFile.get(c))
+        if(GetBufferCharacter(p_buffer, c))
         {
             if(c == '\n')
                 mNumberOfLines++;
             else if(c == '/') // it may be a comment!
             {
-                char next_c = mFile.peek();
-                if(next_c == '/') // it's a line comment
+                const traits_type::int_type next_c = p_buffer->sgetc();
+                if(next_c == traits_type::to_int_type('/')) // it's a line comment
                 {
-                    while((mFile.get(c)) && (c != '\n')); // so going to the end of line
+                    while(GetBufferCharacter(p_buffer, c) && (c != '\n')); // so going to the end of line
                     if(!mFile.eof())
                         mNumberOfLines++;
                 }
-                else if(next_c == '*') // it's a block comment
+                else if(next_c == traits_type::to_int_type('*')) // it's a block comment
                 {
-                    while((mFile.get(c)) && !((c == '*') && (mFile.peek() == '/'))) // so going to the end of block
+                    while(GetBufferCharacter(p_buffer, c) && !((c == '*') && (p_buffer->sgetc() == traits_type::to_int_type('/')))) // so going to the end of block
                         if(c == '\n')
                             mNumberOfLines++;
-                    mFile.get(c);
+                    GetBufferCharacter(p_buffer, c);
                     c = GetCharacter(); // read a new character after comment
                 }
             }
@@ -3793,6 +3817,28 @@ namespace Kratos
         return c;
     }
 
+    template<class TModelPartType>
+    bool ModelPartIO<TModelPartType>::GetBufferCharacter(std::streambuf* pBuffer, char& rC)
+    {
+        typedef std::fstream::traits_type traits_type;
+
+        if(!mFile.good())
+        {
+            mFile.setstate(std::ios_base::failbit);
+            return false;
+        }
+
+        const traits_type::int_type c = pBuffer->sbumpc();
+        if(traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            mFile.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            return false;
+        }
+
+        rC = traits_type::to_char_type(c);
+        return true;
+    }
+
     template<class TModelPartType>
     bool ModelPartIO<TModelPartType>::CheckStatement(std::string const& rStatement, std::string const& rGivenWord) const
     {
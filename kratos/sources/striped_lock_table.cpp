@@ -0,0 +1,21 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                   Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+
+#include "includes/striped_lock_table.h"
+
+
+namespace Kratos
+{
+
+StripedLockTable::PaddedLockObject StripedLockTable::msLocks[StripedLockTable::NumberOfStripes];
+
+}
@@ -218,6 +218,12 @@ public:
 //    axpy_prod(rA, rX, rY, true);
     }// rY = rA * rX
 
+    /// rY = rA * rX, where the columns of rX and rY are the vectors
+    static void Mult(const MatrixType& rA, const matrix<DataType>& rX, matrix<DataType>& rY)
+    {
+        UblasSpace<TDataType, TMatrixType, TVectorType>::Mult(rA, rX, rY);
+    }
+
     static void TransposeMult(MatrixType& rA, VectorType& rX, VectorType& rY)
     {
 // :TODO: Parallelize
@@ -351,6 +351,71 @@ public:
 #endif
     }
 
+    /// rY = rA * rX, where the columns of rX and rY are the vectors. The sparse matrix is streamed only once for all the vectors.
+    static void Mult(const compressed_matrix<DataType>& rA, const matrix<DataType>& rX, matrix<DataType>& rY)
+    {
+        const std::size_t number_of_vectors = rX.size2();
+        if (rY.size1() != rA.size1() || rY.size2() != number_of_vectors)
+            rY.resize(rA.size1(), number_of_vectors, false);
+
+        const int number_of_initialized_rows = static_cast<int>(rA.filled1()) - 1;
+        if (number_of_vectors == 0 || number_of_initialized_rows <= 0)
+        {
+            rY.clear();
+            return;
+        }
+
+        const auto* index1 = &rA.index1_data()[0];
+        const auto* index2 = &rA.index2_data()[0];
+        const DataType* values = &rA.value_data()[0];
+        const DataType* x_data = &rX.data()[0];
+        DataType* y_data = &rY.data()[0];
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(rA.size1()); ++i)
+        {
+            DataType* y = y_data + i * number_of_vectors;
+
+            if (i >= number_of_initialized_rows)
+            {
+                for (std::size_t k = 0; k < number_of_vectors; ++k)
+                    y[k] = DataType();
+                continue;
+            }
+
+            const std::size_t row_begin = index1[i];
+            const std::size_t row_end = index1[i + 1];
+
+            // the sums are kept in registers, four vectors at a time
+            std::size_t k0 = 0;
+            for (; k0 + 4 <= number_of_vectors; k0 += 4)
+            {
+                DataType s0 = DataType(), s1 = DataType(), s2 = DataType(), s3 = DataType();
+                for (std::size_t jj = row_begin; jj < row_end; ++jj)
+                {
+                    const DataType a = values[jj];
+                    const DataType* x = x_data + index2[jj] * number_of_vectors + k0;
+                    s0 += a * x[0];
+                    s1 += a * x[1];
+                    s2 += a * x[2];
+                    s3 += a * x[3];
+                }
+                y[k0] = s0;
+                y[k0 + 1] = s1;
+                y[k0 + 2] = s2;
+                y[k0 + 3] = s3;
+            }
+
+            for (; k0 < number_of_vectors; ++k0)
+            {
+                DataType s = DataType();
+                for (std::size_t jj = row_begin; jj < row_end; ++jj)
+                    s += values[jj] * x_data[index2[jj] * number_of_vectors + k0];
+                y[k0] = s;
+            }
+        }
+    }
+
     template< class TOtherMatrixType >
     static void TransposeMult(const TOtherMatrixType& rA, const VectorType& rX, VectorType& rY)
     {
@@ -0,0 +1,595 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_BINS_BATCH_SEARCH_H_INCLUDED )
+#define  KRATOS_BINS_BATCH_SEARCH_H_INCLUDED
+
+// System includes
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cfloat>
+#include <type_traits>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class BinsBatchSearchResults
+ * @ingroup KratosCore
+ * @brief The results of a batch of queries, stored in CSR format
+ * @details The results of the query i are Results[Offsets[i]] ... Results[Offsets[i+1]-1], with the
+ * corresponding distances, as given by the distance function of the bins (i.e. squared by default).
+ * The vectors keep their capacity, hence reusing the same object for successive batches does not
+ * allocate once the pool is large enough.
+ */
+template<class TPointerType, class TCoordinateType>
+class BinsBatchSearchResults
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef std::size_t SizeType;
+
+    typedef std::size_t IndexType;
+
+    typedef typename std::vector<TPointerType>::const_iterator ResultsConstIteratorType;
+
+    typedef typename std::vector<TCoordinateType>::const_iterator DistancesConstIteratorType;
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    void Clear()
+    {
+        mOffsets.clear();
+        mResults.clear();
+        mDistances.clear();
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    SizeType NumberOfQueries() const
+    {
+        return mOffsets.empty() ? 0 : mOffsets.size() - 1;
+    }
+
+    /// The total number of results of the batch
+    SizeType NumberOfResults() const
+    {
+        return mOffsets.empty() ? 0 : mOffsets.back();
+    }
+
+    SizeType NumberOfResults(const IndexType Query) const
+    {
+        return mOffsets[Query + 1] - mOffsets[Query];
+    }
+
+    ResultsConstIteratorType ResultsBegin(const IndexType Query) const
+    {
+        return mResults.begin() + mOffsets[Query];
+    }
+
+    ResultsConstIteratorType ResultsEnd(const IndexType Query) const
+    {
+        return mResults.begin() + mOffsets[Query + 1];
+    }
+
+    DistancesConstIteratorType DistancesBegin(const IndexType Query) const
+    {
+        return mDistances.begin() + mOffsets[Query];
+    }
+
+    DistancesConstIteratorType DistancesEnd(const IndexType Query) const
+    {
+        return mDistances.begin() + mOffsets[Query + 1];
+    }
+
+    std::vector<SizeType>& GetOffsets()
+    {
+        return mOffsets;
+    }
+
+    const std::vector<SizeType>& GetOffsets() const
+    {
+        return mOffsets;
+    }
+
+    std::vector<TPointerType>& GetResults()
+    {
+        return mResults;
+    }
+
+    const std::vector<TPointerType>& GetResults() const
+    {
+        return mResults;
+    }
+
+    std::vector<TCoordinateType>& GetDistances()
+    {
+        return mDistances;
+    }
+
+    const std::vector<TCoordinateType>& GetDistances() const
+    {
+        return mDistances;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    std::vector<SizeType> mOffsets;
+
+    std::vector<TPointerType> mResults;
+
+    std::vector<TCoordinateType> mDistances;
+
+    ///@}
+
+}; // Class BinsBatchSearchResults
+
+/**
+ * @class BinsBatchSearch
+ * @ingroup KratosCore
+ * @brief Parallel batches of radius, nearest and k-nearest point queries over Bins or BinsDynamic
+ * @details The queries are processed in the order of the cells containing them, so that consecutive
+ * queries visit the same cells, and are distributed statically over the threads. A first pass searches
+ * each query into the pool of its thread and counts its results. The offsets of the queries are then
+ * computed, and a second pass fills the results in the CSR arrays of BinsBatchSearchResults, in the
+ * order of the queries. The pools of the threads are kept between the batches.
+ * The bins must not be empty, their container must be a std::vector of pointers and their distances a
+ * std::vector, which are the defaults. An instance is not thread safe, the parallelism is inside each batch.
+ */
+template<class TBinsType>
+class BinsBatchSearch
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of BinsBatchSearch
+    KRATOS_CLASS_POINTER_DEFINITION(BinsBatchSearch);
+
+    typedef TBinsType BinsType;
+
+    typedef typename BinsType::PointType PointType;
+
+    typedef typename BinsType::PointerType PointerType;
+
+    typedef typename BinsType::IteratorType IteratorType;
+
+    typedef typename BinsType::DistanceIteratorType DistanceIteratorType;
+
+    typedef typename BinsType::CoordinateType CoordinateType;
+
+    typedef typename BinsType::SizeType SizeType;
+
+    typedef typename BinsType::IndexType IndexType;
+
+    typedef typename BinsType::SearchStructureType SearchStructureType;
+
+    typedef std::vector<PointerType> PointerVectorType;
+
+    typedef std::vector<CoordinateType> CoordinateVectorType;
+
+    typedef BinsBatchSearchResults<PointerType, CoordinateType> ResultsType;
+
+    static constexpr std::size_t Dimension = BinsType::Dimension;
+
+    static_assert(std::is_same<IteratorType, typename PointerVectorType::iterator>::value,
+        "BinsBatchSearch requires the bins to store the points in a std::vector of pointers");
+
+    static_assert(std::is_same<DistanceIteratorType, typename CoordinateVectorType::iterator>::value,
+        "BinsBatchSearch requires the bins to return the distances in a std::vector");
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor. The bins must outlive the search. If SortQueries is false, the queries are processed in the given order
+    BinsBatchSearch(BinsType& rBins, const bool SortQueries = true)
+    : mrBins(rBins), mSortQueries(SortQueries)
+    {
+        const PointType min_point = mrBins.GetMinPoint();
+        const PointType max_point = mrBins.GetMaxPoint();
+        mMaxCellSize = 0.0;
+        for (std::size_t i = 0; i < Dimension; ++i)
+        {
+            mMinPoint[i] = min_point[i];
+            mMaxPoint[i] = max_point[i];
+            mNumberOfCells[i] = mrBins.NumCell(i);
+            mInvCellSize[i] = 1.0 / mrBins.CellSize(i);
+            mMaxCellSize = std::max(mMaxCellSize, mrBins.CellSize(i));
+        }
+    }
+
+    virtual ~BinsBatchSearch() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Search the points within Radius of each query, at most MaxNumberOfResults per query
+    template<class TQueryIteratorType>
+    void SearchInRadius(TQueryIteratorType QueriesBegin, TQueryIteratorType QueriesEnd, const CoordinateType Radius,
+        const SizeType MaxNumberOfResults, ResultsType& rResults)
+    {
+        Execute(QueriesBegin, QueriesEnd, RadiusSearch<ConstantRadius>(mrBins, ConstantRadius(Radius), MaxNumberOfResults), rResults);
+    }
+
+    /// Search the points within rRadii[i] of the query i, at most MaxNumberOfResults per query
+    template<class TQueryIteratorType>
+    void SearchInRadius(TQueryIteratorType QueriesBegin, TQueryIteratorType QueriesEnd, const CoordinateVectorType& rRadii,
+        const SizeType MaxNumberOfResults, ResultsType& rResults)
+    {
+        KRATOS_ERROR_IF(rRadii.size() != static_cast<SizeType>(std::distance(QueriesBegin, QueriesEnd)))
+            << "The number of radii " << rRadii.size() << " is not the number of queries " << std::distance(QueriesBegin, QueriesEnd);
+        Execute(QueriesBegin, QueriesEnd, RadiusSearch<VariableRadius>(mrBins, VariableRadius(rRadii), MaxNumberOfResults), rResults);
+    }
+
+    /// Search the nearest point of each query, as SearchNearestPoint of the bins
+    template<class TQueryIteratorType>
+    void SearchNearestPoint(TQueryIteratorType QueriesBegin, TQueryIteratorType QueriesEnd, ResultsType& rResults)
+    {
+        Execute(QueriesBegin, QueriesEnd, NearestSearch(mrBins), rResults);
+    }
+
+    /// Search the K nearest points of each query, sorted by increasing distance
+    template<class TQueryIteratorType>
+    void SearchNearestPoints(TQueryIteratorType QueriesBegin, TQueryIteratorType QueriesEnd, const SizeType K, ResultsType& rResults)
+    {
+        // the bins hold about one point per cell, the radius starts at the size of the K nearest cells
+        const CoordinateType initial_radius = 0.5 * mMaxCellSize * std::pow(static_cast<CoordinateType>(std::max<SizeType>(K, 1)), 1.0 / Dimension);
+
+        Execute(QueriesBegin, QueriesEnd, KNearestSearch(mrBins, K, initial_radius, *this), rResults);
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        return "BinsBatchSearch";
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+    ///@}
+
+private:
+    ///@name Private Classes
+    ///@{
+
+    /// The pool of a thread, filled by the first pass
+    struct ThreadPool
+    {
+        PointerVectorType Results;
+        CoordinateVectorType Distances;
+        std::vector<std::pair<CoordinateType, PointerType> > Sorting;
+        SearchStructureType Box;
+        SizeType Size;
+
+        /// Make room for Count more results
+        void Reserve(const SizeType Count)
+        {
+            if (Results.size() < Size + Count)
+            {
+                const SizeType new_size = std::max(2 * Results.size(), Size + Count);
+                Results.resize(new_size);
+                Distances.resize(new_size);
+            }
+        }
+    };
+
+    struct ConstantRadius
+    {
+        ConstantRadius(const CoordinateType Radius) : mRadius(Radius) {}
+        CoordinateType operator()(const SizeType Query) const { return mRadius; }
+        CoordinateType mRadius;
+    };
+
+    struct VariableRadius
+    {
+        VariableRadius(const CoordinateVectorType& rRadii) : mrRadii(rRadii) {}
+        CoordinateType operator()(const SizeType Query) const { return mrRadii[Query]; }
+        const CoordinateVectorType& mrRadii;
+    };
+
+    template<class TRadiusType>
+    struct RadiusSearch
+    {
+        RadiusSearch(BinsType& rBins, const TRadiusType& rRadius, const SizeType MaxNumberOfResults)
+        : mrBins(rBins), mRadius(rRadius), mMaxNumberOfResults(MaxNumberOfResults) {}
+
+        SizeType operator()(const PointType& rPoint, const SizeType Query, ThreadPool& rPool) const
+        {
+            rPool.Reserve(mMaxNumberOfResults);
+            return mrBins.SearchInRadius(rPoint, mRadius(Query), rPool.Results.begin() + rPool.Size,
+                rPool.Distances.begin() + rPool.Size, mMaxNumberOfResults, rPool.Box);
+        }
+
+        BinsType& mrBins;
+        TRadiusType mRadius;
+        SizeType mMaxNumberOfResults;
+    };
+
+    struct NearestSearch
+    {
+        NearestSearch(BinsType& rBins) : mrBins(rBins) {}
+
+        SizeType operator()(const PointType& rPoint, const SizeType Query, ThreadPool& rPool) const
+        {
+            rPool.Reserve(1);
+            rPool.Results[rPool.Size] = *mrBins.Begin();
+            rPool.Distances[rPool.Size] = static_cast<CoordinateType>(DBL_MAX);
+            mrBins.SearchNearestPoint(rPoint, rPool.Results[rPool.Size], rPool.Distances[rPool.Size], rPool.Box);
+            return 1;
+        }
+
+        BinsType& mrBins;
+    };
+
+    /// The radius search is repeated with a doubled radius until it contains K points or the whole bins
+    struct KNearestSearch
+    {
+        KNearestSearch(BinsType& rBins, const SizeType K, const CoordinateType InitialRadius, const BinsBatchSearch& rSearch)
+        : mrBins(rBins), mK(K), mInitialRadius(InitialRadius), mrSearch(rSearch) {}
+
+        SizeType operator()(const PointType& rPoint, const SizeType Query, ThreadPool& rPool) const
+        {
+            if (mK == 0)
+                return 0;
+
+            // beyond this radius, all the points of the bins are found
+            CoordinateType max_radius2 = 0.0;
+            for (std::size_t i = 0; i < Dimension; ++i)
+            {
+                const CoordinateType d = std::max(std::abs(rPoint[i] - mrSearch.mMinPoint[i]), std::abs(rPoint[i] - mrSearch.mMaxPoint[i]));
+                max_radius2 += d * d;
+            }
+            const CoordinateType max_radius = std::sqrt(max_radius2) + mrSearch.mMaxCellSize;
+
+            CoordinateType radius = std::min(mInitialRadius, max_radius);
+            SizeType capacity = std::max<SizeType>(4 * mK, 32);
+            SizeType number_of_results;
+            while (true)
+            {
+                rPool.Reserve(capacity);
+                number_of_results = mrBins.SearchInRadius(rPoint, radius, rPool.Results.begin() + rPool.Size,
+                    rPool.Distances.begin() + rPool.Size, capacity, rPool.Box);
+
+                if (number_of_results == capacity)
+                    capacity *= 2; // the results may be truncated, search again with more room
+                else if (number_of_results >= mK || radius >= max_radius)
+                    break;
+                else
+                    radius = std::min(2.0 * radius, max_radius);
+            }
+
+            const SizeType number_of_nearest = std::min(mK, number_of_results);
+            rPool.Sorting.resize(number_of_results);
+            for (SizeType i = 0; i < number_of_results; ++i)
+                rPool.Sorting[i] = std::make_pair(rPool.Distances[rPool.Size + i], rPool.Results[rPool.Size + i]);
+            std::partial_sort(rPool.Sorting.begin(), rPool.Sorting.begin() + number_of_nearest, rPool.Sorting.end(),
+                [](const std::pair<CoordinateType, PointerType>& a, const std::pair<CoordinateType, PointerType>& b) { return a.first < b.first; });
+            for (SizeType i = 0; i < number_of_nearest; ++i)
+            {
+                rPool.Distances[rPool.Size + i] = rPool.Sorting[i].first;
+                rPool.Results[rPool.Size + i] = rPool.Sorting[i].second;
+            }
+
+            return number_of_nearest;
+        }
+
+        BinsType& mrBins;
+        SizeType mK;
+        CoordinateType mInitialRadius;
+        const BinsBatchSearch& mrSearch;
+    };
+
+    ///@}
+    ///@name Member Variables
+    ///@{
+
+    BinsType& mrBins;
+
+    bool mSortQueries;
+
+    CoordinateType mMinPoint[Dimension];
+
+    CoordinateType mMaxPoint[Dimension];
+
+    CoordinateType mInvCellSize[Dimension];
+
+    SizeType mNumberOfCells[Dimension];
+
+    CoordinateType mMaxCellSize;
+
+    std::vector<ThreadPool> mPools;
+
+    std::vector<SizeType> mOrder;
+
+    std::vector<SizeType> mCellIndices;
+
+    std::vector<SizeType> mLocalOffsets;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    SizeType CalculateCellIndex(const PointType& rPoint) const
+    {
+        SizeType index = 0;
+        for (int i = static_cast<int>(Dimension) - 1; i >= 0; --i)
+        {
+            const CoordinateType d = (rPoint[i] - mMinPoint[i]) * mInvCellSize[i];
+            SizeType position = static_cast<SizeType>((d < 0.0) ? 0.0 : d);
+            position = std::min(position, mNumberOfCells[i] - 1);
+            index = index * mNumberOfCells[i] + position;
+        }
+        return index;
+    }
+
+    /// Order the queries by cell, with a counting sort over the cells
+    template<class TQueryIteratorType>
+    void ComputeOrder(TQueryIteratorType QueriesBegin, const SizeType NumberOfQueries)
+    {
+        mOrder.resize(NumberOfQueries);
+
+        if (!mSortQueries)
+        {
+            for (SizeType i = 0; i < NumberOfQueries; ++i)
+                mOrder[i] = i;
+            return;
+        }
+
+        SizeType number_of_cells = 1;
+        for (std::size_t i = 0; i < Dimension; ++i)
+            number_of_cells *= mNumberOfCells[i];
+
+        mCellIndices.resize(NumberOfQueries);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(NumberOfQueries); ++i)
+            mCellIndices[i] = CalculateCellIndex(QueriesBegin[i]);
+
+        std::vector<SizeType> cell_offsets(number_of_cells + 1, 0);
+        for (SizeType i = 0; i < NumberOfQueries; ++i)
+            ++cell_offsets[mCellIndices[i] + 1];
+        for (SizeType i = 0; i < number_of_cells; ++i)
+            cell_offsets[i + 1] += cell_offsets[i];
+        for (SizeType i = 0; i < NumberOfQueries; ++i)
+            mOrder[cell_offsets[mCellIndices[i]]++] = i;
+    }
+
+    template<class TQueryIteratorType, class TSearchType>
+    void Execute(TQueryIteratorType QueriesBegin, TQueryIteratorType QueriesEnd, const TSearchType& rSearch, ResultsType& rResults)
+    {
+        const SizeType number_of_queries = std::distance(QueriesBegin, QueriesEnd);
+
+        std::vector<SizeType>& r_offsets = rResults.GetOffsets();
+        r_offsets.assign(number_of_queries + 1, 0);
+        if (number_of_queries == 0)
+        {
+            rResults.GetResults().clear();
+            rResults.GetDistances().clear();
+            return;
+        }
+
+        ComputeOrder(QueriesBegin, number_of_queries);
+
+        const int number_of_threads = OpenMPUtils::GetNumThreads();
+        if (static_cast<int>(mPools.size()) < number_of_threads)
+            mPools.resize(number_of_threads);
+        mLocalOffsets.resize(number_of_queries);
+
+        #pragma omp parallel
+        {
+            ThreadPool& r_pool = mPools[OpenMPUtils::ThisThread()];
+            r_pool.Size = 0;
+
+            // first pass: search into the pool of the thread and count
+            #pragma omp for schedule(static)
+            for (int i = 0; i < static_cast<int>(number_of_queries); ++i)
+            {
+                const SizeType query = mOrder[i];
+                const SizeType count = rSearch(QueriesBegin[query], query, r_pool);
+                mLocalOffsets[query] = r_pool.Size;
+                r_offsets[query + 1] = count;
+                r_pool.Size += count;
+            }
+
+            #pragma omp single
+            {
+                for (SizeType i = 0; i < number_of_queries; ++i)
+                    r_offsets[i + 1] += r_offsets[i];
+                rResults.GetResults().resize(r_offsets[number_of_queries]);
+                rResults.GetDistances().resize(r_offsets[number_of_queries]);
+            }
+
+            // second pass: the same static schedule gives each thread the queries in its pool
+            #pragma omp for schedule(static)
+            for (int i = 0; i < static_cast<int>(number_of_queries); ++i)
+            {
+                const SizeType query = mOrder[i];
+                const SizeType local = mLocalOffsets[query];
+                const SizeType count = r_offsets[query + 1] - r_offsets[query];
+                std::copy(r_pool.Results.begin() + local, r_pool.Results.begin() + local + count, rResults.GetResults().begin() + r_offsets[query]);
+                std::copy(r_pool.Distances.begin() + local, r_pool.Distances.begin() + local + count, rResults.GetDistances().begin() + r_offsets[query]);
+            }
+        }
+    }
+
+    ///@}
+    ///@name Un accessible methods
+    ///@{
+
+    /// Assignment operator.
+    BinsBatchSearch& operator=(BinsBatchSearch const& rOther);
+
+    /// Copy constructor.
+    BinsBatchSearch(BinsBatchSearch const& rOther);
+
+    ///@}
+
+}; // Class BinsBatchSearch
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+template<class TBinsType>
+inline std::ostream& operator << (std::ostream& rOStream, const BinsBatchSearch<TBinsType>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_BINS_BATCH_SEARCH_H_INCLUDED  defined
@@ -404,11 +404,18 @@ public:
     
     //************************************************************************
         
-    void SearchNearestPoint( PointType* const& ThisPoints, SizeType const& NumberOfPoints, IteratorType &Results, std::vector<CoordinateType> ResultsDistances)
+    void SearchNearestPoint( PointType* const& ThisPoints, SizeType const& NumberOfPoints, IteratorType &Results, std::vector<CoordinateType>& ResultsDistances)
     {
+        if( mPointBegin == mPointEnd )
+            return;
+
         #pragma omp parallel for
-        for(int k=0; k< NumberOfPoints; k++)
-            Results[k] = SearchNearestPoint(ThisPoints[k],ResultsDistances[k]);
+        for(int k=0; k< static_cast<int>(NumberOfPoints); k++)
+        {
+            Results[k] = *mPointBegin;
+            ResultsDistances[k] = static_cast<CoordinateType>(DBL_MAX);
+            SearchNearestPoint(ThisPoints[k],Results[k],ResultsDistances[k]);
+        }
     }
 
     //************************************************************************
@@ -479,11 +486,11 @@ public:
     
     //************************************************************************
 
-    void SearchInRadius( PointerType const& ThisPoints, SizeType const& NumberOfPoints, CoordinateVectorType const& Radius, IteratorVectorType Results,
-                         DistanceIteratorVectorType ResultsDistances, std::vector<SizeType>& NumberOfResults, SizeType const& MaxNumberOfResults )
+    void SearchInRadius( PointerType const& ThisPoints, SizeType const& NumberOfPoints, CoordinateVectorType const& Radius, IteratorVectorType const& Results,
+                         DistanceIteratorVectorType const& ResultsDistances, std::vector<SizeType>& NumberOfResults, SizeType const& MaxNumberOfResults )
     {
         #pragma omp parallel for
-        for(int k=0; k< NumberOfPoints; k++)
+        for(int k=0; k< static_cast<int>(NumberOfPoints); k++)
             NumberOfResults[k] = SearchInRadius(ThisPoints[k],Radius[k],Results[k],ResultsDistances[k],MaxNumberOfResults);
     }
 
@@ -730,6 +737,22 @@ public:
         rout << "]" << std::endl;
     }
 
+    TPointType GetMinPoint()
+    {
+        TPointType point;
+        for(SizeType i = 0 ; i < TDimension ; i++)
+            point[i] = mMinPoint[i];
+        return point;
+    }
+
+    TPointType GetMaxPoint()
+    {
+        TPointType point;
+        for(SizeType i = 0 ; i < TDimension ; i++)
+            point[i] = mMaxPoint[i];
+        return point;
+    }
+
     /// Assignment operator.
     BinsDynamic& operator=(BinsDynamic const& rOther);
 
@@ -403,7 +403,7 @@ public:
     PointerType SearchNearestPoint( PointType const& ThisPoint, CoordinateType& rResultDistance, SearchStructureType& Box )
     {
         PointerType Result            = *mPointBegin;                           //static_cast<PointerType>(NULL);
-        CoordinateType ResultDistance = static_cast<CoordinateType>(DBL_MAX);
+        rResultDistance               = static_cast<CoordinateType>(DBL_MAX);
         Box.Set( CalculateCell(ThisPoint), mN, mIndexCellBegin );
         SearchNearestPointLocal( ThisPoint, Result, rResultDistance, Box);
         return Result;
@@ -430,11 +430,11 @@ public:
     
     //************************************************************************
     
-    void SearchNearestPoint( PointerType const& ThisPoints, SizeType const& NumberOfPoints, IteratorType &Results, std::vector<CoordinateType> ResultsDistances)
+    void SearchNearestPoint( PointerType const& ThisPoints, SizeType const& NumberOfPoints, IteratorType &Results, std::vector<CoordinateType>& ResultsDistances)
     {
         #pragma omp parallel for
-        for(int k=0; k< NumberOfPoints; k++)
-	  Results[k] = SearchNearestPoint((&(*ThisPoints))[k],ResultsDistances[k]);
+        for(int k=0; k< static_cast<int>(NumberOfPoints); k++)
+            Results[k] = SearchNearestPoint((&(*ThisPoints))[k],ResultsDistances[k]);
     }
 
     //************************************************************************
@@ -529,12 +529,12 @@ public:
     
     //************************************************************************
     
-   void SearchInRadius( PointerType const& ThisPoints, SizeType const& NumberOfPoints, std::vector<CoordinateType> const& Radius, std::vector<IteratorType> Results,
-                        std::vector<DistanceIteratorType> ResultsDistances, std::vector<SizeType>& NumberOfResults, SizeType const& MaxNumberOfResults )
+    void SearchInRadius( PointerType const& ThisPoints, SizeType const& NumberOfPoints, std::vector<CoordinateType> const& Radius, std::vector<IteratorType> const& Results,
+                         std::vector<DistanceIteratorType> const& ResultsDistances, std::vector<SizeType>& NumberOfResults, SizeType const& MaxNumberOfResults )
     {
         #pragma omp parallel for
-        for(int k=0; k< NumberOfPoints; k++)
-	  NumberOfResults[k] = SearchInRadius((&(*ThisPoints))[k],Radius[k],Results[k],ResultsDistances[k],MaxNumberOfResults);
+        for(int k=0; k< static_cast<int>(NumberOfPoints); k++)
+            NumberOfResults[k] = SearchInRadius((&(*ThisPoints))[k],Radius[k],Results[k],ResultsDistances[k],MaxNumberOfResults);
     }
 
     //************************************************************************
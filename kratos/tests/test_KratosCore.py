@@ -10,6 +10,7 @@ import KratosMultiphysics.KratosUnittest as KratosUnittest
 from test_kratos_parameters import TestParameters as TParameters
 from test_model_part_io import TestModelPartIO as TModelPartIO
 from test_model_part import TestModelPart as TModelPart
+from test_neighbour_search import TestNeighbourSearch as TNeighbourSearch
 
 
 def AssambleTestSuites():
@@ -39,9 +40,17 @@ def AssambleTestSuites():
     nightSuite.addTests(map(TModelPart, [
         'test_model_part_sub_model_parts',
         'test_model_part_nodes',
+        'test_model_part_create_new_nodes_failure',
         'test_model_part_tables'
     ]))
 
+    nightSuite.addTests(map(TNeighbourSearch, [
+        'test_nodal_neighbours_tetrahedra',
+        'test_elemental_neighbours_tetrahedra',
+        'test_neighbours_with_a_node_out_of_the_model_part',
+        'test_conditions_neighbours_quadrilaterals'
+    ]))
+
     nightSuite.addTests(map(TParameters, [
         'test_kratos_parameters',
         'test_kratos_change_parameters',
@@ -55,6 +64,7 @@ def AssambleTestSuites():
         KratosUnittest.TestLoader().loadTestsFromTestCases([
             TModelPartIO,
             TModelPart,
+            TNeighbourSearch,
             TParameters
         ])
     )
@@ -1,5 +1,7 @@
 from __future__ import print_function, absolute_import, division
 
+import array
+
 import KratosMultiphysics.KratosUnittest as KratosUnittest
 from KratosMultiphysics import *
 
@@ -145,6 +147,40 @@ class TestModelPart(KratosUnittest.TestCase):
         self.assertEqual(inlets_model_part.NumberOfNodes(), 5)
         self.assertEqual(model_part.NumberOfNodes(), 7)
 
+    def test_model_part_create_new_nodes_failure(self):
+        current_model = Model()
+        model_part = current_model.CreateModelPart("Main")
+        model_part.CreateNewNode(5, 5.00,0.00,0.00)
+
+        coordinates = array.array('d', [0.00] * 12)
+
+        # an existing id rejects the whole batch, and the model part is not changed
+        with self.assertRaisesRegex(RuntimeError, "already exists"):
+            model_part.CreateNewNodes(array.array('q', [1,2,5,7]), coordinates)
+
+        # so does an id repeated in the batch
+        with self.assertRaisesRegex(RuntimeError, "repeated"):
+            model_part.CreateNewNodes(array.array('q', [1,2,2,7]), coordinates)
+
+        # and a negative id
+        with self.assertRaisesRegex(RuntimeError, "negative"):
+            model_part.CreateNewNodes(array.array('q', [1,2,-3,7]), coordinates)
+
+        self.assertEqual(model_part.NumberOfNodes(), 1)
+        self.assertEqual([node.Id for node in model_part.Nodes], [5])
+
+        model_part.CreateNewNodes(array.array('q', [1,2,6,7]), coordinates)
+
+        self.assertEqual([node.Id for node in model_part.Nodes], [1,2,5,6,7])
+
+        with self.assertRaisesRegex(RuntimeError, "repeated"):
+            model_part.CreateNewElements("Element2D3N", array.array('q', [1,1]), array.array('q', [1,2,6,2,6,7]), model_part.GetProperties()[1])
+        with self.assertRaisesRegex(RuntimeError, "repeated"):
+            model_part.CreateNewConditions("Condition2D", array.array('q', [3,3]), array.array('q', [1,2,6,7]), model_part.GetProperties()[1])
+
+        self.assertEqual(model_part.NumberOfElements(), 0)
+        self.assertEqual(model_part.NumberOfConditions(), 0)
+
     def test_model_part_tables(self):
         model_part = ModelPart("Main")
 
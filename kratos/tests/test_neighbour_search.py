@@ -0,0 +1,95 @@
+from __future__ import print_function, absolute_import, division
+
+import KratosMultiphysics.KratosUnittest as KratosUnittest
+from KratosMultiphysics import *
+
+class TestNeighbourSearch(KratosUnittest.TestCase):
+
+    def _create_tetrahedra(self, model_part, missing_node = None):
+        # two tetrahedra sharing the face 2-3-4
+        coordinates = {1 : (0.0,0.0,0.0), 2 : (1.0,0.0,0.0), 3 : (0.0,1.0,0.0), 4 : (0.0,0.0,1.0), 5 : (1.0,1.0,1.0)}
+        nodes = {}
+        for i, (x, y, z) in coordinates.items():
+            if i == missing_node:
+                nodes[i] = Node(i, x, y, z)
+            else:
+                nodes[i] = model_part.CreateNewNode(i, x, y, z)
+
+        properties = model_part.GetProperties()[1]
+        for i, ids in [(1, [1,2,3,4]), (2, [5,4,3,2])]:
+            element = Element(i, Tetrahedra3D4(*[nodes[j] for j in ids]), properties)
+            element.Set(ACTIVE, True)
+            model_part.AddElement(element)
+
+    def _create_surface(self, model_part):
+        # two quadrilaterals sharing the edge 2-5 and a triangle sharing the edge 3-6 with the second one
+        coordinates = [(0.0,0.0), (1.0,0.0), (2.0,0.0), (0.0,1.0), (1.0,1.0), (2.0,1.0), (3.0,0.5)]
+        nodes = {}
+        for i, (x, y) in enumerate(coordinates):
+            nodes[i + 1] = model_part.CreateNewNode(i + 1, x, y, 0.0)
+
+        properties = model_part.GetProperties()[1]
+        model_part.AddCondition(Condition(1, Quadrilateral3D4(nodes[1], nodes[2], nodes[5], nodes[4]), properties))
+        model_part.AddCondition(Condition(2, Quadrilateral3D4(nodes[2], nodes[3], nodes[6], nodes[5]), properties))
+        model_part.AddCondition(Condition(3, Triangle3D3(nodes[3], nodes[7], nodes[6]), properties))
+
+    def test_nodal_neighbours_tetrahedra(self):
+        current_model = Model()
+        model_part = current_model.CreateModelPart("Main")
+        self._create_tetrahedra(model_part)
+
+        process = FindNodalNeighboursProcess(model_part, 10, 10)
+        process.Execute()
+
+        # the neighbour nodes are in the order they first appear in the elements of the node
+        expected_nodes = {1 : [2,3,4], 2 : [1,3,4,5], 3 : [1,2,4,5], 4 : [1,2,3,5], 5 : [4,3,2]}
+        expected_elements = {1 : [1], 2 : [1,2], 3 : [1,2], 4 : [1,2], 5 : [2]}
+        for node in model_part.Nodes:
+            self.assertEqual(process.GetNeighbourNodesIds(node), expected_nodes[node.Id])
+            self.assertEqual(process.GetNeighbourElementsIds(node), expected_elements[node.Id])
+
+    def test_elemental_neighbours_tetrahedra(self):
+        current_model = Model()
+        model_part = current_model.CreateModelPart("Main")
+        self._create_tetrahedra(model_part)
+
+        process = FindElementalNeighboursProcess(model_part, 3, 10)
+        process.Execute()
+
+        # the neighbour over the face opposite to each node, the element itself on the boundary
+        self.assertEqual(process.GetNeighbourElementsIds(model_part.Elements[1]), [2,1,1,1])
+        self.assertEqual(process.GetNeighbourElementsIds(model_part.Elements[2]), [1,2,2,2])
+
+    def test_neighbours_with_a_node_out_of_the_model_part(self):
+        current_model = Model()
+        model_part = current_model.CreateModelPart("Main")
+        self._create_tetrahedra(model_part, missing_node = 5)
+
+        # the node 5 of the element 2 is not in the model part, it is skipped
+        nodal_process = FindNodalNeighboursProcess(model_part, 10, 10)
+        nodal_process.Execute()
+        self.assertEqual(nodal_process.GetNeighbourNodesIds(model_part.Nodes[2]), [1,3,4])
+        self.assertEqual(nodal_process.GetNeighbourElementsIds(model_part.Nodes[2]), [1,2])
+
+        # the faces through the node 5 have no neighbour
+        elemental_process = FindElementalNeighboursProcess(model_part, 3, 10)
+        elemental_process.Execute()
+        self.assertEqual(elemental_process.GetNeighbourElementsIds(model_part.Elements[1]), [2,1,1,1])
+        self.assertEqual(elemental_process.GetNeighbourElementsIds(model_part.Elements[2]), [1,2,2,2])
+
+    def test_conditions_neighbours_quadrilaterals(self):
+        current_model = Model()
+        model_part = current_model.CreateModelPart("Main")
+        self._create_surface(model_part)
+
+        process = FindConditionsNeighboursProcess(model_part, 3, 10)
+        process.Execute()
+
+        # the neighbours over the edges 1-2, 2-3, 3-0 and 0-1 of the quadrilaterals and 1-2, 2-0 and 0-1
+        # of the triangles, 0 on the boundary
+        self.assertEqual(process.GetNeighbourConditionsIds(model_part.Conditions[1]), [2,0,0,0])
+        self.assertEqual(process.GetNeighbourConditionsIds(model_part.Conditions[2]), [3,0,1,0])
+        self.assertEqual(process.GetNeighbourConditionsIds(model_part.Conditions[3]), [0,2,0])
+
+if __name__ == '__main__':
+    KratosUnittest.main()
@@ -20,6 +20,8 @@ see kratos/LICENSE.txt
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include "includes/define.h"
+#include "utilities/dual_number.h"
 
 namespace Kratos
 {
@@ -152,6 +154,15 @@ struct AD_Helper<adtl::adouble> : public AD_Helper_Base
 };
 #endif
 
+template<typename TDataType, std::size_t TSize>
+struct AD_Helper<Dual<TDataType, TSize> > : public AD_Helper_Base
+{
+    static inline void SetNumberOfADVariables(int ndirs) {KRATOS_ERROR_IF(ndirs > static_cast<int>(TSize)) << "Dual has only " << TSize << " directions, " << ndirs << " are required" << std::endl;}
+    static inline double GetValue(const Dual<TDataType, TSize>& v) {return AD_Helper_GetValue(v.val());}
+    static inline void SetADValue(Dual<TDataType, TSize>& v, const int& index, const unsigned int ndirs) { v.diff(index, ndirs); }
+    static inline double GetADValue(const Dual<TDataType, TSize>& v, const unsigned int index) {return AD_Helper_GetValue(v.dx(index));}
+};
+
 /**
  * Defines several utility functions for operation with AD tensor
  */
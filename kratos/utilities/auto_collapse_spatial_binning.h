@@ -14,12 +14,16 @@
 #include <string>
 #include <vector>
 #include <iostream>
-#include <map>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
 
 // External includes 
 
 // Project includes
 #include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "utilities/mesh_partitioning_utility.h"
 
 
 namespace Kratos
@@ -71,6 +75,7 @@ class SpatialKey
     public:
         KRATOS_CLASS_POINTER_DEFINITION(SpatialKey);
         
+        SpatialKey() : x(0), y(0), z(0) {}
         SpatialKey(int ix, int iy, int iz) : x(ix), y(iy), z(iz) {}
         ~SpatialKey() {}
         bool operator<(const SpatialKey& rOther) const
@@ -87,6 +92,19 @@ class SpatialKey
             else
                 return x < rOther.x;
         }
+        bool operator==(const SpatialKey& rOther) const
+        {
+            return (x == rOther.x) && (y == rOther.y) && (z == rOther.z);
+        }
+        /// Spatial hash of the cell (Teschner et al.)
+        std::size_t Hash() const
+        {
+            return (static_cast<std::size_t>(x) * 73856093u) ^ (static_cast<std::size_t>(y) * 19349663u) ^ (static_cast<std::size_t>(z) * 83492791u);
+        }
+        struct Hasher
+        {
+            std::size_t operator()(const SpatialKey& rKey) const {return rKey.Hash();}
+        };
         int kx() const {return x;}
         int ky() const {return y;}
         int kz() const {return z;}
@@ -98,6 +116,8 @@ class SpatialKey
 /// Short class definition.
 /*** Detail class definition.
  * This utility class supports for spatial binning with auto collapsing functionality. This class used SpatialPoint as point data and will collapse the conincident point.
+ * The cells are stored in a hash grid. A point is collapsed to the first point of its cell, in the order of insertion, which is closer than the tolerance.
+ * AddNodes inserts a batch of points in parallel and gives the same ids as calling AddNode for each point in turn.
  */
 class AutoCollapseSpatialBinning
 {
@@ -140,50 +160,126 @@ public:
     unsigned int AddNode(double X, double Y, double Z)
     {
         // find the cell containing point
-        int ix = (int) floor((X - mX0) / mDx);
-        int iy = (int) floor((Y - mY0) / mDy);
-        int iz = (int) floor((Z - mZ0) / mDz);
-        
-        // check if the spatial key exist
-        SpatialKey key(ix, iy, iz);
-    //    std::cout << "ix = " << ix << ", iy = " << iy << ", iz = " << iz << std::endl;
-        std::map<SpatialKey, std::vector<int> >::iterator it = mBin.find(key);
+        const SpatialKey key = GetKey(X, Y, Z);
+
+        // check if node already exist in the cell
+        BinType::iterator it = mBin.find(key);
         if(it != mBin.end())
         {
-            // check if node already exist in the cell
-    //        std::cout << "check if node already exist in the cell" << std::endl;
-            for(int i = 0; i < it->second.size(); ++i)
+            const unsigned int existing = FindInCell(it->second, X, Y, Z);
+            if(existing != 0)
+                return existing;
+        }
+
+        // node does not exist in cell, insert the node into spatial bin
+        mPointList.push_back(SpatialPoint(++mLastNode, X, Y, Z));
+        mBin[key].push_back(mLastNode);
+        return mLastNode;
+    }
+
+    /**
+     * This function adds a batch of nodes to the spatial binning and returns the ids of the nodes in the bin.
+     * The coordinates are given as x0, y0, z0, x1, y1, z1, ... The points are grouped by cell by sorting their
+     * cell hashes and the cells are resolved in parallel. The ids are the same as adding the nodes one by one.
+     */
+    std::vector<unsigned int> AddNodes(const std::vector<double>& rCoordinates)
+    {
+        const std::size_t number_of_points = rCoordinates.size() / 3;
+        const double* coordinates = rCoordinates.data();
+
+        std::vector<unsigned int> ids(number_of_points, 0);
+
+        // the grouping by cell only pays off in parallel
+        if(OpenMPUtils::GetNumThreads() == 1 || number_of_points < 1000)
+        {
+            for(IndexType i = 0; i < number_of_points; ++i)
+                ids[i] = AddNode(coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2]);
+            return ids;
+        }
+
+        // hash the points to their cells
+        std::vector<SpatialKey> keys(number_of_points);
+        std::vector<std::pair<std::size_t, IndexType> > sorted_points(number_of_points);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(number_of_points); ++i)
+        {
+            keys[i] = GetKey(coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2]);
+            sorted_points[i] = std::make_pair(keys[i].Hash(), static_cast<IndexType>(i));
+        }
+        MeshPartitioningUtility::ParallelSort(sorted_points);
+
+        std::vector<IndexType> runs(1, 0);
+        for(IndexType k = 1; k < number_of_points; ++k)
+            if(sorted_points[k].first != sorted_points[k-1].first)
+                runs.push_back(k);
+        runs.push_back(number_of_points);
+
+        // the representative of each point: an existing node (ids), or the first coincident point of the batch in the same cell
+        std::vector<IndexType> representatives(number_of_points);
+        #pragma omp parallel
+        {
+            std::vector<IndexType> fresh;
+
+            #pragma omp for schedule(dynamic, 64)
+            for(int r = 0; r < static_cast<int>(runs.size()) - 1; ++r)
             {
-                double xi = mPointList[it->second[i] - 1]->GetX();
-                double yi = mPointList[it->second[i] - 1]->GetY();
-                double zi = mPointList[it->second[i] - 1]->GetZ();
-                double d = sqrt(pow(X - xi, 2) + pow(Y - yi, 2) + pow(Z - zi, 2));
-                if(d < mTol)
+                fresh.clear();
+                for(IndexType k = runs[r]; k < runs[r+1]; ++k)
                 {
-    //                std::cout << "node exist in cell, return its id" << std::endl;
-                    return mPointList[it->second[i] - 1]->GetId();
+                    const IndexType i = sorted_points[k].second;
+                    const double X = coordinates[3*i], Y = coordinates[3*i+1], Z = coordinates[3*i+2];
+                    representatives[i] = i;
+
+                    BinType::const_iterator it = mBin.find(keys[i]);
+                    if(it != mBin.end())
+                    {
+                        ids[i] = FindInCell(it->second, X, Y, Z);
+                        if(ids[i] != 0)
+                            continue;
+                    }
+
+                    // the cells sharing the hash are told apart by their keys
+                    std::vector<IndexType>::const_iterator it_fresh = fresh.begin();
+                    for(; it_fresh != fresh.end(); ++it_fresh)
+                    {
+                        const IndexType j = *it_fresh;
+                        if(keys[j] == keys[i] && Distance(coordinates[3*j], coordinates[3*j+1], coordinates[3*j+2], X, Y, Z) < mTol)
+                            break;
+                    }
+                    if(it_fresh != fresh.end())
+                        representatives[i] = *it_fresh;
+                    else
+                        fresh.push_back(i);
                 }
             }
-            // node does not exist in cell, insert the node into spatial bin
-            mPointList.push_back(boost::shared_ptr<SpatialPoint>(new SpatialPoint(++mLastNode, X, Y, Z)));
-            mBin[key].push_back(mLastNode);
-    //        std::cout << "node does not exist in cell, insert the node into spatial bin, mLastNode = " << mLastNode << ", mBin[key].size() = " << mBin[key].size() << std::endl;
-            return mLastNode;
         }
-        else
+
+        // number the new nodes in the order of the batch
+        mPointList.reserve(mPointList.size() + number_of_points);
+        mBin.reserve(mBin.size() + runs.size());
+        for(IndexType i = 0; i < number_of_points; ++i)
         {
-            // insert the node into spatial bin
-            mPointList.push_back(boost::shared_ptr<SpatialPoint>(new SpatialPoint(++mLastNode, X, Y, Z)));
-            mBin[key].push_back(mLastNode);
-    //        std::cout << "insert the node into spatial bin, mLastNode = " << mLastNode << ", mBin[key].size() = " << mBin[key].size() << std::endl;
-            return mLastNode;
+            if(ids[i] != 0)
+                continue;
+
+            if(representatives[i] != i)
+            {
+                ids[i] = ids[representatives[i]];
+                continue;
+            }
+
+            ids[i] = ++mLastNode;
+            mPointList.push_back(SpatialPoint(mLastNode, coordinates[3*i], coordinates[3*i+1], coordinates[3*i+2]));
+            mBin[keys[i]].push_back(mLastNode);
         }
+
+        return ids;
     }
 
     std::size_t NumberOfNodes() const {return mPointList.size();}
-    double GetX(unsigned int id) const {return mPointList[id - 1]->GetX();}
-    double GetY(unsigned int id) const {return mPointList[id - 1]->GetY();}
-    double GetZ(unsigned int id) const {return mPointList[id - 1]->GetZ();}
+    double GetX(unsigned int id) const {return mPointList[id - 1].GetX();}
+    double GetY(unsigned int id) const {return mPointList[id - 1].GetY();}
+    double GetZ(unsigned int id) const {return mPointList[id - 1].GetZ();}
 
     ///@}
     ///@name Access
@@ -258,8 +354,10 @@ private:
     unsigned int mLastNode;
     double mTol;
 
-    std::map<SpatialKey, std::vector<int> > mBin;
-    std::vector<boost::shared_ptr<SpatialPoint> > mPointList;
+    typedef std::unordered_map<SpatialKey, std::vector<unsigned int>, SpatialKey::Hasher> BinType;
+
+    BinType mBin;
+    std::vector<SpatialPoint> mPointList;
     
     ///@}
     ///@name Member Variables
@@ -272,8 +370,29 @@ private:
     ///@}
     ///@name Private Operations
     ///@{
-    
-    
+
+    SpatialKey GetKey(double X, double Y, double Z) const
+    {
+        return SpatialKey((int) floor((X - mX0) / mDx), (int) floor((Y - mY0) / mDy), (int) floor((Z - mZ0) / mDz));
+    }
+
+    static double Distance(double X1, double Y1, double Z1, double X2, double Y2, double Z2)
+    {
+        return sqrt(pow(X2 - X1, 2) + pow(Y2 - Y1, 2) + pow(Z2 - Z1, 2));
+    }
+
+    /// The id of the first node of the cell closer than the tolerance, 0 if there is none
+    unsigned int FindInCell(const std::vector<unsigned int>& rCell, double X, double Y, double Z) const
+    {
+        for(std::size_t i = 0; i < rCell.size(); ++i)
+        {
+            const SpatialPoint& rPoint = mPointList[rCell[i] - 1];
+            if(Distance(rPoint.GetX(), rPoint.GetY(), rPoint.GetZ(), X, Y, Z) < mTol)
+                return rPoint.GetId();
+        }
+        return 0;
+    }
+
     ///@}
     ///@name Private  Access
     ///@{
@@ -51,6 +51,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
 /* System includes */
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 #include "includes/define.h"
 #include "includes/model_part.h"
 //#include "includes/ublas_interface.h"
@@ -197,63 +200,27 @@ public:
     }
 
     ///this function constructs the structure of a smaller matrix using a technique taken from MIS aggregation
-    ///the algorythm is taken from the pyamg lib
+    ///the nodes are aggregated around the roots of a distance-2 maximal independent set, which is computed in parallel
     static void ConstructW(const std::size_t max_reduced_size, SparseMatrixType& rA, std::vector<int>& w, SparseMatrixType&  deflatedA)
     {
         KRATOS_TRY
 
         std::size_t full_size = rA.size1();
         w.resize(full_size,0);
-
-        //call aggregation function to fill mw with "colors"
-        std::size_t reduced_size = standard_aggregation<int>(rA.size1(),rA.index1_data().begin(), rA.index2_data().begin(), &w[0]);
-// for( int i=0; i<full_size; i++)
-//   std::cout << w[i] << std::endl;
-
-        // Non-zero structure of deflatedA
-
-        std::vector<std::set<std::size_t> > deflatedANZ(reduced_size);
-
-        // Loop over non-zero structure of A and build non-zero structure of deflatedA
-        typename SparseMatrixType::iterator1 a_iterator = rA.begin1();
-
-        for (std::size_t i = 0; i < full_size; i++)
+        if (full_size == 0 || rA.nnz() == 0)
         {
-#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
-            for (typename SparseMatrixType::iterator2 row_iterator = a_iterator.begin() ;
-                    row_iterator != a_iterator.end() ; ++row_iterator)
-            {
-#else
-            for (typename SparseMatrixType::iterator2 row_iterator = begin(a_iterator,
-                    boost::numeric::ublas::iterator1_tag());
-                    row_iterator != end(a_iterator,
-                                        boost::numeric::ublas::iterator1_tag()); ++row_iterator )
-            {
-#endif
-                deflatedANZ[w[a_iterator.index1()]].insert(w[row_iterator.index2()]);
-            }
-
-            a_iterator++;
+            deflatedA = SparseMatrixType(0, 0);
+            return;
         }
 
-        std::cout << "********** NZS built!" << std::endl;
-
-        // Count the number of non-zeros in deflatedA
-        std::size_t NZ = 0;
-        for (std::size_t i = 0; i < reduced_size; i++)
-            NZ += deflatedANZ[i].size();
-
-        std::cout << "********** NZ = " << NZ << std::endl;
-        deflatedA.resize(reduced_size, reduced_size,NZ);
+        //call aggregation function to fill mw with "colors"
+        std::size_t reduced_size = ParallelAggregation(full_size, &rA.index1_data()[0], &rA.index2_data()[0], w);
 
-        // Insert the non-zero structure into deflatedA
-        for(std::size_t i = 0 ; i < reduced_size ; i++)
-        {
-            for(std::set<std::size_t>::iterator j = deflatedANZ[i].begin() ; j != deflatedANZ[i].end() ; j++)
-            {
-                deflatedA.push_back(i,*j, 0.00);
-            }
-        }
+        // Non-zero structure of deflatedA
+        std::vector<std::size_t> wt_index1;
+        std::vector<int> wt_index2;
+        ConstructWtranspose(w, reduced_size, wt_index1, wt_index2);
+        ConstructDeflatedMatrixStructure(rA, w, wt_index1, wt_index2, deflatedA);
 
         if(reduced_size > max_reduced_size)
         {
@@ -264,16 +231,15 @@ public:
             ConstructW(max_reduced_size, deflatedA, wsmaller, Areduced);
 
             //now change deflatedA and w on the coarser size
-            for(unsigned int i=0; i<full_size; i++)
+            #pragma omp parallel for
+            for(int i=0; i<static_cast<int>(full_size); i++)
             {
-                int color = w[i];
-                int new_color = wsmaller[color];
-                w[i] = new_color;
+                w[i] = wsmaller[w[i]];
             }
             deflatedA.clear();
             deflatedA = Areduced;
 
-            reduced_size = wsmaller.size();
+            reduced_size = Areduced.size1();
         }
 
         KRATOS_WATCH(reduced_size);
@@ -390,45 +356,120 @@ public:
 #endif
     }
 
+    //Wt is the transpose of the deflation matrix, stored in CSR format without values:
+    //the rows of the full size problem in aggregate I are wt_index2[wt_index1[I]] ... wt_index2[wt_index1[I+1]-1]
+    static void ConstructWtranspose(const std::vector<int>& w, const std::size_t reduced_size,
+                                    std::vector<std::size_t>& wt_index1, std::vector<int>& wt_index2)
+    {
+        wt_index1.assign(reduced_size+1, 0);
+        for(std::size_t i=0; i<w.size(); i++)
+            wt_index1[w[i]+1]++;
+
+        for(std::size_t I=0; I<reduced_size; I++)
+            wt_index1[I+1] += wt_index1[I];
+
+        wt_index2.resize(w.size());
+        std::vector<std::size_t> position(wt_index1.begin(), wt_index1.end()-1);
+        for(std::size_t i=0; i<w.size(); i++)
+            wt_index2[position[w[i]]++] = i;
+    }
+
+    //y is a vector of "reduced" size
+    //x is a vector of "full" size
+    //y = Wtranspose*x, each entry of y is summed by a single thread using the transpose of W
+    static void ApplyWtranspose(const std::vector<std::size_t>& wt_index1, const std::vector<int>& wt_index2,
+                                const SparseVectorType& x, SparseVectorType& y)
+    {
+        #pragma omp parallel for
+        for(int I=0; I<static_cast<int>(y.size()); I++)
+        {
+            DataType sum = DataType();
+            for(std::size_t k=wt_index1[I]; k<wt_index1[I+1]; k++)
+                sum += x[wt_index2[k]];
+            y[I] = sum;
+        }
+    }
+
     //*******************************************************************************
     //*******************************************************************************
     static void FillDeflatedMatrix( const SparseMatrixType& rA, std::vector<int>& w, SparseMatrixType&  Ah)
     {
         KRATOS_TRY
 
-        DataType* abegin = Ah.value_data().begin();
-        int size = Ah.value_data().size();
-        #pragma omp parallel for
-        for (int i = 0; i < size; i++)
+        std::vector<std::size_t> wt_index1, fill_map;
+        std::vector<int> wt_index2;
+        ConstructWtranspose(w, Ah.size1(), wt_index1, wt_index2);
+        ConstructFillMap(rA, w, wt_index1, wt_index2, Ah, fill_map);
+        FillDeflatedMatrix(rA, wt_index1, wt_index2, fill_map, Ah);
+
+        KRATOS_CATCH("");
+    }
+
+    ///compute for each non-zero of rA the position of the entry of Ah = Wt*rA*W it contributes to
+    ///the map is valid as long as the structures of rA and Ah do not change
+    static void ConstructFillMap(const SparseMatrixType& rA, const std::vector<int>& w,
+                                 const std::vector<std::size_t>& wt_index1, const std::vector<int>& wt_index2,
+                                 const SparseMatrixType& Ah, std::vector<std::size_t>& fill_map)
+    {
+        KRATOS_TRY
+
+        fill_map.resize(rA.nnz());
+
+        const std::size_t* a_index1 = &rA.index1_data()[0];
+        const std::size_t* a_index2 = &rA.index2_data()[0];
+        const std::size_t* ah_index1 = &Ah.index1_data()[0];
+        const std::size_t* ah_index2 = &Ah.index2_data()[0];
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(int I=0; I<static_cast<int>(Ah.size1()); I++)
         {
-            *(abegin+i) = 0.0;
+            for(std::size_t k=wt_index1[I]; k<wt_index1[I+1]; k++)
+            {
+                const int i = wt_index2[k];
+                for(std::size_t jj=a_index1[i]; jj<a_index1[i+1]; jj++)
+                {
+                    const std::size_t J = w[a_index2[jj]];
+                    const std::size_t* pos = std::lower_bound(ah_index2 + ah_index1[I], ah_index2 + ah_index1[I+1], J);
+                    if(pos == ah_index2 + ah_index1[I+1] || *pos != J)
+                        KRATOS_THROW_ERROR(std::logic_error, "the structure of the deflated matrix does not match the deflation matrix", "")
+                    fill_map[jj] = pos - ah_index2;
+                }
+            }
         }
-//      TSparseSpaceType::SetToZero(Ah);
 
-        // Now building Ah
-        typename SparseMatrixType::const_iterator1 a_iterator = rA.begin1();
-        int full_size = rA.size1();
+        KRATOS_CATCH("");
+    }
+
+    ///Ah = Wt*rA*W, with the structure of Ah and the fill map computed before
+    ///each row of Ah is assembled by a single thread, so no synchronization is needed
+    static void FillDeflatedMatrix(const SparseMatrixType& rA,
+                                   const std::vector<std::size_t>& wt_index1, const std::vector<int>& wt_index2,
+                                   const std::vector<std::size_t>& fill_map, SparseMatrixType& Ah)
+    {
+        KRATOS_TRY
 
-        for (int i = 0; i < full_size; i++)
+        if(fill_map.size() != rA.nnz())
+            KRATOS_THROW_ERROR(std::logic_error, "the fill map does not match the number of non-zeros of the matrix", "")
+
+        const std::size_t* a_index1 = &rA.index1_data()[0];
+        const DataType* a_values = &rA.value_data()[0];
+        const std::size_t* ah_index1 = &Ah.index1_data()[0];
+        DataType* ah_values = &Ah.value_data()[0];
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(int I=0; I<static_cast<int>(Ah.size1()); I++)
         {
-#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
-            for (typename SparseMatrixType::const_iterator2 row_iterator = a_iterator.begin() ;
-                    row_iterator != a_iterator.end() ; ++row_iterator)
-            {
-#else
-            for (typename SparseMatrixType::iterator2 row_iterator = begin(a_iterator,
-                    boost::numeric::ublas::iterator1_tag());
-                    row_iterator != end(a_iterator,
-                                        boost::numeric::ublas::iterator1_tag()); ++row_iterator )
+            for(std::size_t k=ah_index1[I]; k<ah_index1[I+1]; k++)
+                ah_values[k] = DataType();
+
+            for(std::size_t k=wt_index1[I]; k<wt_index1[I+1]; k++)
             {
-#endif
-                Ah(w[a_iterator.index1()], w[row_iterator.index2()]) += *row_iterator;
+                const int i = wt_index2[k];
+                for(std::size_t jj=a_index1[i]; jj<a_index1[i+1]; jj++)
+                    ah_values[fill_map[jj]] += a_values[jj];
             }
-            a_iterator++;
         }
 
-        std::cout << "********** W^T * A * W built!" << std::endl;
-
         KRATOS_CATCH("");
     }
 
@@ -468,6 +509,43 @@ private:
     /**@name Private Operators*/
     /*@{ */
 
+    /// the state (2 bits: 2 root, 1 undecided, 0 not a root), priority (30 bits) and index (32 bits) of a node
+    /// in the search of the independent set, packed so that they are compared lexicographically as one integer
+    static std::uint64_t AggregationKey(const std::uint64_t State, const std::size_t i)
+    {
+        // pseudo-random priority, so that the roots are spread uniformly
+        std::uint32_t h = static_cast<std::uint32_t>(i);
+        h ^= h >> 16;
+        h *= 0x7feb352dU;
+        h ^= h >> 15;
+        h *= 0x846ca68bU;
+        h ^= h >> 16;
+        return (State << 62) | (static_cast<std::uint64_t>(h & 0x3fffffffU) << 32) | static_cast<std::uint64_t>(i);
+    }
+
+    static std::uint64_t AggregationState(const std::uint64_t Key)
+    {
+        return Key >> 62;
+    }
+
+    /// rOut[i] = maximum of rIn over i and its neighbours, only for the undecided nodes if OnlyUndecided
+    static void MaxOverNeighbours(const std::size_t n_row, const std::size_t Ap[], const std::size_t Aj[],
+                                  const std::vector<std::uint64_t>& rKeys, const std::vector<std::uint64_t>& rIn,
+                                  std::vector<std::uint64_t>& rOut, const bool OnlyUndecided)
+    {
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n_row); i++)
+        {
+            if(OnlyUndecided && AggregationState(rKeys[i]) != 1)
+                continue;
+
+            std::uint64_t m = rIn[i];
+            for(std::size_t jj = Ap[i]; jj < Ap[i+1]; jj++)
+                m = std::max(m, rIn[Aj[jj]]);
+            rOut[i] = m;
+        }
+    }
+
     /*
     * Compute aggregates for a matrix A stored in CSR format
     *
@@ -482,131 +560,148 @@ private:
     *
     * Notes:
     *    It is assumed that A is structurally symmetric.
-    *    A may contain diagonal entries (self loops)
-    *    Unaggregated nodes are marked with a -1
+    *    The roots of the aggregates are a distance-2 maximal independent set, computed with the
+    *    parallel algorithm of Bell, Dalton and Olson (the same as pyamg). Each aggregate is a root
+    *    with its neighbours, the remaining nodes join the aggregate of one of their neighbours.
+    *    All the passes read and write different arrays, so the result does not depend on the number of threads.
     *
     */
-    template <class I>
-    static I standard_aggregation(const I n_row,
-                                  const std::size_t Ap[],
-                                  const std::size_t Aj[],
-                                  I  x[])
+    static std::size_t ParallelAggregation(const std::size_t n_row,
+                                           const std::size_t Ap[],
+                                           const std::size_t Aj[],
+                                           std::vector<int>& x)
     {
-        // Bj[n] == -1 means i-th node has not been aggregated
-        std::fill(x, x + n_row, 0);
+        if(n_row >= (static_cast<std::size_t>(1) << 32))
+            KRATOS_THROW_ERROR(std::logic_error, "the matrix is too large for the aggregation", n_row)
+
+        std::vector<std::uint64_t> t(n_row), m1(n_row), m2(n_row);
 
-        I next_aggregate = 1; // number of aggregates + 1
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n_row); i++)
+            t[i] = AggregationKey(1, i);
 
-        //Pass #1
-        for(I i = 0; i < n_row; i++)
+        //distance-2 maximal independent set
+        int number_of_undecided;
+        do
         {
-            if(x[i])
+            MaxOverNeighbours(n_row, Ap, Aj, t, t, m1, false);
+            MaxOverNeighbours(n_row, Ap, Aj, t, m1, m2, true);
+
+            number_of_undecided = 0;
+            #pragma omp parallel for reduction(+:number_of_undecided)
+            for(int i = 0; i < static_cast<int>(n_row); i++)
             {
-                continue;    //already marked
+                if(AggregationState(t[i]) != 1)
+                    continue;
+
+                if(m2[i] == t[i])
+                    t[i] = AggregationKey(2, i);
+                else if(AggregationState(m2[i]) == 2)
+                    t[i] = AggregationKey(0, i);
+                else
+                    number_of_undecided++;
             }
+        }
+        while(number_of_undecided > 0);
 
-            const I row_start = Ap[i];
-            const I row_end   = Ap[i+1];
+        //number the aggregates in the order of their roots
+        int next_aggregate = 0;
+        x.resize(n_row);
+        for(std::size_t i = 0; i < n_row; i++)
+            x[i] = (AggregationState(t[i]) == 2) ? next_aggregate++ : -1;
 
-            //Determine whether all neighbors of this node are free (not already aggregates)
-            bool has_aggregated_neighbors = false;
-            bool has_neighbors            = false;
-            for(I jj = row_start; jj < row_end; jj++)
-            {
-                const I j = Aj[jj];
-                if( i != j )
-                {
-                    has_neighbors = true;
-                    if( x[j] )
-                    {
-                        has_aggregated_neighbors = true;
-                        break;
-                    }
-                }
-            }
+        //Pass #1: the neighbours of a root. Since the roots are distance-2 independent, there is only one
+        std::vector<int> y(x);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n_row); i++)
+        {
+            if(x[i] >= 0)
+                continue;
 
-            if(!has_neighbors)
+            for(std::size_t jj = Ap[i]; jj < Ap[i+1]; jj++)
             {
-                //isolated node, do not aggregate
-                x[i] = -n_row;
-            }
-            else if (!has_aggregated_neighbors)
-            {
-                //Make an aggregate out of this node and its neighbors
-                x[i] = next_aggregate;
-                for(I jj = row_start; jj < row_end; jj++)
+                if(AggregationState(t[Aj[jj]]) == 2)
                 {
-                    x[Aj[jj]] = next_aggregate;
+                    y[i] = x[Aj[jj]];
+                    break;
                 }
-                next_aggregate++;
             }
         }
 
-        //Pass #2
-        // Add unaggregated nodes to any neighboring aggregate
-        for(I i = 0; i < n_row; i++)
+        //Pass #2: the nodes at distance 2 of a root join the aggregate of a neighbour marked in pass #1
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n_row); i++)
         {
-            if(x[i])
-            {
-                continue;    //already marked
-            }
+            x[i] = y[i];
+            if(y[i] >= 0)
+                continue;
 
-            for(I jj = static_cast<I>(Ap[i]); jj < static_cast<I>(Ap[i+1]); jj++)
+            for(std::size_t jj = Ap[i]; jj < Ap[i+1]; jj++)
             {
-                const I j = Aj[jj];
-
-                const I xj = x[j];
-                if(xj > 0)
+                if(y[Aj[jj]] >= 0)
                 {
-                    x[i] = -xj;
+                    x[i] = y[Aj[jj]];
                     break;
                 }
             }
         }
 
-        next_aggregate--;
-
-        //Pass #3
-        for(I i = 0; i < n_row; i++)
+        //Pass #3: only for a structurally unsymmetric matrix, a node may remain alone
+        for(std::size_t i = 0; i < n_row; i++)
         {
-            const I xi = x[i];
+            if(x[i] < 0)
+                x[i] = next_aggregate++;
+        }
 
-            if(xi != 0)
-            {
-                // node i has been aggregated
-                if(xi > 0)
-                    x[i] = xi - 1;
-                else if(xi == -n_row)
-                    x[i] = -1;
-                else
-                    x[i] = -xi - 1;
-                continue;
-            }
+        return next_aggregate; //number of aggregates
+    }
 
-            // node i has not been aggregated
-            const I row_start = Ap[i];
-            const I row_end   = Ap[i+1];
+    ///build the structure of Wt*rA*W, with zero values
+    static void ConstructDeflatedMatrixStructure(const SparseMatrixType& rA, const std::vector<int>& w,
+                                                 const std::vector<std::size_t>& wt_index1, const std::vector<int>& wt_index2,
+                                                 SparseMatrixType& deflatedA)
+    {
+        const std::size_t reduced_size = wt_index1.size() - 1;
+        const std::size_t* a_index1 = &rA.index1_data()[0];
+        const std::size_t* a_index2 = &rA.index2_data()[0];
 
-            x[i] = next_aggregate;
+        std::vector<std::vector<std::size_t> > columns(reduced_size);
 
-            for(I jj = row_start; jj < row_end; jj++)
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(int I=0; I<static_cast<int>(reduced_size); I++)
+        {
+            std::vector<std::size_t>& r_columns = columns[I];
+            for(std::size_t k=wt_index1[I]; k<wt_index1[I+1]; k++)
             {
-                const I j = Aj[jj];
-
-                if(x[j] == 0)  //unmarked neighbors
-                {
-                    x[j] = next_aggregate;
-                }
+                const int i = wt_index2[k];
+                for(std::size_t jj=a_index1[i]; jj<a_index1[i+1]; jj++)
+                    r_columns.push_back(w[a_index2[jj]]);
             }
-            next_aggregate++;
+            std::sort(r_columns.begin(), r_columns.end());
+            r_columns.erase(std::unique(r_columns.begin(), r_columns.end()), r_columns.end());
         }
 
+        std::vector<std::size_t> row_start(reduced_size+1, 0);
+        for(std::size_t I=0; I<reduced_size; I++)
+            row_start[I+1] = row_start[I] + columns[I].size();
+        const std::size_t NZ = row_start[reduced_size];
 
-        return next_aggregate; //number of aggregates
-    }
-
+        deflatedA = SparseMatrixType(reduced_size, reduced_size, NZ);
+        std::size_t* index1 = &deflatedA.index1_data()[0];
+        std::size_t* index2 = &deflatedA.index2_data()[0];
+        DataType* values = &deflatedA.value_data()[0];
 
+        #pragma omp parallel for
+        for(int I=0; I<static_cast<int>(reduced_size); I++)
+        {
+            index1[I+1] = row_start[I+1];
+            std::copy(columns[I].begin(), columns[I].end(), index2 + row_start[I]);
+            std::fill(values + row_start[I], values + row_start[I+1], DataType());
+        }
+        index1[0] = 0;
 
+        deflatedA.set_filled(reduced_size+1, NZ);
+    }
 
     static void ConstructScalarMatrix(const std::size_t n_row, const std::size_t block_size,
                                       const std::size_t Ap[],
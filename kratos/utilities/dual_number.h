@@ -0,0 +1,402 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_DUAL_NUMBER_H_INCLUDED)
+#define KRATOS_DUAL_NUMBER_H_INCLUDED
+
+// System includes
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+// External includes
+
+// Project includes
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class Dual
+ * @ingroup KratosCore
+ * @brief Forward mode automatic differentiation number with TSize directions
+ * @details The value and the derivatives with respect to TSize independent variables are stored
+ * contiguously, so that the operations are fixed-length loops over the derivatives. The interface
+ * val()/dx()/diff() is the one used by AD_Helper. Nesting, e.g. Dual<Dual<double, N>, N>, gives
+ * second derivatives (see AD_Helper_GetValue2).
+ */
+template<typename TDataType, std::size_t TSize>
+class Dual
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef TDataType value_type;
+
+    static constexpr std::size_t Size = TSize;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    constexpr Dual() : mValue(), mDerivatives() {}
+
+    /// A constant, all the derivatives are zero
+    constexpr Dual(const TDataType& rValue) : mValue(rValue), mDerivatives() {}
+
+    /// The independent variable Index, its derivative is 1
+    Dual(const TDataType& rValue, const std::size_t Index) : mValue(rValue), mDerivatives()
+    {
+        mDerivatives[Index] = TDataType(1);
+    }
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    Dual& operator=(const TDataType& rValue)
+    {
+        mValue = rValue;
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] = TDataType();
+        return *this;
+    }
+
+    Dual& operator+=(const Dual& rOther)
+    {
+        mValue += rOther.mValue;
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] += rOther.mDerivatives[i];
+        return *this;
+    }
+
+    Dual& operator+=(const TDataType& rValue)
+    {
+        mValue += rValue;
+        return *this;
+    }
+
+    Dual& operator-=(const Dual& rOther)
+    {
+        mValue -= rOther.mValue;
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] -= rOther.mDerivatives[i];
+        return *this;
+    }
+
+    Dual& operator-=(const TDataType& rValue)
+    {
+        mValue -= rValue;
+        return *this;
+    }
+
+    Dual& operator*=(const Dual& rOther)
+    {
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] = mDerivatives[i] * rOther.mValue + mValue * rOther.mDerivatives[i];
+        mValue *= rOther.mValue;
+        return *this;
+    }
+
+    Dual& operator*=(const TDataType& rValue)
+    {
+        mValue *= rValue;
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] *= rValue;
+        return *this;
+    }
+
+    Dual& operator/=(const Dual& rOther)
+    {
+        const TDataType inverse = TDataType(1) / rOther.mValue;
+        mValue *= inverse;
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] = (mDerivatives[i] - mValue * rOther.mDerivatives[i]) * inverse;
+        return *this;
+    }
+
+    Dual& operator/=(const TDataType& rValue)
+    {
+        return (*this) *= TDataType(1) / rValue;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    /// The value
+    const TDataType& val() const {return mValue;}
+    TDataType& val() {return mValue;}
+
+    /// The derivative with respect to the independent variable Index
+    const TDataType& dx(const std::size_t Index) const {return mDerivatives[Index];}
+    TDataType& dx(const std::size_t Index) {return mDerivatives[Index];}
+
+    /// Make this the independent variable Index of NumberOfDirections, which must not be greater than TSize
+    void diff(const std::size_t Index, const std::size_t NumberOfDirections)
+    {
+        for (std::size_t i = 0; i < TSize; ++i)
+            mDerivatives[i] = TDataType();
+        mDerivatives[Index] = TDataType(1);
+    }
+
+    ///@}
+    ///@name Friends
+    ///@{
+
+    friend Dual operator+(const Dual& a) {return a;}
+    friend Dual operator-(const Dual& a) {return Dual() - a;}
+
+    friend Dual operator+(Dual a, const Dual& b) {return a += b;}
+    friend Dual operator+(Dual a, const TDataType& b) {return a += b;}
+    friend Dual operator+(const TDataType& a, Dual b) {return b += a;}
+
+    friend Dual operator-(Dual a, const Dual& b) {return a -= b;}
+    friend Dual operator-(Dual a, const TDataType& b) {return a -= b;}
+    friend Dual operator-(const TDataType& a, const Dual& b)
+    {
+        Dual c(a);
+        return c -= b;
+    }
+
+    friend Dual operator*(Dual a, const Dual& b) {return a *= b;}
+    friend Dual operator*(Dual a, const TDataType& b) {return a *= b;}
+    friend Dual operator*(const TDataType& a, Dual b) {return b *= a;}
+
+    friend Dual operator/(Dual a, const Dual& b) {return a /= b;}
+    friend Dual operator/(Dual a, const TDataType& b) {return a /= b;}
+    friend Dual operator/(const TDataType& a, const Dual& b)
+    {
+        Dual c(a);
+        return c /= b;
+    }
+
+    /// The comparisons are on the values
+    friend bool operator==(const Dual& a, const Dual& b) {return a.mValue == b.mValue;}
+    friend bool operator==(const Dual& a, const TDataType& b) {return a.mValue == b;}
+    friend bool operator==(const TDataType& a, const Dual& b) {return a == b.mValue;}
+    friend bool operator!=(const Dual& a, const Dual& b) {return a.mValue != b.mValue;}
+    friend bool operator!=(const Dual& a, const TDataType& b) {return a.mValue != b;}
+    friend bool operator!=(const TDataType& a, const Dual& b) {return a != b.mValue;}
+    friend bool operator<(const Dual& a, const Dual& b) {return a.mValue < b.mValue;}
+    friend bool operator<(const Dual& a, const TDataType& b) {return a.mValue < b;}
+    friend bool operator<(const TDataType& a, const Dual& b) {return a < b.mValue;}
+    friend bool operator<=(const Dual& a, const Dual& b) {return a.mValue <= b.mValue;}
+    friend bool operator<=(const Dual& a, const TDataType& b) {return a.mValue <= b;}
+    friend bool operator<=(const TDataType& a, const Dual& b) {return a <= b.mValue;}
+    friend bool operator>(const Dual& a, const Dual& b) {return a.mValue > b.mValue;}
+    friend bool operator>(const Dual& a, const TDataType& b) {return a.mValue > b;}
+    friend bool operator>(const TDataType& a, const Dual& b) {return a > b.mValue;}
+    friend bool operator>=(const Dual& a, const Dual& b) {return a.mValue >= b.mValue;}
+    friend bool operator>=(const Dual& a, const TDataType& b) {return a.mValue >= b;}
+    friend bool operator>=(const TDataType& a, const Dual& b) {return a >= b.mValue;}
+
+    /// The math functions are found by argument dependent lookup, i.e. call them unqualified after using std::sqrt etc.
+    friend Dual sqrt(const Dual& a)
+    {
+        using std::sqrt;
+        const TDataType value = sqrt(a.mValue);
+        return Chain(a, value, TDataType(0.5) / value);
+    }
+
+    friend Dual cbrt(const Dual& a)
+    {
+        using std::cbrt;
+        const TDataType value = cbrt(a.mValue);
+        return Chain(a, value, TDataType(1) / (TDataType(3) * value * value));
+    }
+
+    friend Dual exp(const Dual& a)
+    {
+        using std::exp;
+        const TDataType value = exp(a.mValue);
+        return Chain(a, value, value);
+    }
+
+    friend Dual log(const Dual& a)
+    {
+        using std::log;
+        return Chain(a, log(a.mValue), TDataType(1) / a.mValue);
+    }
+
+    friend Dual log10(const Dual& a)
+    {
+        using std::log;
+        return Chain(a, log(a.mValue) / log(TDataType(10)), TDataType(1) / (a.mValue * log(TDataType(10))));
+    }
+
+    /// The derivative b*a^(b-1) is taken as 0 for b = 0 and as its limit at a = 0 for b >= 1
+    friend Dual pow(const Dual& a, const TDataType& b)
+    {
+        using std::pow;
+        TDataType derivative;
+        if (b == TDataType(0))
+            derivative = TDataType(0);
+        else if (a.mValue == TDataType(0) && b >= TDataType(1))
+            derivative = (b == TDataType(1)) ? TDataType(1) : TDataType(0);
+        else
+            derivative = b * pow(a.mValue, b - TDataType(1));
+        return Chain(a, pow(a.mValue, b), derivative);
+    }
+
+    friend Dual pow(const Dual& a, const int b)
+    {
+        return pow(a, TDataType(b));
+    }
+
+    friend Dual pow(const TDataType& a, const Dual& b)
+    {
+        using std::pow;
+        using std::log;
+        const TDataType value = pow(a, b.mValue);
+        return Chain(b, value, value * log(a));
+    }
+
+    friend Dual pow(const Dual& a, const Dual& b)
+    {
+        return exp(b * log(a));
+    }
+
+    friend Dual sin(const Dual& a)
+    {
+        using std::sin;
+        using std::cos;
+        return Chain(a, sin(a.mValue), cos(a.mValue));
+    }
+
+    friend Dual cos(const Dual& a)
+    {
+        using std::sin;
+        using std::cos;
+        return Chain(a, cos(a.mValue), -sin(a.mValue));
+    }
+
+    friend Dual tan(const Dual& a)
+    {
+        using std::tan;
+        const TDataType value = tan(a.mValue);
+        return Chain(a, value, TDataType(1) + value * value);
+    }
+
+    friend Dual asin(const Dual& a)
+    {
+        using std::asin;
+        using std::sqrt;
+        return Chain(a, asin(a.mValue), TDataType(1) / sqrt(TDataType(1) - a.mValue * a.mValue));
+    }
+
+    friend Dual acos(const Dual& a)
+    {
+        using std::acos;
+        using std::sqrt;
+        return Chain(a, acos(a.mValue), TDataType(-1) / sqrt(TDataType(1) - a.mValue * a.mValue));
+    }
+
+    friend Dual atan(const Dual& a)
+    {
+        using std::atan;
+        return Chain(a, atan(a.mValue), TDataType(1) / (TDataType(1) + a.mValue * a.mValue));
+    }
+
+    friend Dual atan2(const Dual& a, const Dual& b)
+    {
+        using std::atan2;
+        const TDataType inverse = TDataType(1) / (a.mValue * a.mValue + b.mValue * b.mValue);
+        Dual c(atan2(a.mValue, b.mValue));
+        for (std::size_t i = 0; i < TSize; ++i)
+            c.mDerivatives[i] = (b.mValue * a.mDerivatives[i] - a.mValue * b.mDerivatives[i]) * inverse;
+        return c;
+    }
+
+    friend Dual sinh(const Dual& a)
+    {
+        using std::sinh;
+        using std::cosh;
+        return Chain(a, sinh(a.mValue), cosh(a.mValue));
+    }
+
+    friend Dual cosh(const Dual& a)
+    {
+        using std::sinh;
+        using std::cosh;
+        return Chain(a, cosh(a.mValue), sinh(a.mValue));
+    }
+
+    friend Dual tanh(const Dual& a)
+    {
+        using std::tanh;
+        const TDataType value = tanh(a.mValue);
+        return Chain(a, value, TDataType(1) - value * value);
+    }
+
+    /// The derivative at 0 is taken as 0
+    friend Dual abs(const Dual& a)
+    {
+        if (a.mValue < TDataType(0))
+            return -a;
+        else if (a.mValue > TDataType(0))
+            return a;
+        else
+            return Dual(a.mValue);
+    }
+
+    friend Dual fabs(const Dual& a)
+    {
+        return abs(a);
+    }
+
+    friend std::ostream& operator<<(std::ostream& rOStream, const Dual& a)
+    {
+        rOStream << a.mValue << " [";
+        for (std::size_t i = 0; i < TSize; ++i)
+            rOStream << " " << a.mDerivatives[i];
+        rOStream << " ]";
+        return rOStream;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    TDataType mValue;
+
+    TDataType mDerivatives[TSize];
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// f(a), with the value f and the derivative df/da
+    static Dual Chain(const Dual& a, const TDataType& rValue, const TDataType& rDerivative)
+    {
+        Dual c(rValue);
+        for (std::size_t i = 0; i < TSize; ++i)
+            c.mDerivatives[i] = rDerivative * a.mDerivatives[i];
+        return c;
+    }
+
+    ///@}
+}; // Class Dual
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_DUAL_NUMBER_H_INCLUDED  defined
@@ -20,6 +20,7 @@
 // System includes
 #include <cmath>
 #include <type_traits>
+#include <utility>
 
 // External includes
 
@@ -134,16 +135,18 @@ public:
     template<bool TCheck>// = false>
     static inline TDataType Heron(const TDataType a, const TDataType b, const TDataType c)
     {
+        using std::sqrt;
+        using std::abs;
         const TDataType s = 0.5 * (a + b + c);
         const TDataType A2 = s * (s - a) * (s - b) * (s - c);
         if constexpr(TCheck) {
             if(A2 < 0.0) {
                 KRATOS_ERROR << "The square of area is negative, probably the triangle is in bad shape:" << A2 << std::endl;
             } else {
-                return std::sqrt(A2);
+                return sqrt(A2);
             }
         } else {
-            return std::sqrt(std::abs(A2));
+            return sqrt(abs(A2));
         }
     }
 
@@ -294,6 +297,7 @@ public:
         const TDataType Tolerance = GetZeroTolerance()
         )
     {
+        using std::sqrt;
         const SizeType size_1 = rInputMatrix.size1();
         const SizeType size_2 = rInputMatrix.size2();
 
@@ -306,7 +310,7 @@ public:
             const TMatrix1 aux = prod(rInputMatrix, trans(rInputMatrix));
             TMatrix1 auxInv;
             InvertMatrix(aux, auxInv, rInputMatrixDet, Tolerance);
-            rInputMatrixDet = std::sqrt(rInputMatrixDet);
+            rInputMatrixDet = sqrt(rInputMatrixDet);
             noalias(rInvertedMatrix) = prod(trans(rInputMatrix), auxInv);
         } else { // Left inverse
             if (rInvertedMatrix.size1() != size_2 || rInvertedMatrix.size2() != size_1) {
@@ -315,7 +319,7 @@ public:
             const TMatrix1 aux = prod(trans(rInputMatrix), rInputMatrix);
             TMatrix1 auxInv;
             InvertMatrix(aux, auxInv, rInputMatrixDet, Tolerance);
-            rInputMatrixDet = std::sqrt(rInputMatrixDet);
+            rInputMatrixDet = sqrt(rInputMatrixDet);
             noalias(rInvertedMatrix) = prod(auxInv, trans(rInputMatrix));
         }
     }
@@ -639,14 +643,15 @@ public:
     template<class TMatrixType>
     static inline TDataType GeneralizedDet(const TMatrixType& rA)
     {
+        using std::sqrt;
         if (rA.size1() == rA.size2()) {
             return Det(rA);
         } else if (rA.size1() < rA.size2()) { // Right determinant
             const TMatrixType AAT = prod( rA, trans(rA) );
-            return std::sqrt(Det(AAT));
+            return sqrt(Det(AAT));
         } else { // Left determinant
             const TMatrixType ATA = prod( trans(rA), rA );
-            return std::sqrt(Det(ATA));
+            return sqrt(Det(ATA));
         }
     }
 
@@ -695,8 +700,10 @@ public:
     template<class TVectorType>
     static inline TDataType Norm3(const TVectorType& a)
     {
-        TDataType temp = std::pow(a[0],2) + std::pow(a[1],2) + std::pow(a[2],2);
-        temp = std::sqrt(temp);
+        using std::pow;
+        using std::sqrt;
+        TDataType temp = pow(a[0],2) + pow(a[1],2) + pow(a[2],2);
+        temp = sqrt(temp);
         return temp;
     }
 
@@ -708,13 +715,14 @@ public:
     template<class TVectorType>
     static inline TDataType Norm(const TVectorType& a)
     {
+        using std::sqrt;
         typename TVectorType::const_iterator i = a.begin();
         TDataType temp = 0.0;
         while(i != a.end()) {
             temp += (*i) * (*i);
             i++;
         }
-        return std::sqrt(temp);
+        return sqrt(temp);
     }
 
     /**
@@ -726,6 +734,8 @@ public:
     template<class TVectorType>
     static inline TDataType StableNorm(const TVectorType& a)
     {
+        using std::sqrt;
+        using std::abs;
         if (a.size() == 0) {
             return 0;
         }
@@ -742,7 +752,7 @@ public:
             TDataType x = *it;
 
             if (x != 0) {
-                const TDataType abs_x = std::abs(x);
+                const TDataType abs_x = abs(x);
 
                 if (scale < abs_x) {
                     const TDataType f = scale / abs_x;
@@ -755,7 +765,7 @@ public:
             }
         }
 
-        return scale * std::sqrt(sqr_sum_scaled);
+        return scale * sqrt(sqr_sum_scaled);
     }
 
     /**
@@ -1557,6 +1567,16 @@ public:
 
         // Manual multiplication
         rA.clear();
+
+        // The sizes of the common elements are done by the fixed size kernels
+        if (rD.size1() == rD.size2() && rD.size1() == rB.size1()
+            && AddFixedSizeBtDBProducts(rB.size1(), rB.size2(), rA, 1,
+                [&rD](IndexType) -> const TMatrixType2& { return rD; },
+                [&rB](IndexType) -> const TMatrixType3& { return rB; },
+                [](IndexType) { return TDataType(1); }, IsSymmetric(rD))) {
+            return;
+        }
+
         for(IndexType k = 0; k< rD.size1(); ++k) {
             for(IndexType l = 0; l < rD.size2(); ++l) {
                 const TDataType Dkl = rD(k, l);
@@ -1598,6 +1618,16 @@ public:
 
         // Manual multiplication
         rA.clear();
+
+        // The sizes of the common elements are done by the fixed size kernels, on B'
+        if (rD.size1() == rD.size2() && rD.size1() == rB.size2()
+            && AddFixedSizeBtDBProducts(rB.size2(), rB.size1(), rA, 1,
+                [&rD](IndexType) -> const TMatrixType2& { return rD; },
+                [&rB](IndexType) { return trans(rB); },
+                [](IndexType) { return TDataType(1); }, IsSymmetric(rD))) {
+            return;
+        }
+
         for(IndexType k = 0; k< rD.size1(); ++k) {
             for(IndexType l = 0; l < rD.size2(); ++l) {
                 const TDataType Dkl = rD(k,l);
@@ -1611,6 +1641,120 @@ public:
         }
     }
 
+    /**
+     * @brief Calculates rA += sum_g w_g B_g'D_g B_g over the integration points g
+     * @details The strain sizes and numbers of dofs of the common elements (3x6, 3x8, 6x12, 6x24, 6x30, 6x60 and 6x81)
+     * are done by fixed size kernels. When all D_g are symmetric only the upper triangle is computed. rA is resized
+     * and zeroed if its size is not the number of dofs.
+     * @param rA The resulting matrix
+     * @param rD The "center" matrices of the integration points
+     * @param rB The matrices to be transposed of the integration points
+     * @param rWeights The weights of the integration points
+     * @tparam TMatrixType1 The type of matrix considered (1)
+     * @tparam TMatricesType2 The type of the container of the matrices considered (2)
+     * @tparam TMatricesType3 The type of the container of the matrices considered (3)
+     * @tparam TVectorType The type of the weights
+     */
+    template<class TMatrixType1, class TMatricesType2, class TMatricesType3, class TVectorType>
+    static inline void AddBtDBProducts(
+        TMatrixType1& rA,
+        const TMatricesType2& rD,
+        const TMatricesType3& rB,
+        const TVectorType& rWeights
+        )
+    {
+        const SizeType number_of_points = rB.size();
+        if (number_of_points == 0)
+            return;
+
+        // The sizes
+        const SizeType strain_size = rB[0].size1();
+        const SizeType size = rB[0].size2();
+
+        if (rA.size1() != size || rA.size2() != size) {
+            rA.resize(size, size, false);
+            rA.clear();
+        }
+
+        bool symmetric = true;
+        for(IndexType g = 0; g < number_of_points; ++g)
+            symmetric = symmetric && IsSymmetric(rD[g]);
+
+        if (AddFixedSizeBtDBProducts(strain_size, size, rA, number_of_points,
+                [&rD](IndexType g) -> decltype(rD[g]) { return rD[g]; },
+                [&rB](IndexType g) -> decltype(rB[g]) { return rB[g]; },
+                [&rWeights](IndexType g) { return TDataType(rWeights[g]); }, symmetric)) {
+            return;
+        }
+
+        for(IndexType g = 0; g < number_of_points; ++g) {
+            for(IndexType k = 0; k < strain_size; ++k) {
+                for(IndexType l = 0; l < strain_size; ++l) {
+                    const TDataType wDkl = rWeights[g] * rD[g](k, l);
+                    for(IndexType j = 0; j < size; ++j) {
+                        const TDataType wDklBlj = wDkl * rB[g](l, j);
+                        for(IndexType i = 0; i < size; ++i) {
+                            rA(i, j) += rB[g](k, i) * wDklBlj;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Calculates rA += sum_g w_g N_g N_g' over the integration points g, e.g. the consistent mass matrix
+     * @details Only the upper triangle is computed. The numbers of nodes 3, 4, 6, 8, 9, 10, 20 and 27 are done by
+     * fixed size kernels. rA is resized and zeroed if its size is not the number of nodes.
+     * @param rA The resulting matrix
+     * @param rN The shape function values of the integration points, e.g. the rows of the matrix of the geometry
+     * @param rWeights The weights of the integration points
+     * @tparam TMatrixType1 The type of matrix considered (1)
+     * @tparam TMatrixType2 The type of the shape function values
+     * @tparam TVectorType The type of the weights
+     */
+    template<class TMatrixType1, class TMatrixType2, class TVectorType>
+    static inline void AddNtNProducts(
+        TMatrixType1& rA,
+        const TMatrixType2& rN,
+        const TVectorType& rWeights
+        )
+    {
+        const SizeType number_of_points = rN.size1();
+        const SizeType size = rN.size2();
+
+        if (rA.size1() != size || rA.size2() != size) {
+            rA.resize(size, size, false);
+            rA.clear();
+        }
+
+        switch (size) {
+            case 3: AddFixedSizeNtNProducts<3>(rA, rN, rWeights); return;
+            case 4: AddFixedSizeNtNProducts<4>(rA, rN, rWeights); return;
+            case 6: AddFixedSizeNtNProducts<6>(rA, rN, rWeights); return;
+            case 8: AddFixedSizeNtNProducts<8>(rA, rN, rWeights); return;
+            case 9: AddFixedSizeNtNProducts<9>(rA, rN, rWeights); return;
+            case 10: AddFixedSizeNtNProducts<10>(rA, rN, rWeights); return;
+            case 20: AddFixedSizeNtNProducts<20>(rA, rN, rWeights); return;
+            case 27: AddFixedSizeNtNProducts<27>(rA, rN, rWeights); return;
+            default: break;
+        }
+
+        for(IndexType g = 0; g < number_of_points; ++g) {
+            for(IndexType i = 0; i < size; ++i) {
+                const TDataType wNi = rWeights[g] * rN(g, i);
+                for(IndexType j = i; j < size; ++j) {
+                    rA(i, j) += wNi * rN(g, j);
+                }
+            }
+        }
+        for(IndexType i = 0; i < size; ++i) {
+            for(IndexType j = 0; j < i; ++j) {
+                rA(i, j) = rA(j, i);
+            }
+        }
+    }
+
     /**
      * @brief Calculates the eigenvectors and eigenvalues of given symmetric matrix
      * @details The eigenvectors and eigenvalues are calculated using the iterative Gauss-Seidel-method. The resulting decomposition is LDL'
@@ -1770,6 +1914,203 @@ public:
         return is_converged;
     }
 
+    /**
+     * @brief Calculates the eigenvectors and eigenvalues of given symmetric 2x2 matrix in closed form
+     * @details The decomposition A = V D V' of GaussSeidelEigenSystem, without iterations. The eigenvalues are sorted
+     * in descending order and the eigenvectors are orthonormal, also for repeated eigenvalues. See SymmetricEigenSystems2
+     * @param rA The given symmetric matrix, only the upper triangle is used
+     * @param rEigenVectorsMatrix The result matrix (will be overwritten with the eigenvectors as columns)
+     * @param rEigenValuesMatrix The result diagonal matrix with the eigenvalues
+     * @tparam TMatrixType1 The type of matrix considered (1)
+     * @tparam TMatrixType2 The type of matrix considered (2)
+     */
+    template<class TMatrixType1, class TMatrixType2>
+    static inline void SymmetricEigenSystem2(
+        const TMatrixType1& rA,
+        TMatrixType2& rEigenVectorsMatrix,
+        TMatrixType2& rEigenValuesMatrix
+        )
+    {
+        const TDataType tensor[3] = {rA(0, 0), rA(1, 1), rA(0, 1)};
+        TDataType eigen_values[2], eigen_vectors[4];
+        SymmetricEigenSystems2(1, tensor, eigen_values, eigen_vectors);
+        CopyEigenSystem<2>(eigen_values, eigen_vectors, rEigenVectorsMatrix, rEigenValuesMatrix);
+    }
+
+    /**
+     * @brief Calculates the eigenvectors and eigenvalues of given symmetric 3x3 matrix in closed form
+     * @details The decomposition A = V D V' of GaussSeidelEigenSystem, without iterations. The eigenvalues are sorted
+     * in descending order, e.g. the principal stresses s1 >= s2 >= s3, and the eigenvectors are orthonormal, also for
+     * repeated eigenvalues. See SymmetricEigenSystems3
+     * @param rA The given symmetric matrix, only the upper triangle is used
+     * @param rEigenVectorsMatrix The result matrix (will be overwritten with the eigenvectors as columns)
+     * @param rEigenValuesMatrix The result diagonal matrix with the eigenvalues
+     * @tparam TMatrixType1 The type of matrix considered (1)
+     * @tparam TMatrixType2 The type of matrix considered (2)
+     */
+    template<class TMatrixType1, class TMatrixType2>
+    static inline void SymmetricEigenSystem3(
+        const TMatrixType1& rA,
+        TMatrixType2& rEigenVectorsMatrix,
+        TMatrixType2& rEigenValuesMatrix
+        )
+    {
+        const TDataType tensor[6] = {rA(0, 0), rA(1, 1), rA(2, 2), rA(0, 1), rA(1, 2), rA(0, 2)};
+        TDataType eigen_values[3], eigen_vectors[9];
+        SymmetricEigenSystems3(1, tensor, eigen_values, eigen_vectors);
+        CopyEigenSystem<3>(eigen_values, eigen_vectors, rEigenVectorsMatrix, rEigenValuesMatrix);
+    }
+
+    /**
+     * @brief Calculates the eigenvalues, and optionally the eigenvectors, of an array of symmetric 2x2 tensors
+     * @details The eigenvalues are the center plus and minus the radius of Mohr's circle, the first eigenvector is the
+     * null vector of the row of A - l0 I with the larger norm. The loop over the tensors has no branches and vectorizes
+     * @param NumberOfTensors The number of tensors
+     * @param pTensors The tensors one after another, 3 components each in the order of the 2D stress vector: xx, yy, xy
+     * @param pEigenValues The eigenvalues, 2 per tensor in descending order
+     * @param pEigenVectors The eigenvectors, 4 per tensor row by row with the eigenvectors as columns, nullptr for only the eigenvalues
+     */
+    static inline void SymmetricEigenSystems2(
+        const SizeType NumberOfTensors,
+        const TDataType* pTensors,
+        TDataType* pEigenValues,
+        TDataType* pEigenVectors = nullptr
+        )
+    {
+        using std::abs;
+        using std::sqrt;
+
+        for(IndexType t = 0; t < NumberOfTensors; ++t) {
+            const TDataType* a = pTensors + 3 * t;
+            const TDataType center = 0.5 * (a[0] + a[1]);
+
+            // the radius from the components scaled by the largest one, so that the squares do not overflow
+            const TDataType abs_half_difference = abs(0.5 * (a[0] - a[1]));
+            const TDataType abs_a01 = abs(a[2]);
+            const TDataType scale = (abs_half_difference > abs_a01) ? abs_half_difference : abs_a01;
+            const TDataType inverse_scale = 1.0 / ((scale > 0.0) ? scale : TDataType(1.0));
+            const TDataType half_difference = 0.5 * (a[0] - a[1]) * inverse_scale;
+            const TDataType a01 = a[2] * inverse_scale;
+            const TDataType radius = sqrt(half_difference * half_difference + a01 * a01);
+
+            pEigenValues[2 * t] = center + scale * radius;
+            pEigenValues[2 * t + 1] = center - scale * radius;
+
+            if (pEigenVectors != nullptr) {
+                const bool first_row = half_difference < 0.0;
+                const TDataType x = first_row ? a01 : half_difference + radius;
+                const TDataType y = first_row ? radius - half_difference : a01;
+                const TDataType norm = sqrt(x * x + y * y);
+                const TDataType inverse_norm = 1.0 / ((norm > 0.0) ? norm : TDataType(1.0));
+                const TDataType c = (norm > 0.0) ? x * inverse_norm : TDataType(1.0);
+                const TDataType s = y * inverse_norm;
+
+                TDataType* v = pEigenVectors + 4 * t;
+                v[0] = c; v[1] = -s;
+                v[2] = s; v[3] = c;
+            }
+        }
+    }
+
+    /**
+     * @brief Calculates the eigenvalues, and optionally the eigenvectors, of an array of symmetric 3x3 tensors
+     * @details The eigenvalues are the trigonometric solution of the characteristic equation of the deviator, scaled by
+     * the largest component against overflow. For two close eigenvalues it loses about half of the digits of their
+     * difference. With the eigenvectors the eigenvalues are refined: the eigenvector of the best separated eigenvalue
+     * is the largest cross product of two rows of A - l I (D. Eberly, A robust eigensolver for 3x3 symmetric matrices),
+     * the other two eigenpairs are the closed form solution of the 2x2 matrix of A in the plane orthogonal to it, so
+     * that the eigenvectors are orthonormal and accurate also for close and repeated eigenvalues.
+     * The tensors are processed in blocks: the invariants and the eigenvalues of a block are computed in loops without
+     * branches, which vectorize, only the acos and cos are scalar calls and the eigenvectors are computed per tensor
+     * @param NumberOfTensors The number of tensors
+     * @param pTensors The tensors one after another, 6 components each in the order of the stress vector: xx, yy, zz, xy, yz, xz
+     * @param pEigenValues The eigenvalues, 3 per tensor in descending order
+     * @param pEigenVectors The eigenvectors, 9 per tensor row by row with the eigenvectors as columns, nullptr for only the eigenvalues
+     */
+    static inline void SymmetricEigenSystems3(
+        const SizeType NumberOfTensors,
+        const TDataType* pTensors,
+        TDataType* pEigenValues,
+        TDataType* pEigenVectors = nullptr
+        )
+    {
+        using std::abs;
+        using std::sqrt;
+        using std::acos;
+        using std::cos;
+
+        constexpr SizeType block_size = 16;
+        TDataType scale[block_size], shift[block_size], radius[block_size], half_det[block_size], off_diagonal[block_size];
+        TDataType cos0[block_size], cos2[block_size];
+
+        for(IndexType start = 0; start < NumberOfTensors; start += block_size) {
+            const SizeType size = (NumberOfTensors - start < block_size) ? NumberOfTensors - start : block_size;
+            const TDataType* p_block = pTensors + 6 * start;
+
+            // The shift and the radius of B = (A - shift I) / radius, from the components divided by the largest one
+            for(IndexType t = 0; t < size; ++t) {
+                const TDataType* a = p_block + 6 * t;
+                TDataType s = abs(a[0]);
+                for(IndexType k = 1; k < 6; ++k)
+                    s = (abs(a[k]) > s) ? abs(a[k]) : s;
+                const TDataType inverse_scale = 1.0 / ((s > 0.0) ? s : TDataType(1.0));
+
+                const TDataType a00 = a[0] * inverse_scale, a11 = a[1] * inverse_scale, a22 = a[2] * inverse_scale;
+                const TDataType a01 = a[3] * inverse_scale, a12 = a[4] * inverse_scale, a02 = a[5] * inverse_scale;
+
+                const TDataType q = (a00 + a11 + a22) / 3.0;
+                const TDataType b00 = a00 - q, b11 = a11 - q, b22 = a22 - q;
+                const TDataType o = a01 * a01 + a12 * a12 + a02 * a02;
+                const TDataType p = sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * o) / 6.0);
+                const TDataType safe_p = (p > 0.0) ? p : TDataType(1.0);
+
+                const TDataType det = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) + a02 * (a01 * a12 - b11 * a02);
+                const TDataType r = 0.5 * det / (safe_p * safe_p * safe_p);
+
+                scale[t] = s;
+                shift[t] = q;
+                radius[t] = p;
+                off_diagonal[t] = o;
+                half_det[t] = (r < -1.0) ? TDataType(-1.0) : ((r > 1.0) ? TDataType(1.0) : r);
+            }
+
+            // The angle of the trigonometric solution
+            for(IndexType t = 0; t < size; ++t) {
+                const TDataType angle = acos(half_det[t]) / 3.0;
+                cos0[t] = cos(angle);
+                cos2[t] = cos(angle + 2.0 * Pi() / 3.0);
+            }
+
+            // The eigenvalues, the diagonal ones of the diagonal tensors without the round-off of the trigonometric solution
+            for(IndexType t = 0; t < size; ++t) {
+                const TDataType* a = p_block + 6 * t;
+                TDataType* l = pEigenValues + 3 * (start + t);
+
+                const TDataType l0 = shift[t] + 2.0 * radius[t] * cos0[t];
+                const TDataType l2 = shift[t] + 2.0 * radius[t] * cos2[t];
+                const TDataType l1 = 3.0 * shift[t] - l0 - l2;
+
+                const TDataType max01 = (a[0] > a[1]) ? a[0] : a[1];
+                const TDataType min01 = (a[0] > a[1]) ? a[1] : a[0];
+                const TDataType d0 = (max01 > a[2]) ? max01 : a[2];
+                const TDataType d2 = (min01 > a[2]) ? a[2] : min01;
+                const TDataType d1 = (max01 > a[2]) ? ((min01 > a[2]) ? min01 : a[2]) : max01;
+
+                const bool is_diagonal = (off_diagonal[t] == 0.0);
+                l[0] = is_diagonal ? d0 : scale[t] * l0;
+                l[1] = is_diagonal ? d1 : scale[t] * l1;
+                l[2] = is_diagonal ? d2 : scale[t] * l2;
+            }
+
+            if (pEigenVectors != nullptr) {
+                for(IndexType t = 0; t < size; ++t) {
+                    SymmetricEigenVectors3(p_block + 6 * t, scale[t], off_diagonal[t] == 0.0,
+                        pEigenValues + 3 * (start + t), pEigenVectors + 9 * (start + t));
+                }
+            }
+        }
+    }
+
     /**
      * @brief Calculates the square root of a matrix
      * @details This function calculates the square root of a matrix by doing an eigenvalue decomposition
@@ -1874,6 +2215,324 @@ public:
 
 private:
 
+    ///@name Private Operations
+    ///@{
+
+    /// Exact symmetry, as of the constitutive matrices of the hyperelastic and associative laws
+    template<class TMatrixType>
+    static inline bool IsSymmetric(const TMatrixType& rD)
+    {
+        for(IndexType k = 0; k < rD.size1(); ++k)
+            for(IndexType l = k + 1; l < rD.size2(); ++l)
+                if (rD(k, l) != rD(l, k))
+                    return false;
+        return true;
+    }
+
+    /// Dispatch rA += sum_g w_g B_g'D_g B_g to the fixed size kernel of the sizes, false if there is none
+    template<class TMatrixType, class TGetDType, class TGetBType, class TGetWeightType>
+    static inline bool AddFixedSizeBtDBProducts(
+        const SizeType StrainSize,
+        const SizeType Size,
+        TMatrixType& rA,
+        const SizeType NumberOfPoints,
+        const TGetDType& rGetD,
+        const TGetBType& rGetB,
+        const TGetWeightType& rGetWeight,
+        const bool Symmetric
+        )
+    {
+        if (StrainSize == 3) {
+            switch (Size) {
+                case 6: AddFixedSizeBtDBProducts<3, 6>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                case 8: AddFixedSizeBtDBProducts<3, 8>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                default: return false;
+            }
+        } else if (StrainSize == 6) {
+            switch (Size) {
+                case 12: AddFixedSizeBtDBProducts<6, 12>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                case 24: AddFixedSizeBtDBProducts<6, 24>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                case 30: AddFixedSizeBtDBProducts<6, 30>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                case 60: AddFixedSizeBtDBProducts<6, 60>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                case 81: AddFixedSizeBtDBProducts<6, 81>(rA, NumberOfPoints, rGetD, rGetB, rGetWeight, Symmetric); return true;
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief rA += sum_g w_g B_g'D_g B_g with the sizes known at compile time
+     * @details The matrices of each point are copied to arrays, the sum is accumulated in an array and added to rA
+     * once. The inner loops run over the dofs, the contiguous index of the arrays, and vectorize. The zeros of D and
+     * of B, about half of the entries of B for the solids, are skipped.
+     */
+    template<SizeType TStrainSize, SizeType TSize, class TMatrixType, class TGetDType, class TGetBType, class TGetWeightType>
+    static inline void AddFixedSizeBtDBProducts(
+        TMatrixType& rA,
+        const SizeType NumberOfPoints,
+        const TGetDType& rGetD,
+        const TGetBType& rGetB,
+        const TGetWeightType& rGetWeight,
+        const bool Symmetric
+        )
+    {
+        TDataType a[TSize][TSize];
+        TDataType b[TStrainSize][TSize];
+        TDataType db[TStrainSize][TSize];
+
+        for(IndexType i = 0; i < TSize; ++i)
+            for(IndexType j = 0; j < TSize; ++j)
+                a[i][j] = TDataType();
+
+        for(IndexType g = 0; g < NumberOfPoints; ++g) {
+            const auto& r_d = rGetD(g);
+            const auto& r_b = rGetB(g);
+            const TDataType weight = rGetWeight(g);
+
+            for(IndexType k = 0; k < TStrainSize; ++k)
+                for(IndexType j = 0; j < TSize; ++j)
+                    b[k][j] = r_b(k, j);
+
+            // wDB
+            for(IndexType k = 0; k < TStrainSize; ++k) {
+                for(IndexType j = 0; j < TSize; ++j)
+                    db[k][j] = TDataType();
+                for(IndexType l = 0; l < TStrainSize; ++l) {
+                    const TDataType wDkl = weight * r_d(k, l);
+                    if (wDkl == TDataType())
+                        continue;
+                    for(IndexType j = 0; j < TSize; ++j)
+                        db[k][j] += wDkl * b[l][j];
+                }
+            }
+
+            // B'(wDB), only the upper triangle if it is symmetric
+            for(IndexType k = 0; k < TStrainSize; ++k) {
+                for(IndexType i = 0; i < TSize; ++i) {
+                    const TDataType Bki = b[k][i];
+                    if (Bki == TDataType())
+                        continue;
+                    for(IndexType j = (Symmetric ? i : 0); j < TSize; ++j)
+                        a[i][j] += Bki * db[k][j];
+                }
+            }
+        }
+
+        for(IndexType i = 0; i < TSize; ++i)
+            for(IndexType j = 0; j < TSize; ++j)
+                rA(i, j) += (Symmetric && j < i) ? a[j][i] : a[i][j];
+    }
+
+    /// rA += sum_g w_g N_g N_g' with the number of nodes known at compile time, only the upper triangle is computed
+    template<SizeType TSize, class TMatrixType1, class TMatrixType2, class TVectorType>
+    static inline void AddFixedSizeNtNProducts(
+        TMatrixType1& rA,
+        const TMatrixType2& rN,
+        const TVectorType& rWeights
+        )
+    {
+        TDataType a[TSize][TSize];
+        TDataType n[TSize];
+
+        for(IndexType i = 0; i < TSize; ++i)
+            for(IndexType j = 0; j < TSize; ++j)
+                a[i][j] = TDataType();
+
+        for(IndexType g = 0; g < rN.size1(); ++g) {
+            for(IndexType i = 0; i < TSize; ++i)
+                n[i] = rN(g, i);
+            const TDataType weight = rWeights[g];
+            for(IndexType i = 0; i < TSize; ++i) {
+                const TDataType wNi = weight * n[i];
+                for(IndexType j = i; j < TSize; ++j)
+                    a[i][j] += wNi * n[j];
+            }
+        }
+
+        for(IndexType i = 0; i < TSize; ++i)
+            for(IndexType j = 0; j < TSize; ++j)
+                rA(i, j) += (j < i) ? a[j][i] : a[i][j];
+    }
+
+    /// Copy the eigenvalues and the eigenvectors, row by row, of SymmetricEigenSystems2/3 to the matrices
+    template<SizeType TDim, class TMatrixType>
+    static inline void CopyEigenSystem(
+        const TDataType* pEigenValues,
+        const TDataType* pEigenVectors,
+        TMatrixType& rEigenVectorsMatrix,
+        TMatrixType& rEigenValuesMatrix
+        )
+    {
+        if (rEigenVectorsMatrix.size1() != TDim || rEigenVectorsMatrix.size2() != TDim)
+            rEigenVectorsMatrix.resize(TDim, TDim, false);
+        if (rEigenValuesMatrix.size1() != TDim || rEigenValuesMatrix.size2() != TDim)
+            rEigenValuesMatrix.resize(TDim, TDim, false);
+
+        for(IndexType i = 0; i < TDim; ++i) {
+            for(IndexType j = 0; j < TDim; ++j) {
+                rEigenVectorsMatrix(i, j) = pEigenVectors[TDim * i + j];
+                rEigenValuesMatrix(i, j) = (i == j) ? pEigenValues[i] : TDataType();
+            }
+        }
+    }
+
+    /**
+     * @brief The eigenvectors of the symmetric 3x3 tensor a, in the order xx, yy, zz, xy, yz, xz, from its eigenvalues in descending order
+     * @details The eigenvalues are replaced by the refined ones, in descending order. The eigenvectors are written row by
+     * row as the columns of a matrix
+     */
+    static inline void SymmetricEigenVectors3(
+        const TDataType* a,
+        const TDataType Scale,
+        const bool IsDiagonal,
+        TDataType* pEigenValues,
+        TDataType* pEigenVectors
+        )
+    {
+        TDataType v[3][3];
+
+        if (IsDiagonal) {
+            // the unit vectors in the order of the sorted diagonal
+            IndexType order[3] = {0, 1, 2};
+            if (a[order[1]] > a[order[0]]) std::swap(order[0], order[1]);
+            if (a[order[2]] > a[order[1]]) std::swap(order[1], order[2]);
+            if (a[order[1]] > a[order[0]]) std::swap(order[0], order[1]);
+            for(IndexType i = 0; i < 3; ++i)
+                for(IndexType j = 0; j < 3; ++j)
+                    v[i][j] = (j == order[i]) ? TDataType(1.0) : TDataType(0.0);
+        } else {
+            // the tensor divided by Scale, the largest component
+            const TDataType inverse_scale = 1.0 / Scale;
+            const TDataType m[3][3] = {{a[0] * inverse_scale, a[3] * inverse_scale, a[5] * inverse_scale},
+                                       {a[3] * inverse_scale, a[1] * inverse_scale, a[4] * inverse_scale},
+                                       {a[5] * inverse_scale, a[4] * inverse_scale, a[2] * inverse_scale}};
+            TDataType l[3];
+            for(IndexType i = 0; i < 3; ++i)
+                l[i] = pEigenValues[i] * inverse_scale;
+
+            // the eigenvector of the eigenvalue that is best separated from the others, its eigenvalue is replaced by the
+            // Rayleigh quotient. The other two from the 2x2 matrix in the plane orthogonal to it
+            const IndexType k = (l[0] - l[1] >= l[1] - l[2]) ? 0 : 2;
+            SymmetricEigenVector3(m, l[k], v[k]);
+            if (k == 0)
+                SymmetricDeflatedEigenSystem3(m, v[0], l + 1, v[1], v[2]);
+            else
+                SymmetricDeflatedEigenSystem3(m, v[2], l, v[0], v[1]);
+
+            l[k] = TDataType();
+            for(IndexType j = 0; j < 3; ++j)
+                l[k] += v[k][j] * (m[j][0] * v[k][0] + m[j][1] * v[k][1] + m[j][2] * v[k][2]);
+
+            for(IndexType i = 0; i < 2; ++i) {
+                for(IndexType j = 2; j > i; --j) {
+                    if (l[j] > l[j - 1]) {
+                        std::swap(l[j], l[j - 1]);
+                        for(IndexType k = 0; k < 3; ++k)
+                            std::swap(v[j][k], v[j - 1][k]);
+                    }
+                }
+            }
+            for(IndexType i = 0; i < 3; ++i)
+                pEigenValues[i] = Scale * l[i];
+        }
+
+        for(IndexType i = 0; i < 3; ++i)
+            for(IndexType j = 0; j < 3; ++j)
+                pEigenVectors[3 * i + j] = v[j][i];
+    }
+
+    /// The unit eigenvector of the eigenvalue Value of the symmetric 3x3 matrix m, the largest cross product of two rows of m - Value I
+    static inline void SymmetricEigenVector3(
+        const TDataType m[3][3],
+        const TDataType Value,
+        TDataType* pVector
+        )
+    {
+        using std::sqrt;
+
+        TDataType rows[3][3];
+        for(IndexType i = 0; i < 3; ++i)
+            for(IndexType j = 0; j < 3; ++j)
+                rows[i][j] = (i == j) ? m[i][j] - Value : m[i][j];
+
+        TDataType products[3][3];
+        Cross3(rows[0], rows[1], products[0]);
+        Cross3(rows[0], rows[2], products[1]);
+        Cross3(rows[1], rows[2], products[2]);
+
+        IndexType k_max = 0;
+        TDataType d_max = TDataType();
+        for(IndexType k = 0; k < 3; ++k) {
+            const TDataType d = products[k][0] * products[k][0] + products[k][1] * products[k][1] + products[k][2] * products[k][2];
+            if (d > d_max) {
+                d_max = d;
+                k_max = k;
+            }
+        }
+
+        if (d_max > 0.0) {
+            const TDataType inverse_norm = 1.0 / sqrt(d_max);
+            for(IndexType j = 0; j < 3; ++j)
+                pVector[j] = products[k_max][j] * inverse_norm;
+        } else {
+            // m is Value I, any vector is an eigenvector
+            pVector[0] = 1.0; pVector[1] = 0.0; pVector[2] = 0.0;
+        }
+    }
+
+    /**
+     * @brief The eigenvalues, in descending order, and the unit eigenvectors of the symmetric 3x3 matrix m in the plane orthogonal to its unit eigenvector pW
+     * @details The closed form solution of the 2x2 matrix of m in an orthonormal basis u, v of the plane. Unlike the
+     * null vector of m - l I, it does not depend on the accuracy of l and so separates close eigenvalues
+     */
+    static inline void SymmetricDeflatedEigenSystem3(
+        const TDataType m[3][3],
+        const TDataType* pW,
+        TDataType* pEigenValues,
+        TDataType* pVector0,
+        TDataType* pVector1
+        )
+    {
+        using std::abs;
+        using std::sqrt;
+
+        TDataType u[3], v[3];
+        if (abs(pW[0]) > abs(pW[1])) {
+            const TDataType inverse_norm = 1.0 / sqrt(pW[0] * pW[0] + pW[2] * pW[2]);
+            u[0] = -pW[2] * inverse_norm; u[1] = 0.0; u[2] = pW[0] * inverse_norm;
+        } else {
+            const TDataType inverse_norm = 1.0 / sqrt(pW[1] * pW[1] + pW[2] * pW[2]);
+            u[0] = 0.0; u[1] = pW[2] * inverse_norm; u[2] = -pW[1] * inverse_norm;
+        }
+        Cross3(pW, u, v);
+
+        TDataType mu[3], mv[3];
+        for(IndexType i = 0; i < 3; ++i) {
+            mu[i] = m[i][0] * u[0] + m[i][1] * u[1] + m[i][2] * u[2];
+            mv[i] = m[i][0] * v[0] + m[i][1] * v[1] + m[i][2] * v[2];
+        }
+        const TDataType projected[3] = {u[0] * mu[0] + u[1] * mu[1] + u[2] * mu[2],
+                                        v[0] * mv[0] + v[1] * mv[1] + v[2] * mv[2],
+                                        u[0] * mv[0] + u[1] * mv[1] + u[2] * mv[2]};
+        TDataType c[4];
+        SymmetricEigenSystems2(1, projected, pEigenValues, c);
+
+        for(IndexType j = 0; j < 3; ++j) {
+            pVector0[j] = c[0] * u[j] + c[2] * v[j];
+            pVector1[j] = c[1] * u[j] + c[3] * v[j];
+        }
+    }
+
+    /// c = a x b for arrays of 3
+    static inline void Cross3(const TDataType* a, const TDataType* b, TDataType* c)
+    {
+        c[0] = a[1] * b[2] - a[2] * b[1];
+        c[1] = a[2] * b[0] - a[0] * b[2];
+        c[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    ///@}
     ///@name Unaccessible methods
     ///@{
 
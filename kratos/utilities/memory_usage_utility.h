@@ -0,0 +1,252 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_MEMORY_USAGE_UTILITY_H_INCLUDED )
+#define  KRATOS_MEMORY_USAGE_UTILITY_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <utility>
+
+// External includes
+#include <boost/smart_ptr/detail/sp_counted_impl.hpp>
+
+// Project includes
+#include "includes/define.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class MemoryUsageUtility
+ * @ingroup KratosCore
+ * @brief Accounting of the memory of the nodes, elements and conditions of a model part, by component
+ * @details The memory of each component is the size of the objects and of the containers they own: the shared
+ * pointer and its counter, the dofs, the non-historical values and the historical data block of the nodes, the
+ * geometry of the elements and conditions. The sizes are shallow: the elements and the conditions are counted with
+ * the size of the base class, the heap memory of the values (e.g. of a Vector) and the overhead of the allocator
+ * are not counted, and the properties, which are shared, are not counted either.
+ */
+template<class TModelPartType>
+class MemoryUsageUtility
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of MemoryUsageUtility
+    KRATOS_CLASS_POINTER_DEFINITION(MemoryUsageUtility);
+
+    typedef std::size_t SizeType;
+
+    typedef TModelPartType ModelPartType;
+
+    typedef typename ModelPartType::NodeType NodeType;
+
+    typedef typename ModelPartType::ElementType ElementType;
+
+    typedef typename ModelPartType::ConditionType ConditionType;
+
+    typedef typename ModelPartType::GeometryType GeometryType;
+
+    typedef typename NodeType::DofType DofType;
+
+    /// The bytes used by the objects of one kind, by component
+    struct MemoryUsage
+    {
+        std::string Name;
+
+        SizeType NumberOfObjects = 0;
+
+        std::vector<std::pair<std::string, SizeType> > Components;
+
+        SizeType Total() const
+        {
+            SizeType total = 0;
+            for (const auto& r_component : Components)
+                total += r_component.second;
+            return total;
+        }
+
+        void PrintData(std::ostream& rOStream) const
+        {
+            const double number_of_objects = (NumberOfObjects == 0) ? 1.0 : static_cast<double>(NumberOfObjects);
+            rOStream << NumberOfObjects << " " << Name << ": " << Total() << " bytes, "
+                     << std::fixed << std::setprecision(1) << Total() / number_of_objects << " bytes per object" << std::endl;
+            for (const auto& r_component : Components)
+                rOStream << "    " << std::left << std::setw(24) << r_component.first << std::right << std::setw(16) << r_component.second
+                         << " bytes, " << std::setw(10) << r_component.second / number_of_objects << " per object" << std::endl;
+            rOStream.unsetf(std::ios_base::floatfield);
+        }
+    };
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    MemoryUsageUtility() {}
+
+    /// Destructor.
+    virtual ~MemoryUsageUtility() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    static MemoryUsage NodesMemoryUsage(ModelPartType& rModelPart)
+    {
+        MemoryUsage usage;
+        usage.Name = "nodes";
+        usage.NumberOfObjects = rModelPart.NumberOfNodes();
+
+        SizeType dofs = 0, data = 0, historical_data = 0;
+        for (auto it = rModelPart.NodesBegin(); it != rModelPart.NodesEnd(); ++it)
+        {
+            typename NodeType::DofsContainerType& r_dofs = it->GetDofs();
+            dofs += r_dofs.capacity() * sizeof(typename DofType::Pointer)
+                  + r_dofs.size() * (sizeof(DofType) + sizeof(boost::detail::sp_counted_impl_p<DofType>));
+            data += DataValueContainerSize(it->Data());
+            historical_data += it->SolutionStepData().TotalSize() * sizeof(typename NodeType::BlockType);
+        }
+
+        usage.Components.push_back(std::make_pair("node", usage.NumberOfObjects * sizeof(NodeType)));
+        usage.Components.push_back(std::make_pair("shared pointer", usage.NumberOfObjects * SharedPointerSize<NodeType>()));
+        usage.Components.push_back(std::make_pair("dofs", dofs));
+        usage.Components.push_back(std::make_pair("non-historical values", data));
+        usage.Components.push_back(std::make_pair("historical values", historical_data));
+
+        return usage;
+    }
+
+    static MemoryUsage ElementsMemoryUsage(ModelPartType& rModelPart)
+    {
+        return GeometricalObjectsMemoryUsage<ElementType>("elements", rModelPart.ElementsBegin(), rModelPart.ElementsEnd(), rModelPart.NumberOfElements());
+    }
+
+    static MemoryUsage ConditionsMemoryUsage(ModelPartType& rModelPart)
+    {
+        return GeometricalObjectsMemoryUsage<ConditionType>("conditions", rModelPart.ConditionsBegin(), rModelPart.ConditionsEnd(), rModelPart.NumberOfConditions());
+    }
+
+    /// The memory of the nodes, elements and conditions of the model part, by component
+    static std::string Report(ModelPartType& rModelPart)
+    {
+        std::stringstream buffer;
+        NodesMemoryUsage(rModelPart).PrintData(buffer);
+        ElementsMemoryUsage(rModelPart).PrintData(buffer);
+        ConditionsMemoryUsage(rModelPart).PrintData(buffer);
+        return buffer.str();
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        return "MemoryUsageUtility";
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+    ///@}
+
+private:
+    ///@name Private Operations
+    ///@{
+
+    /// The pointer in the container and the counter of the shared pointer
+    template<class TObjectType>
+    static constexpr SizeType SharedPointerSize()
+    {
+        return sizeof(typename TObjectType::Pointer) + sizeof(boost::detail::sp_counted_impl_p<TObjectType>);
+    }
+
+    /// The entries of the container and the values they point to
+    template<class TDataValueContainerType>
+    static SizeType DataValueContainerSize(const TDataValueContainerType& rData)
+    {
+        SizeType size = 0;
+        for (auto it = rData.begin(); it != rData.end(); ++it)
+            size += sizeof(typename TDataValueContainerType::ValueType) + it->first->Size();
+        return size;
+    }
+
+    template<class TObjectType, class TIteratorType>
+    static MemoryUsage GeometricalObjectsMemoryUsage(const std::string& rName, TIteratorType itBegin, TIteratorType itEnd, const SizeType NumberOfObjects)
+    {
+        MemoryUsage usage;
+        usage.Name = rName;
+        usage.NumberOfObjects = NumberOfObjects;
+
+        SizeType geometry = 0, data = 0;
+        for (auto it = itBegin; it != itEnd; ++it)
+        {
+            const TObjectType& r_object = *it; // the non-const Data() is protected
+            GeometryType& r_geometry = it->GetGeometry();
+            geometry += SharedPointerSize<GeometryType>() + sizeof(GeometryType) + r_geometry.capacity() * sizeof(typename NodeType::Pointer);
+            data += DataValueContainerSize(r_object.Data());
+        }
+
+        usage.Components.push_back(std::make_pair(rName.substr(0, rName.size() - 1), NumberOfObjects * sizeof(TObjectType)));
+        usage.Components.push_back(std::make_pair("shared pointer", NumberOfObjects * SharedPointerSize<TObjectType>()));
+        usage.Components.push_back(std::make_pair("geometry", geometry));
+        usage.Components.push_back(std::make_pair("non-historical values", data));
+
+        return usage;
+    }
+
+    ///@}
+
+}; // Class MemoryUsageUtility
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+template<class TModelPartType>
+inline std::ostream& operator << (std::ostream& rOStream, const MemoryUsageUtility<TModelPartType>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_MEMORY_USAGE_UTILITY_H_INCLUDED  defined
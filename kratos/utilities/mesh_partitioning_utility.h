@@ -0,0 +1,549 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    hbui
+//
+//
+
+#if !defined(KRATOS_MESH_PARTITIONING_UTILITY_H_INCLUDED )
+#define  KRATOS_MESH_PARTITIONING_UTILITY_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/ublas_interface.h"
+#include "containers/array_1d.h"
+#include "utilities/openmp_utils.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * @class MeshPartitioningUtility
+ * @ingroup KratosCore
+ * @brief Geometric partitioner of a mesh along a Hilbert space-filling curve
+ * @details The elements are sorted by the Hilbert index of their centroid and the sorted sequence is cut
+ * into chunks of equal size, which gives compact partitions with a balanced number of elements. Each node
+ * is owned by the partition holding most of its elements; the nodes without element take the partition
+ * of their own position on the curve. Each condition goes to the partition owning most of its nodes.
+ * The results are the partition indices expected by IO::DivideInputToPartitions, indexed by id - 1,
+ * and the graph of the neighbour partitions, to be colored by GraphColoringProcess.
+ * All the steps except the merge of the sorted chunks run in parallel.
+ */
+class MeshPartitioningUtility
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of MeshPartitioningUtility
+    KRATOS_CLASS_POINTER_DEFINITION(MeshPartitioningUtility);
+
+    typedef std::size_t IndexType;
+
+    typedef std::size_t SizeType;
+
+    typedef array_1d<double, 3> PointType;
+
+    typedef std::vector<std::vector<IndexType> > ConnectivitiesContainerType;
+
+    typedef std::vector<std::vector<IndexType> > PartitionIndicesContainerType;
+
+    typedef std::vector<IndexType> PartitionIndicesType;
+
+    typedef matrix<int> GraphType;
+
+    typedef std::uint64_t KeyType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor.
+    MeshPartitioningUtility(SizeType NumberOfPartitions) : mNumberOfPartitions(NumberOfPartitions)
+    {
+        KRATOS_ERROR_IF(NumberOfPartitions == 0) << "The number of partitions must be positive";
+    }
+
+    /// Destructor.
+    virtual ~MeshPartitioningUtility() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /**
+     * @brief Partition the mesh
+     * @param rNodalCoordinates the coordinates of the node with id i + 1 at position i
+     * @param rElementsConnectivities the node ids of the element with id i + 1 at position i
+     * @param rConditionsConnectivities the node ids of the condition with id i + 1 at position i
+     */
+    void Partition(const std::vector<PointType>& rNodalCoordinates,
+                   const ConnectivitiesContainerType& rElementsConnectivities,
+                   const ConnectivitiesContainerType& rConditionsConnectivities)
+    {
+        KRATOS_TRY
+
+        const SizeType number_of_nodes = rNodalCoordinates.size();
+        const SizeType number_of_elements = rElementsConnectivities.size();
+        const SizeType number_of_conditions = rConditionsConnectivities.size();
+
+        CheckConnectivities(rElementsConnectivities, number_of_nodes, "element");
+        CheckConnectivities(rConditionsConnectivities, number_of_nodes, "condition");
+
+        ComputeBoundingBox(rNodalCoordinates, mMinPoint, mMaxPoint);
+
+        // cut the elements sorted along the curve into chunks of the same size
+        std::vector<std::pair<KeyType, IndexType> > sorted_elements(number_of_elements);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_elements); ++i)
+        {
+            const std::vector<IndexType>& r_nodes = rElementsConnectivities[i];
+            PointType centroid = ZeroVector(3);
+            for (std::size_t k = 0; k < r_nodes.size(); ++k)
+                noalias(centroid) += rNodalCoordinates[r_nodes[k] - 1];
+            if (r_nodes.size() > 0)
+                centroid /= static_cast<double>(r_nodes.size());
+            sorted_elements[i] = std::make_pair(HilbertKey(centroid), static_cast<IndexType>(i));
+        }
+
+        ParallelSort(sorted_elements);
+
+        mElementsPartitions.resize(number_of_elements);
+        mSplitterKeys.assign(mNumberOfPartitions, std::numeric_limits<KeyType>::max());
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_elements); ++i)
+        {
+            const IndexType partition = (static_cast<std::uint64_t>(i) * mNumberOfPartitions) / number_of_elements;
+            mElementsPartitions[sorted_elements[i].second] = partition;
+        }
+        for (IndexType i = 0; i < number_of_elements; ++i)
+        {
+            const IndexType partition = mElementsPartitions[sorted_elements[i].second];
+            mSplitterKeys[partition] = sorted_elements[i].first;
+        }
+        for (IndexType p = mNumberOfPartitions - 1; p > 0; --p) // the empty partitions do not own any range of the curve
+            mSplitterKeys[p - 1] = std::min(mSplitterKeys[p - 1], mSplitterKeys[p]);
+        sorted_elements.clear();
+
+        // the elements of each node
+        std::vector<IndexType> node_elements_index, node_elements;
+        BuildNodalConnectivities(rElementsConnectivities, number_of_nodes, node_elements_index, node_elements);
+
+        mNodesPartitions.resize(number_of_nodes);
+        #pragma omp parallel
+        {
+            std::vector<SizeType> counts(mNumberOfPartitions, 0);
+
+            #pragma omp for
+            for (int i = 0; i < static_cast<int>(number_of_nodes); ++i)
+            {
+                if (node_elements_index[i] == node_elements_index[i + 1])
+                {
+                    mNodesPartitions[i] = PartitionOfKey(HilbertKey(rNodalCoordinates[i]));
+                    continue;
+                }
+
+                for (IndexType j = node_elements_index[i]; j < node_elements_index[i + 1]; ++j)
+                    ++counts[mElementsPartitions[node_elements[j]]];
+
+                IndexType owner = mElementsPartitions[node_elements[node_elements_index[i]]];
+                for (IndexType j = node_elements_index[i]; j < node_elements_index[i + 1]; ++j)
+                {
+                    const IndexType partition = mElementsPartitions[node_elements[j]];
+                    if (counts[partition] > counts[owner] || (counts[partition] == counts[owner] && partition < owner))
+                        owner = partition;
+                }
+                mNodesPartitions[i] = owner;
+
+                for (IndexType j = node_elements_index[i]; j < node_elements_index[i + 1]; ++j)
+                    counts[mElementsPartitions[node_elements[j]]] = 0;
+            }
+        }
+
+        mConditionsPartitions.resize(number_of_conditions);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_conditions); ++i)
+        {
+            const std::vector<IndexType>& r_nodes = rConditionsConnectivities[i];
+            IndexType owner = 0;
+            SizeType owner_count = 0;
+            for (std::size_t k = 0; k < r_nodes.size(); ++k)
+            {
+                const IndexType partition = mNodesPartitions[r_nodes[k] - 1];
+                SizeType count = 0;
+                for (std::size_t l = 0; l < r_nodes.size(); ++l)
+                    count += (mNodesPartitions[r_nodes[l] - 1] == partition);
+                if (count > owner_count || (count == owner_count && partition < owner))
+                {
+                    owner = partition;
+                    owner_count = count;
+                }
+            }
+            mConditionsPartitions[i] = owner;
+        }
+
+        // all the partitions holding a node
+        std::vector<IndexType> node_conditions_index, node_conditions;
+        BuildNodalConnectivities(rConditionsConnectivities, number_of_nodes, node_conditions_index, node_conditions);
+
+        mNodesAllPartitions.resize(number_of_nodes);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_nodes); ++i)
+        {
+            std::vector<IndexType>& r_partitions = mNodesAllPartitions[i];
+            r_partitions.clear();
+            r_partitions.push_back(mNodesPartitions[i]);
+            for (IndexType j = node_elements_index[i]; j < node_elements_index[i + 1]; ++j)
+                r_partitions.push_back(mElementsPartitions[node_elements[j]]);
+            for (IndexType j = node_conditions_index[i]; j < node_conditions_index[i + 1]; ++j)
+                r_partitions.push_back(mConditionsPartitions[node_conditions[j]]);
+            std::sort(r_partitions.begin(), r_partitions.end());
+            r_partitions.erase(std::unique(r_partitions.begin(), r_partitions.end()), r_partitions.end());
+        }
+
+        FillAllPartitions(mElementsPartitions, mElementsAllPartitions);
+        FillAllPartitions(mConditionsPartitions, mConditionsAllPartitions);
+
+        mDomainsGraph = GraphType(mNumberOfPartitions, mNumberOfPartitions, 0);
+        for (IndexType i = 0; i < number_of_nodes; ++i)
+        {
+            const std::vector<IndexType>& r_partitions = mNodesAllPartitions[i];
+            for (std::size_t k = 0; k < r_partitions.size(); ++k)
+                for (std::size_t l = k + 1; l < r_partitions.size(); ++l)
+                {
+                    mDomainsGraph(r_partitions[k], r_partitions[l]) = 1;
+                    mDomainsGraph(r_partitions[l], r_partitions[k]) = 1;
+                }
+        }
+
+        ComputeEdgeCut(rElementsConnectivities, node_elements_index, node_elements);
+
+        KRATOS_CATCH("")
+    }
+
+    /// The bounding box of the points
+    static void ComputeBoundingBox(const std::vector<PointType>& rPoints, PointType& rMinPoint, PointType& rMaxPoint)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            rMinPoint[k] = std::numeric_limits<double>::max();
+            rMaxPoint[k] = -std::numeric_limits<double>::max();
+        }
+
+        #pragma omp parallel
+        {
+            PointType local_min = rMinPoint, local_max = rMaxPoint;
+
+            #pragma omp for nowait
+            for (int i = 0; i < static_cast<int>(rPoints.size()); ++i)
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    local_min[k] = std::min(local_min[k], rPoints[i][k]);
+                    local_max[k] = std::max(local_max[k], rPoints[i][k]);
+                }
+
+            #pragma omp critical
+            {
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    rMinPoint[k] = std::min(rMinPoint[k], local_min[k]);
+                    rMaxPoint[k] = std::max(rMaxPoint[k], local_max[k]);
+                }
+            }
+        }
+    }
+
+    /// The index of the point along the Hilbert curve of 21 bits per direction filling the bounding box (Skilling's algorithm)
+    static KeyType HilbertKey(const PointType& rPoint, const PointType& rMinPoint, const PointType& rMaxPoint)
+    {
+        const unsigned int bits = 21;
+        const double max_coordinate = static_cast<double>((1u << bits) - 1);
+
+        std::uint32_t x[3];
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            const double length = rMaxPoint[k] - rMinPoint[k];
+            const double t = (length > 0.0) ? (rPoint[k] - rMinPoint[k]) / length : 0.0;
+            x[k] = static_cast<std::uint32_t>(std::min(std::max(t, 0.0), 1.0) * max_coordinate);
+        }
+
+        // inverse undo of the excess work
+        for (std::uint32_t q = 1u << (bits - 1); q > 1; q >>= 1)
+        {
+            const std::uint32_t p = q - 1;
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                if (x[k] & q)
+                    x[0] ^= p;
+                else
+                {
+                    const std::uint32_t t = (x[0] ^ x[k]) & p;
+                    x[0] ^= t;
+                    x[k] ^= t;
+                }
+            }
+        }
+
+        // Gray encode
+        x[1] ^= x[0];
+        x[2] ^= x[1];
+        std::uint32_t t = 0;
+        for (std::uint32_t q = 1u << (bits - 1); q > 1; q >>= 1)
+            if (x[2] & q)
+                t ^= q - 1;
+        for (std::size_t k = 0; k < 3; ++k)
+            x[k] ^= t;
+
+        KeyType key = 0;
+        for (int b = bits - 1; b >= 0; --b)
+            for (std::size_t k = 0; k < 3; ++k)
+                key = (key << 1) | ((x[k] >> b) & 1u);
+
+        return key;
+    }
+
+    /// Sort the chunks of each thread in parallel, then merge them pairwise
+    template<class TValueType>
+    static void ParallelSort(std::vector<TValueType>& rValues)
+    {
+        const int number_of_threads = OpenMPUtils::GetNumThreads();
+        if (number_of_threads == 1 || rValues.size() < 10000)
+        {
+            std::sort(rValues.begin(), rValues.end());
+            return;
+        }
+
+        OpenMPUtils::PartitionVector bounds;
+        OpenMPUtils::DivideInPartitions(rValues.size(), number_of_threads, bounds);
+
+        #pragma omp parallel for
+        for (int k = 0; k < number_of_threads; ++k)
+            std::sort(rValues.begin() + bounds[k], rValues.begin() + bounds[k + 1]);
+
+        for (int width = 1; width < number_of_threads; width *= 2)
+        {
+            #pragma omp parallel for
+            for (int k = 0; k < number_of_threads - width; k += 2 * width)
+            {
+                const int last = std::min(k + 2 * width, number_of_threads);
+                std::inplace_merge(rValues.begin() + bounds[k], rValues.begin() + bounds[k + width], rValues.begin() + bounds[last]);
+            }
+        }
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    SizeType GetNumberOfPartitions() const {return mNumberOfPartitions;}
+
+    const PartitionIndicesType& GetNodesPartitions() const {return mNodesPartitions;}
+
+    const PartitionIndicesType& GetElementsPartitions() const {return mElementsPartitions;}
+
+    const PartitionIndicesType& GetConditionsPartitions() const {return mConditionsPartitions;}
+
+    const PartitionIndicesContainerType& GetNodesAllPartitions() const {return mNodesAllPartitions;}
+
+    const PartitionIndicesContainerType& GetElementsAllPartitions() const {return mElementsAllPartitions;}
+
+    const PartitionIndicesContainerType& GetConditionsAllPartitions() const {return mConditionsAllPartitions;}
+
+    /// The neighbour partitions, 1 at (i, j) if partitions i and j share a node
+    const GraphType& GetDomainsGraph() const {return mDomainsGraph;}
+
+    /// The number of edges of the nodal graph (node pairs of an element) joining nodes of different partitions
+    SizeType GetEdgeCut() const {return mEdgeCut;}
+
+    /// The number of nodes held by more than one partition
+    SizeType GetNumberOfInterfaceNodes() const
+    {
+        SizeType count = 0;
+        for (IndexType i = 0; i < mNodesAllPartitions.size(); ++i)
+            count += (mNodesAllPartitions[i].size() > 1);
+        return count;
+    }
+
+    /// The largest number of elements in a partition over the average
+    double GetElementsImbalance() const {return Imbalance(mElementsPartitions);}
+
+    /// The largest number of owned nodes in a partition over the average
+    double GetNodesImbalance() const {return Imbalance(mNodesPartitions);}
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        return "MeshPartitioningUtility";
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << "Number of partitions: " << mNumberOfPartitions << std::endl;
+        rOStream << "Edge cut: " << GetEdgeCut() << std::endl;
+        rOStream << "Interface nodes: " << GetNumberOfInterfaceNodes() << std::endl;
+        rOStream << "Elements imbalance: " << GetElementsImbalance() << std::endl;
+        rOStream << "Nodes imbalance: " << GetNodesImbalance() << std::endl;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    SizeType mNumberOfPartitions;
+
+    PointType mMinPoint, mMaxPoint;
+
+    std::vector<KeyType> mSplitterKeys; // the largest key of the elements in each partition
+
+    PartitionIndicesType mNodesPartitions, mElementsPartitions, mConditionsPartitions;
+
+    PartitionIndicesContainerType mNodesAllPartitions, mElementsAllPartitions, mConditionsAllPartitions;
+
+    GraphType mDomainsGraph;
+
+    SizeType mEdgeCut = 0;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    static void CheckConnectivities(const ConnectivitiesContainerType& rConnectivities, const SizeType NumberOfNodes, const std::string& rName)
+    {
+        for (IndexType i = 0; i < rConnectivities.size(); ++i)
+            for (std::size_t k = 0; k < rConnectivities[i].size(); ++k)
+                KRATOS_ERROR_IF(rConnectivities[i][k] == 0 || rConnectivities[i][k] > NumberOfNodes)
+                    << "The " << rName << " " << i + 1 << " refers to node " << rConnectivities[i][k]
+                    << ", the node ids must be consecutive from 1 to " << NumberOfNodes;
+    }
+
+    KeyType HilbertKey(const PointType& rPoint) const
+    {
+        return HilbertKey(rPoint, mMinPoint, mMaxPoint);
+    }
+
+    /// The first partition whose range of the curve contains the key
+    IndexType PartitionOfKey(const KeyType Key) const
+    {
+        const IndexType partition = std::lower_bound(mSplitterKeys.begin(), mSplitterKeys.end(), Key) - mSplitterKeys.begin();
+        return std::min(partition, mNumberOfPartitions - 1);
+    }
+
+    /// The entities holding each node, in CSR format
+    static void BuildNodalConnectivities(const ConnectivitiesContainerType& rConnectivities, const SizeType NumberOfNodes,
+                                         std::vector<IndexType>& rIndex, std::vector<IndexType>& rEntities)
+    {
+        rIndex.assign(NumberOfNodes + 1, 0);
+        for (IndexType i = 0; i < rConnectivities.size(); ++i)
+            for (std::size_t k = 0; k < rConnectivities[i].size(); ++k)
+                ++rIndex[rConnectivities[i][k]];
+
+        for (IndexType i = 0; i < NumberOfNodes; ++i)
+            rIndex[i + 1] += rIndex[i];
+
+        rEntities.resize(rIndex[NumberOfNodes]);
+        std::vector<IndexType> position(rIndex.begin(), rIndex.end() - 1);
+        for (IndexType i = 0; i < rConnectivities.size(); ++i)
+            for (std::size_t k = 0; k < rConnectivities[i].size(); ++k)
+                rEntities[position[rConnectivities[i][k] - 1]++] = i;
+    }
+
+    static void FillAllPartitions(const PartitionIndicesType& rPartitions, PartitionIndicesContainerType& rAllPartitions)
+    {
+        rAllPartitions.resize(rPartitions.size());
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(rPartitions.size()); ++i)
+            rAllPartitions[i].assign(1, rPartitions[i]);
+    }
+
+    void ComputeEdgeCut(const ConnectivitiesContainerType& rElementsConnectivities,
+                        const std::vector<IndexType>& rNodeElementsIndex, const std::vector<IndexType>& rNodeElements)
+    {
+        SizeType edge_cut = 0;
+
+        #pragma omp parallel reduction(+:edge_cut)
+        {
+            std::vector<IndexType> neighbours;
+
+            #pragma omp for
+            for (int i = 0; i < static_cast<int>(mNodesPartitions.size()); ++i)
+            {
+                neighbours.clear();
+                for (IndexType j = rNodeElementsIndex[i]; j < rNodeElementsIndex[i + 1]; ++j)
+                {
+                    const std::vector<IndexType>& r_nodes = rElementsConnectivities[rNodeElements[j]];
+                    for (std::size_t k = 0; k < r_nodes.size(); ++k)
+                        if (r_nodes[k] - 1 > static_cast<IndexType>(i) && mNodesPartitions[r_nodes[k] - 1] != mNodesPartitions[i])
+                            neighbours.push_back(r_nodes[k]);
+                }
+                std::sort(neighbours.begin(), neighbours.end());
+                edge_cut += std::unique(neighbours.begin(), neighbours.end()) - neighbours.begin();
+            }
+        }
+
+        mEdgeCut = edge_cut;
+    }
+
+    double Imbalance(const PartitionIndicesType& rPartitions) const
+    {
+        if (rPartitions.empty())
+            return 1.0;
+
+        std::vector<SizeType> counts(mNumberOfPartitions, 0);
+        for (IndexType i = 0; i < rPartitions.size(); ++i)
+            ++counts[rPartitions[i]];
+
+        const double average = static_cast<double>(rPartitions.size()) / mNumberOfPartitions;
+        return *std::max_element(counts.begin(), counts.end()) / average;
+    }
+
+    ///@}
+
+}; // Class MeshPartitioningUtility
+
+///@}
+
+/// output stream function
+inline std::ostream& operator << (std::ostream& rOStream, const MeshPartitioningUtility& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_MESH_PARTITIONING_UTILITY_H_INCLUDED  defined
@@ -0,0 +1,699 @@
+//    |  /           |
+//    ' /   __| _` | __|  _ \   __|
+//    . \  |   (   | |   (   |\__ `
+//   _|\_\_|  \__,_|\__|\___/ ____/
+//                   Multi-Physics
+//
+//  License:         BSD License
+//                     Kratos default license: kratos/license.txt
+//
+//  Main authors:    Hoang-Giang Bui
+//
+//
+
+#if !defined(KRATOS_MODEL_PART_REORDERING_UTILITY_H_INCLUDED )
+#define  KRATOS_MODEL_PART_REORDERING_UTILITY_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "utilities/mesh_partitioning_utility.h"
+
+
+namespace Kratos
+{
+
+///@name  Enum's
+///@{
+
+/// The order given to the elements by the ModelPartReorderingUtility
+enum class ModelPartReorderingType
+{
+    HilbertCurve,           // the elements are sorted by the Hilbert index of their centroid
+    ReverseCuthillMcKee     // the elements are ordered by the reverse Cuthill-McKee algorithm on the dual graph (elements sharing a node)
+};
+
+///@}
+///@name Kratos Classes
+///@{
+
+/**
+ * @class ModelPartReorderingUtility
+ * @ingroup KratosCore
+ * @brief Reordering of the nodes, elements and conditions of a model part for the locality of the assembly
+ * @details The elements are ordered along a Hilbert curve or by the reverse Cuthill-McKee algorithm, the nodes
+ * are numbered in the order they are first met along the elements (the nodes without element follow in their
+ * previous order), and the conditions are ordered by the first of their nodes. The entities are renumbered consecutively
+ * in this order and the containers of the model part, its meshes and its sub model parts are sorted again, so the
+ * iteration over the elements touches nearby nodes and, once the dofs are set up again, nearby rows of the system.
+ * Reorder does not move the entities in memory, where they stay in the order they were created (e.g. read). Relocate
+ * allocates them anew in the order of the containers, so the iteration also runs through contiguous memory.
+ * The original ids are kept in the utility, to translate the ids from and to the input, or to give them back to
+ * the model part with RestoreIds. The ids stored in the variables of the entities are not translated. The
+ * reordering must be done before the dofs of the solving strategy are set up.
+ */
+template<class TModelPartType>
+class ModelPartReorderingUtility
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of ModelPartReorderingUtility
+    KRATOS_CLASS_POINTER_DEFINITION(ModelPartReorderingUtility);
+
+    typedef std::size_t IndexType;
+
+    typedef std::size_t SizeType;
+
+    typedef TModelPartType ModelPartType;
+
+    typedef typename ModelPartType::NodeType NodeType;
+
+    typedef typename ModelPartType::ElementType ElementType;
+
+    typedef typename ModelPartType::ConditionType ConditionType;
+
+    typedef typename ModelPartType::GeometryType GeometryType;
+
+    typedef typename ModelPartType::MeshType MeshType;
+
+    typedef MeshPartitioningUtility::PointType PointType;
+
+    typedef MeshPartitioningUtility::KeyType KeyType;
+
+    typedef std::vector<IndexType> IdsContainerType;
+
+    typedef std::unordered_map<IndexType, IndexType> IdsMapType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor.
+    ModelPartReorderingUtility(const ModelPartReorderingType Type = ModelPartReorderingType::HilbertCurve) : mType(Type) {}
+
+    /// Destructor.
+    virtual ~ModelPartReorderingUtility() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Renumber and sort the nodes, elements and conditions of the root model part
+    void Reorder(ModelPartType& rModelPart)
+    {
+        KRATOS_TRY
+
+        KRATOS_ERROR_IF(rModelPart.IsSubModelPart()) << "The model part " << rModelPart.Name()
+            << " is a sub model part, only a root model part can be reordered";
+
+        SortContainers(rModelPart);
+
+        std::vector<NodeType*> nodes;
+        std::vector<ElementType*> elements;
+        std::vector<ConditionType*> conditions;
+        GetEntities(rModelPart.NodesBegin(), rModelPart.NodesEnd(), nodes);
+        GetEntities(rModelPart.ElementsBegin(), rModelPart.ElementsEnd(), elements);
+        GetEntities(rModelPart.ConditionsBegin(), rModelPart.ConditionsEnd(), conditions);
+
+        // the connectivities, as positions in the nodes container
+        IdsContainerType nodes_ids(nodes.size());
+        for (IndexType i = 0; i < nodes.size(); ++i)
+            nodes_ids[i] = nodes[i]->Id();
+
+        std::vector<IndexType> element_nodes_index, element_nodes, condition_nodes_index, condition_nodes;
+        BuildConnectivities(elements, nodes_ids, "element", element_nodes_index, element_nodes);
+        BuildConnectivities(conditions, nodes_ids, "condition", condition_nodes_index, condition_nodes);
+
+        // the new order of the elements, then of the nodes and of the conditions
+        std::vector<IndexType> elements_order;
+        if (mType == ModelPartReorderingType::HilbertCurve)
+            HilbertCurveOrder(nodes, element_nodes_index, element_nodes, elements_order);
+        else
+            ReverseCuthillMcKeeOrder(nodes.size(), element_nodes_index, element_nodes, elements_order);
+
+        std::vector<IndexType> nodes_order;
+        nodes_order.reserve(nodes.size());
+        std::vector<IndexType> nodes_positions(nodes.size(), nodes.size());
+        for (IndexType i = 0; i < elements_order.size(); ++i)
+        {
+            const IndexType e = elements_order[i];
+            for (IndexType j = element_nodes_index[e]; j < element_nodes_index[e + 1]; ++j)
+                if (nodes_positions[element_nodes[j]] == nodes.size())
+                {
+                    nodes_positions[element_nodes[j]] = nodes_order.size();
+                    nodes_order.push_back(element_nodes[j]);
+                }
+        }
+        for (IndexType i = 0; i < nodes.size(); ++i)
+            if (nodes_positions[i] == nodes.size())
+            {
+                nodes_positions[i] = nodes_order.size();
+                nodes_order.push_back(i);
+            }
+
+        std::vector<IndexType> conditions_keys(conditions.size(), nodes.size());
+        for (IndexType c = 0; c < conditions.size(); ++c)
+            for (IndexType j = condition_nodes_index[c]; j < condition_nodes_index[c + 1]; ++j)
+                conditions_keys[c] = std::min(conditions_keys[c], nodes_positions[condition_nodes[j]]);
+
+        std::vector<IndexType> conditions_order(conditions.size());
+        std::iota(conditions_order.begin(), conditions_order.end(), 0);
+        std::stable_sort(conditions_order.begin(), conditions_order.end(),
+            [&conditions_keys](const IndexType a, const IndexType b) { return conditions_keys[a] < conditions_keys[b]; });
+
+        Renumber(nodes, nodes_order, mOriginalNodesIds, mNodesIds);
+        Renumber(elements, elements_order, mOriginalElementsIds, mElementsIds);
+        Renumber(conditions, conditions_order, mOriginalConditionsIds, mConditionsIds);
+        mIsReordered = true;
+
+        SortContainers(rModelPart);
+
+        KRATOS_CATCH("")
+    }
+
+    /**
+     * @brief Allocate the nodes, elements and conditions of the root model part anew, in the order of their containers
+     * @details The nodes are copied with their dofs and values, the elements and conditions are created by their
+     * Create method on the new nodes and get the flags and the data of the old ones. The new entities replace the
+     * old ones in all the meshes of the model part, of its communicator and of its sub model parts. Any other
+     * pointer to the old entities is left to the old entities, and the state of the derived elements and
+     * conditions is not carried over, so the relocation is done after reading the model part and before the
+     * elements and conditions are initialized. The master-slave constraints, which refer to the dofs of the
+     * nodes, are not supported.
+     */
+    static void Relocate(ModelPartType& rModelPart)
+    {
+        KRATOS_TRY
+
+        KRATOS_ERROR_IF(rModelPart.IsSubModelPart()) << "The model part " << rModelPart.Name()
+            << " is a sub model part, only a root model part can be relocated";
+
+        ForEachMesh(rModelPart, [](MeshType& rMesh)
+        {
+            KRATOS_ERROR_IF(rMesh.NumberOfMasterSlaveConstraints() != 0)
+                << "The master-slave constraints refer to the dofs of the nodes, a model part with constraints cannot be relocated";
+        });
+
+        SortContainers(rModelPart);
+
+        std::vector<typename NodeType::Pointer> nodes;
+        IdsContainerType nodes_ids;
+        nodes.reserve(rModelPart.NumberOfNodes());
+        nodes_ids.reserve(rModelPart.NumberOfNodes());
+        for (auto it = rModelPart.NodesBegin(); it != rModelPart.NodesEnd(); ++it)
+        {
+            nodes.push_back(typename NodeType::Pointer(new NodeType(*it)));
+            nodes_ids.push_back(it->Id());
+        }
+
+        std::vector<typename ElementType::Pointer> elements;
+        std::vector<typename ConditionType::Pointer> conditions;
+        IdsContainerType elements_ids, conditions_ids;
+        RelocateEntities(rModelPart.ElementsBegin(), rModelPart.ElementsEnd(), nodes, nodes_ids, "element", elements, elements_ids);
+        RelocateEntities(rModelPart.ConditionsBegin(), rModelPart.ConditionsEnd(), nodes, nodes_ids, "condition", conditions, conditions_ids);
+
+        ForEachMesh(rModelPart, [&](MeshType& rMesh)
+        {
+            ReplaceEntities(rMesh.Nodes(), nodes, nodes_ids);
+            ReplaceEntities(rMesh.Elements(), elements, elements_ids);
+            ReplaceEntities(rMesh.Conditions(), conditions, conditions_ids);
+        });
+
+        KRATOS_CATCH("")
+    }
+
+    /// Give back the original ids to the nodes, elements and conditions of the reordered model part, in their original order
+    void RestoreIds(ModelPartType& rModelPart)
+    {
+        KRATOS_TRY
+
+        KRATOS_ERROR_IF(rModelPart.IsSubModelPart()) << "The model part " << rModelPart.Name()
+            << " is a sub model part, the ids are restored on the root model part";
+
+        RestoreEntitiesIds(rModelPart.NodesBegin(), rModelPart.NodesEnd(), mOriginalNodesIds, "node");
+        RestoreEntitiesIds(rModelPart.ElementsBegin(), rModelPart.ElementsEnd(), mOriginalElementsIds, "element");
+        RestoreEntitiesIds(rModelPart.ConditionsBegin(), rModelPart.ConditionsEnd(), mOriginalConditionsIds, "condition");
+
+        SortContainers(rModelPart);
+
+        Clear();
+
+        KRATOS_CATCH("")
+    }
+
+    /// Forget the original ids
+    void Clear()
+    {
+        IdsContainerType().swap(mOriginalNodesIds);
+        IdsContainerType().swap(mOriginalElementsIds);
+        IdsContainerType().swap(mOriginalConditionsIds);
+        IdsMapType().swap(mNodesIds);
+        IdsMapType().swap(mElementsIds);
+        IdsMapType().swap(mConditionsIds);
+        mIsReordered = false;
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+    ModelPartReorderingType GetReorderingType() const {return mType;}
+
+    /// The original id of the node of the given id, after the reordering
+    IndexType GetOriginalNodeId(const IndexType Id) const {return GetOriginalId(Id, mOriginalNodesIds, "node");}
+
+    IndexType GetOriginalElementId(const IndexType Id) const {return GetOriginalId(Id, mOriginalElementsIds, "element");}
+
+    IndexType GetOriginalConditionId(const IndexType Id) const {return GetOriginalId(Id, mOriginalConditionsIds, "condition");}
+
+    /// The id of the node of the given original id, after the reordering
+    IndexType GetNodeId(const IndexType OriginalId) const {return GetId(OriginalId, mNodesIds, "node");}
+
+    IndexType GetElementId(const IndexType OriginalId) const {return GetId(OriginalId, mElementsIds, "element");}
+
+    IndexType GetConditionId(const IndexType OriginalId) const {return GetId(OriginalId, mConditionsIds, "condition");}
+
+    /// The original ids of the nodes, at position id - 1
+    const IdsContainerType& GetOriginalNodesIds() const {return mOriginalNodesIds;}
+
+    const IdsContainerType& GetOriginalElementsIds() const {return mOriginalElementsIds;}
+
+    const IdsContainerType& GetOriginalConditionsIds() const {return mOriginalConditionsIds;}
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+    bool IsReordered() const {return mIsReordered;}
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        return "ModelPartReorderingUtility";
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << "Reordering: " << ((mType == ModelPartReorderingType::HilbertCurve) ? "Hilbert curve" : "reverse Cuthill-McKee") << std::endl;
+        rOStream << "Reordered nodes: " << mOriginalNodesIds.size() << std::endl;
+        rOStream << "Reordered elements: " << mOriginalElementsIds.size() << std::endl;
+        rOStream << "Reordered conditions: " << mOriginalConditionsIds.size() << std::endl;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    ModelPartReorderingType mType;
+
+    bool mIsReordered = false;
+
+    IdsContainerType mOriginalNodesIds, mOriginalElementsIds, mOriginalConditionsIds; // the original id of the entity of id i + 1 at position i
+
+    IdsMapType mNodesIds, mElementsIds, mConditionsIds; // the id of the entity of each original id
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// Apply the function to the meshes of the model part, of its communicator and of its sub model parts. A mesh
+    /// shared by several of them is visited several times
+    template<class TFunctionType>
+    static void ForEachMesh(ModelPartType& rModelPart, TFunctionType&& rFunction)
+    {
+        for (auto it_mesh = rModelPart.GetMeshes().begin(); it_mesh != rModelPart.GetMeshes().end(); ++it_mesh)
+            rFunction(*it_mesh);
+
+        auto& r_communicator = rModelPart.GetCommunicator();
+        rFunction(r_communicator.LocalMesh());
+        rFunction(r_communicator.GhostMesh());
+        rFunction(r_communicator.InterfaceMesh());
+        for (auto it_mesh = r_communicator.LocalMeshes().begin(); it_mesh != r_communicator.LocalMeshes().end(); ++it_mesh)
+            rFunction(*it_mesh);
+        for (auto it_mesh = r_communicator.GhostMeshes().begin(); it_mesh != r_communicator.GhostMeshes().end(); ++it_mesh)
+            rFunction(*it_mesh);
+        for (auto it_mesh = r_communicator.InterfaceMeshes().begin(); it_mesh != r_communicator.InterfaceMeshes().end(); ++it_mesh)
+            rFunction(*it_mesh);
+
+        for (auto it_sub_model_part = rModelPart.SubModelPartsBegin(); it_sub_model_part != rModelPart.SubModelPartsEnd(); ++it_sub_model_part)
+        {
+            ModelPartType* p_sub_model_part = dynamic_cast<ModelPartType*>(&(*it_sub_model_part));
+            KRATOS_ERROR_IF(p_sub_model_part == nullptr) << "The sub ModelPart is not the same type as the current ModelPart" << std::endl;
+            ForEachMesh(*p_sub_model_part, rFunction);
+        }
+    }
+
+    /// Sort the containers of all the meshes by id
+    static void SortContainers(ModelPartType& rModelPart)
+    {
+        ForEachMesh(rModelPart, [](MeshType& rMesh)
+        {
+            rMesh.Nodes().Sort();
+            rMesh.Elements().Sort();
+            rMesh.Conditions().Sort();
+        });
+    }
+
+    /// The position of the id in the sorted ids, or the number of ids if it is not found
+    static IndexType FindId(const IdsContainerType& rIds, const IndexType Id)
+    {
+        const auto it = std::lower_bound(rIds.begin(), rIds.end(), Id);
+        return (it != rIds.end() && *it == Id) ? static_cast<IndexType>(it - rIds.begin()) : rIds.size();
+    }
+
+    /// Create the copies of the entities on the new nodes, one after the other to allocate them contiguously
+    template<class TIteratorType, class TEntityPointerType>
+    static void RelocateEntities(TIteratorType itBegin, TIteratorType itEnd, const std::vector<typename NodeType::Pointer>& rNodes,
+                                 const IdsContainerType& rNodesIds, const std::string& rName,
+                                 std::vector<TEntityPointerType>& rEntities, IdsContainerType& rIds)
+    {
+        rEntities.clear();
+        rIds.clear();
+        rEntities.reserve(std::distance(itBegin, itEnd));
+        rIds.reserve(std::distance(itBegin, itEnd));
+        for (auto it = itBegin; it != itEnd; ++it)
+        {
+            const auto& r_entity = *it; // the non-const Data() is protected
+            const GeometryType& r_geometry = r_entity.GetGeometry();
+
+            typename GeometryType::PointsArrayType points;
+            for (IndexType k = 0; k < r_geometry.size(); ++k)
+            {
+                const IndexType position = FindId(rNodesIds, r_geometry[k].Id());
+                KRATOS_ERROR_IF(position == rNodesIds.size()) << "The " << rName << " " << r_entity.Id() << " refers to the node "
+                    << r_geometry[k].Id() << ", which is not in the model part";
+                points.push_back(rNodes[position]);
+            }
+
+            TEntityPointerType p_entity = r_entity.Create(r_entity.Id(), points, it->pGetProperties());
+            p_entity->SetData(r_entity.Data());
+            static_cast<Flags&>(*p_entity) = static_cast<const Flags&>(r_entity);
+
+            rEntities.push_back(p_entity);
+            rIds.push_back(r_entity.Id());
+        }
+    }
+
+    /// Replace the entities of the container by their copies of the same id
+    template<class TContainerType, class TEntityPointerType>
+    static void ReplaceEntities(TContainerType& rContainer, const std::vector<TEntityPointerType>& rEntities, const IdsContainerType& rIds)
+    {
+        for (auto it = rContainer.ptr_begin(); it != rContainer.ptr_end(); ++it)
+        {
+            const IndexType position = FindId(rIds, (*it)->Id());
+            if (position != rIds.size())
+                *it = rEntities[position];
+        }
+    }
+
+    template<class TIteratorType, class TEntityType>
+    static void GetEntities(TIteratorType itBegin, TIteratorType itEnd, std::vector<TEntityType*>& rEntities)
+    {
+        rEntities.clear();
+        rEntities.reserve(std::distance(itBegin, itEnd));
+        for (auto it = itBegin; it != itEnd; ++it)
+            rEntities.push_back(&(*it));
+    }
+
+    /// The positions of the nodes of each entity in the sorted ids of the nodes, in CSR format
+    template<class TEntityType>
+    static void BuildConnectivities(const std::vector<TEntityType*>& rEntities, const IdsContainerType& rNodesIds, const std::string& rName,
+                                    std::vector<IndexType>& rIndex, std::vector<IndexType>& rNodes)
+    {
+        rIndex.resize(rEntities.size() + 1);
+        rIndex[0] = 0;
+        for (IndexType i = 0; i < rEntities.size(); ++i)
+            rIndex[i + 1] = rIndex[i] + rEntities[i]->GetGeometry().size();
+
+        rNodes.resize(rIndex.back());
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(rEntities.size()); ++i)
+        {
+            const GeometryType& r_geometry = rEntities[i]->GetGeometry();
+            for (IndexType k = 0; k < r_geometry.size(); ++k)
+                rNodes[rIndex[i] + k] = FindId(rNodesIds, r_geometry[k].Id());
+        }
+
+        for (IndexType i = 0; i < rEntities.size(); ++i)
+            for (IndexType j = rIndex[i]; j < rIndex[i + 1]; ++j)
+                KRATOS_ERROR_IF(rNodes[j] == rNodesIds.size()) << "The " << rName << " " << rEntities[i]->Id() << " refers to the node "
+                    << rEntities[i]->GetGeometry()[j - rIndex[i]].Id() << ", which is not in the model part";
+    }
+
+    /// The elements sorted by the Hilbert index of their centroid
+    static void HilbertCurveOrder(const std::vector<NodeType*>& rNodes, const std::vector<IndexType>& rElementNodesIndex,
+                                  const std::vector<IndexType>& rElementNodes, std::vector<IndexType>& rOrder)
+    {
+        const SizeType number_of_elements = rElementNodesIndex.size() - 1;
+
+        std::vector<PointType> centroids(number_of_elements);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_elements); ++i)
+        {
+            PointType& r_centroid = centroids[i];
+            r_centroid = ZeroVector(3);
+            for (IndexType j = rElementNodesIndex[i]; j < rElementNodesIndex[i + 1]; ++j)
+            {
+                const NodeType& r_node = *rNodes[rElementNodes[j]];
+                r_centroid[0] += r_node.X();
+                r_centroid[1] += r_node.Y();
+                r_centroid[2] += r_node.Z();
+            }
+            if (rElementNodesIndex[i + 1] > rElementNodesIndex[i])
+                r_centroid /= static_cast<double>(rElementNodesIndex[i + 1] - rElementNodesIndex[i]);
+        }
+
+        PointType min_point, max_point;
+        MeshPartitioningUtility::ComputeBoundingBox(centroids, min_point, max_point);
+
+        std::vector<std::pair<KeyType, IndexType> > sorted_elements(number_of_elements);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_elements); ++i)
+            sorted_elements[i] = std::make_pair(MeshPartitioningUtility::HilbertKey(centroids[i], min_point, max_point), static_cast<IndexType>(i));
+
+        MeshPartitioningUtility::ParallelSort(sorted_elements);
+
+        rOrder.resize(number_of_elements);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(number_of_elements); ++i)
+            rOrder[i] = sorted_elements[i].second;
+    }
+
+    /**
+     * @brief The elements ordered by the reverse Cuthill-McKee algorithm on the dual graph
+     * @details Each connected component is visited breadth first from a pseudo-peripheral element, found as
+     * by George and Liu, and the neighbours of each element are visited by increasing degree. The degree of an
+     * element counts its neighbours once per shared node, which saves building the dual graph.
+     */
+    static void ReverseCuthillMcKeeOrder(const SizeType NumberOfNodes, const std::vector<IndexType>& rElementNodesIndex,
+                                         const std::vector<IndexType>& rElementNodes, std::vector<IndexType>& rOrder)
+    {
+        const SizeType number_of_elements = rElementNodesIndex.size() - 1;
+
+        // the elements of each node
+        std::vector<IndexType> node_elements_index(NumberOfNodes + 1, 0), node_elements(rElementNodes.size());
+        for (IndexType j = 0; j < rElementNodes.size(); ++j)
+            ++node_elements_index[rElementNodes[j] + 1];
+        for (IndexType i = 0; i < NumberOfNodes; ++i)
+            node_elements_index[i + 1] += node_elements_index[i];
+        std::vector<IndexType> position(node_elements_index.begin(), node_elements_index.end() - 1);
+        for (IndexType e = 0; e < number_of_elements; ++e)
+            for (IndexType j = rElementNodesIndex[e]; j < rElementNodesIndex[e + 1]; ++j)
+                node_elements[position[rElementNodes[j]]++] = e;
+        std::vector<IndexType>().swap(position);
+
+        std::vector<SizeType> degrees(number_of_elements);
+        #pragma omp parallel for
+        for (int e = 0; e < static_cast<int>(number_of_elements); ++e)
+        {
+            SizeType degree = 0;
+            for (IndexType j = rElementNodesIndex[e]; j < rElementNodesIndex[e + 1]; ++j)
+                degree += node_elements_index[rElementNodes[j] + 1] - node_elements_index[rElementNodes[j]] - 1;
+            degrees[e] = degree;
+        }
+
+        // the roots of the components are taken by increasing degree
+        std::vector<IndexType> roots(number_of_elements);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::stable_sort(roots.begin(), roots.end(), [&degrees](const IndexType a, const IndexType b) { return degrees[a] < degrees[b]; });
+
+        rOrder.clear();
+        rOrder.reserve(number_of_elements);
+        std::vector<SizeType> markers(number_of_elements, 0);
+        SizeType stamp = 0;
+        std::vector<IndexType> queue, neighbours;
+        for (IndexType r = 0; r < number_of_elements; ++r)
+        {
+            IndexType root = roots[r];
+            if (markers[root] != 0)
+                continue;
+
+            // the pseudo-peripheral element of the component
+            IndexType last_level_begin = 0;
+            SizeType levels = Visit(root, rElementNodesIndex, rElementNodes, node_elements_index, node_elements, degrees, markers, ++stamp, queue, neighbours, last_level_begin);
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                IndexType candidate = queue[last_level_begin];
+                for (IndexType q = last_level_begin + 1; q < queue.size(); ++q)
+                    if (degrees[queue[q]] < degrees[candidate])
+                        candidate = queue[q];
+
+                const SizeType candidate_levels = Visit(candidate, rElementNodesIndex, rElementNodes, node_elements_index, node_elements, degrees, markers, ++stamp, queue, neighbours, last_level_begin);
+                if (candidate_levels <= levels)
+                    break;
+                root = candidate;
+                levels = candidate_levels;
+            }
+
+            Visit(root, rElementNodesIndex, rElementNodes, node_elements_index, node_elements, degrees, markers, ++stamp, queue, neighbours, last_level_begin);
+            rOrder.insert(rOrder.end(), queue.begin(), queue.end());
+        }
+
+        std::reverse(rOrder.begin(), rOrder.end());
+    }
+
+    /// Visit the component of Root breadth first, marking its elements with Stamp. Returns the number of levels,
+    /// rQueue holds the visited elements and its elements from rLastLevelBegin are the last level
+    static SizeType Visit(const IndexType Root, const std::vector<IndexType>& rElementNodesIndex, const std::vector<IndexType>& rElementNodes,
+                          const std::vector<IndexType>& rNodeElementsIndex, const std::vector<IndexType>& rNodeElements,
+                          const std::vector<SizeType>& rDegrees, std::vector<SizeType>& rMarkers, const SizeType Stamp,
+                          std::vector<IndexType>& rQueue, std::vector<IndexType>& rNeighbours, IndexType& rLastLevelBegin)
+    {
+        rQueue.clear();
+        rQueue.push_back(Root);
+        rMarkers[Root] = Stamp;
+
+        SizeType levels = 0;
+        IndexType level_begin = 0;
+        while (level_begin < rQueue.size())
+        {
+            const IndexType level_end = rQueue.size();
+            rLastLevelBegin = level_begin;
+            ++levels;
+
+            for (IndexType q = level_begin; q < level_end; ++q)
+            {
+                const IndexType e = rQueue[q];
+                rNeighbours.clear();
+                for (IndexType j = rElementNodesIndex[e]; j < rElementNodesIndex[e + 1]; ++j)
+                {
+                    const IndexType n = rElementNodes[j];
+                    for (IndexType k = rNodeElementsIndex[n]; k < rNodeElementsIndex[n + 1]; ++k)
+                    {
+                        const IndexType f = rNodeElements[k];
+                        if (rMarkers[f] != Stamp)
+                        {
+                            rMarkers[f] = Stamp;
+                            rNeighbours.push_back(f);
+                        }
+                    }
+                }
+
+                std::sort(rNeighbours.begin(), rNeighbours.end(), [&rDegrees](const IndexType a, const IndexType b)
+                    { return rDegrees[a] < rDegrees[b] || (rDegrees[a] == rDegrees[b] && a < b); });
+                rQueue.insert(rQueue.end(), rNeighbours.begin(), rNeighbours.end());
+            }
+
+            level_begin = level_end;
+        }
+
+        return levels;
+    }
+
+    /// Number the entities consecutively in the given order and update the original ids, which compose with a previous reordering
+    template<class TEntityType>
+    void Renumber(const std::vector<TEntityType*>& rEntities, const std::vector<IndexType>& rOrder, IdsContainerType& rOriginalIds, IdsMapType& rIds) const
+    {
+        IdsContainerType original_ids(rOrder.size());
+        for (IndexType i = 0; i < rOrder.size(); ++i)
+        {
+            const IndexType id = rEntities[rOrder[i]]->Id();
+            original_ids[i] = (mIsReordered && id >= 1 && id <= rOriginalIds.size()) ? rOriginalIds[id - 1] : id;
+        }
+
+        for (IndexType i = 0; i < rOrder.size(); ++i)
+            rEntities[rOrder[i]]->SetId(i + 1);
+
+        rOriginalIds.swap(original_ids);
+
+        rIds.clear();
+        rIds.reserve(rOriginalIds.size());
+        for (IndexType i = 0; i < rOriginalIds.size(); ++i)
+            rIds[rOriginalIds[i]] = i + 1;
+    }
+
+    template<class TIteratorType>
+    void RestoreEntitiesIds(TIteratorType itBegin, TIteratorType itEnd, const IdsContainerType& rOriginalIds, const std::string& rName) const
+    {
+        KRATOS_ERROR_IF(!mIsReordered) << "The model part is not reordered";
+        KRATOS_ERROR_IF(static_cast<SizeType>(std::distance(itBegin, itEnd)) != rOriginalIds.size())
+            << "The number of " << rName << "s changed since the reordering";
+
+        for (auto it = itBegin; it != itEnd; ++it)
+            it->SetId(GetOriginalId(it->Id(), rOriginalIds, rName));
+    }
+
+    IndexType GetOriginalId(const IndexType Id, const IdsContainerType& rOriginalIds, const std::string& rName) const
+    {
+        KRATOS_ERROR_IF(!mIsReordered) << "The model part is not reordered";
+        KRATOS_ERROR_IF(Id == 0 || Id > rOriginalIds.size()) << "There is no reordered " << rName << " with id " << Id;
+        return rOriginalIds[Id - 1];
+    }
+
+    IndexType GetId(const IndexType OriginalId, const IdsMapType& rIds, const std::string& rName) const
+    {
+        KRATOS_ERROR_IF(!mIsReordered) << "The model part is not reordered";
+        const auto it = rIds.find(OriginalId);
+        KRATOS_ERROR_IF(it == rIds.end()) << "There is no reordered " << rName << " with original id " << OriginalId;
+        return it->second;
+    }
+
+    ///@}
+
+}; // Class ModelPartReorderingUtility
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+template<class TModelPartType>
+inline std::ostream& operator << (std::ostream& rOStream, const ModelPartReorderingUtility<TModelPartType>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+
+///@}
+
+}  // namespace Kratos.
+
+#endif // KRATOS_MODEL_PART_REORDERING_UTILITY_H_INCLUDED  defined
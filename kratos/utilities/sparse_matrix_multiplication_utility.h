@@ -18,6 +18,9 @@
 #include <math.h>
 #include <algorithm>
 #include <numeric>
+#include <memory>
+#include <string>
+#include <iostream>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -27,6 +30,7 @@
 
 // Project includes
 #include "includes/define.h"
+#include "includes/key_hash.h"
 
 namespace Kratos
 {
@@ -286,25 +290,17 @@ public:
 
         IndexType max_row_width = 0;
 
-        #pragma omp parallel
-        {
-            IndexType my_max = 0;
+        #pragma omp parallel for reduction(max : max_row_width)
+        for(int i = 0; i < static_cast<int>(nrows); ++i) {
+            const IndexType row_beg = index1_a[i];
+            const IndexType row_end = index1_a[i+1];
 
-            #pragma omp for
-            for(int i = 0; i < static_cast<int>(nrows); ++i) {
-                const IndexType row_beg = index1_a[i];
-                const IndexType row_end = index1_a[i+1];
-
-                IndexType row_width = 0;
-                for(IndexType j = row_beg; j < row_end; ++j) {
-                    const IndexType a_col = index2_a[j];
-                    row_width += index1_b[a_col + 1] - index1_b[a_col];
-                }
-                my_max = std::max(my_max, row_width);
+            IndexType row_width = 0;
+            for(IndexType j = row_beg; j < row_end; ++j) {
+                const IndexType a_col = index2_a[j];
+                row_width += index1_b[a_col + 1] - index1_b[a_col];
             }
-
-            #pragma omp critical
-            max_row_width = std::max(max_row_width, my_max);
+            max_row_width = std::max(max_row_width, row_width);
         }
 
     #ifdef _OPENMP
@@ -517,8 +513,10 @@ public:
 
     /**
      * @brief This method computes of the transpose matrix of a given matrix
+     * @details The values are gathered in parallel with the positions of TransposePattern
      * @param rA The resulting matrix
      * @param rB The second matrix to transpose
+     * @param Factor The factor of the values of the transpose
      */
     template <class AMatrix, class BMatrix, typename TDataType>
     static void TransposeMatrix(
@@ -529,12 +527,6 @@ public:
     {
         typedef typename value_type<AMatrix>::type ValueType;
 
-        // Get access to B data
-        const IndexType* index1 = rB.index1_data().begin();
-        const IndexType* index2 = rB.index2_data().begin();
-        const ValueType* data = rB.value_data().begin();
-        const SizeType transpose_nonzero_values = rB.value_data().end() - rB.value_data().begin();
-
         const SizeType size_system_1 = rB.size1();
         const SizeType size_system_2 = rB.size2();
 
@@ -542,56 +534,104 @@ public:
             rA.resize(size_system_2, size_system_1, false);
         }
 
-        IndexVectorType new_a_ptr(size_system_2 + 1);
-        #pragma omp parallel for
-        for (int i = 0; i < static_cast<int>(size_system_2 + 1); ++i)
-            new_a_ptr[i] = 0;
-        IndexVectorType aux_index2_new_a(transpose_nonzero_values);
-        vector<ValueType> aux_val_new_a(transpose_nonzero_values);
+        IndexVectorType new_a_ptr, aux_index2_new_a, positions;
+        TransposePattern(rB, new_a_ptr, aux_index2_new_a, positions);
 
+        const auto* data = rB.value_data().begin();
+        const SizeType transpose_nonzero_values = positions.size();
+        vector<ValueType> aux_val_new_a(transpose_nonzero_values);
         #pragma omp parallel for
-        for (int i=0; i<static_cast<int>(size_system_1); ++i) {
-            IndexType row_begin = index1[i];
-            IndexType row_end   = index1[i+1];
+        for (int i = 0; i < static_cast<int>(transpose_nonzero_values); ++i)
+            aux_val_new_a[i] = Factor * data[positions[i]];
 
-            for (IndexType j=row_begin; j<row_end; j++) {
-                #pragma omp atomic
-                new_a_ptr[index2[j] + 1] += 1;
-            }
-        }
+        // We fill the matrix
+        CreateSolutionMatrix(rA, size_system_2, size_system_1, new_a_ptr.data().begin(), aux_index2_new_a.data().begin(), aux_val_new_a.data().begin());
+    }
 
-        // We initialize the blocks sparse matrix
-        std::partial_sum(new_a_ptr.begin(), new_a_ptr.end(), &new_a_ptr[0]);
+    /**
+     * @brief This method computes the pattern of the transpose of a given matrix, with sorted rows
+     * @details With several threads, the entries of the columns of rA are counted and placed in parallel, then sorted
+     * by rows, hence the pattern does not depend on the number of threads
+     * @param rA The matrix to transpose
+     * @param rRowStarts The beginnings of the rows of the transpose
+     * @param rColumns The columns of the entries of the transpose (the rows of rA)
+     * @param rPositions The positions of the entries of the transpose in the values of rA
+     */
+    template <class AMatrix>
+    static void TransposePattern(
+        const AMatrix& rA,
+        IndexVectorType& rRowStarts,
+        IndexVectorType& rColumns,
+        IndexVectorType& rPositions
+        )
+    {
+        // Get access to A data
+        const IndexType* index1 = rA.index1_data().begin();
+        const IndexType* index2 = rA.index2_data().begin();
 
-        IndexVectorType aux_indexes(size_system_2);
-        #pragma omp parallel for
-        for (int i = 0; i < static_cast<int>(size_system_2); ++i)
-            aux_indexes[i] = 0;
+        const SizeType size_system_1 = rA.size1();
+        const SizeType size_system_2 = rA.size2();
+        const SizeType nonzero_values = (size_system_1 == 0) ? 0 : index1[size_system_1];
 
-//         #pragma omp parallel for
-        for (int i=0; i<static_cast<int>(size_system_1); ++i) {
-            IndexType row_begin = index1[i];
-            IndexType row_end   = index1[i+1];
+        rRowStarts.resize(size_system_2 + 1, false);
+        rColumns.resize(nonzero_values, false);
+        rPositions.resize(nonzero_values, false);
 
-            for (IndexType j=row_begin; j<row_end; j++) {
-                const IndexType current_row = index2[j];
-                const IndexType initial_position = new_a_ptr[current_row];
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(size_system_2 + 1); ++i)
+            rRowStarts[i] = 0;
 
-                const IndexType current_index = initial_position + aux_indexes[current_row];
-                aux_index2_new_a[current_index] = i;
-                aux_val_new_a[current_index] = Factor * data[j];
+    #ifdef _OPENMP
+        const int nthreads = omp_get_max_threads();
+    #else
+        const int nthreads = 1;
+    #endif
 
-//                 #pragma omp atomic
-                aux_indexes[current_row] += 1;
+        if (nthreads == 1) {
+            for (IndexType j = 0; j < nonzero_values; ++j)
+                ++rRowStarts[index2[j] + 1];
+        } else {
+            #pragma omp parallel for
+            for (int i=0; i<static_cast<int>(size_system_1); ++i) {
+                for (IndexType j=index1[i]; j<index1[i+1]; j++) {
+                    #pragma omp atomic
+                    rRowStarts[index2[j] + 1] += 1;
+                }
             }
-
         }
 
-        // We reorder the rows
-        SortRows(&new_a_ptr[0], size_system_2, size_system_1, &aux_index2_new_a[0], &aux_val_new_a[0]);
+        std::partial_sum(rRowStarts.begin(), rRowStarts.end(), rRowStarts.begin());
 
-        // We fill the matrix
-        CreateSolutionMatrix(rA, size_system_2, size_system_1, &new_a_ptr[0], &aux_index2_new_a[0], &aux_val_new_a[0]);
+        IndexVectorType next_positions(size_system_2);
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(size_system_2); ++i)
+            next_positions[i] = rRowStarts[i];
+
+        if (nthreads == 1) {
+            // The rows of A are visited in order, hence the rows of the transpose are sorted
+            for (IndexType i=0; i<size_system_1; ++i) {
+                for (IndexType j=index1[i]; j<index1[i+1]; j++) {
+                    const IndexType position = next_positions[index2[j]]++;
+                    rColumns[position] = i;
+                    rPositions[position] = j;
+                }
+            }
+        } else {
+            #pragma omp parallel for
+            for (int i=0; i<static_cast<int>(size_system_1); ++i) {
+                for (IndexType j=index1[i]; j<index1[i+1]; j++) {
+                    IndexType position;
+                    #pragma omp atomic capture
+                    position = next_positions[index2[j]]++;
+
+                    rColumns[position] = i;
+                    rPositions[position] = j;
+                }
+            }
+
+            // The threads interleave the entries of the rows, which are sorted back
+            SortRows(rRowStarts.data().begin(), size_system_2, size_system_1, rColumns.data().begin(), rPositions.data().begin());
+        }
     }
 
     /**
@@ -1085,6 +1125,392 @@ private:
 
 }; // Class SparseMatrixMultiplicationUtility
 
+/**
+ * @class SparseMatrixProductPlan
+ * @ingroup KratosCore
+ * @brief The product C = A·B or C = Aᵀ·B of sparse matrices, for the products repeated with unchanged patterns
+ * @details Initialize computes the pattern of C once (the symbolic product) with its values, Multiply only recomputes
+ * the values of C in its storage from the current values of A and B, in parallel over the rows of C. The transpose of A is not
+ * assembled: the plan keeps the pattern of the columns of A and the positions of their entries in the values of A.
+ * Initialize must be called again when the pattern of A or B changes. Multiply only checks the sizes and the numbers of
+ * nonzeros of the matrices: a pattern with the same number of nonzeros is not detected. With KRATOS_DEBUG it also compares
+ * the hashes of the row starts and column indices with the ones kept by Initialize; this pass over the patterns costs
+ * about as much as the product itself, hence it is not done in release.
+ */
+template<class TMatrixType>
+class SparseMatrixProductPlan
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of SparseMatrixProductPlan
+    KRATOS_CLASS_POINTER_DEFINITION( SparseMatrixProductPlan );
+
+    typedef TMatrixType MatrixType;
+
+    typedef typename MatrixType::value_type ValueType;
+
+    typedef SparseMatrixMultiplicationUtility::SizeType SizeType;
+
+    typedef SparseMatrixMultiplicationUtility::IndexType IndexType;
+
+    typedef SparseMatrixMultiplicationUtility::SignedIndexType SignedIndexType;
+
+    typedef SparseMatrixMultiplicationUtility::IndexVectorType IndexVectorType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Constructor, of the product C = Aᵀ·B if TransposeA
+    explicit SparseMatrixProductPlan(const bool TransposeA = false)
+    : mTransposeA(TransposeA), mIsInitialized(false), mSize1(0), mSize2(0), mNonZerosA(0), mNonZerosB(0), mNonZerosC(0)
+    , mPatternHashA(0), mPatternHashB(0), mPatternHashC(0)
+    {}
+
+    /// Destructor
+    virtual ~SparseMatrixProductPlan() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /**
+     * @brief The symbolic and numeric product: rC is given the pattern of the product, with sorted rows, and its values
+     * @param rA The first matrix
+     * @param rB The second matrix
+     * @param rC The resulting matrix
+     */
+    void Initialize(
+        const MatrixType& rA,
+        const MatrixType& rB,
+        MatrixType& rC
+        )
+    {
+        const SizeType inner_size = mTransposeA ? rA.size1() : rA.size2();
+        KRATOS_ERROR_IF(inner_size != rB.size1()) << "The sizes of the matrices do not match for the product: " << inner_size << " and " << rB.size1() << std::endl;
+
+        mSize1 = mTransposeA ? rA.size2() : rA.size1();
+        mSize2 = rB.size2();
+
+        if (mTransposeA)
+            SparseMatrixMultiplicationUtility::TransposePattern(rA, mRowStartsA, mColumnsA, mPositionsA);
+
+        const IndexType* index1_a = mTransposeA ? mRowStartsA.data().begin() : rA.index1_data().begin();
+        const IndexType* index2_a = mTransposeA ? mColumnsA.data().begin() : rA.index2_data().begin();
+        const IndexType* positions_a = mTransposeA ? mPositionsA.data().begin() : nullptr;
+        const auto* values_a = rA.value_data().begin();
+        const IndexType* index1_b = rB.index1_data().begin();
+        const IndexType* index2_b = rB.index2_data().begin();
+        const auto* values_b = rB.value_data().begin();
+        const SizeType nrows = mSize1;
+        const SizeType ncols = mSize2;
+
+        IndexVectorType c_ptr(nrows + 1);
+        c_ptr[0] = 0;
+
+        #pragma omp parallel
+        {
+            std::vector<SignedIndexType> marker(ncols, -1);
+
+            #pragma omp for
+            for(int ia = 0; ia < static_cast<int>(nrows); ++ia) {
+                IndexType C_cols = 0;
+                for(IndexType ja = index1_a[ia]; ja < index1_a[ia+1]; ++ja) {
+                    const IndexType ca = index2_a[ja];
+                    for(IndexType jb = index1_b[ca]; jb < index1_b[ca+1]; ++jb) {
+                        const IndexType cb = index2_b[jb];
+                        if (marker[cb] != ia) {
+                            marker[cb] = ia;
+                            ++C_cols;
+                        }
+                    }
+                }
+                c_ptr[ia + 1] = C_cols;
+            }
+        }
+
+        std::partial_sum(c_ptr.begin(), c_ptr.end(), c_ptr.begin());
+        const SizeType nonzero_values = c_ptr[nrows];
+        IndexVectorType index2_c(nonzero_values);
+        std::vector<ValueType> values_c(nonzero_values);
+
+        #pragma omp parallel
+        {
+            std::vector<SignedIndexType> marker(ncols, -1);
+
+            #pragma omp for
+            for(int ia = 0; ia < static_cast<int>(nrows); ++ia) {
+                const IndexType row_beg = c_ptr[ia];
+                IndexType row_end = row_beg;
+                for(IndexType ja = index1_a[ia]; ja < index1_a[ia+1]; ++ja) {
+                    const IndexType ca = index2_a[ja];
+                    const ValueType va = values_a[(positions_a == nullptr) ? ja : positions_a[ja]];
+                    for(IndexType jb = index1_b[ca]; jb < index1_b[ca+1]; ++jb) {
+                        const IndexType cb = index2_b[jb];
+                        if (marker[cb] < static_cast<SignedIndexType>(row_beg)) {
+                            marker[cb] = row_end;
+                            index2_c[row_end] = cb;
+                            values_c[row_end] = va * values_b[jb];
+                            ++row_end;
+                        } else {
+                            values_c[marker[cb]] += va * values_b[jb];
+                        }
+                    }
+                }
+            }
+        }
+
+        // We reorder the rows
+        SparseMatrixMultiplicationUtility::SortRows(c_ptr.data().begin(), nrows, ncols, index2_c.data().begin(), values_c.data());
+
+        rC = MatrixType(nrows, ncols);
+        SparseMatrixMultiplicationUtility::CreateSolutionMatrix(rC, nrows, ncols, c_ptr.data().begin(), index2_c.data().begin(), values_c.data());
+
+        mNonZerosA = rA.nnz();
+        mNonZerosB = rB.nnz();
+        mNonZerosC = rC.nnz();
+        mPatternHashA = PatternHash(rA);
+        mPatternHashB = PatternHash(rB);
+        mPatternHashC = PatternHash(rC);
+        mIsInitialized = true;
+    }
+
+    /**
+     * @brief The numeric product, in the pattern given to rC by Initialize
+     * @param rA The first matrix
+     * @param rB The second matrix
+     * @param rC The resulting matrix
+     */
+    void Multiply(
+        const MatrixType& rA,
+        const MatrixType& rB,
+        MatrixType& rC
+        ) const
+    {
+        KRATOS_ERROR_IF(!mIsInitialized || rA.nnz() != mNonZerosA || rB.nnz() != mNonZerosB || rC.nnz() != mNonZerosC
+            || rC.size1() != mSize1 || rC.size2() != mSize2) << "The patterns of the matrices changed since the Initialize of the product" << std::endl;
+        KRATOS_DEBUG_ERROR_IF(PatternHash(rA) != mPatternHashA || PatternHash(rB) != mPatternHashB || PatternHash(rC) != mPatternHashC)
+            << "The patterns of the matrices changed since the Initialize of the product" << std::endl;
+
+        const IndexType* index1_a = mTransposeA ? mRowStartsA.data().begin() : rA.index1_data().begin();
+        const IndexType* index2_a = mTransposeA ? mColumnsA.data().begin() : rA.index2_data().begin();
+        const IndexType* positions_a = mTransposeA ? mPositionsA.data().begin() : nullptr;
+        const auto* values_a = rA.value_data().begin();
+        const IndexType* index1_b = rB.index1_data().begin();
+        const IndexType* index2_b = rB.index2_data().begin();
+        const auto* values_b = rB.value_data().begin();
+        const IndexType* index1_c = rC.index1_data().begin();
+        const IndexType* index2_c = rC.index2_data().begin();
+        auto* values_c = rC.value_data().begin();
+
+        #pragma omp parallel
+        {
+            // the positions in the row of C of its columns, only read for the columns of the row
+            std::unique_ptr<IndexType[]> position(new IndexType[mSize2]);
+
+            #pragma omp for
+            for(int ia = 0; ia < static_cast<int>(mSize1); ++ia) {
+                for(IndexType jc = index1_c[ia]; jc < index1_c[ia+1]; ++jc) {
+                    position[index2_c[jc]] = jc;
+                    values_c[jc] = ValueType();
+                }
+
+                for(IndexType ja = index1_a[ia]; ja < index1_a[ia+1]; ++ja) {
+                    const IndexType ca = index2_a[ja];
+                    const ValueType va = values_a[(positions_a == nullptr) ? ja : positions_a[ja]];
+                    for(IndexType jb = index1_b[ca]; jb < index1_b[ca+1]; ++jb)
+                        values_c[position[index2_b[jb]]] += va * values_b[jb];
+                }
+            }
+        }
+    }
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+    bool IsInitialized() const
+    {
+        return mIsInitialized;
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const
+    {
+        return "SparseMatrixProductPlan";
+    }
+
+    /// Print information about this object.
+    void PrintInfo (std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    void PrintData (std::ostream& rOStream) const
+    {
+        rOStream << (mTransposeA ? "C = A'·B, " : "C = A·B, ") << mSize1 << "x" << mSize2 << ", " << mNonZerosC << " nonzeros";
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    bool mTransposeA;
+
+    bool mIsInitialized;
+
+    SizeType mSize1;
+
+    SizeType mSize2;
+
+    SizeType mNonZerosA;
+
+    SizeType mNonZerosB;
+
+    SizeType mNonZerosC;
+
+    IndexVectorType mRowStartsA; // the pattern of the transpose of A
+
+    IndexVectorType mColumnsA;
+
+    IndexVectorType mPositionsA; // the positions of the entries of the transpose in the values of A
+
+    HashType mPatternHashA; // the hashes of the patterns given to Initialize
+
+    HashType mPatternHashB;
+
+    HashType mPatternHashC;
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// A hash of the row starts and the column indices of rM
+    static HashType PatternHash(const MatrixType& rM)
+    {
+        HashType seed = HashRange(rM.index1_data().begin(), rM.index1_data().begin() + rM.filled1());
+        HashCombine(seed, HashRange(rM.index2_data().begin(), rM.index2_data().begin() + rM.filled2()));
+        return seed;
+    }
+
+    ///@}
+
+}; // Class SparseMatrixProductPlan
+
+/**
+ * @class SparseMatrixTripleProductPlan
+ * @ingroup KratosCore
+ * @brief The Galerkin product C = Pᵀ·A·P of sparse matrices, for the products repeated with unchanged patterns (e.g.
+ * the coarse matrices of a multigrid, or the systems with constraints)
+ * @details The product is computed as Pᵀ·(A·P), with the plans of both products and the intermediate A·P kept
+ * between the calls. The transpose of P is not assembled.
+ */
+template<class TMatrixType>
+class SparseMatrixTripleProductPlan
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of SparseMatrixTripleProductPlan
+    KRATOS_CLASS_POINTER_DEFINITION( SparseMatrixTripleProductPlan );
+
+    typedef TMatrixType MatrixType;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor
+    SparseMatrixTripleProductPlan()
+    : mProductAP(false), mProductPtAP(true)
+    {}
+
+    /// Destructor
+    virtual ~SparseMatrixTripleProductPlan() {}
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// The symbolic and numeric product C = Pᵀ·A·P
+    void Initialize(
+        const MatrixType& rP,
+        const MatrixType& rA,
+        MatrixType& rC
+        )
+    {
+        mProductAP.Initialize(rA, rP, mAP);
+        mProductPtAP.Initialize(rP, mAP, rC);
+    }
+
+    /// The numeric product C = Pᵀ·A·P, in the pattern given to rC by Initialize
+    void Multiply(
+        const MatrixType& rP,
+        const MatrixType& rA,
+        MatrixType& rC
+        )
+    {
+        mProductAP.Multiply(rA, rP, mAP);
+        mProductPtAP.Multiply(rP, mAP, rC);
+    }
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+    bool IsInitialized() const
+    {
+        return mProductPtAP.IsInitialized();
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    std::string Info() const
+    {
+        return "SparseMatrixTripleProductPlan";
+    }
+
+    /// Print information about this object.
+    void PrintInfo (std::ostream& rOStream) const
+    {
+        rOStream << Info();
+    }
+
+    /// Print object's data.
+    void PrintData (std::ostream& rOStream) const
+    {
+        mProductPtAP.PrintData(rOStream);
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    SparseMatrixProductPlan<MatrixType> mProductAP;
+
+    SparseMatrixProductPlan<MatrixType> mProductPtAP;
+
+    MatrixType mAP;
+
+    ///@}
+
+}; // Class SparseMatrixTripleProductPlan
+
 ///@}
 
 ///@name Type Definitions